@@ -0,0 +1,240 @@
+/***************************************************************************
+               benchmark_ksparser.cpp  -  KStars Planetarium
+                             -------------------
+    begin                : Sat 17 Oct 2026
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "benchmark_ksparser.h"
+
+#include <random>
+
+namespace
+{
+const int SyntheticRows = 500000;
+}
+
+void BenchmarkKSParser::initTestCase()
+{
+    Catalog ngcic;
+    ngcic.file = QString(KSTARS_DATA_DIR) + "/ngcic.dat";
+    QList<QPair<QString, int>> const columns = { { "Flag", 1 },      { "ID", 4 },     { "suffix", 1 },   { "RA_H", 2 },
+                                                 { "RA_M", 2 },      { "RA_S", 4 },   { "D_Sign", 2 },   { "Dec_d", 2 },
+                                                 { "Dec_m", 2 },     { "Dec_s", 2 },  { "BMag", 6 },     { "type", 2 },
+                                                 { "a", 6 },         { "b", 6 },      { "pa", 4 },       { "PGC", 7 },
+                                                 { "other cat", 4 }, { "other1", 6 }, { "other2", 6 },   { "Messr", 2 },
+                                                 { "MessrNum", 4 }
+                                               };
+    QStringList const intColumns   = { "ID", "RA_H", "RA_M", "Dec_d", "Dec_m", "Dec_s", "type", "PGC", "MessrNum" };
+    QStringList const floatColumns = { "RA_S", "a", "b" };
+    for (const auto &column : columns)
+    {
+        KSParser::DataTypes type = KSParser::D_QSTRING;
+        if (intColumns.contains(column.first))
+            type = KSParser::D_INT;
+        else if (floatColumns.contains(column.first))
+            type = KSParser::D_FLOAT;
+        ngcic.sequence.append(qMakePair(column.first, type));
+        ngcic.widths.append(column.second);
+    }
+    ngcic.sequence.append(qMakePair(QString("Longname"), KSParser::D_QSTRING));
+    ngcic.doubleColumn = "a";
+    ngcic.intColumn    = "PGC";
+    catalogs_["ngcic"] = ngcic;
+
+    Catalog asteroids;
+    asteroids.file = QString(KSTARS_DATA_DIR) + "/asteroids.dat";
+    for (const QString &name : { "full name", "epoch_mjd", "q", "a", "e", "i", "w", "om", "ma", "tp_calc", "orbit_id",
+                                 "H", "G", "neo", "M1", "M2", "diameter", "extent", "albedo", "rot_period", "per_y",
+                                 "moid", "class" })
+    {
+        KSParser::DataTypes type = KSParser::D_DOUBLE;
+        if (name == "epoch_mjd")
+            type = KSParser::D_INT;
+        else if (QStringList({ "full name", "orbit_id", "neo", "extent", "class" }).contains(name))
+            type = KSParser::D_QSTRING;
+        else if (QStringList({ "tp_calc", "M1", "M2" }).contains(name))
+            type = KSParser::D_SKIP;
+        asteroids.sequence.append(qMakePair(name, type));
+    }
+    asteroids.doubleColumn = "a";
+    asteroids.intColumn    = "epoch_mjd";
+    catalogs_["asteroids"] = asteroids;
+
+    // Same kind of data as a custom catalog, with quoted names
+    QVERIFY(synthetic_file_.open());
+    {
+        QTextStream stream(&synthetic_file_);
+        std::mt19937 generator(42);
+        std::uniform_real_distribution<double> uniform(0, 1);
+
+        stream << "# name,id,ra,dec,mag,type\n";
+        for (int i = 0; i < SyntheticRows; ++i)
+        {
+            stream << "\"Object " << i << ", part " << char('a' + i % 26) << "\"," << i << ','
+                   << QString::number(uniform(generator) * 360, 'f', 10) << ','
+                   << QString::number(uniform(generator) * 180 - 90, 'f', 10) << ','
+                   << QString::number(uniform(generator) * 20, 'f', 2) << ",Galaxy\n";
+        }
+    }
+    synthetic_file_.close();
+
+    Catalog synthetic;
+    synthetic.file     = synthetic_file_.fileName();
+    synthetic.sequence = { qMakePair(QString("name"), KSParser::D_QSTRING), qMakePair(QString("id"), KSParser::D_INT),
+                           qMakePair(QString("ra"), KSParser::D_DOUBLE),    qMakePair(QString("dec"), KSParser::D_DOUBLE),
+                           qMakePair(QString("mag"), KSParser::D_FLOAT),    qMakePair(QString("type"), KSParser::D_QSTRING)
+                         };
+    synthetic.doubleColumn = "dec";
+    synthetic.intColumn    = "id";
+    catalogs_["synthetic"] = synthetic;
+}
+
+std::unique_ptr<KSParser> BenchmarkKSParser::parser(const Catalog &catalog)
+{
+    if (catalog.widths.isEmpty())
+        return std::unique_ptr<KSParser>(new KSParser(catalog.file, '#', catalog.sequence));
+    return std::unique_ptr<KSParser>(new KSParser(catalog.file, '#', catalog.sequence, catalog.widths));
+}
+
+int BenchmarkKSParser::readRows(const Catalog &catalog, double &doubleSum, qint64 &intSum)
+{
+    std::unique_ptr<KSParser> rowParser = parser(catalog);
+    int rows  = 0;
+    doubleSum = 0;
+    intSum    = 0;
+
+    while (rowParser->HasNextRow())
+    {
+        QHash<QString, QVariant> const row = rowParser->ReadNextRow();
+        // Dummy row returned at the end of files with trailing invalid lines
+        if (row.value(catalog.sequence.first().first) == KSParser::EBROKEN_QSTRING)
+            continue;
+
+        doubleSum += row.value(catalog.doubleColumn).toDouble();
+        intSum += row.value(catalog.intColumn).toInt();
+        rows++;
+    }
+
+    return rows;
+}
+
+int BenchmarkKSParser::readTypedRows(const Catalog &catalog, double &doubleSum, qint64 &intSum)
+{
+    std::unique_ptr<KSParser> rowParser = parser(catalog);
+    int const doubleColumn = rowParser->ColumnIndex(catalog.doubleColumn);
+    int const intColumn    = rowParser->ColumnIndex(catalog.intColumn);
+    bool const isFloat     = catalog.sequence[doubleColumn].second == KSParser::D_FLOAT;
+    int rows  = 0;
+    doubleSum = 0;
+    intSum    = 0;
+
+    while (rowParser->NextRow())
+    {
+        doubleSum += isFloat ? rowParser->FieldFloat(doubleColumn) : rowParser->FieldDouble(doubleColumn);
+        intSum += rowParser->FieldInt(intColumn);
+        rows++;
+    }
+
+    return rows;
+}
+
+void BenchmarkKSParser::addCatalogRows()
+{
+    for (const QString &name : catalogs_.keys())
+    {
+        QTest::newRow(qPrintable(name + "_QHash")) << name << false;
+        QTest::newRow(qPrintable(name + "_Typed")) << name << true;
+    }
+}
+
+void BenchmarkKSParser::compareInterfaces_data()
+{
+    QTest::addColumn<QString>("Catalog");
+
+    for (const QString &name : catalogs_.keys())
+        QTest::newRow(qPrintable(name)) << name;
+}
+
+void BenchmarkKSParser::compareInterfaces()
+{
+    QFETCH(QString, Catalog);
+    const auto &catalog = catalogs_[Catalog];
+
+    double doubleSum = 0, typedDoubleSum = 0;
+    qint64 intSum = 0, typedIntSum = 0;
+    int const rows      = readRows(catalog, doubleSum, intSum);
+    int const typedRows = readTypedRows(catalog, typedDoubleSum, typedIntSum);
+
+    QVERIFY(rows > 0);
+    QCOMPARE(typedRows, rows);
+    QCOMPARE(typedIntSum, intSum);
+    QCOMPARE(typedDoubleSum, doubleSum);
+
+    // Row by row, on every column
+    std::unique_ptr<KSParser> rowParser   = parser(catalog);
+    std::unique_ptr<KSParser> typedParser = parser(catalog);
+    while (typedParser->NextRow())
+    {
+        QHash<QString, QVariant> const row = rowParser->ReadNextRow();
+        for (int i = 0; i < catalog.sequence.size(); ++i)
+        {
+            const QPair<QString, KSParser::DataTypes> &column = catalog.sequence[i];
+            // Duplicate names keep the last column in the QHash
+            if (typedParser->ColumnIndex(column.first) != i)
+                continue;
+
+            switch (column.second)
+            {
+                case KSParser::D_INT:
+                    QCOMPARE(typedParser->FieldInt(i), row.value(column.first).toInt());
+                    break;
+                case KSParser::D_FLOAT:
+                    QCOMPARE(typedParser->FieldFloat(i), row.value(column.first).toFloat());
+                    break;
+                case KSParser::D_DOUBLE:
+                    QCOMPARE(typedParser->FieldDouble(i), row.value(column.first).toDouble());
+                    break;
+                default:
+                    QCOMPARE(typedParser->FieldString(i), row.value(column.first).toString());
+                    break;
+            }
+        }
+    }
+}
+
+void BenchmarkKSParser::benchmarkRead_data()
+{
+    QTest::addColumn<QString>("Catalog");
+    QTest::addColumn<bool>("Typed");
+
+    addCatalogRows();
+}
+
+void BenchmarkKSParser::benchmarkRead()
+{
+    QFETCH(QString, Catalog);
+    QFETCH(bool, Typed);
+    const auto &catalog = catalogs_[Catalog];
+
+    double doubleSum = 0;
+    qint64 intSum    = 0;
+    int rows         = 0;
+
+    QBENCHMARK
+    {
+        rows = Typed ? readTypedRows(catalog, doubleSum, intSum) : readRows(catalog, doubleSum, intSum);
+    }
+
+    QVERIFY(rows > 0);
+}
+
+QTEST_GUILESS_MAIN(BenchmarkKSParser)
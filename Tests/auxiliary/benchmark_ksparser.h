@@ -0,0 +1,72 @@
+/***************************************************************************
+                benchmark_ksparser.h  -  KStars Planetarium
+                             -------------------
+    begin                : Sat 17 Oct 2026
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include "ksparser.h"
+
+#include <QtTest/QtTest>
+
+#include <memory>
+
+/**
+ * @class BenchmarkKSParser
+ * @short Measures the time KSParser takes to read whole catalogs
+ *
+ * The QHash rows of ReadNextRow() are compared with the typed accessors of NextRow() on
+ * ngcic.dat, asteroids.dat and a large synthetic CSV file. Both interfaces must read the
+ * same rows and values.
+ */
+class BenchmarkKSParser : public QObject
+{
+    Q_OBJECT
+
+  public:
+    BenchmarkKSParser() = default;
+    ~BenchmarkKSParser() override = default;
+
+  private slots:
+    void initTestCase();
+
+    void compareInterfaces_data();
+    void compareInterfaces();
+
+    void benchmarkRead_data();
+    void benchmarkRead();
+
+  private:
+    struct Catalog
+    {
+        QString file;
+        QList<QPair<QString, KSParser::DataTypes>> sequence;
+        /// Empty for CSV files
+        QList<int> widths;
+        /// Columns summed to check the values read
+        QString doubleColumn;
+        QString intColumn;
+    };
+
+    static std::unique_ptr<KSParser> parser(const Catalog &catalog);
+
+    /** Read all rows with ReadNextRow(), and sum the check columns */
+    static int readRows(const Catalog &catalog, double &doubleSum, qint64 &intSum);
+    /** Read all rows with NextRow(), and sum the check columns */
+    static int readTypedRows(const Catalog &catalog, double &doubleSum, qint64 &intSum);
+
+    void addCatalogRows();
+
+    QMap<QString, Catalog> catalogs_;
+    QTemporaryFile synthetic_file_;
+};
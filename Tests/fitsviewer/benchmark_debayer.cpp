@@ -0,0 +1,236 @@
+/***************************************************************************
+                 benchmark_debayer.cpp  -  KStars Planetarium
+                             -------------------
+    begin                : Sat 17 Oct 2026
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "benchmark_debayer.h"
+
+#include "fitsviewer/bayer.h"
+#include "fitsviewer/paralleldebayer.h"
+
+#include <random>
+
+Q_DECLARE_METATYPE(dc1394color_filter_t)
+Q_DECLARE_METATYPE(dc1394bayer_method_t)
+
+namespace
+{
+/** Sky-like synthetic frame: a gradient, noise and a grid of stars */
+template <typename T>
+void fillFrame(std::vector<T> &frame, uint32_t width, uint32_t height, int maximum)
+{
+    std::mt19937 generator(42);
+    std::normal_distribution<double> noise(0, maximum / 100.0);
+
+    frame.resize(static_cast<size_t>(width) * height);
+    for (uint32_t y = 0; y < height; y++)
+    {
+        for (uint32_t x = 0; x < width; x++)
+        {
+            double value = maximum * (0.1 + 0.1 * x / width) + noise(generator);
+
+            // A star every 64 pixels, a few pixels wide
+            int const dx = static_cast<int>(x % 64) - 32, dy = static_cast<int>(y % 64) - 32;
+            value += maximum * 0.7 * std::exp(-(dx * dx + dy * dy) / 8.0);
+
+            frame[static_cast<size_t>(y) * width + x] = static_cast<T>(qBound(0.0, value, static_cast<double>(maximum)));
+        }
+    }
+}
+}
+
+void BenchmarkDebayer::initTestCase()
+{
+    QString const size = qgetenv("KSTARS_BENCHMARK_BAYER_SIZE");
+    if (size.isEmpty() == false)
+    {
+        QStringList const dimensions = size.split('x');
+        QVERIFY(dimensions.count() == 2);
+        // Whole bayer cells
+        m_Width  = dimensions[0].toUInt() & ~1U;
+        m_Height = dimensions[1].toUInt() & ~1U;
+        QVERIFY(m_Width >= 16 && m_Height >= 16);
+    }
+
+    fillFrame(m_Bayer8, m_Width, m_Height, 255);
+    fillFrame(m_Bayer16, m_Width, m_Height, 65535);
+
+    qDebug() << "Bayer frame" << m_Width << "x" << m_Height << "," << QThread::idealThreadCount() << "threads";
+}
+
+void BenchmarkDebayer::addRows(bool parallelOnly)
+{
+    QTest::addColumn<dc1394color_filter_t>("Pattern");
+    QTest::addColumn<dc1394bayer_method_t>("Method");
+    QTest::addColumn<bool>("Parallel");
+
+    const QList<QPair<QString, dc1394color_filter_t>> patterns =
+    {
+        { "RGGB", DC1394_COLOR_FILTER_RGGB },
+        { "BGGR", DC1394_COLOR_FILTER_BGGR }
+    };
+    const QList<QPair<QString, dc1394bayer_method_t>> methods =
+    {
+        { "nearest", DC1394_BAYER_METHOD_NEAREST },
+        { "simple", DC1394_BAYER_METHOD_SIMPLE },
+        { "bilinear", DC1394_BAYER_METHOD_BILINEAR },
+        { "hqlinear", DC1394_BAYER_METHOD_HQLINEAR },
+        { "edgesense", DC1394_BAYER_METHOD_EDGESENSE },
+        { "vng", DC1394_BAYER_METHOD_VNG }
+    };
+
+    for (const auto &pattern : patterns)
+    {
+        for (const auto &method : methods)
+        {
+            if (parallelOnly == false)
+                QTest::newRow(qPrintable(QString("%1_%2_dc1394").arg(pattern.first, method.first)))
+                        << pattern.second << method.second << false;
+            QTest::newRow(qPrintable(QString("%1_%2_parallel").arg(pattern.first, method.first)))
+                    << pattern.second << method.second << true;
+        }
+    }
+}
+
+void BenchmarkDebayer::benchmarkDebayer8_data()
+{
+    addRows(false);
+}
+
+void BenchmarkDebayer::benchmarkDebayer8()
+{
+    QFETCH(dc1394color_filter_t, Pattern);
+    QFETCH(dc1394bayer_method_t, Method);
+    QFETCH(bool, Parallel);
+
+    BayerParams params;
+    params.method  = Method;
+    params.filter  = Pattern;
+    params.offsetX = params.offsetY = 0;
+
+    std::vector<uint8_t> rgb(m_Bayer8.size() * 3);
+    ParallelDebayer debayer;
+
+    if (Parallel)
+    {
+        QBENCHMARK
+        {
+            QCOMPARE(debayer.debayer(m_Bayer8.data(), rgb.data(), m_Width, m_Height, params, ParallelDebayer::RGB_INTERLEAVED),
+                     DC1394_SUCCESS);
+        }
+
+        // Same pixels as the whole frame decoding
+        std::vector<uint8_t> reference(rgb.size());
+        QCOMPARE(dc1394_bayer_decoding_8bit(m_Bayer8.data(), reference.data(), m_Width, m_Height, Pattern, Method), DC1394_SUCCESS);
+        QVERIFY(rgb == reference);
+    }
+    else
+    {
+        QBENCHMARK
+        {
+            QCOMPARE(dc1394_bayer_decoding_8bit(m_Bayer8.data(), rgb.data(), m_Width, m_Height, Pattern, Method), DC1394_SUCCESS);
+        }
+    }
+}
+
+void BenchmarkDebayer::benchmarkDebayer16_data()
+{
+    addRows(false);
+}
+
+void BenchmarkDebayer::benchmarkDebayer16()
+{
+    QFETCH(dc1394color_filter_t, Pattern);
+    QFETCH(dc1394bayer_method_t, Method);
+    QFETCH(bool, Parallel);
+
+    BayerParams params;
+    params.method  = Method;
+    params.filter  = Pattern;
+    params.offsetX = params.offsetY = 0;
+
+    std::vector<uint16_t> rgb(m_Bayer16.size() * 3);
+    ParallelDebayer debayer;
+
+    if (Parallel)
+    {
+        // Planar, as FITSData decodes
+        QBENCHMARK
+        {
+            QCOMPARE(debayer.debayer(m_Bayer16.data(), rgb.data(), m_Width, m_Height, params, ParallelDebayer::RGB_PLANAR),
+                     DC1394_SUCCESS);
+        }
+
+        std::vector<uint16_t> reference(rgb.size());
+        QCOMPARE(dc1394_bayer_decoding_16bit(m_Bayer16.data(), reference.data(), m_Width, m_Height, Pattern, Method, 16),
+                 DC1394_SUCCESS);
+
+        size_t const plane = m_Bayer16.size();
+        for (size_t i = 0; i < plane; i++)
+        {
+            if (rgb[i] != reference[i * 3] || rgb[plane + i] != reference[i * 3 + 1] || rgb[2 * plane + i] != reference[i * 3 + 2])
+                QFAIL(qPrintable(QString("Pixel %1 differs from dc1394").arg(i)));
+        }
+    }
+    else
+    {
+        // Including the split into planes that FITSData used to do
+        std::vector<uint16_t> interleaved(rgb.size());
+        QBENCHMARK
+        {
+            QCOMPARE(dc1394_bayer_decoding_16bit(m_Bayer16.data(), interleaved.data(), m_Width, m_Height, Pattern, Method, 16),
+                     DC1394_SUCCESS);
+
+            size_t const plane = m_Bayer16.size();
+            for (size_t i = 0; i < plane; i++)
+            {
+                rgb[i]             = interleaved[i * 3];
+                rgb[plane + i]     = interleaved[i * 3 + 1];
+                rgb[2 * plane + i] = interleaved[i * 3 + 2];
+            }
+        }
+    }
+}
+
+void BenchmarkDebayer::benchmarkSuperPixel_data()
+{
+    QTest::addColumn<dc1394color_filter_t>("Pattern");
+
+    QTest::newRow("RGGB") << DC1394_COLOR_FILTER_RGGB;
+    QTest::newRow("BGGR") << DC1394_COLOR_FILTER_BGGR;
+}
+
+void BenchmarkDebayer::benchmarkSuperPixel()
+{
+    QFETCH(dc1394color_filter_t, Pattern);
+
+    BayerParams params;
+    params.method  = DC1394_BAYER_METHOD_NEAREST;
+    params.filter  = Pattern;
+    params.offsetX = params.offsetY = 0;
+
+    std::vector<uint8_t> rgb(m_Bayer8.size() * 3 / 4);
+
+    QBENCHMARK
+    {
+        QCOMPARE(ParallelDebayer::superPixel(m_Bayer8.data(), rgb.data(), m_Width, m_Height, params), DC1394_SUCCESS);
+    }
+
+    // Top left cell: red is the first sample for RGGB, the last one for BGGR
+    uint8_t const topLeft = m_Bayer8[0], bottomRight = m_Bayer8[m_Width + 1];
+    QCOMPARE(rgb[0], Pattern == DC1394_COLOR_FILTER_RGGB ? topLeft : bottomRight);
+    QCOMPARE(rgb[2], Pattern == DC1394_COLOR_FILTER_RGGB ? bottomRight : topLeft);
+    QCOMPARE(static_cast<int>(rgb[1]), (m_Bayer8[1] + m_Bayer8[m_Width] + 1) >> 1);
+}
+
+QTEST_GUILESS_MAIN(BenchmarkDebayer)
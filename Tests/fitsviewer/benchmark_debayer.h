@@ -0,0 +1,60 @@
+/***************************************************************************
+                  benchmark_debayer.h  -  KStars Planetarium
+                             -------------------
+    begin                : Sat 17 Oct 2026
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+#include <vector>
+
+/**
+ * @class BenchmarkDebayer
+ * @short Compares ParallelDebayer with the plain dc1394 decoders
+ *
+ * Decodes synthetic 8 and 16 bit bayer frames of a large sensor, with RGGB and BGGR patterns and
+ * the usual methods, once with dc1394_bayer_decoding_8bit/16bit on the whole frame and once with
+ * ParallelDebayer, then checks that both give the same pixels. The superpixel preview decoding is
+ * measured as well. The frame size can be set with the KSTARS_BENCHMARK_BAYER_SIZE environment
+ * variable, e.g. 6000x4000.
+ */
+class BenchmarkDebayer : public QObject
+{
+    Q_OBJECT
+
+  public:
+    BenchmarkDebayer() = default;
+    ~BenchmarkDebayer() override = default;
+
+  private slots:
+    void initTestCase();
+
+    void benchmarkDebayer8_data();
+    void benchmarkDebayer8();
+
+    void benchmarkDebayer16_data();
+    void benchmarkDebayer16();
+
+    void benchmarkSuperPixel_data();
+    void benchmarkSuperPixel();
+
+  private:
+    /** Rows for the pattern, method and decoder columns */
+    static void addRows(bool parallelOnly);
+
+    uint32_t m_Width { 4656 };
+    uint32_t m_Height { 3520 };
+    std::vector<uint8_t> m_Bayer8;
+    std::vector<uint16_t> m_Bayer16;
+};
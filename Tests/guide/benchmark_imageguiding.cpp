@@ -0,0 +1,103 @@
+/***************************************************************************
+             benchmark_imageguiding.cpp  -  KStars Planetarium
+                             -------------------
+    begin                : Sat 17 Oct 2026
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "benchmark_imageguiding.h"
+
+#include "ekos/guide/internalguide/imageautoguiding.h"
+
+#include <random>
+
+std::vector<float> BenchmarkImageGuiding::starField(int n, double dx, double dy)
+{
+    // Same stars for every frame, different noise
+    std::mt19937 starGenerator(42);
+    std::uniform_real_distribution<double> uniform(0, 1);
+    static std::mt19937 noiseGenerator(7);
+    std::normal_distribution<double> noise(0, 3);
+
+    struct Star
+    {
+        double x, y, flux;
+    };
+    std::vector<Star> stars(n * n / 2000 + 3);
+    for (Star &star : stars)
+        star = { uniform(starGenerator) * n, uniform(starGenerator) * n, 200 + 2000 * uniform(starGenerator) };
+
+    std::vector<float> field(static_cast<size_t>(n) * n);
+    for (int y = 0; y < n; y++)
+    {
+        for (int x = 0; x < n; x++)
+        {
+            double value = 100 + noise(noiseGenerator);
+            for (const Star &star : stars)
+            {
+                double const d2 = (x - star.x - dx) * (x - star.x - dx) + (y - star.y - dy) * (y - star.y - dy);
+                if (d2 < 200)
+                    value += star.flux * std::exp(-d2 / 8.0);
+            }
+            field[static_cast<size_t>(y) * n + x] = value;
+        }
+    }
+
+    return field;
+}
+
+void BenchmarkImageGuiding::benchmarkShift_data()
+{
+    QTest::addColumn<int>("Size");
+    QTest::addColumn<bool>("Cached");
+
+    for (int size : { 128, 256, 512, 1024 })
+    {
+        QTest::newRow(qPrintable(QString("%1_ImageAutoGuiding1").arg(size))) << size << false;
+        QTest::newRow(qPrintable(QString("%1_PhaseCorrelator").arg(size))) << size << true;
+    }
+}
+
+void BenchmarkImageGuiding::benchmarkShift()
+{
+    QFETCH(int, Size);
+    QFETCH(bool, Cached);
+
+    double const dx = 1.3, dy = -0.4;
+    std::vector<float> reference = starField(Size, 0, 0);
+    std::vector<float> frame     = starField(Size, dx, dy);
+
+    float xshift = 0, yshift = 0;
+
+    if (Cached)
+    {
+        ImageAutoGuiding::PhaseCorrelator correlator(Size);
+        correlator.setReference(reference.data());
+
+        QBENCHMARK
+        {
+            correlator.shift(frame.data(), &xshift, &yshift);
+        }
+    }
+    else
+    {
+        QBENCHMARK
+        {
+            ImageAutoGuiding::ImageAutoGuiding1(reference.data(), frame.data(), Size, &xshift, &yshift);
+        }
+    }
+
+    // xshift is reported along the rows
+    QVERIFY2(std::fabs(xshift - dy) < 0.1 && std::fabs(yshift - dx) < 0.1,
+             qPrintable(QString("Found shift %1, %2").arg(yshift).arg(xshift)));
+}
+
+QTEST_GUILESS_MAIN(BenchmarkImageGuiding)
@@ -0,0 +1,45 @@
+/***************************************************************************
+              benchmark_imageguiding.h  -  KStars Planetarium
+                             -------------------
+    begin                : Sat 17 Oct 2026
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+#include <vector>
+
+/**
+ * @class BenchmarkImageGuiding
+ * @short Measures the per frame cost of image guiding for the guide region sizes
+ *
+ * A synthetic star field is shifted by a known sub-pixel amount. The cached PhaseCorrelator,
+ * which only transforms the new frame, is compared with ImageAutoGuiding1, which transforms the
+ * reference of every frame as well, and both must find the shift.
+ */
+class BenchmarkImageGuiding : public QObject
+{
+    Q_OBJECT
+
+  public:
+    BenchmarkImageGuiding() = default;
+    ~BenchmarkImageGuiding() override = default;
+
+  private slots:
+    void benchmarkShift_data();
+    void benchmarkShift();
+
+  private:
+    /** Star field of n x n pixels, with its stars moved by (dx, dy) pixels */
+    static std::vector<float> starField(int n, double dx, double dy);
+};
@@ -0,0 +1,194 @@
+/***************************************************************************
+                  benchmark_skymap.cpp  -  KStars Planetarium
+                             -------------------
+    begin                : Sat 17 Oct 2026
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "benchmark_skymap.h"
+
+#include "kstarsdata.h"
+#include "Options.h"
+#include "skymap.h"
+#include "skyqpainter.h"
+#include "auxiliary/frameprofiler.h"
+#include "auxiliary/kspaths.h"
+#include "projections/projector.h"
+#include "skycomponents/skymapcomposite.h"
+#include "skycomponents/starblockfactory.h"
+
+#include <QPainterPath>
+
+#ifdef Q_OS_UNIX
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+const int ImageWidth  = 1280;
+const int ImageHeight = 800;
+}
+
+void BenchmarkSkyMap::initTestCase()
+{
+    // Keep the user's configuration and databases out of this
+    QStandardPaths::setTestModeEnabled(true);
+
+    // KStarsData::initialize() pops up message boxes for missing files, which would block here
+    for (const QString &file : { "TZrules.dat", "citydb.sqlite", "image_url.dat", "info_url.dat" })
+    {
+        if (KSPaths::locate(QStandardPaths::GenericDataLocation, file).isEmpty())
+            QSKIP(qPrintable(QString("KStars data file %1 not found").arg(file)));
+    }
+
+    // Nothing may be fetched from the network
+    Options::setShowHIPS(false);
+
+    m_Data = KStarsData::Create();
+    QVERIFY(m_Data != nullptr);
+    QVERIFY(m_Data->initialize());
+    // Asteroids, comets, satellites and custom catalogs are drawn too
+    m_Data->loadDeferredData(true);
+
+    m_Data->setLocationFromOptions();
+    m_Data->colorScheme()->loadFromConfig();
+
+    // Fixed date, so that runs are comparable
+    m_Data->clock()->setUTC(KStarsDateTime(QDateTime(QDate(2020, 3, 20), QTime(21, 0, 0), Qt::UTC)));
+    m_Data->clock()->stop();
+
+    m_Map = SkyMap::Create();
+    m_Map->resize(ImageWidth, ImageHeight);
+
+    m_Data->setFullTimeUpdate();
+    m_Data->updateTime(m_Data->geo());
+
+    m_Image = QImage(ImageWidth, ImageHeight, QImage::Format_ARGB32_Premultiplied);
+
+    FrameProfiler::setEnabled(true);
+}
+
+void BenchmarkSkyMap::cleanupTestCase()
+{
+    FrameProfiler::setEnabled(false);
+
+    delete m_Map;
+    m_Map = nullptr;
+    delete m_Data;
+    m_Data = nullptr;
+}
+
+void BenchmarkSkyMap::benchmarkRender_data()
+{
+    QTest::addColumn<double>("RA");
+    QTest::addColumn<double>("Dec");
+    QTest::addColumn<double>("RAStep");
+    QTest::addColumn<double>("DecStep");
+    QTest::addColumn<double>("Zoom");
+    QTest::addColumn<int>("Projection");
+    QTest::addColumn<int>("StarDensity");
+
+    // Pan along the Milky Way, across the celestial pole, and sit on dense fields
+    QTest::newRow("wide_lambert") << 5.5 << 0.0 << 0.2 << 0.0 << 250.0 << int(Projector::Lambert) << 5;
+    QTest::newRow("wide_equirectangular") << 5.5 << 0.0 << 0.2 << 0.0 << 250.0 << int(Projector::Equirectangular) << 5;
+    QTest::newRow("medium_stereographic") << 18.0 << -25.0 << 0.05 << 0.5 << 1500.0
+                                          << int(Projector::Stereographic) << 7;
+    QTest::newRow("medium_orthographic") << 2.0 << 80.0 << 0.5 << 0.2 << 1500.0 << int(Projector::Orthographic) << 7;
+    QTest::newRow("narrow_gnomonic") << 5.59 << -5.4 << 0.005 << 0.05 << 20000.0 << int(Projector::Gnomonic) << 10;
+    QTest::newRow("narrow_azimuthal") << 20.4 << 40.0 << 0.005 << 0.05 << 20000.0
+                                      << int(Projector::AzimuthalEquidistant) << 10;
+    QTest::newRow("deep_lambert") << 18.1 << -29.0 << 0.001 << 0.01 << 100000.0 << int(Projector::Lambert) << 14;
+}
+
+void BenchmarkSkyMap::benchmarkRender()
+{
+    QFETCH(double, RA);
+    QFETCH(double, Dec);
+    QFETCH(double, RAStep);
+    QFETCH(double, DecStep);
+    QFETCH(double, Zoom);
+    QFETCH(int, Projection);
+    QFETCH(int, StarDensity);
+
+    int frames = qEnvironmentVariableIntValue("KSTARS_BENCHMARK_FRAMES");
+    if (frames <= 0)
+        frames = 20;
+
+    Options::setProjection(Projection);
+    Options::setStarDensity(StarDensity);
+    Options::setUseAltAz(false);
+    m_Map->setZoomFactor(Zoom);
+
+    // Warm up: load the star blocks and fill the caches for the starting field
+    m_Map->setFocus(dms(RA * 15.0), dms(Dec));
+    renderFrame();
+    FrameProfiler::Instance()->reset();
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int i = 0; i < frames; ++i)
+    {
+        double dec = qBound(-90.0, Dec + i * DecStep, 90.0);
+        m_Map->setFocus(dms((RA + i * RAStep) * 15.0), dms(dec));
+        renderFrame();
+    }
+
+    double seconds = timer.nsecsElapsed() * 1e-9;
+    double fps     = frames / seconds;
+
+    qInfo("%s: %.2f fps, %.2f ms/frame, %d star blocks, peak RSS %ld kB", QTest::currentDataTag(), fps,
+          1000.0 * seconds / frames, StarBlockFactory::Instance()->getBlockCount(), peakRSS());
+    for (const QString &line : FrameProfiler::Instance()->summary())
+        qInfo("    %s", qPrintable(line));
+
+    QTest::setBenchmarkResult(fps, QTest::FramesPerSecond);
+}
+
+void BenchmarkSkyMap::renderFrame()
+{
+    m_Data->setFullTimeUpdate();
+    m_Data->updateTime(m_Data->geo());
+    m_Map->setupProjector();
+
+    SkyQPainter psky(&m_Image, m_Image.size());
+    psky.begin();
+    psky.drawSkyBackground();
+
+    QPainterPath path;
+    path.addPolygon(m_Map->projector()->clipPoly());
+    psky.setClipPath(path);
+    psky.setClipping(true);
+
+    FrameProfiler::Timer timer;
+    m_Data->skyComposite()->draw(&psky);
+    timer.lap("frame/Composite");
+
+    psky.end();
+}
+
+long BenchmarkSkyMap::peakRSS()
+{
+#ifdef Q_OS_UNIX
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#ifdef Q_OS_MACOS
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+#else
+    return 0;
+#endif
+}
+
+QTEST_MAIN(BenchmarkSkyMap)
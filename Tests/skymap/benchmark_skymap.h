@@ -0,0 +1,63 @@
+/***************************************************************************
+                   benchmark_skymap.h  -  KStars Planetarium
+                             -------------------
+    begin                : Sat 17 Oct 2026
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QtTest/QtTest>
+#include <QImage>
+
+class KStarsData;
+class SkyMap;
+
+/**
+ * @class BenchmarkSkyMap
+ * @short Headless rendering benchmark of the sky map
+ *
+ * Boots KStarsData without the main window, then renders SkyMapComposite::draw() through
+ * SkyQPainter into an offscreen QImage while panning along a scripted path, for a set of zoom
+ * levels, projections and star densities. For each scenario it reports the frame rate as the
+ * benchmark result, and logs the per-component draw times collected by FrameProfiler, the number
+ * of star blocks in the StarBlockFactory and the peak resident set size.
+ *
+ * Needs the KStars data files to be installed, but neither a display (run it with
+ * QT_QPA_PLATFORM=offscreen) nor network access. The number of measured frames per scenario can
+ * be set with the KSTARS_BENCHMARK_FRAMES environment variable.
+ */
+class BenchmarkSkyMap : public QObject
+{
+    Q_OBJECT
+
+  public:
+    BenchmarkSkyMap() = default;
+    ~BenchmarkSkyMap() override = default;
+
+  private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void benchmarkRender_data();
+    void benchmarkRender();
+
+  private:
+    /** Render one frame the way SkyMapQDraw::paintEvent() does */
+    void renderFrame();
+
+    /** @return peak resident set size of the process in kB, 0 if unknown */
+    static long peakRSS();
+
+    KStarsData *m_Data { nullptr };
+    SkyMap *m_Map { nullptr };
+    QImage m_Image;
+};
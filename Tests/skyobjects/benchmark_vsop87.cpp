@@ -0,0 +1,158 @@
+/***************************************************************************
+                benchmark_vsop87.cpp  -  KStars Planetarium
+                             -------------------
+    begin                : Sat 17 Oct 2026
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "benchmark_vsop87.h"
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+const int Count = 256;
+// One day, in Julian millenia
+const double Step = 1.0 / 365250;
+// From 2015
+const double Tau = 0.015;
+
+const QStringList planets = { "mercury", "venus", "earth", "mars", "jupiter", "saturn", "uranus", "neptune" };
+}
+
+bool BenchmarkVSOP87::readTextSeries(const QString &planet, TextSeries &series)
+{
+    char const coordinates[] = { 'L', 'B', 'R' };
+    int files = 0;
+
+    for (int c = 0; c < VSOP87::Coordinates; c++)
+    {
+        for (int p = 0; p < VSOP87::Powers; p++)
+        {
+            QFile file(QString("%1/vsop87/%2.%3%4.vsop")
+                       .arg(QString(KSTARS_DATA_DIR), planet)
+                       .arg(QChar(coordinates[c]))
+                       .arg(p));
+            if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+                continue;
+            files++;
+
+            QTextStream stream(&file);
+            while (!stream.atEnd())
+            {
+                QStringList const fields = stream.readLine().split(' ', QString::SkipEmptyParts);
+                if (fields.size() == 3)
+                    series[c][p].append({ fields[0].toDouble(), fields[1].toDouble(), fields[2].toDouble() });
+            }
+        }
+    }
+
+    return files > 0;
+}
+
+VSOP87::Position BenchmarkVSOP87::evaluateTextSeries(const TextSeries &series, double tau)
+{
+    double values[VSOP87::Coordinates];
+    double Tpow[VSOP87::Powers];
+
+    Tpow[0] = 1.0;
+    for (int i = 1; i < VSOP87::Powers; ++i)
+        Tpow[i] = Tpow[i - 1] * tau;
+
+    for (int c = 0; c < VSOP87::Coordinates; c++)
+    {
+        values[c] = 0;
+        for (int i = 0; i < VSOP87::Powers; ++i)
+        {
+            double sum = 0.0;
+            for (int j = 0; j < series[c][i].size(); ++j)
+                sum += series[c][i][j].A * cos(series[c][i][j].B + series[c][i][j].C * tau);
+            values[c] += sum * Tpow[i];
+        }
+    }
+
+    return { values[VSOP87::Longitude], values[VSOP87::Latitude], values[VSOP87::Radius] };
+}
+
+void BenchmarkVSOP87::initTestCase()
+{
+    for (const QString &planet : planets)
+        QVERIFY2(readTextSeries(planet, text_series_[planet]), qPrintable(planet));
+}
+
+void BenchmarkVSOP87::benchmarkEvaluate_data()
+{
+    QTest::addColumn<QString>("Planet");
+    QTest::addColumn<QString>("Method");
+    QTest::addColumn<double>("Tolerance");
+
+    for (const QString &planet : planets)
+    {
+        QTest::newRow(qPrintable(planet + "_text")) << planet << "text" << 0.0;
+        QTest::newRow(qPrintable(planet + "_tables")) << planet << "tables" << 0.0;
+        QTest::newRow(qPrintable(planet + "_batch")) << planet << "batch" << 0.0;
+        QTest::newRow(qPrintable(planet + "_tables_1e-7")) << planet << "tables" << 1e-7;
+        QTest::newRow(qPrintable(planet + "_batch_1e-7")) << planet << "batch" << 1e-7;
+    }
+}
+
+void BenchmarkVSOP87::benchmarkEvaluate()
+{
+    QFETCH(QString, Planet);
+    QFETCH(QString, Method);
+    QFETCH(double, Tolerance);
+
+    const TextSeries &text = text_series_[Planet];
+    std::shared_ptr<const VSOP87> const series = VSOP87::get(Planet, Tolerance);
+    QVERIFY(series);
+
+    std::vector<VSOP87::Position> positions(Count);
+
+    if (Method == "text")
+    {
+        QBENCHMARK
+        {
+            for (int k = 0; k < Count; k++)
+                positions[k] = evaluateTextSeries(text, Tau + k * Step);
+        }
+    }
+    else if (Method == "tables")
+    {
+        QBENCHMARK
+        {
+            for (int k = 0; k < Count; k++)
+                positions[k] = series->evaluate(Tau + k * Step);
+        }
+    }
+    else
+    {
+        QBENCHMARK
+        {
+            series->evaluate(Tau, Step, Count, positions.data());
+        }
+    }
+
+    // The complete series must give the positions of the text files, in radians and AU
+    double const tolerance = (Tolerance > 0) ? 1e-5 : 1e-10;
+    for (int k = 0; k < Count; k++)
+    {
+        VSOP87::Position const expected = evaluateTextSeries(text, Tau + k * Step);
+        QVERIFY2(std::fabs(positions[k].longitude - expected.longitude) < tolerance &&
+                 std::fabs(positions[k].latitude - expected.latitude) < tolerance &&
+                 std::fabs(positions[k].radius - expected.radius) < tolerance,
+                 qPrintable(QString("Position %1 differs from the text series").arg(k)));
+    }
+
+    qInfo() << Planet << Method << "evaluates" << series->terms() << "terms";
+}
+
+QTEST_GUILESS_MAIN(BenchmarkVSOP87)
@@ -0,0 +1,59 @@
+/***************************************************************************
+                 benchmark_vsop87.h  -  KStars Planetarium
+                             -------------------
+    begin                : Sat 17 Oct 2026
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include "vsop87.h"
+
+#include <QtTest/QtTest>
+
+#include <QMap>
+#include <QVector>
+
+/**
+ * @class BenchmarkVSOP87
+ * @short Measures the cost of a planet position with the compiled VSOP87 tables
+ *
+ * The reference is the former implementation of KSPlanet: the series read from the text files
+ * of data/vsop87, and a cosine for each term of each evaluation. It is compared with the
+ * compiled tables evaluated one date at a time and for evenly spaced dates at once, with the
+ * complete and the truncated series. Each benchmark iteration evaluates Count dates.
+ */
+class BenchmarkVSOP87 : public QObject
+{
+    Q_OBJECT
+
+  public:
+    BenchmarkVSOP87() = default;
+    ~BenchmarkVSOP87() override = default;
+
+  private slots:
+    void initTestCase();
+
+    void benchmarkEvaluate_data();
+    void benchmarkEvaluate();
+
+  private:
+    /** The series of the former implementation, by coordinate then power of time */
+    typedef QVector<VSOP87::Term> TextSeries[VSOP87::Coordinates][VSOP87::Powers];
+
+    /** Read the series of a planet from the text files, as KSPlanet did */
+    static bool readTextSeries(const QString &planet, TextSeries &series);
+
+    /** Evaluate the series of the text files, as KSPlanet did */
+    static VSOP87::Position evaluateTextSeries(const TextSeries &series, double tau);
+
+    QMap<QString, TextSeries> text_series_;
+};
@@ -20,6 +20,7 @@
 #include "ksnumbers.h"
 #include "time/kstarsdatetime.h"
 #include "auxiliary/dms.h"
+#include "skyobjects/skypointbatch.h"
 
 void TestSkyPoint::testPrecession()
 {
@@ -93,4 +94,85 @@ void TestSkyPoint::testPrecession()
     verify(p, 169.71785991, 45.30132855, arcsecPrecision);
 }
 
+void TestSkyPoint::testBatchPrecessNutate()
+{
+    // The batch kernel applies nutation as an exact rotation, while SkyPoint::nutate() uses the
+    // first order formula away from the poles. Both must agree to well within an arcsecond.
+    constexpr double arcsecPrecision = 1.e-4;
+
+    const double ra0[]  = { 0.0, 45.5, 123.456, 275.65, 351.3, 180.0 };
+    const double dec0[] = { 0.0, -30.25, 12.5, 34.38, -8.03, 75.0 };
+    const int n         = sizeof(ra0) / sizeof(ra0[0]);
+    double ra[n], dec[n];
+
+    KSNumbers num(KStarsDateTime::epochToJd(2020.5));
+    SkyPointBatch::precessNutate(&num, n, ra0, dec0, ra, dec);
+
+    for (int i = 0; i < n; ++i)
+    {
+        SkyPoint p(ra0[i] / 15.0, dec0[i]);
+        p.precess(&num);
+        p.nutate(&num);
+
+        double dRA = fabs(p.ra().Degrees() - ra[i]);
+        if (dRA > 180.0)
+            dRA = 360.0 - dRA;
+        QVERIFY(dRA * cos(dec[i] * dms::DegToRad) < arcsecPrecision);
+        QVERIFY(fabs(p.dec().Degrees() - dec[i]) < arcsecPrecision);
+    }
+}
+
+void TestSkyPoint::testBatchHorizontal()
+{
+    constexpr double precision = 1.e-8;
+
+    const double ra[]  = { 10.0, 100.0, 200.0, 300.0, 359.0 };
+    const double dec[] = { -60.0, -10.0, 0.5, 45.0, 85.0 };
+    const int n        = sizeof(ra) / sizeof(ra[0]);
+    double alt[n], az[n];
+
+    dms LST(123.4), lat(48.5);
+    SkyPointBatch::equatorialToHorizontal(&LST, &lat, n, ra, dec, alt, az);
+
+    for (int i = 0; i < n; ++i)
+    {
+        SkyPoint p(ra[i] / 15.0, dec[i]);
+        p.EquatorialToHorizontal(&LST, &lat);
+
+        QVERIFY(fabs(p.alt().Degrees() - alt[i]) < precision);
+        QVERIFY(fabs(p.az().Degrees() - az[i]) < precision);
+    }
+}
+
+void TestSkyPoint::testBatchUpdateCoords()
+{
+    // Stars of a StarBlock are updated with SkyPointBatch, named stars one by one with
+    // SkyPoint::updateCoords(). Only the nutation method differs, so both must agree closely.
+    constexpr double arcsecPrecision = 1.e-4;
+
+    const double ra0[]  = { 0.0, 45.5, 90.0, 123.456, 180.0, 275.65, 300.0, 351.3 };
+    const double dec0[] = { 0.0, -30.25, 66.5, 12.5, 75.0, 34.38, -70.0, -8.03 };
+    const int n         = sizeof(ra0) / sizeof(ra0[0]);
+    const double epochs[] = { 1950.0, 2000.0, 2017.3, 2020.5, 2050.9 };
+    double ra[n], dec[n];
+
+    for (double epoch : epochs)
+    {
+        KSNumbers num(KStarsDateTime::epochToJd(epoch));
+        SkyPointBatch::updateCoords(&num, n, ra0, dec0, ra, dec);
+
+        for (int i = 0; i < n; ++i)
+        {
+            SkyPoint p(ra0[i] / 15.0, dec0[i]);
+            p.updateCoordsNow(&num);
+
+            double dRA = fabs(p.ra().Degrees() - ra[i]);
+            if (dRA > 180.0)
+                dRA = 360.0 - dRA;
+            QVERIFY(dRA * cos(dec[i] * dms::DegToRad) < arcsecPrecision);
+            QVERIFY(fabs(p.dec().Degrees() - dec[i]) < arcsecPrecision);
+        }
+    }
+}
+
 QTEST_GUILESS_MAIN(TestSkyPoint)
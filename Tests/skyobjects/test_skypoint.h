@@ -41,6 +41,9 @@ class TestSkyPoint : public QObject
 
   private slots:
     void testPrecession();
+    void testBatchPrecessNutate();
+    void testBatchHorizontal();
+    void testBatchUpdateCoords();
 };
 
 #endif
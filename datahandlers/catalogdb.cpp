@@ -25,13 +25,95 @@
 #include "deepskyobject.h"
 #include "skycomponent.h"
 
+#include <QElapsedTimer>
+#include <QHash>
 #include <QSqlField>
 #include <QSqlQuery>
 #include <QSqlRecord>
 #include <QSqlTableModel>
+#include <QThread>
+#include <QVector>
 
 #include <catalog_debug.h>
 
+#include <cmath>
+
+namespace
+{
+/// Largest difference of RA and Dec in degrees, and of magnitude, between two entries of the same object
+const double FuzzyCoordinate = 0.0016;
+const double FuzzyMagnitude  = 0.1;
+
+/// Rows written in each transaction of AddCatalogContents()
+const int ImportBatchSize = 10000;
+
+/** @return false for entries with null, broken or unparsed coordinates, which must not be written */
+bool hasValidCoordinates(const CatalogEntryData &entry)
+{
+    return !(entry.ra == KSParser::EBROKEN_DOUBLE || entry.ra == 0.0 || std::isnan(entry.ra) ||
+             entry.dec == KSParser::EBROKEN_DOUBLE || entry.dec == 0.0 || std::isnan(entry.dec));
+}
+
+/**
+ * @class FuzzyMatcher
+ * The rows of the DSO table on a grid of cells as wide as the match tolerance, so that an entry
+ * is only compared with the rows of the 3 x 3 cells around it. Matches the same rows as
+ * CatalogDB::FindFuzzyEntry() without querying the database.
+ */
+class FuzzyMatcher
+{
+  public:
+    void add(int uid, double ra, double dec, double magnitude)
+    {
+        Row const row = { uid, ra, dec, magnitude };
+        m_Cells[key(cell(ra), cell(dec))].append(row);
+    }
+
+    /** @return the lowest UID of the rows matching the entry, -1 if none */
+    int find(double ra, double dec, double magnitude) const
+    {
+        int uid        = -1;
+        qint32 const x = cell(ra), y = cell(dec);
+
+        for (qint32 i = x - 1; i <= x + 1; i++)
+        {
+            for (qint32 j = y - 1; j <= y + 1; j++)
+            {
+                auto it = m_Cells.constFind(key(i, j));
+                if (it == m_Cells.constEnd())
+                    continue;
+
+                for (const Row &row : *it)
+                {
+                    if (std::abs(row.ra - ra) <= FuzzyCoordinate && std::abs(row.dec - dec) <= FuzzyCoordinate &&
+                        std::abs(row.magnitude - magnitude) <= FuzzyMagnitude && (uid < 0 || row.uid < uid))
+                        uid = row.uid;
+                }
+            }
+        }
+
+        return uid;
+    }
+
+  private:
+    struct Row
+    {
+        int uid;
+        double ra;
+        double dec;
+        double magnitude;
+    };
+
+    static qint32 cell(double degrees) { return static_cast<qint32>(std::floor(degrees / FuzzyCoordinate)); }
+    static quint64 key(qint32 x, qint32 y)
+    {
+        return (static_cast<quint64>(static_cast<quint32>(x)) << 32) | static_cast<quint32>(y);
+    }
+
+    QHash<quint64, QVector<Row>> m_Cells;
+};
+}
+
 bool CatalogDB::Initialize()
 {
     skydb_         = QSqlDatabase::addDatabase("QSQLITE", "skydb");
@@ -47,6 +129,8 @@ bool CatalogDB::Initialize()
         first_run = true;
     }
     skydb_.setDatabaseName(dbfile);
+    skydbFile_   = dbfile;
+    skydbThread_ = QThread::currentThread();
     if (!skydb_.open())
     {
         qCWarning(KSTARS_CATALOG) << "Unable to open DSO database file!";
@@ -59,6 +143,11 @@ bool CatalogDB::Initialize()
         {
             FirstRun();
         }
+
+        // FindFuzzyEntry() looks objects up by position, also in databases created by older versions
+        QSqlQuery index_query(skydb_);
+        if (!index_query.exec("CREATE INDEX IF NOT EXISTS DSO_RA_Dec ON DSO (RA, Dec)"))
+            qCWarning(KSTARS_CATALOG) << index_query.lastError();
     }
     skydb_.close();
     return true;
@@ -162,8 +251,13 @@ void CatalogDB::RefreshCatalogList()
 
 int CatalogDB::FindCatalog(const QString &catalog_name)
 {
-    skydb_.open();
-    QSqlTableModel catalog(nullptr, skydb_);
+    return FindCatalog(skydb_, catalog_name);
+}
+
+int CatalogDB::FindCatalog(QSqlDatabase &db, const QString &catalog_name)
+{
+    db.open();
+    QSqlTableModel catalog(nullptr, db);
 
     catalog.setTable("Catalog");
     catalog.setFilter("Name LIKE \'" + catalog_name + "\'");
@@ -177,7 +271,7 @@ int CatalogDB::FindCatalog(const QString &catalog_name)
         returnval = record.value("id").toInt();
 
     catalog.clear();
-    skydb_.close();
+    db.close();
 
     return returnval;
 }
@@ -261,28 +355,25 @@ int CatalogDB::FindFuzzyEntry(const double ra, const double dec, const double ma
      * This Fuzz has not been established after due discussion
     */
     //skydb_.open();
-    QSqlTableModel dsoentries(nullptr, skydb_);
-
-    QString filter = "((RA - " + QString().setNum(ra) +
-                     ") between -0.0016 and 0.0016) and "
-                     "((Dec - " +
-                     QString().setNum(dec) +
-                     ") between -0.0016 and 0.0016) and"
-                     "((Magnitude - " +
-                     QString().setNum(magnitude) + ") between -0.1 and 0.1)";
-    //   qDebug() << filter;
-    dsoentries.setTable("DSO");
-    dsoentries.setFilter(filter);
-    dsoentries.select();
-
-    int entry_count   = dsoentries.rowCount();
-    QSqlRecord record = dsoentries.record(0);
+    QSqlQuery find_query(skydb_);
+
+    // The ranges on RA and Dec use the DSO_RA_Dec index
+    find_query.prepare("SELECT UID FROM DSO WHERE RA BETWEEN :ra_min AND :ra_max AND "
+                       "Dec BETWEEN :dec_min AND :dec_max AND "
+                       "Magnitude BETWEEN :mag_min AND :mag_max ORDER BY UID LIMIT 1");
+    find_query.bindValue(":ra_min", ra - FuzzyCoordinate);
+    find_query.bindValue(":ra_max", ra + FuzzyCoordinate);
+    find_query.bindValue(":dec_min", dec - FuzzyCoordinate);
+    find_query.bindValue(":dec_max", dec + FuzzyCoordinate);
+    find_query.bindValue(":mag_min", magnitude - FuzzyMagnitude);
+    find_query.bindValue(":mag_max", magnitude + FuzzyMagnitude);
 
     int returnval = -1;
-    if (entry_count > 0)
-        returnval = record.value("UID").toInt();
+    if (!find_query.exec())
+        qCWarning(KSTARS_CATALOG) << find_query.lastError();
+    else if (find_query.next())
+        returnval = find_query.value(0).toInt();
 
-    dsoentries.clear();
     //skydb_.close();
     //   qDebug() << returnval;
     return returnval;
@@ -310,8 +401,7 @@ bool CatalogDB::_AddEntry(const CatalogEntryData &catalog_entry, int catid)
         qCWarning(KSTARS_CATALOG) << "Catalog ID " << catid << " is invalid! Cannot add object.";
         return false;
     }
-    if (catalog_entry.ra == KSParser::EBROKEN_DOUBLE || catalog_entry.ra == 0.0 || std::isnan(catalog_entry.ra) ||
-        catalog_entry.dec == KSParser::EBROKEN_DOUBLE || catalog_entry.dec == 0.0 || std::isnan(catalog_entry.dec))
+    if (!hasValidCoordinates(catalog_entry))
     {
         qCWarning(KSTARS_CATALOG) << "Attempt to add incorrect ra & dec with ID:" << catalog_entry.ID
                  << " Long Name: " << catalog_entry.long_name;
@@ -539,37 +629,146 @@ bool CatalogDB::AddCatalogContents(const QString &fname)
         KSParser catalog_text_parser(filename, '#', sequence, delimiter);
 
         int catid = FindCatalog(catalog_name);
+        if (catid < 0)
+        {
+            qCWarning(KSTARS_CATALOG) << "Catalog" << catalog_name << "was not added to the database.";
+            return false;
+        }
 
-        skydb_.open();
-        skydb_.transaction();
+        if (!skydb_.open())
+        {
+            qCWarning(KSTARS_CATALOG) << "Failed to open database to add catalog contents!";
+            qCWarning(KSTARS_CATALOG) << LastError();
+            return false;
+        }
+
+        QElapsedTimer timer;
+        timer.start();
 
-        QHash<QString, QVariant> row_content;
-        while (catalog_text_parser.HasNextRow())
+        // Objects already in the database are matched in memory rather than with a query per row
+        FuzzyMatcher matcher;
+        QSqlQuery dso_query(skydb_);
+        dso_query.setForwardOnly(true);
+        if (!dso_query.exec("SELECT UID, RA, Dec, Magnitude FROM DSO"))
+            qCWarning(KSTARS_CATALOG) << dso_query.lastError();
+        while (dso_query.next())
         {
-            row_content = catalog_text_parser.ReadNextRow();
+            // A null magnitude never matches
+            if (!dso_query.value(3).isNull())
+                matcher.add(dso_query.value(0).toInt(), dso_query.value(1).toDouble(), dso_query.value(2).toDouble(),
+                            dso_query.value(3).toDouble());
+        }
+        dso_query.finish();
+
+        QSqlQuery add_dso(skydb_);
+        add_dso.prepare("INSERT INTO DSO (RA, Dec, Type, Magnitude, PositionAngle,"
+                        " MajorAxis, MinorAxis, Flux) VALUES (?, ?, ?, ?, ?, ?, ?, ?)");
 
+        QSqlQuery add_od(skydb_);
+        add_od.prepare("INSERT INTO ObjectDesignation (id_Catalog, UID_DSO, LongName"
+                       ", IDNumber) VALUES (?, ?, ?, ?)");
+
+        skydb_.transaction();
+
+        int rows = 0, matched = 0, rejected = 0;
+        int const raColumn    = catalog_text_parser.ColumnIndex("RA");
+        int const decColumn   = catalog_text_parser.ColumnIndex("Dc");
+        int const idColumn    = catalog_text_parser.ColumnIndex("ID");
+        int const nameColumn  = catalog_text_parser.ColumnIndex("Nm");
+        int const typeColumn  = catalog_text_parser.ColumnIndex("Tp");
+        int const magColumn   = catalog_text_parser.ColumnIndex("Mg");
+        int const paColumn    = catalog_text_parser.ColumnIndex("PA");
+        int const majorColumn = catalog_text_parser.ColumnIndex("Mj");
+        int const minorColumn = catalog_text_parser.ColumnIndex("Mn");
+        int const fluxColumn  = catalog_text_parser.ColumnIndex("Flux");
+
+        while (catalog_text_parser.NextRow())
+        {
             CatalogEntryData catalog_entry;
 
-            dms read_ra(row_content["RA"].toString(), false);
-            dms read_dec(row_content["Dc"].toString(), true);
-            //qDebug()<<row_content["Nm"].toString();
+            dms read_ra(catalog_text_parser.FieldString(raColumn), false);
+            dms read_dec(catalog_text_parser.FieldString(decColumn), true);
             catalog_entry.catalog_name   = catalog_name;
-            catalog_entry.ID             = row_content["ID"].toInt();
-            catalog_entry.long_name      = row_content["Nm"].toString();
+            catalog_entry.ID             = catalog_text_parser.FieldInt(idColumn);
+            catalog_entry.long_name      = catalog_text_parser.FieldString(nameColumn);
             catalog_entry.ra             = read_ra.Degrees();
             catalog_entry.dec            = read_dec.Degrees();
-            catalog_entry.type           = row_content["Tp"].toInt();
-            catalog_entry.magnitude      = row_content["Mg"].toFloat();
-            catalog_entry.position_angle = row_content["PA"].toFloat();
-            catalog_entry.major_axis     = row_content["Mj"].toFloat();
-            catalog_entry.minor_axis     = row_content["Mn"].toFloat();
-            catalog_entry.flux           = row_content["Flux"].toFloat();
-
-            _AddEntry(catalog_entry, catid);
+            catalog_entry.type           = catalog_text_parser.FieldInt(typeColumn);
+            catalog_entry.magnitude      = catalog_text_parser.FieldFloat(magColumn);
+            catalog_entry.position_angle = catalog_text_parser.FieldFloat(paColumn);
+            catalog_entry.major_axis     = catalog_text_parser.FieldFloat(majorColumn);
+            catalog_entry.minor_axis     = catalog_text_parser.FieldFloat(minorColumn);
+            catalog_entry.flux           = catalog_text_parser.FieldFloat(fluxColumn);
+
+            if (!hasValidCoordinates(catalog_entry))
+            {
+                qCWarning(KSTARS_CATALOG) << "Attempt to add incorrect ra & dec with ID:" << catalog_entry.ID
+                         << " Long Name: " << catalog_entry.long_name;
+                rejected++;
+                continue;
+            }
+
+            // The IDs of the catalog files are never negative, unlike those of _AddEntry()
+            if (catalog_entry.ID < 0)
+            {
+                _AddEntry(catalog_entry, catid);
+                rows++;
+                continue;
+            }
+
+            int rowuid = matcher.find(catalog_entry.ra, catalog_entry.dec, catalog_entry.magnitude);
+            if (rowuid == -1)
+            {
+                add_dso.addBindValue(catalog_entry.ra);
+                add_dso.addBindValue(catalog_entry.dec);
+                add_dso.addBindValue(catalog_entry.type);
+                add_dso.addBindValue(catalog_entry.magnitude);
+                add_dso.addBindValue(catalog_entry.position_angle);
+                add_dso.addBindValue(catalog_entry.major_axis);
+                add_dso.addBindValue(catalog_entry.minor_axis);
+                add_dso.addBindValue(catalog_entry.flux);
+                if (!add_dso.exec())
+                {
+                    qCWarning(KSTARS_CATALOG) << "Custom Catalog Insert Query FAILED!";
+                    qCWarning(KSTARS_CATALOG) << add_dso.lastError();
+                }
+
+                rowuid = add_dso.lastInsertId().toInt();
+
+                // Later rows of the catalog match this one, as they did when it was queried
+                if (!std::isnan(catalog_entry.magnitude))
+                    matcher.add(rowuid, catalog_entry.ra, catalog_entry.dec, catalog_entry.magnitude);
+            }
+            else
+                matched++;
+
+            add_od.addBindValue(catid);
+            add_od.addBindValue(rowuid);
+            add_od.addBindValue(catalog_entry.long_name);
+            add_od.addBindValue(catalog_entry.ID);
+            if (!add_od.exec())
+            {
+                qCWarning(KSTARS_CATALOG) << "Query exec failed:";
+                qCWarning(KSTARS_CATALOG) << add_od.lastError();
+            }
+
+            // Batches keep the journal small without paying for a commit per row
+            if (++rows % ImportBatchSize == 0)
+            {
+                skydb_.commit();
+                skydb_.transaction();
+            }
         }
 
+        add_dso.finish();
+        add_od.finish();
         skydb_.commit();
         skydb_.close();
+
+        double const seconds = timer.elapsed() / 1000.0;
+        qCInfo(KSTARS_CATALOG) << "Imported" << rows << "rows of" << catalog_name << "in" << seconds << "s,"
+                               << (seconds > 0 ? rows / seconds : rows) << "rows/s," << matched
+                               << "matched existing objects," << rejected << "rejected";
     }
     return true;
 }
@@ -865,10 +1064,38 @@ bool CatalogDB::ParseCatalogInfoToDB(const QStringList &lines, QStringList &colu
     }
 }
 
+QSqlDatabase CatalogDB::threadDatabase()
+{
+    if (QThread::currentThread() == skydbThread_)
+        return skydb_;
+
+    QString const connection = QString("skydb_%1").arg(reinterpret_cast<quintptr>(QThread::currentThread()));
+    QSqlDatabase db          = QSqlDatabase::addDatabase("QSQLITE", connection);
+    db.setDatabaseName(skydbFile_);
+    return db;
+}
+
+void CatalogDB::releaseDatabase(QSqlDatabase &db)
+{
+    if (QThread::currentThread() == skydbThread_)
+        return;
+
+    QString const connection = db.connectionName();
+    db                       = QSqlDatabase();
+    QSqlDatabase::removeDatabase(connection);
+}
+
 void CatalogDB::GetCatalogData(const QString &catalog_name, CatalogData &load_catalog)
 {
-    skydb_.open();
-    QSqlTableModel catalog(nullptr, skydb_);
+    QSqlDatabase db = threadDatabase();
+    GetCatalogData(db, catalog_name, load_catalog);
+    releaseDatabase(db);
+}
+
+void CatalogDB::GetCatalogData(QSqlDatabase &db, const QString &catalog_name, CatalogData &load_catalog)
+{
+    db.open();
+    QSqlTableModel catalog(nullptr, db);
     catalog.setTable("Catalog");
     catalog.setFilter("Name LIKE \'" + catalog_name + "\'");
     catalog.select();
@@ -881,19 +1108,28 @@ void CatalogDB::GetCatalogData(const QString &catalog_name, CatalogData &load_ca
     load_catalog.epoch    = record.value("Epoch").toFloat();
 
     catalog.clear();
-    skydb_.close();
+    db.close();
 }
 
 void CatalogDB::GetAllObjects(const QString &catalog, QList<SkyObject *> &sky_list,
                               QList<QPair<int, QString>> &object_names, CatalogComponent *catalog_ptr,
                               bool includeCatalogDesignation)
+{
+    QSqlDatabase db = threadDatabase();
+    GetAllObjects(db, catalog, sky_list, object_names, catalog_ptr, includeCatalogDesignation);
+    releaseDatabase(db);
+}
+
+void CatalogDB::GetAllObjects(QSqlDatabase &db, const QString &catalog, QList<SkyObject *> &sky_list,
+                              QList<QPair<int, QString>> &object_names, CatalogComponent *catalog_ptr,
+                              bool includeCatalogDesignation)
 {
     qDeleteAll(sky_list);
     sky_list.clear();
-    QString selected_catalog = QString::number(FindCatalog(catalog));
+    QString selected_catalog = QString::number(FindCatalog(db, catalog));
 
-    skydb_.open();
-    QSqlQuery get_query(skydb_);
+    db.open();
+    QSqlQuery get_query(db);
     get_query.prepare("SELECT Epoch, Type, RA, Dec, Magnitude, Prefix, "
                       "IDNumber, LongName, MajorAxis, MinorAxis, "
                       "PositionAngle, Flux FROM ObjectDesignation JOIN DSO "
@@ -998,7 +1234,7 @@ void CatalogDB::GetAllObjects(const QString &catalog, QList<SkyObject *> &sky_li
     }
 
     get_query.clear();
-    skydb_.close();
+    db.close();
 }
 
 QList<QPair<QString, KSParser::DataTypes>> CatalogDB::buildParserSequence(const QStringList &Columns)
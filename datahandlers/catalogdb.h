@@ -27,6 +27,8 @@
 #include <QSqlDatabase>
 #include <QSqlError>
 
+class QThread;
+
 class SkyObject;
 class CatalogComponent;
 class CatalogData;
@@ -89,6 +91,11 @@ class CatalogDB
     /**
      * @short Add contents of custom catalog to the program database
      *
+     * The rows are streamed from the file and written with prepared statements in
+     * batched transactions. They are matched with the objects already in the database
+     * in memory, with the tolerance of FindFuzzyEntry(), so that large catalogs import
+     * in linear time. The import rate is logged.
+     *
      * @p filename the name of the file containing the data to be read
      * @return true if catalog was successfully added
      */
@@ -127,6 +134,8 @@ class CatalogDB
      * long name. When this is the case, this flag is set to false, and the catalog designation
      * (cat_prefix + cat_id) will not be included in the object_names returned.
      *
+     * @note This may be called on any thread, e.g. to load the catalogs in the background.
+     *
      * @return void
      **/
     void GetAllObjects(const QString &catalog_name, QList<SkyObject *> &sky_list,
@@ -138,6 +147,7 @@ class CatalogDB
      *
      * @param catalog_name Name of catalog whose details are required
      * @param catalog_data Data structure assigned with required data
+     * @note This may be called on any thread, e.g. to load the catalogs in the background.
      * @return void
      **/
     void GetCatalogData(const QString &catalog_name, CatalogData &catalog_data);
@@ -205,11 +215,38 @@ class CatalogDB
      **/
     bool _AddEntry(const CatalogEntryData &catalog_entry, int catid);
 
+    /** @short GetAllObjects() through the given connection */
+    void GetAllObjects(QSqlDatabase &db, const QString &catalog_name, QList<SkyObject *> &sky_list,
+                       QList<QPair<int, QString>> &object_names, CatalogComponent *catalog_pointer,
+                       bool includeCatalogDesignation);
+
+    /** @short GetCatalogData() through the given connection */
+    void GetCatalogData(QSqlDatabase &db, const QString &catalog_name, CatalogData &catalog_data);
+
+    /** @short FindCatalog() through the given connection */
+    int FindCatalog(QSqlDatabase &db, const QString &catalog_name);
+
+    /**
+     * @brief Connection to the database for the calling thread
+     *
+     * A connection may only be used on the thread which created it, so threads other than the
+     * one which called Initialize() get a connection of their own, removed by releaseDatabase().
+     * @return skydb_ on the thread which called Initialize()
+     **/
+    QSqlDatabase threadDatabase();
+
+    /** @brief Remove a connection returned by threadDatabase(), once its queries are destroyed */
+    void releaseDatabase(QSqlDatabase &db);
+
     /**
      * @brief Database object for the sky object. Assigned and Initialized by Initialize()
      **/
     QSqlDatabase skydb_;
 
+    /** @brief File of the database and thread owning skydb_, assigned by Initialize() */
+    QString skydbFile_;
+    QThread *skydbThread_ { nullptr };
+
     /**
      * @brief Returns the last error the database encountered
      *
@@ -19,12 +19,145 @@
 
 #include <QDebug>
 
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <cstring>
+
 const int KSParser::EBROKEN_INT         = 0;
 const double KSParser::EBROKEN_DOUBLE   = 0.0;
 const float KSParser::EBROKEN_FLOAT     = 0.0;
 const QString KSParser::EBROKEN_QSTRING = "Null";
 const bool KSParser::parser_debug_mode_ = false;
 
+namespace
+{
+inline bool isSpace(char c)
+{
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+void trim(const char *&begin, const char *&end)
+{
+    while (begin < end && isSpace(*begin))
+        ++begin;
+    while (end > begin && isSpace(end[-1]))
+        --end;
+}
+
+/** @return the position n UTF-8 characters after begin, nullptr if the line is shorter */
+const char *advanceCharacters(const char *begin, const char *end, int n)
+{
+    for (; n > 0; --n)
+    {
+        if (begin >= end)
+            return nullptr;
+        ++begin;
+        while (begin < end && (static_cast<unsigned char>(*begin) & 0xC0) == 0x80)
+            ++begin;
+    }
+    return begin;
+}
+
+bool parseInt(const char *begin, const char *end, int &value)
+{
+    trim(begin, end);
+
+    bool negative = false;
+    if (begin < end && (*begin == '-' || *begin == '+'))
+        negative = (*begin++ == '-');
+    if (begin == end)
+        return false;
+
+    qint64 result = 0;
+    for (; begin < end; ++begin)
+    {
+        if (*begin < '0' || *begin > '9')
+            return false;
+        result = result * 10 + (*begin - '0');
+        if (result > qint64(INT_MAX) + 1)
+            return false;
+    }
+    if (negative)
+        result = -result;
+    if (result > INT_MAX)
+        return false;
+
+    value = static_cast<int>(result);
+    return true;
+}
+
+/**
+ * Plain decimal numbers whose mantissa and power of ten are exact doubles are converted
+ * exactly with one multiplication or division. Anything else goes through QString.
+ */
+bool parseDouble(const char *begin, const char *end, double &value)
+{
+    static const double powersOfTen[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                          1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                          1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+                                        };
+
+    trim(begin, end);
+
+    const char *p  = begin;
+    bool negative  = false;
+    quint64 mantissa = 0;
+    int significant  = 0, exponent = 0;
+    bool digits      = false;
+
+    if (p < end && (*p == '-' || *p == '+'))
+        negative = (*p++ == '-');
+    for (; p < end && *p >= '0' && *p <= '9'; ++p)
+    {
+        digits   = true;
+        mantissa = mantissa * 10 + (*p - '0');
+        if (mantissa != 0)
+            ++significant;
+    }
+    if (p < end && *p == '.')
+    {
+        for (++p; p < end && *p >= '0' && *p <= '9'; ++p)
+        {
+            digits   = true;
+            mantissa = mantissa * 10 + (*p - '0');
+            if (mantissa != 0)
+                ++significant;
+            --exponent;
+        }
+    }
+    if (digits && p < end && (*p == 'e' || *p == 'E'))
+    {
+        const char *q = p + 1;
+        bool negativeExponent = false;
+        if (q < end && (*q == '-' || *q == '+'))
+            negativeExponent = (*q++ == '-');
+        int e = 0;
+        const char *first = q;
+        for (; q < end && *q >= '0' && *q <= '9' && e < 10000; ++q)
+            e = e * 10 + (*q - '0');
+        if (q > first)
+        {
+            exponent += negativeExponent ? -e : e;
+            p = q;
+        }
+    }
+
+    if (digits && p == end && significant <= 19 && mantissa <= (quint64(1) << 53) && exponent >= -22 &&
+        exponent <= 22)
+    {
+        double result = static_cast<double>(mantissa);
+        result = (exponent < 0) ? result / powersOfTen[-exponent] : result * powersOfTen[exponent];
+        value  = negative ? -result : result;
+        return true;
+    }
+
+    bool ok = false;
+    value   = QString::fromUtf8(begin, end - begin).toDouble(&ok);
+    return ok;
+}
+}
+
 KSParser::KSParser(const QString &filename, const char comment_char, const QList<QPair<QString, DataTypes>> &sequence,
                    const char delimiter)
     : filename_(filename), comment_char_(comment_char), name_type_sequence_(sequence), delimiter_(delimiter)
@@ -252,6 +385,208 @@ void KSParser::ShowProgress()
     file_reader_.showProgress();
 }
 
+bool KSParser::OpenInput()
+{
+    input_opened_ = true;
+
+    input_file_.setFileName(filename_);
+    if (!input_file_.open(QIODevice::ReadOnly))
+    {
+        qWarning() << "Unable to open file: " << filename_;
+        return false;
+    }
+
+    if (input_file_.size() > 0)
+    {
+        const uchar *data = input_file_.map(0, input_file_.size());
+        if (data != nullptr)
+        {
+            cursor_    = reinterpret_cast<const char *>(data);
+            input_end_ = cursor_ + input_file_.size();
+        }
+        else
+        {
+            input_buffer_ = input_file_.readAll();
+            cursor_       = input_buffer_.constData();
+            input_end_    = cursor_ + input_buffer_.size();
+        }
+    }
+
+    // UTF-8 byte order mark
+    if (input_end_ - cursor_ >= 3 && memcmp(cursor_, "\xEF\xBB\xBF", 3) == 0)
+        cursor_ += 3;
+
+    return true;
+}
+
+bool KSParser::NextRow()
+{
+    if (readFunctionPtr == &KSParser::DummyRow)
+        return false;
+
+    bool const fixed_width = (readFunctionPtr == &KSParser::ReadFixedWidthRow);
+    if (fixed_width && name_type_sequence_.length() != (width_sequence_.length() + 1))
+    {
+        qWarning() << "Unequal fields and widths!";
+        Q_ASSERT(false);
+        return false;
+    }
+
+    if (!input_opened_ && !OpenInput())
+        return false;
+
+    while (cursor_ < input_end_)
+    {
+        const char *line = cursor_;
+        const char *end  = static_cast<const char *>(memchr(line, '\n', input_end_ - line));
+        if (end == nullptr)
+            end = input_end_;
+        cursor_ = (end < input_end_) ? end + 1 : input_end_;
+        line_number_++;
+
+        if (end > line && end[-1] == '\r')
+            --end;
+        if (line < end && *line == comment_char_)
+            continue;
+
+        if (fixed_width ? SplitFixedWidthLine(line, end) : SplitCSVLine(line, end))
+        {
+            file_reader_.setLineNumber(line_number_);
+            return true;
+        }
+    }
+
+    fields_.clear();
+    return false;
+}
+
+bool KSParser::SplitCSVLine(const char *begin, const char *end)
+{
+    fields_.clear();
+
+    // Lines without delimiter are skipped
+    if (memchr(begin, delimiter_, end - begin) == nullptr)
+        return false;
+
+    // Same quoting as CombineQuoteParts(): a word starting with a quote runs to the next word
+    // ending with one, and loses both quotes
+    const char *word = begin;
+    while (true)
+    {
+        const char *word_end = static_cast<const char *>(memchr(word, delimiter_, end - word));
+        if (word_end == nullptr)
+            word_end = end;
+
+        const char *field_begin = word;
+        const char *field_end   = word_end;
+        if (word < word_end && *word == '"')
+        {
+            field_begin = word + 1;
+            const char *last_word = field_begin;
+            while (word_end > last_word && word_end[-1] != '"' && word_end < end)
+            {
+                last_word = word_end + 1;
+                word_end  = static_cast<const char *>(memchr(last_word, delimiter_, end - last_word));
+                if (word_end == nullptr)
+                    word_end = end;
+            }
+            field_end = (word_end > last_word) ? word_end - 1 : word_end;
+        }
+
+        fields_.push_back({ field_begin, static_cast<int>(field_end - field_begin) });
+
+        if (word_end == end)
+            break;
+        word = word_end + 1;
+    }
+
+    return fields_.size() == static_cast<size_t>(name_type_sequence_.length());
+}
+
+bool KSParser::SplitFixedWidthLine(const char *begin, const char *end)
+{
+    fields_.clear();
+
+    for (int width : width_sequence_)
+    {
+        const char *field_end = advanceCharacters(begin, end, width);
+        // Too short
+        if (field_end == nullptr)
+            return false;
+
+        const char *field_begin = begin;
+        begin = field_end;
+        trim(field_begin, field_end);
+        fields_.push_back({ field_begin, static_cast<int>(field_end - field_begin) });
+    }
+
+    trim(begin, end);
+    fields_.push_back({ begin, static_cast<int>(end - begin) });
+    return true;
+}
+
+int KSParser::ColumnIndex(const QString &name) const
+{
+    for (int i = 0; i < name_type_sequence_.length(); ++i)
+    {
+        if (name_type_sequence_[i].first == name)
+            return i;
+    }
+    return -1;
+}
+
+QString KSParser::FieldString(int column) const
+{
+    if (column < 0 || static_cast<size_t>(column) >= fields_.size())
+        return QString();
+    return QString::fromUtf8(fields_[column].data, fields_[column].size);
+}
+
+QLatin1String KSParser::FieldLatin1(int column) const
+{
+    if (column < 0 || static_cast<size_t>(column) >= fields_.size())
+        return QLatin1String();
+    return QLatin1String(fields_[column].data, fields_[column].size);
+}
+
+bool KSParser::FieldIsEmpty(int column) const
+{
+    return column < 0 || static_cast<size_t>(column) >= fields_.size() || fields_[column].size == 0;
+}
+
+int KSParser::FieldInt(int column, bool *ok) const
+{
+    int value = EBROKEN_INT;
+    bool const success = column >= 0 && static_cast<size_t>(column) < fields_.size() &&
+                         parseInt(fields_[column].data, fields_[column].data + fields_[column].size, value);
+    if (ok != nullptr)
+        *ok = success;
+    return success ? value : EBROKEN_INT;
+}
+
+double KSParser::FieldDouble(int column, bool *ok) const
+{
+    double value = EBROKEN_DOUBLE;
+    bool const success = column >= 0 && static_cast<size_t>(column) < fields_.size() &&
+                         parseDouble(fields_[column].data, fields_[column].data + fields_[column].size, value);
+    if (ok != nullptr)
+        *ok = success;
+    return success ? value : EBROKEN_DOUBLE;
+}
+
+float KSParser::FieldFloat(int column, bool *ok) const
+{
+    bool success = false;
+    double const value = FieldDouble(column, &success);
+
+    // QString::toFloat() fails on finite numbers out of the float range
+    if (success && std::fabs(value) > FLT_MAX && !std::isinf(value))
+        success = false;
+    if (ok != nullptr)
+        *ok = success;
+    return success ? static_cast<float>(value) : EBROKEN_FLOAT;
+}
+
 QList<QString> KSParser::CombineQuoteParts(QList<QString> &separated)
 {
     QString iter_string;
@@ -17,12 +17,16 @@
 
 #pragma once
 
+#include <QFile>
 #include <QHash>
+#include <QLatin1String>
 #include <QList>
 #include <QVariant>
 
 #include "ksfilereader.h"
 
+#include <vector>
+
 /**
  * @brief Generic class for text file parsers used in KStars.
  * Read rows using ReadCSVRow() regardless of the type of parser.
@@ -43,6 +47,16 @@
  * In case of failure, the parser returns a Dummy Row. So if you see the
  * string "Null" in the returned QHash, it signifies the parserencountered an
  * unexpected error.
+ *
+ * Large files are better read with the typed interface, which reads the file
+ * memory mapped and keeps the fields of the current row as spans of it, so
+ * that no memory is allocated per row:
+ * 1) initialize KSParser and look up the columns with ColumnIndex()
+ * 2) while (KSParserObject.NextRow()) {
+ *      double ra = KSParserObject.FieldDouble(ra_column);
+ *      ...
+ *    }
+ * Do not mix ReadNextRow() and NextRow() on the same parser.
  **/
 class KSParser
 {
@@ -138,6 +152,43 @@ class KSParser
     // Too many warnings when const: datahandlers/ksparser.h:131:27: warning:
     // type qualifiers ignored on function return type [-Wignored-qualifiers]
 
+    /**
+     * @brief Read the next valid row into the row buffer of the typed accessors
+     * Comment lines and incomplete rows are skipped like ReadNextRow() does.
+     *
+     * @return false when there are no more rows
+     **/
+    bool NextRow();
+
+    /**
+     * @brief Index of a column of the sequence, for the typed accessors
+     *
+     * @param name field name given in the sequence
+     * @return the index of the first column named name, -1 if none
+     **/
+    int ColumnIndex(const QString &name) const;
+
+    /**
+     * @brief Typed accessors to the fields of the row read by NextRow()
+     * Fixed width fields are trimmed, CSV fields are not but numbers are parsed
+     * from their trimmed value. Numbers which cannot be parsed return the EBROKEN
+     * value of their type, and set ok to false.
+     * Columns not in the sequence, with index -1, read as empty fields.
+     **/
+    QString FieldString(int column) const;
+    int FieldInt(int column, bool *ok = nullptr) const;
+    float FieldFloat(int column, bool *ok = nullptr) const;
+    double FieldDouble(int column, bool *ok = nullptr) const;
+
+    /** @return true if the field is empty */
+    bool FieldIsEmpty(int column) const;
+
+    /**
+     * @brief The field without copying, valid until the next call to NextRow()
+     * Only meaningful for ASCII fields such as flags and codes.
+     **/
+    QLatin1String FieldLatin1(int column) const;
+
     /**
      * @brief Wrapper function for KSFileReader setProgress
      *
@@ -208,6 +259,21 @@ class KSParser
      **/
     QVariant ConvertToQVariant(const QString &input_string, const DataTypes &data_type, bool &ok);
 
+    /**
+     * @brief Map the file for the typed interface, or read it whole if it cannot be mapped
+     *
+     * @return false if the file cannot be read
+     **/
+    bool OpenInput();
+
+    /**
+     * @brief Split a line into the field buffer
+     *
+     * @return false if the line is not a complete row
+     **/
+    bool SplitCSVLine(const char *begin, const char *end);
+    bool SplitFixedWidthLine(const char *begin, const char *end);
+
     static const bool parser_debug_mode_;
 
     KSFileReader file_reader_;
@@ -217,4 +283,21 @@ class KSParser
     QList<QPair<QString, DataTypes>> name_type_sequence_;
     QList<int> width_sequence_;
     char delimiter_ { 0 };
+
+    /// A field of the current row, pointing into the input
+    struct Field
+    {
+        const char *data;
+        int size;
+    };
+
+    QFile input_file_;
+    /// Contents of files which cannot be memory mapped
+    QByteArray input_buffer_;
+    bool input_opened_ { false };
+    const char *cursor_ { nullptr };
+    const char *input_end_ { nullptr };
+    unsigned int line_number_ { 0 };
+    /// Reused by every row, so that it keeps its capacity
+    std::vector<Field> fields_;
 };
@@ -40,6 +40,7 @@ BinFileHelper::~BinFileHelper()
 
 void BinFileHelper::init()
 {
+    unmapFile();
     if (fileHandle)
         fclose(fileHandle);
 
@@ -95,6 +96,7 @@ FILE *BinFileHelper::openFile(const QString &fileName)
         errnum = ERR_FILEOPEN;
         return nullptr;
     }
+    filePath = FilePath;
     return fileHandle;
 }
 
@@ -287,10 +289,43 @@ bool BinFileHelper::readHeader()
 
 void BinFileHelper::closeFile()
 {
+    unmapFile();
     fclose(fileHandle);
     fileHandle = nullptr;
 }
 
+bool BinFileHelper::mapFile()
+{
+    if (mappedData)
+        return true;
+    if (!fileHandle || filePath.isEmpty())
+        return false;
+
+    mappedFile.setFileName(filePath);
+    if (!mappedFile.open(QIODevice::ReadOnly))
+        return false;
+
+    mappedSize = mappedFile.size();
+    mappedData = mappedFile.map(0, mappedSize);
+    if (!mappedData)
+    {
+        mappedSize = 0;
+        mappedFile.close();
+        return false;
+    }
+    return true;
+}
+
+void BinFileHelper::unmapFile()
+{
+    if (mappedData)
+        mappedFile.unmap(mappedData);
+    if (mappedFile.isOpen())
+        mappedFile.close();
+    mappedData = nullptr;
+    mappedSize = 0;
+}
+
 int BinFileHelper::getErrorNumber()
 {
     int err = errnum;
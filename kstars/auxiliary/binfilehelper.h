@@ -18,10 +18,12 @@
 
 #pragma once
 
+#include <QFile>
 #include <QString>
 #include <QVector>
 
 #include <cstdio>
+#include <cstring>
 
 class QString;
 
@@ -36,6 +38,44 @@ typedef struct dataElement
     qint32 scale { 0 }; /**< Field scale. The final field value = raw_value * scale */
 } dataElement;
 
+/**
+ * @class BinRecordSpan
+ *
+ * A read-only view over a contiguous run of fixed size records inside a memory-mapped
+ * binary data file. No data is copied when the span is created; records are copied out
+ * one at a time by at(), which also takes care of the (rare) alignment issues of the
+ * on-disk layout. Byte swapping is left to the caller, so that little-endian hosts never
+ * pay for it.
+ *
+ * @short A zero-copy view over records of a memory-mapped binary data file
+ */
+template <typename T>
+class BinRecordSpan
+{
+  public:
+    BinRecordSpan() = default;
+    BinRecordSpan(const uchar *data, quint32 count) : m_Data(data), m_Count(count) {}
+
+    /** @return true if the span has no records */
+    inline bool isEmpty() const { return (m_Count == 0 || !m_Data); }
+
+    /** @return number of records in the span */
+    inline quint32 size() const { return m_Count; }
+
+    /** @return raw pointer to the first byte of the span */
+    inline const uchar *data() const { return m_Data; }
+
+    /**
+     * @short Copy the i-th record out of the span
+     * @note No bounds checking is done
+     */
+    inline void at(quint32 i, T *record) const { memcpy(record, m_Data + i * sizeof(T), sizeof(T)); }
+
+  private:
+    const uchar *m_Data { nullptr };
+    quint32 m_Count { 0 };
+};
+
 /**
  * @class BinFileHelper
  *
@@ -78,9 +118,55 @@ class BinFileHelper
 
     /**
      * @short  Close the binary data file
+     * @note   Also releases the memory mapping, if any
      */
     void closeFile();
 
+    /**
+     * @short  Memory-map the currently open file
+     *
+     * Once mapped, the records of an index entry can be accessed through records() without
+     * any seek or read calls, and from several threads at once since no file position is shared.
+     * The stdio handle stays valid, so the usual fread() based access keeps working.
+     *
+     * @return True if the file could be mapped, false otherwise (eg. no file open, mmap unsupported)
+     */
+    bool mapFile();
+
+    /**
+     * @short  Release the memory mapping created by mapFile()
+     */
+    void unmapFile();
+
+    /**
+     * @return True if the file is currently memory-mapped
+     */
+    inline bool isMapped() const { return mappedData != nullptr; }
+
+    /**
+     * @short  Returns the records under the given index ID as a zero-copy span
+     * @param  id      ID of the index entry
+     * @param  first   Number of records to skip at the start of the index entry
+     * @return A span over the remaining records, or an empty span if the file is not mapped,
+     *         the index has not been read or the entry lies outside the file
+     */
+    template <typename T>
+    BinRecordSpan<T> records(int id, quint32 first = 0) const
+    {
+        if (!mappedData || !indexUpdated || id < 0 || id >= indexOffset.size())
+            return BinRecordSpan<T>();
+
+        quint32 count = indexCount.at(id);
+        if (first >= count)
+            return BinRecordSpan<T>();
+
+        quint64 start = quint64(indexOffset.at(id)) + quint64(first) * sizeof(T);
+        if (start + quint64(count - first) * sizeof(T) > quint64(mappedSize))
+            return BinRecordSpan<T>();
+
+        return BinRecordSpan<T>(mappedData + start, count - first);
+    }
+
     /**
      * @short   Get error number
      * @return  A number corresponding to the error
@@ -241,6 +327,14 @@ class BinFileHelper
 
     /// Handle to the file.
     FILE *fileHandle { nullptr};
+    /// Full path of the currently open file
+    QString filePath;
+    /// File used for the memory mapping
+    QFile mappedFile;
+    /// Start of the memory mapped file contents, nullptr if not mapped
+    uchar *mappedData { nullptr };
+    /// Size of the memory mapping in bytes
+    qint64 mappedSize { 0 };
     /// Stores offsets corresponding to each index table entry
     QVector<unsigned long> indexOffset;
     /// Stores number of records under each index table entry
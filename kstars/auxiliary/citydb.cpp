@@ -0,0 +1,490 @@
+/***************************************************************************
+                         citydb.cpp  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sat 17 Oct 2026
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "citydb.h"
+
+#include "geolocation.h"
+#include "kspaths.h"
+#include "timezonerule.h"
+#include "kstars_debug.h"
+
+#include <QDir>
+#include <QFile>
+#include <QSqlError>
+#include <QSqlQuery>
+
+#include <cmath>
+
+namespace
+{
+// Columns of the installed cities, in the order readCities() reads them
+const char *cityColumns = "city.id, city.Name, city.Province, city.Country, city.Latitude, city.Longitude, city.TZ, "
+                          "city.TZRule, city.Elevation";
+
+/** Add the index range of the keys starting with prefix, keys and prefix being case folded */
+void addPrefixRange(const QString &column, const QString &prefix, QStringList &conditions, QVariantList &values)
+{
+    if (prefix.isEmpty())
+        return;
+
+    conditions << column + " >= ?";
+    values << prefix;
+
+    // The keys starting with prefix sort before prefix with its last character incremented
+    QChar const last = prefix.at(prefix.size() - 1);
+    if (last.unicode() < 0xFFFF)
+    {
+        conditions << column + " < ?";
+        values << QString(prefix).replace(prefix.size() - 1, 1, QChar(last.unicode() + 1));
+    }
+}
+
+bool hasPrefix(const QString &str, const QString &prefix)
+{
+    return prefix.isEmpty() || str.startsWith(prefix, Qt::CaseInsensitive);
+}
+
+/** Unit vector of the location, the chord between two of them grows with their great circle distance */
+void unitVector(const dms &longitude, const dms &latitude, double &x, double &y, double &z)
+{
+    double sinLat, cosLat, sinLng, cosLng;
+    latitude.SinCos(sinLat, cosLat);
+    longitude.SinCos(sinLng, cosLng);
+    x = cosLat * cosLng;
+    y = cosLat * sinLng;
+    z = sinLat;
+}
+}
+
+CityDB::CityDB(QMap<QString, TimeZoneRule> &rulebook) : m_Rulebook(rulebook)
+{
+}
+
+CityDB::~CityDB()
+{
+    qDeleteAll(m_Cities);
+    qDeleteAll(m_UserCities);
+    m_CityDB.close();
+}
+
+bool CityDB::open()
+{
+    m_CityDB       = QSqlDatabase::addDatabase("QSQLITE", "citydb");
+    QString dbfile = KSPaths::locate(QStandardPaths::GenericDataLocation, "citydb.sqlite");
+    m_CityDB.setDatabaseName(dbfile);
+    if (m_CityDB.open() == false)
+    {
+        qCCritical(KSTARS) << "Unable to open city database file " << dbfile << m_CityDB.lastError().text();
+        return false;
+    }
+
+    // get_query.size() always returns -1, so citiesFound is set if at least one city is found
+    QSqlQuery get_query(m_CityDB);
+    if (!get_query.exec("SELECT id FROM city LIMIT 1"))
+    {
+        qCCritical(KSTARS) << get_query.lastError();
+        return false;
+    }
+    bool const citiesFound = get_query.next();
+
+    // Reading local database
+    QSqlDatabase mycitydb = QSqlDatabase::addDatabase("QSQLITE", "mycitydb");
+    dbfile = KSPaths::writableLocation(QStandardPaths::GenericDataLocation) + QDir::separator() + "mycitydb.sqlite";
+
+    if (QFile::exists(dbfile))
+    {
+        mycitydb.setDatabaseName(dbfile);
+        if (mycitydb.open())
+        {
+            QSqlQuery get_query(mycitydb);
+
+            if (!get_query.exec("SELECT * FROM city"))
+            {
+                qDebug() << get_query.lastError();
+                return false;
+            }
+            while (get_query.next())
+            {
+                QString name         = get_query.value(1).toString();
+                QString province     = get_query.value(2).toString();
+                QString country      = get_query.value(3).toString();
+                dms lat              = dms(get_query.value(4).toString());
+                dms lng              = dms(get_query.value(5).toString());
+                double TZ            = get_query.value(6).toDouble();
+                TimeZoneRule *TZrule = &(m_Rulebook[get_query.value(7).toString()]);
+                double elevation     = get_query.value(8).toDouble();
+
+                m_UserCities.append(new GeoLocation(lng, lat, name, province, country, TZ, TZrule, elevation, false, 4));
+            }
+            mycitydb.close();
+        }
+    }
+
+    return citiesFound;
+}
+
+QVector<CityDB::CityName> CityDB::names()
+{
+    QVector<CityName> names;
+
+    if (ensureIndex())
+    {
+        QSqlQuery get_query(m_CityDB);
+        if (get_query.exec("SELECT id, full_name FROM city_index"))
+        {
+            while (get_query.next())
+            {
+                CityName name;
+                name.id       = get_query.value(0).toInt();
+                name.fullName = get_query.value(1).toString();
+                names.append(name);
+            }
+        }
+        else
+            qCWarning(KSTARS) << get_query.lastError();
+    }
+
+    for (GeoLocation *loc : m_UserCities)
+    {
+        CityName name;
+        name.fullName = loc->fullName();
+        name.city     = loc;
+        names.append(name);
+    }
+    return names;
+}
+
+GeoLocation *CityDB::city(const CityName &name)
+{
+    if (name.city != nullptr || name.id < 0)
+        return name.city;
+
+    GeoLocation *city = m_Cities.value(name.id);
+    if (city != nullptr)
+        return city;
+
+    QSqlQuery get_query(m_CityDB);
+    get_query.prepare(QString("SELECT %1 FROM city WHERE city.id = ?").arg(cityColumns));
+    get_query.addBindValue(name.id);
+    if (!get_query.exec())
+    {
+        qCWarning(KSTARS) << get_query.lastError();
+        return nullptr;
+    }
+
+    QList<GeoLocation *> const found = readCities(get_query);
+    return found.isEmpty() ? nullptr : found.first();
+}
+
+QList<double> CityDB::timeZones()
+{
+    QList<double> timeZones;
+
+    QSqlQuery get_query(m_CityDB);
+    if (get_query.exec("SELECT DISTINCT TZ FROM city"))
+    {
+        while (get_query.next())
+            timeZones.append(get_query.value(0).toDouble());
+    }
+    else
+        qCWarning(KSTARS) << get_query.lastError();
+
+    for (GeoLocation *loc : m_UserCities)
+    {
+        if (timeZones.contains(loc->TZ0()) == false)
+            timeZones.append(loc->TZ0());
+    }
+    return timeZones;
+}
+
+GeoLocation *CityDB::find(const QString &city, const QString &province, const QString &country)
+{
+    if (ensureIndex())
+    {
+        // The name is looked up by its key, which is indexed
+        QStringList conditions;
+        QVariantList values;
+        conditions << "city_index.name_key = ?" << "city_index.name = ?";
+        values << city.toCaseFolded() << city;
+        if (province.isEmpty() == false)
+        {
+            conditions << "city_index.province = ?";
+            values << province;
+        }
+        if (country.isEmpty() == false)
+        {
+            conditions << "city_index.country = ?";
+            values << country;
+        }
+
+        QList<GeoLocation *> const found = selectCities(conditions, QString(), values, 1);
+        if (found.isEmpty() == false)
+            return found.first();
+    }
+
+    for (GeoLocation *loc : m_UserCities)
+    {
+        if (loc->translatedName() == city && (province.isEmpty() || loc->translatedProvince() == province) &&
+                (country.isEmpty() || loc->translatedCountry() == country))
+        {
+            return loc;
+        }
+    }
+    return nullptr;
+}
+
+QList<GeoLocation *> CityDB::findByPrefix(const QString &city, const QString &province, const QString &country)
+{
+    QList<GeoLocation *> found;
+
+    if (ensureIndex())
+    {
+        QStringList conditions;
+        QVariantList values;
+        addPrefixRange("city_index.name_key", city.toCaseFolded(), conditions, values);
+        addPrefixRange("city_index.province_key", province.toCaseFolded(), conditions, values);
+        addPrefixRange("city_index.country_key", country.toCaseFolded(), conditions, values);
+        found = selectCities(conditions, QString(), values);
+    }
+
+    for (GeoLocation *loc : m_UserCities)
+    {
+        if (hasPrefix(loc->translatedName(), city) && hasPrefix(loc->translatedProvince(), province) &&
+                hasPrefix(loc->translatedCountry(), country))
+        {
+            found.append(loc);
+        }
+    }
+    return found;
+}
+
+QList<GeoLocation *> CityDB::findNear(double longitude, double latitude, double radius)
+{
+    QList<GeoLocation *> found;
+
+    if (ensureIndex())
+    {
+        // The latitude range is indexed, the longitude one may cross the date line
+        QStringList conditions;
+        QVariantList values;
+        conditions << "city_index.lat BETWEEN ? AND ?"
+                   << "(abs(city_index.lng - ?) <= ? OR abs(city_index.lng - ?) >= ?)";
+        values << latitude - radius << latitude + radius << longitude << radius << longitude << 360.0 - radius;
+        found = selectCities(conditions, QString(), values);
+    }
+
+    for (GeoLocation *loc : m_UserCities)
+    {
+        double const dLng = std::fabs(loc->lng()->Degrees() - longitude);
+        if (std::fabs(loc->lat()->Degrees() - latitude) <= radius && (dLng <= radius || dLng >= 360.0 - radius))
+            found.append(loc);
+    }
+    return found;
+}
+
+GeoLocation *CityDB::nearest(double longitude, double latitude)
+{
+    GeoLocation *nearest = nullptr;
+    double distance      = 1e6;
+
+    double x, y, z;
+    unitVector(dms(longitude), dms(latitude), x, y, z);
+
+    if (ensureIndex())
+    {
+        QVariantList values;
+        values << x << x << y << y << z << z;
+        QList<GeoLocation *> const found = selectCities(
+            QStringList(), "(city_index.x - ?) * (city_index.x - ?) + (city_index.y - ?) * (city_index.y - ?) + "
+            "(city_index.z - ?) * (city_index.z - ?)", values, 1);
+
+        if (found.isEmpty() == false)
+        {
+            nearest = found.first();
+
+            double cx, cy, cz;
+            unitVector(*nearest->lng(), *nearest->lat(), cx, cy, cz);
+            distance = (cx - x) * (cx - x) + (cy - y) * (cy - y) + (cz - z) * (cz - z);
+        }
+    }
+
+    for (GeoLocation *loc : m_UserCities)
+    {
+        double cx, cy, cz;
+        unitVector(*loc->lng(), *loc->lat(), cx, cy, cz);
+        double const newDistance = (cx - x) * (cx - x) + (cy - y) * (cy - y) + (cz - z) * (cz - z);
+        if (newDistance < distance)
+        {
+            distance = newDistance;
+            nearest  = loc;
+        }
+    }
+
+    return nearest;
+}
+
+QVector<QPointF> CityDB::coordinates()
+{
+    QVector<QPointF> coordinates;
+    if (ensureIndex())
+        coordinates = m_Coordinates;
+
+    for (GeoLocation *loc : m_UserCities)
+        coordinates.append(QPointF(loc->lng()->Degrees(), loc->lat()->Degrees()));
+    return coordinates;
+}
+
+void CityDB::addUserCity(GeoLocation *city)
+{
+    m_UserCities.append(city);
+}
+
+void CityDB::removeUserCity(GeoLocation *city)
+{
+    if (m_UserCities.removeOne(city))
+        delete city;
+}
+
+bool CityDB::ensureIndex()
+{
+    if (m_Indexed == false)
+        m_Indexed = buildIndex();
+    return m_Indexed;
+}
+
+bool CityDB::buildIndex()
+{
+    // A temporary table, as the installed database is read only
+    QSqlQuery query(m_CityDB);
+    if (!query.exec("DROP TABLE IF EXISTS temp.city_index") ||
+            !query.exec("CREATE TEMP TABLE city_index (id INTEGER PRIMARY KEY, name TEXT, province TEXT, country TEXT, "
+                        "name_key TEXT, province_key TEXT, country_key TEXT, lat REAL, lng REAL, x REAL, y REAL, z REAL, "
+                        "full_name TEXT)"))
+    {
+        qCWarning(KSTARS) << "Unable to index the cities" << query.lastError();
+        return false;
+    }
+
+    QSqlQuery get_query(m_CityDB);
+    if (!get_query.exec("SELECT id, Name, Province, Country, Latitude, Longitude FROM city"))
+    {
+        qCWarning(KSTARS) << "Unable to index the cities" << get_query.lastError();
+        return false;
+    }
+
+    m_Coordinates.clear();
+    m_CityDB.transaction();
+
+    QSqlQuery insert_query(m_CityDB);
+    insert_query.prepare("INSERT INTO city_index VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+    while (get_query.next())
+    {
+        dms const lat(get_query.value(4).toString());
+        dms const lng(get_query.value(5).toString());
+
+        // Only used for its translated names, which depend on each other
+        GeoLocation const names(lng, lat, get_query.value(1).toString(), get_query.value(2).toString(),
+                                get_query.value(3).toString());
+        QString const name     = names.translatedName();
+        QString const province = names.translatedProvince();
+        QString const country  = names.translatedCountry();
+
+        double x, y, z;
+        unitVector(lng, lat, x, y, z);
+
+        insert_query.addBindValue(get_query.value(0).toInt());
+        insert_query.addBindValue(name);
+        insert_query.addBindValue(province);
+        insert_query.addBindValue(country);
+        insert_query.addBindValue(name.toCaseFolded());
+        insert_query.addBindValue(province.toCaseFolded());
+        insert_query.addBindValue(country.toCaseFolded());
+        insert_query.addBindValue(lat.Degrees());
+        insert_query.addBindValue(lng.Degrees());
+        insert_query.addBindValue(x);
+        insert_query.addBindValue(y);
+        insert_query.addBindValue(z);
+        insert_query.addBindValue(names.fullName());
+        if (!insert_query.exec())
+        {
+            qCWarning(KSTARS) << "Unable to index the cities" << insert_query.lastError();
+            m_CityDB.rollback();
+            m_Coordinates.clear();
+            return false;
+        }
+
+        m_Coordinates.append(QPointF(lng.Degrees(), lat.Degrees()));
+    }
+
+    m_CityDB.commit();
+
+    // Indexed once filled, which is faster
+    if (!query.exec("CREATE INDEX city_index_name ON city_index(name_key)") ||
+            !query.exec("CREATE INDEX city_index_lat ON city_index(lat)"))
+    {
+        qCWarning(KSTARS) << "Unable to index the cities" << query.lastError();
+        m_Coordinates.clear();
+        return false;
+    }
+
+    return true;
+}
+
+QList<GeoLocation *> CityDB::selectCities(const QStringList &conditions, const QString &order,
+                                          const QVariantList &values, int limit)
+{
+    QString sql = QString("SELECT %1 FROM city_index JOIN city ON city.id = city_index.id").arg(cityColumns);
+    if (conditions.isEmpty() == false)
+        sql += " WHERE " + conditions.join(" AND ");
+    sql += " ORDER BY " + (order.isEmpty() ? QString("city.id") : order);
+    if (limit >= 0)
+        sql += QString(" LIMIT %1").arg(limit);
+
+    QSqlQuery get_query(m_CityDB);
+    get_query.prepare(sql);
+    for (const QVariant &value : values)
+        get_query.addBindValue(value);
+
+    if (!get_query.exec())
+    {
+        qCWarning(KSTARS) << get_query.lastError();
+        return QList<GeoLocation *>();
+    }
+    return readCities(get_query);
+}
+
+QList<GeoLocation *> CityDB::readCities(QSqlQuery &query)
+{
+    QList<GeoLocation *> cities;
+    while (query.next())
+    {
+        GeoLocation *&city = m_Cities[query.value(0).toInt()];
+        if (city == nullptr)
+        {
+            QString name         = query.value(1).toString();
+            QString province     = query.value(2).toString();
+            QString country      = query.value(3).toString();
+            dms lat              = dms(query.value(4).toString());
+            dms lng              = dms(query.value(5).toString());
+            double TZ            = query.value(6).toDouble();
+            TimeZoneRule *TZrule = &(m_Rulebook[query.value(7).toString()]);
+            double elevation     = query.value(8).toDouble();
+
+            city = new GeoLocation(lng, lat, name, province, country, TZ, TZrule, elevation, true, 4);
+        }
+        cities.append(city);
+    }
+    return cities;
+}
@@ -0,0 +1,134 @@
+/***************************************************************************
+                          citydb.h  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sat 17 Oct 2026
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QList>
+#include <QMap>
+#include <QPointF>
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <QVector>
+
+class GeoLocation;
+class QSqlQuery;
+class TimeZoneRule;
+
+/**
+ * @class CityDB
+ *
+ * Geographic locations of the installed "citydb.sqlite" database and of the user "mycitydb.sqlite"
+ * database.
+ *
+ * The installed cities are not read at startup, they are looked up in the database instead. The
+ * first lookup builds a temporary index of their translated names, case folded so that a prefix
+ * search is a range of the index, and of their coordinates. A GeoLocation is only created once a
+ * lookup returns its city, and is then kept so that a city is always the same object.
+ *
+ * The few user cities are kept in memory, as the location dialogs edit them.
+ *
+ * @short Lazily loaded and indexed city database
+ */
+class CityDB
+{
+  public:
+    /** Name of a city, to list the cities without creating them */
+    struct CityName
+    {
+        /// Translated full name, as returned by GeoLocation::fullName()
+        QString fullName;
+        /// Id of an installed city, -1 for a user city
+        int id { -1 };
+        /// The user city, nullptr for an installed city
+        GeoLocation *city { nullptr };
+    };
+
+    /** @param rulebook daylight saving time rules of the cities, by name */
+    explicit CityDB(QMap<QString, TimeZoneRule> &rulebook);
+
+    /** Deletes all the cities which were created */
+    ~CityDB();
+
+    /**
+     * @brief open Open the installed database and read the user cities
+     * @return true if at least one installed city is found
+     */
+    bool open();
+
+    /** @return the names of all the cities, read from the index without creating the cities */
+    QVector<CityName> names();
+
+    /** @return the city of a name returned by names(), created if needed */
+    GeoLocation *city(const CityName &name);
+
+    /** @return the distinct time zones of all the cities, without creating them */
+    QList<double> timeZones();
+
+    /**
+     * @brief find Find a city by its translated names
+     * @param province any province if empty
+     * @param country any country if empty
+     * @return the first matching city, nullptr if none
+     */
+    GeoLocation *find(const QString &city, const QString &province = QString(), const QString &country = QString());
+
+    /** @return the cities whose translated names start with the given prefixes, ignoring case */
+    QList<GeoLocation *> findByPrefix(const QString &city, const QString &province, const QString &country);
+
+    /** @return the cities within radius degrees of both the longitude and the latitude */
+    QList<GeoLocation *> findNear(double longitude, double latitude, double radius);
+
+    /** @return the city at the shortest great circle distance, nullptr if none */
+    GeoLocation *nearest(double longitude, double latitude);
+
+    /** @return the longitude and latitude in degrees of all the cities, without creating them */
+    QVector<QPointF> coordinates();
+
+    /** Take the ownership of a city just added to the user database */
+    void addUserCity(GeoLocation *city);
+
+    /** Delete a city just removed from the user database */
+    void removeUserCity(GeoLocation *city);
+
+  private:
+    /** @return true once the index of the installed cities is built */
+    bool ensureIndex();
+
+    bool buildIndex();
+
+    /**
+     * @brief selectCities Select installed cities with the index
+     * @param conditions SQL conditions on the columns of the city_index table
+     * @param order SQL ordering terms, none if empty
+     * @param values values of the ? placeholders of the conditions then of the order
+     * @return the selected cities in id order unless ordered, created if needed
+     */
+    QList<GeoLocation *> selectCities(const QStringList &conditions, const QString &order, const QVariantList &values,
+                                      int limit = -1);
+
+    /** @return the cities of the rows of a query on the installed cities, created if needed */
+    QList<GeoLocation *> readCities(QSqlQuery &query);
+
+    QMap<QString, TimeZoneRule> &m_Rulebook;
+    QSqlDatabase m_CityDB;
+    /// Installed cities which were looked up, by id
+    QMap<int, GeoLocation *> m_Cities;
+    QList<GeoLocation *> m_UserCities;
+    /// Coordinates of the installed cities, read with the index
+    QVector<QPointF> m_Coordinates;
+    bool m_Indexed { false };
+};
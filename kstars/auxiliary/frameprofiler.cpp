@@ -0,0 +1,197 @@
+/***************************************************************************
+                   frameprofiler.cpp  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sat 17 Oct 2026
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "frameprofiler.h"
+
+#include "Options.h"
+
+#include <QJsonArray>
+#include <QMutexLocker>
+
+#include <algorithm>
+
+FrameProfiler *FrameProfiler::pinstance = nullptr;
+
+FrameProfiler::Timer::Timer() : m_Enabled(FrameProfiler::isEnabled())
+{
+    if (m_Enabled)
+        m_Timer.start();
+}
+
+void FrameProfiler::Timer::lap(const char *section)
+{
+    if (!m_Enabled)
+        return;
+
+    FrameProfiler::Instance()->record(QLatin1String(section), m_Timer.nsecsElapsed());
+    m_Timer.restart();
+}
+
+void FrameProfiler::Timer::restart()
+{
+    if (m_Enabled)
+        m_Timer.restart();
+}
+
+FrameProfiler *FrameProfiler::Instance()
+{
+    if (!pinstance)
+        pinstance = new FrameProfiler();
+    return pinstance;
+}
+
+bool FrameProfiler::isEnabled()
+{
+    return Options::frameProfiling();
+}
+
+void FrameProfiler::setEnabled(bool enable)
+{
+    Options::setFrameProfiling(enable);
+}
+
+void FrameProfiler::record(const QString &section, qint64 nsecs)
+{
+    QMutexLocker locker(&m_Mutex);
+
+    Section &s = m_Sections[section];
+    if (s.samples.size() < HistorySize)
+        s.samples.append(nsecs);
+    else
+        s.samples[s.next] = nsecs;
+    s.next = (s.next + 1) % HistorySize;
+    s.total++;
+}
+
+void FrameProfiler::reset()
+{
+    QMutexLocker locker(&m_Mutex);
+    m_Sections.clear();
+}
+
+QStringList FrameProfiler::sections() const
+{
+    QMutexLocker locker(&m_Mutex);
+    return m_Sections.keys();
+}
+
+FrameProfiler::Stats FrameProfiler::stats(const QString &section) const
+{
+    QMutexLocker locker(&m_Mutex);
+
+    auto it = m_Sections.constFind(section);
+    if (it == m_Sections.constEnd())
+        return Stats();
+    return statsOf(it.value());
+}
+
+FrameProfiler::Stats FrameProfiler::statsOf(const Section &section) const
+{
+    Stats result;
+    result.histogram.fill(0, BucketCount);
+
+    QVector<qint64> sorted = section.samples;
+    if (sorted.isEmpty())
+        return result;
+
+    const double nsToMs = 1e-6;
+    std::sort(sorted.begin(), sorted.end());
+
+    qint64 sum = 0;
+    for (qint64 ns : sorted)
+    {
+        sum += ns;
+
+        // Bucket i holds [2^i, 2^(i+1)) * BucketBase us; the last one is open ended
+        int bucket  = 0;
+        qint64 edge = qint64(BucketBase) * 1000;
+        while (ns >= edge && bucket < BucketCount - 1)
+        {
+            edge *= 2;
+            bucket++;
+        }
+        result.histogram[bucket]++;
+    }
+
+    int lastIndex = (section.next + section.samples.size() - 1) % section.samples.size();
+
+    result.count  = sorted.size();
+    result.total  = section.total;
+    result.last   = section.samples[lastIndex] * nsToMs;
+    result.mean   = sum * nsToMs / sorted.size();
+    result.min    = sorted.first() * nsToMs;
+    result.max    = sorted.last() * nsToMs;
+    result.median = sorted[sorted.size() / 2] * nsToMs;
+    result.p95    = sorted[qMin(sorted.size() - 1, int(0.95 * sorted.size()))] * nsToMs;
+
+    return result;
+}
+
+QJsonObject FrameProfiler::toJson() const
+{
+    QMutexLocker locker(&m_Mutex);
+
+    QJsonObject sections;
+    for (auto it = m_Sections.constBegin(); it != m_Sections.constEnd(); ++it)
+    {
+        Stats s = statsOf(it.value());
+
+        QJsonArray histogram;
+        for (int n : s.histogram)
+            histogram.append(n);
+
+        sections.insert(it.key(), QJsonObject{ { "count", s.count },
+                                                { "total", double(s.total) },
+                                                { "last", s.last },
+                                                { "mean", s.mean },
+                                                { "min", s.min },
+                                                { "max", s.max },
+                                                { "median", s.median },
+                                                { "p95", s.p95 },
+                                                { "histogram", histogram } });
+    }
+
+    return QJsonObject{ { "enabled", isEnabled() },
+                        { "unit", "ms" },
+                        { "historySize", HistorySize },
+                        { "histogramBaseUs", BucketBase },
+                        { "sections", sections } };
+}
+
+QStringList FrameProfiler::summary(int maxLines) const
+{
+    QList<QPair<double, QString>> lines;
+
+    {
+        QMutexLocker locker(&m_Mutex);
+        for (auto it = m_Sections.constBegin(); it != m_Sections.constEnd(); ++it)
+        {
+            Stats s = statsOf(it.value());
+            lines.append(qMakePair(s.mean, QString("%1  %2 / %3 / %4 ms")
+                                   .arg(it.key(), -24)
+                                   .arg(s.mean, 6, 'f', 2)
+                                   .arg(s.p95, 6, 'f', 2)
+                                   .arg(s.max, 6, 'f', 2)));
+        }
+    }
+
+    std::sort(lines.begin(), lines.end(),
+              [](const QPair<double, QString> &a, const QPair<double, QString> &b) { return a.first > b.first; });
+
+    QStringList result;
+    for (int i = 0; i < lines.size() && i < maxLines; ++i)
+        result.append(lines[i].second);
+    return result;
+}
@@ -0,0 +1,138 @@
+/***************************************************************************
+                    frameprofiler.h  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sat 17 Oct 2026
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QMap>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/**
+ * @class FrameProfiler
+ *
+ * Runtime instrumentation of the sky map draw and update cycles. Callers time named sections
+ * (e.g. "draw/Stars" for StarComponent::draw() in SkyMapComposite::draw(), or "update/Sky" in
+ * KStarsData::updateTime()) and the profiler keeps the last HistorySize samples of each section,
+ * from which it computes rolling statistics and a log2 histogram of the durations.
+ *
+ * Profiling is switched on and off at runtime with Options::frameProfiling(). While it is off,
+ * timing a section costs a single option check. The collected statistics are shown on the sky
+ * map by SkyMapDrawAbstract::drawOverlays() and can be retrieved as JSON over DBus through
+ * KStars::getFrameProfile().
+ *
+ * @short Rolling timing statistics of the draw and update cycles
+ */
+class FrameProfiler
+{
+  public:
+    /** Number of samples per section used for the rolling statistics */
+    static const int HistorySize = 256;
+
+    /** Number of histogram buckets. Bucket i counts durations in [2^i, 2^(i+1)) * BucketBase */
+    static const int BucketCount = 12;
+
+    /** Upper limit of the first histogram bucket, in microseconds */
+    static const int BucketBase = 64;
+
+    /** Statistics of one section over its last (up to) HistorySize samples, durations in ms */
+    struct Stats
+    {
+        /** Number of samples in the window */
+        int count { 0 };
+        /** Number of samples recorded since the last reset() */
+        quint64 total { 0 };
+        double last { 0 };
+        double mean { 0 };
+        double min { 0 };
+        double max { 0 };
+        double median { 0 };
+        double p95 { 0 };
+        QVector<int> histogram;
+    };
+
+    /**
+     * @short Measures consecutive sections, like a stopwatch with a lap button
+     *
+     * The timer starts on construction. Each call to lap() records the time elapsed since the
+     * previous lap (or since construction) under the given section name and restarts the timer.
+     * Nothing is recorded while profiling is off.
+     */
+    class Timer
+    {
+      public:
+        Timer();
+
+        /** Record the time since the last lap as section, then restart */
+        void lap(const char *section);
+
+        /** Restart without recording anything, e.g. to skip code that should not be timed */
+        void restart();
+
+      private:
+        QElapsedTimer m_Timer;
+        bool m_Enabled { false };
+    };
+
+    static FrameProfiler *Instance();
+
+    /** @return true if profiling is on, see Options::frameProfiling() */
+    static bool isEnabled();
+
+    /** Turn profiling on or off. Collected statistics are kept. */
+    static void setEnabled(bool enable);
+
+    /** Add a sample of nsecs nanoseconds to section */
+    void record(const QString &section, qint64 nsecs);
+
+    /** Forget all collected samples */
+    void reset();
+
+    /** @return the names of the sections for which samples were recorded, sorted */
+    QStringList sections() const;
+
+    /** @return the rolling statistics of section */
+    Stats stats(const QString &section) const;
+
+    /** @return the statistics of all sections as a JSON object keyed by section name */
+    QJsonObject toJson() const;
+
+    /**
+     * @return a short human readable summary, one line per section, ordered by decreasing mean
+     * duration and limited to maxLines lines
+     */
+    QStringList summary(int maxLines = 20) const;
+
+  private:
+    FrameProfiler() = default;
+
+    /** Ring buffer of the last samples of a section, in nanoseconds */
+    struct Section
+    {
+        QVector<qint64> samples;
+        int next { 0 };
+        quint64 total { 0 };
+    };
+
+    Stats statsOf(const Section &section) const;
+
+    static FrameProfiler *pinstance;
+
+    mutable QMutex m_Mutex;
+    QMap<QString, Section> m_Sections;
+};
@@ -122,6 +122,12 @@ class KSFileReader : public QObject, public QTextStream
     /** @short returns the current line number */
     int lineNumber() const { return m_curLine; }
 
+    /**
+     * @short sets the current line number, for readers which do not go through readLine()
+     * and still report their progress with showProgress()
+     */
+    void setLineNumber(int line) { m_curLine = line; }
+
     /**
      * @short Prepares this instance to emit progress reports on how much
      * of the file has been read (in percent).
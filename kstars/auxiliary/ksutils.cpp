@@ -27,6 +27,7 @@
 #include "Options.h"
 #include "starobject.h"
 #include "auxiliary/kspaths.h"
+#include "auxiliary/logwriter.h"
 
 #ifndef KSTARS_LITE
 #include <KMessageBox>
@@ -916,24 +917,9 @@ QString constGenetiveToAbbrev(const QString &genetive_)
     return genetive_;
 }
 
-QString Logging::_filename;
-
 void Logging::UseFile()
 {
-    if (_filename.isEmpty())
-    {
-        QDir dir;
-        QString path = KSPaths::writableLocation(QStandardPaths::GenericDataLocation) + "logs/" +
-                       QDateTime::currentDateTime().toString("yyyy-MM-dd");
-        dir.mkpath(path);
-        QString name = "log_" + QDateTime::currentDateTime().toString("HH-mm-ss") + ".txt";
-        _filename    = path + QStringLiteral("/") + name;
-
-        // Clear file contents
-        QFile file(_filename);
-        file.open(QFile::WriteOnly);
-        file.close();
-    }
+    LogWriter::Instance()->open();
 
     qSetMessagePattern("[%{time yyyy-MM-dd h:mm:ss.zzz t} %{if-debug}DEBG%{endif}%{if-info}INFO%{endif}%{if-warning}WARN%{endif}%{if-critical}CRIT%{endif}%{if-fatal}FATL%{endif}] %{if-category}[%{category}]%{endif} - %{message}");
     qInstallMessageHandler(File);
@@ -941,12 +927,16 @@ void Logging::UseFile()
 
 void Logging::File(QtMsgType type, const QMessageLogContext &context, const QString &msg)
 {
-    QFile file(_filename);
-    if (file.open(QFile::Append | QIODevice::Text))
-    {
-        QTextStream stream(&file);
-        Write(stream, type, context, msg);
-    }
+    // Only format the line here, LogWriter writes it from its own thread
+    QString line;
+    QTextStream stream(&line, QIODevice::WriteOnly);
+    Write(stream, type, context, msg);
+
+    LogWriter::Instance()->append(line.toUtf8(), type != QtDebugMsg && type != QtInfoMsg);
+
+    // Critical messages often come right before a crash, and the application aborts after a fatal one
+    if (type == QtCriticalMsg || type == QtFatalMsg)
+        LogWriter::Instance()->flush();
 }
 
 void Logging::UseStdout()
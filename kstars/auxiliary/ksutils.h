@@ -211,7 +211,7 @@ class Logging
 {
     public:
         /**
-             * Store all logs into the specified file
+             * Store all logs into a file of the day, written by LogWriter on its own thread
              */
         static void UseFile();
 
@@ -241,8 +241,6 @@ class Logging
         static void SyncFilterRules();
 
     private:
-        static QString _filename;
-
         static void Disabled(QtMsgType type, const QMessageLogContext &context, const QString &msg);
         static void File(QtMsgType type, const QMessageLogContext &context, const QString &msg);
         static void Stdout(QtMsgType type, const QMessageLogContext &context, const QString &msg);
@@ -17,6 +17,7 @@
 
 #include "kswizard.h"
 
+#include "citydb.h"
 #include "geolocation.h"
 #include "kspaths.h"
 #include "kstars.h"
@@ -36,16 +37,6 @@
 #include <QStackedWidget>
 #include <QStandardPaths>
 
-namespace
-{
-bool hasPrefix(QString str, QString prefix)
-{
-    if (prefix.isEmpty())
-        return true;
-    return str.startsWith(prefix, Qt::CaseInsensitive);
-}
-}
-
 WizWelcomeUI::WizWelcomeUI(QWidget *parent) : QFrame(parent)
 {
     setupUi(this);
@@ -213,15 +204,15 @@ void KSWizard::initGeoPage()
     location->LongBox->setReadOnly(true);
     location->LatBox->setReadOnly(true);
 
-    //Populate the CityListBox
+    //Populate the CityListBox with the names only, a city is created once it is selected
     //flag the ID of the current City
-    foreach (GeoLocation *loc, data->getGeoList())
+    cityNames = data->citydb()->names();
+    for (const auto &name : cityNames)
     {
-        location->CityListBox->addItem(loc->fullName());
-        filteredCityList.append(loc);
-        if (loc->fullName() == data->geo()->fullName())
+        location->CityListBox->addItem(name.fullName);
+        if (name.fullName == data->geo()->fullName())
         {
-            Geo = loc;
+            Geo = data->citydb()->city(name);
         }
     }
 
@@ -245,6 +236,16 @@ void KSWizard::slotChangeCity()
                 break;
             }
         }
+
+        // The list is not filtered, create the selected city
+        for (const auto &name : cityNames)
+        {
+            if (name.fullName == location->CityListBox->currentItem()->text())
+            {
+                Geo = KStarsData::Instance()->citydb()->city(name);
+                break;
+            }
+        }
         location->LongBox->showInDegrees(Geo->lng());
         location->LatBox->showInDegrees(Geo->lat());
     }
@@ -255,12 +256,20 @@ void KSWizard::slotFilterCities()
     location->CityListBox->clear();
     //Do NOT delete members of filteredCityList!
     filteredCityList.clear();
+    cityNames.clear();
 
-    foreach (GeoLocation *loc, KStarsData::Instance()->getGeoList())
+    // Without a filter, only the names are listed
+    if (location->CityFilter->text().isEmpty() && location->ProvinceFilter->text().isEmpty() &&
+            location->CountryFilter->text().isEmpty())
+    {
+        cityNames = KStarsData::Instance()->citydb()->names();
+        for (const auto &name : cityNames)
+            location->CityListBox->addItem(name.fullName);
+    }
+    else
     {
-        if (hasPrefix(loc->translatedName(), location->CityFilter->text()) &&
-                hasPrefix(loc->translatedCountry(), location->CountryFilter->text()) &&
-                hasPrefix(loc->translatedProvince(), location->ProvinceFilter->text()))
+        foreach (GeoLocation *loc, KStarsData::Instance()->citydb()->findByPrefix(location->CityFilter->text(),
+                 location->ProvinceFilter->text(), location->CountryFilter->text()))
         {
             location->CityListBox->addItem(loc->fullName());
             filteredCityList.append(loc);
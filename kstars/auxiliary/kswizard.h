@@ -32,6 +32,7 @@
 #include "ui_wizdownload.h"
 #include "ui_wizdata.h"
 #include "QProgressIndicator.h"
+#include "citydb.h"
 
 class GeoLocation;
 class QStackedWidget;
@@ -156,4 +157,6 @@ class KSWizard : public QDialog
     QDialogButtonBox *buttonBox { nullptr };
     GeoLocation *Geo { nullptr };
     QList<GeoLocation *> filteredCityList;
+    /// Names of all the cities while the list is not filtered, the cities are created once selected
+    QVector<CityDB::CityName> cityNames;
 };
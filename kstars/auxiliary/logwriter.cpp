@@ -0,0 +1,234 @@
+/***************************************************************************
+                     logwriter.cpp  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sat 17 Oct 2026
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "logwriter.h"
+
+#include "Options.h"
+#include "auxiliary/kspaths.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QMutexLocker>
+#include <qplatformdefs.h>
+
+namespace
+{
+void stopAtExit()
+{
+    LogWriter::Instance()->stop();
+}
+}
+
+LogWriter *LogWriter::pinstance = nullptr;
+
+LogWriter *LogWriter::Instance()
+{
+    if (!pinstance)
+        pinstance = new LogWriter();
+    return pinstance;
+}
+
+LogWriter::LogWriter()
+{
+    setObjectName("LogWriter");
+}
+
+LogWriter::~LogWriter()
+{
+    stop();
+}
+
+void LogWriter::open()
+{
+    {
+        QMutexLocker fileLocker(&m_FileMutex);
+        if (!m_File.isOpen())
+            rotate();
+    }
+
+    if (isRunning())
+        return;
+
+    {
+        QMutexLocker locker(&m_Mutex);
+        m_Stopping = false;
+    }
+
+    static bool stopRegistered = false;
+    if (!stopRegistered)
+    {
+        // Write the last lines when the application exits
+        qAddPostRoutine(stopAtExit);
+        stopRegistered = true;
+    }
+
+    start(QThread::LowPriority);
+}
+
+QString LogWriter::filename()
+{
+    QMutexLocker fileLocker(&m_FileMutex);
+    return m_File.isOpen() ? m_File.fileName() : QString();
+}
+
+void LogWriter::append(const QByteArray &line, bool urgent)
+{
+    {
+        QMutexLocker locker(&m_Mutex);
+
+        if (isRunning() && !m_Stopping)
+        {
+            if (m_Pending.size() + line.size() > MaxPending)
+            {
+                m_Dropped++;
+                return;
+            }
+
+            m_Pending.append(line);
+            if (urgent || m_Pending.size() >= FlushThreshold)
+                m_Wake.wakeOne();
+            return;
+        }
+
+        m_Pending.append(line);
+    }
+
+    // Without the writer thread, e.g. while the application is exiting
+    writePending();
+}
+
+void LogWriter::flush()
+{
+    writePending();
+}
+
+void LogWriter::stop()
+{
+    {
+        QMutexLocker locker(&m_Mutex);
+        m_Stopping = true;
+        m_Wake.wakeOne();
+    }
+
+    if (isRunning() && QThread::currentThread() != this)
+        wait();
+
+    writePending();
+}
+
+void LogWriter::crashFlush()
+{
+    if (!pinstance)
+        return;
+
+    int const handle = pinstance->m_FileHandle.loadAcquire();
+    if (handle < 0)
+        return;
+
+    // If the crashed thread holds the lock, the buffer is written as it is
+    bool const locked = pinstance->m_Mutex.tryLock();
+
+    QByteArray const &pending = pinstance->m_Pending;
+    if (!pending.isEmpty())
+    {
+        auto const written = QT_WRITE(handle, pending.constData(), pending.size());
+        Q_UNUSED(written);
+    }
+
+    if (locked)
+        pinstance->m_Mutex.unlock();
+}
+
+void LogWriter::run()
+{
+    QMutexLocker locker(&m_Mutex);
+
+    while (!m_Stopping)
+    {
+        if (m_Pending.size() < FlushThreshold)
+            m_Wake.wait(&m_Mutex, FlushInterval);
+
+        locker.unlock();
+        writePending();
+        locker.relock();
+    }
+}
+
+void LogWriter::writePending()
+{
+    // Nothing may be logged in here, the file mutex is not recursive
+    QMutexLocker fileLocker(&m_FileMutex);
+
+    QByteArray batch;
+    int dropped = 0;
+    {
+        QMutexLocker locker(&m_Mutex);
+        batch.swap(m_Pending);
+        dropped   = m_Dropped;
+        m_Dropped = 0;
+    }
+
+    if ((batch.isEmpty() && dropped == 0) || !m_File.isOpen())
+        return;
+
+    qint64 const maxSize = static_cast<qint64>(Options::logFileMaxSize()) * 1024 * 1024;
+    qint64 const maxAge  = static_cast<qint64>(Options::logFileMaxAge()) * 3600;
+    if ((maxSize > 0 && m_File.size() >= maxSize) ||
+            (maxAge > 0 && m_FileCreated.secsTo(QDateTime::currentDateTime()) >= maxAge))
+    {
+        if (!rotate())
+            return;
+    }
+
+    if (dropped > 0)
+        m_File.write(QString("%1 log messages were dropped, the log file could not be written fast enough.\n")
+                     .arg(dropped).toUtf8());
+
+    m_File.write(batch);
+    m_File.flush();
+}
+
+bool LogWriter::rotate()
+{
+    m_FileHandle.storeRelease(-1);
+    if (m_File.isOpen())
+        m_File.close();
+
+    m_File.setFileName(newFilename());
+    m_FileCreated = QDateTime::currentDateTime();
+
+    if (!m_File.open(QFile::WriteOnly | QFile::Truncate | QIODevice::Text))
+        return false;
+
+    m_FileHandle.storeRelease(m_File.handle());
+    return true;
+}
+
+QString LogWriter::newFilename()
+{
+    QDateTime const now = QDateTime::currentDateTime();
+    QString const path  = KSPaths::writableLocation(QStandardPaths::GenericDataLocation) + "logs/" +
+                          now.toString("yyyy-MM-dd");
+    QDir().mkpath(path);
+
+    QString const name = path + QStringLiteral("/log_") + now.toString("HH-mm-ss");
+    QString filename   = name + ".txt";
+
+    // A file rotated within the same second must not overwrite the previous one
+    for (int i = 1; QFile::exists(filename); ++i)
+        filename = QString("%1_%2.txt").arg(name).arg(i);
+
+    return filename;
+}
@@ -0,0 +1,119 @@
+/***************************************************************************
+                      logwriter.h  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sat 17 Oct 2026
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QByteArray>
+#include <QAtomicInt>
+#include <QDateTime>
+#include <QFile>
+#include <QMutex>
+#include <QString>
+#include <QThread>
+#include <QWaitCondition>
+
+/**
+ * @class LogWriter
+ *
+ * Background writer of the log file used by KSUtils::Logging::UseFile().
+ *
+ * The threads that log only append the formatted line to a pending buffer under a short lock.
+ * The writer thread swaps that buffer out and writes it to the log file, which stays open, every
+ * FlushInterval milliseconds, or as soon as FlushThreshold bytes are pending or a warning is
+ * logged. If the disk cannot keep up, lines beyond MaxPending bytes are dropped and counted.
+ *
+ * A new log file is started in the directory of the day when the current one grows over
+ * Options::logFileMaxSize() megabytes, or is older than Options::logFileMaxAge() hours.
+ *
+ * Pending lines are written synchronously by flush(), which is called after critical and fatal
+ * messages and when the application exits. Lines logged once the writer has been stopped are
+ * written synchronously. When the application crashes, crashFlush() writes what is still pending
+ * from the crash handler.
+ *
+ * @short Buffered log file writer running on its own thread
+ */
+class LogWriter : public QThread
+{
+        Q_OBJECT
+
+    public:
+        /** Pending bytes which wake up the writer before the end of the interval */
+        static const int FlushThreshold = 64 * 1024;
+
+        /** Maximum interval between two writes, in milliseconds */
+        static const int FlushInterval = 1000;
+
+        /** Pending bytes over which new lines are dropped */
+        static const int MaxPending = 16 * 1024 * 1024;
+
+        static LogWriter *Instance();
+
+        /** Start a new log file if none is open, and the writer thread */
+        void open();
+
+        /** @return the path of the current log file, empty if none is open */
+        QString filename();
+
+        /**
+         * @short Queue a formatted line, may be called from any thread
+         * @param urgent wake up the writer right away, e.g. for warnings
+         */
+        void append(const QByteArray &line, bool urgent = false);
+
+        /** Write all the pending lines to the file before returning */
+        void flush();
+
+        /** Flush and stop the writer thread, later lines are written synchronously */
+        void stop();
+
+        /**
+         * @short Write the pending lines from a crash handler, e.g. on SIGSEGV or SIGABRT
+         *
+         * Best effort: no lock is waited for and nothing is allocated, so that a crash of a thread
+         * holding a lock does not hang the handler. Does nothing if the log file was never opened.
+         */
+        static void crashFlush();
+
+    protected:
+        void run() override;
+
+    private:
+        LogWriter();
+        ~LogWriter() override;
+
+        /** Write the pending lines, rotating the file first if needed */
+        void writePending();
+
+        /** Close the current file and create a new empty one, with m_FileMutex held */
+        bool rotate();
+
+        static QString newFilename();
+
+        static LogWriter *pinstance;
+
+        /** Protects the pending buffer and the state of the thread */
+        QMutex m_Mutex;
+        QWaitCondition m_Wake;
+        QByteArray m_Pending;
+        int m_Dropped { 0 };
+        bool m_Stopping { false };
+
+        /** Protects the file, so that batches are written in order */
+        QMutex m_FileMutex;
+        QFile m_File;
+        QDateTime m_FileCreated;
+        /** Descriptor of m_File for crashFlush(), -1 if none is open */
+        QAtomicInt m_FileHandle { -1 };
+};
@@ -0,0 +1,259 @@
+/***************************************************************************
+                   startuploader.cpp  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sat 17 Oct 2026
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "startuploader.h"
+
+#include "frameprofiler.h"
+#include "kstars_debug.h"
+
+#include <QEventLoop>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <climits>
+
+StartupLoader::StartupLoader(const QString &name, QObject *parent) : QObject(parent), m_Name(name)
+{
+}
+
+StartupLoader::~StartupLoader()
+{
+    for (QFuture<void> &future : m_Futures)
+        future.waitForFinished();
+}
+
+void StartupLoader::addTask(const QString &name, Affinity affinity, const QStringList &dependencies,
+                            const QStringList &resources, const Task &task)
+{
+    Q_ASSERT(!m_Running);
+    Q_ASSERT(indexOf(name) < 0);
+
+    TaskData data;
+    data.name            = name;
+    data.affinity        = affinity;
+    data.dependencies    = dependencies;
+    data.resources       = resources;
+    data.task            = task;
+    data.timing.task     = name;
+    data.timing.affinity = affinity;
+    m_Tasks.append(data);
+}
+
+void StartupLoader::start()
+{
+    if (m_Running)
+        return;
+
+    m_Running   = true;
+    m_Succeeded = false;
+    m_Clock.start();
+
+    m_ScheduleQueued = true;
+    QMetaObject::invokeMethod(this, "schedule", Qt::QueuedConnection);
+}
+
+bool StartupLoader::run()
+{
+    start();
+
+    QEventLoop loop;
+    connect(this, &StartupLoader::finished, &loop, &QEventLoop::quit);
+    if (m_Running)
+        loop.exec(QEventLoop::ExcludeUserInputEvents);
+
+    return m_Succeeded;
+}
+
+StartupLoader::State StartupLoader::state(const QString &name) const
+{
+    int const index = indexOf(name);
+    return (index < 0) ? Skipped : m_Tasks[index].timing.state;
+}
+
+QVector<StartupLoader::Timing> StartupLoader::timings() const
+{
+    QVector<Timing> timings;
+    for (const TaskData &task : m_Tasks)
+        timings.append(task.timing);
+
+    // Tasks which did not run go last
+    std::stable_sort(timings.begin(), timings.end(), [](const Timing &a, const Timing &b)
+    {
+        return (a.start < 0 ? LLONG_MAX : a.start) < (b.start < 0 ? LLONG_MAX : b.start);
+    });
+    return timings;
+}
+
+int StartupLoader::indexOf(const QString &name) const
+{
+    for (int i = 0; i < m_Tasks.size(); i++)
+    {
+        if (m_Tasks[i].name == name)
+            return i;
+    }
+    return -1;
+}
+
+void StartupLoader::schedule()
+{
+    m_ScheduleQueued = false;
+    if (!m_Running)
+        return;
+
+    int mainTask = -1;
+
+    // Skipping a task may skip the tasks depending on it, which may come earlier in the list
+    bool skipped = true;
+    while (skipped)
+    {
+        skipped = false;
+
+        for (int i = 0; i < m_Tasks.size(); i++)
+        {
+            TaskData &task = m_Tasks[i];
+            if (task.timing.state != Waiting)
+                continue;
+
+            bool ready = true, skip = false;
+            for (const QString &dependency : task.dependencies)
+            {
+                int const index = indexOf(dependency);
+                State const state = (index < 0) ? Skipped : m_Tasks[index].timing.state;
+                if (state == Failed || state == Skipped)
+                    skip = true;
+                else if (state != Succeeded)
+                    ready = false;
+            }
+
+            if (skip)
+            {
+                qCWarning(KSTARS) << m_Name << "skips" << task.name;
+                task.timing.state = Skipped;
+                skipped           = true;
+                continue;
+            }
+
+            bool const busy = std::any_of(task.resources.begin(), task.resources.end(), [this](const QString &resource)
+            {
+                return m_BusyResources.contains(resource);
+            });
+            if (!ready || busy)
+                continue;
+
+            if (task.affinity == MainThread)
+            {
+                // One at a time, so that events are processed in between
+                if (mainTask >= 0 || m_MainTaskRunning)
+                    continue;
+                mainTask = i;
+            }
+
+            task.timing.state = Running;
+            for (const QString &resource : task.resources)
+                m_BusyResources.insert(resource);
+
+            if (task.affinity == AnyThread)
+            {
+                m_PoolTasks++;
+                Task const function = task.task;
+                m_Futures.append(QtConcurrent::run([this, i, function]()
+                {
+                    // In ms, an int is plenty for startup and is queued without registering a type
+                    int const start    = m_Clock.elapsed();
+                    bool const success = function();
+                    QMetaObject::invokeMethod(this, "finishTask", Qt::QueuedConnection, Q_ARG(int, i),
+                                              Q_ARG(bool, success), Q_ARG(int, start),
+                                              Q_ARG(int, static_cast<int>(m_Clock.elapsed())));
+                }));
+            }
+        }
+    }
+
+    if (mainTask >= 0)
+    {
+        m_MainTaskRunning  = true;
+        qint64 const start = m_Clock.elapsed();
+        Task const function = m_Tasks[mainTask].task;
+        bool const success  = function();
+        m_MainTaskRunning = false;
+
+        endTask(m_Tasks[mainTask], success, start, m_Clock.elapsed());
+
+        if (!m_ScheduleQueued)
+        {
+            m_ScheduleQueued = true;
+            QMetaObject::invokeMethod(this, "schedule", Qt::QueuedConnection);
+        }
+        return;
+    }
+
+    if (m_PoolTasks > 0 || m_MainTaskRunning)
+        return;
+
+    // Nothing runs, so the tasks still waiting depend on each other
+    for (TaskData &task : m_Tasks)
+    {
+        if (task.timing.state == Waiting)
+        {
+            qCWarning(KSTARS) << m_Name << "skips" << task.name << "which waits for" << task.dependencies;
+            task.timing.state = Skipped;
+        }
+    }
+
+    finish();
+}
+
+void StartupLoader::finishTask(int index, bool success, int start, int end)
+{
+    m_PoolTasks--;
+    endTask(m_Tasks[index], success, start, end);
+    schedule();
+}
+
+void StartupLoader::endTask(TaskData &task, bool success, qint64 start, qint64 end)
+{
+    task.timing.state    = success ? Succeeded : Failed;
+    task.timing.start    = start;
+    task.timing.duration = end - start;
+
+    for (const QString &resource : task.resources)
+        m_BusyResources.remove(resource);
+
+    if (!success)
+        qCWarning(KSTARS) << m_Name << "task" << task.name << "failed";
+
+    if (FrameProfiler::isEnabled())
+        FrameProfiler::Instance()->record("startup/" + task.name, task.timing.duration * 1000000);
+}
+
+void StartupLoader::finish()
+{
+    m_Running   = false;
+    m_Succeeded = std::all_of(m_Tasks.begin(), m_Tasks.end(), [](const TaskData &task)
+    {
+        return task.timing.state == Succeeded;
+    });
+
+    qCInfo(KSTARS) << m_Name << "loaded in" << m_Clock.elapsed() << "ms";
+    for (const Timing &timing : timings())
+    {
+        if (timing.start < 0)
+            continue;
+        qCInfo(KSTARS) << "   " << timing.task << timing.duration << "ms, from" << timing.start << "ms on the"
+                       << (timing.affinity == MainThread ? "main thread" : "thread pool");
+    }
+
+    emit finished(m_Succeeded);
+}
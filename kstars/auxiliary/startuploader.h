@@ -0,0 +1,163 @@
+/***************************************************************************
+                    startuploader.h  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sat 17 Oct 2026
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QFuture>
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <functional>
+
+/**
+ * @class StartupLoader
+ *
+ * Runs the named loading tasks of a startup phase as a dependency graph. A task starts once all
+ * the tasks it depends on have succeeded, and tasks which do not depend on each other run at the
+ * same time: tasks with the AnyThread affinity on the global thread pool, and MainThread tasks on
+ * the thread of the loader, one per event loop turn so that progress messages are still shown.
+ *
+ * Tasks which share state that is not thread safe, e.g. the result buffers of the SkyMesh,
+ * declare it as a named resource. Tasks holding the same resource never run at the same time.
+ *
+ * A task fails by returning false, and the tasks depending on it are then skipped. The time each
+ * task took is logged when the graph is done, and recorded in the FrameProfiler as
+ * "startup/<task>" when profiling is on.
+ *
+ * @short Dependency graph of the tasks loading KStars data
+ */
+class StartupLoader : public QObject
+{
+    Q_OBJECT
+
+  public:
+    typedef std::function<bool()> Task;
+
+    enum Affinity
+    {
+        /// Run on the global thread pool
+        AnyThread,
+        /// Run on the thread of the loader, for QObjects, pixmaps and SQL connections used later on
+        MainThread
+    };
+
+    enum State
+    {
+        Waiting,
+        Running,
+        Succeeded,
+        Failed,
+        /// Not run because a task it depends on failed or does not exist
+        Skipped
+    };
+
+    /** Timing of a task, in ms since the loader was started */
+    struct Timing
+    {
+        QString task;
+        State state { Waiting };
+        Affinity affinity { AnyThread };
+        qint64 start { -1 };
+        qint64 duration { -1 };
+    };
+
+    /** @param name name of the loading phase in the logs */
+    explicit StartupLoader(const QString &name, QObject *parent = nullptr);
+
+    /** Waits for the tasks running on the thread pool */
+    ~StartupLoader() override;
+
+    /**
+     * @brief addTask Add a task to the graph, before the loader is started
+     * @param name unique name of the task, used by dependencies and in the logs
+     * @param affinity where the task must run
+     * @param dependencies names of the tasks which must succeed before this one starts
+     * @param resources names of the state this task uses exclusively
+     * @param task returns false if it failed
+     */
+    void addTask(const QString &name, Affinity affinity, const QStringList &dependencies,
+                 const QStringList &resources, const Task &task);
+
+    /** Start the tasks and return, finished() is emitted once they are all done */
+    void start();
+
+    /**
+     * @brief run Start the tasks and wait for them, processing events but user input
+     * @return true if all tasks succeeded
+     */
+    bool run();
+
+    bool isRunning() const
+    {
+        return m_Running;
+    }
+
+    /** @return true if all tasks succeeded, once finished */
+    bool succeeded() const
+    {
+        return m_Succeeded;
+    }
+
+    /** @return the state of the named task */
+    State state(const QString &name) const;
+
+    /** @return the timings of the tasks, in the order they started */
+    QVector<Timing> timings() const;
+
+  signals:
+    void finished(bool success);
+
+  private slots:
+    /** Start the tasks which are ready, and finish when there is nothing left to run */
+    void schedule();
+
+    /** A thread pool task is done */
+    void finishTask(int index, bool success, int start, int end);
+
+  private:
+    struct TaskData
+    {
+        QString name;
+        Affinity affinity { AnyThread };
+        QStringList dependencies;
+        QStringList resources;
+        Task task;
+        Timing timing;
+    };
+
+    /** @return the index of the named task, -1 if none */
+    int indexOf(const QString &name) const;
+
+    /** Record the end of a task and release its resources */
+    void endTask(TaskData &task, bool success, qint64 start, qint64 end);
+
+    void finish();
+
+    QString m_Name;
+    QVector<TaskData> m_Tasks;
+    QSet<QString> m_BusyResources;
+    QList<QFuture<void>> m_Futures;
+    QElapsedTimer m_Clock;
+    int m_PoolTasks { 0 };
+    bool m_Running { false };
+    bool m_MainTaskRunning { false };
+    bool m_ScheduleQueued { false };
+    bool m_Succeeded { false };
+};
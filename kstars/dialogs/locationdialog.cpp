@@ -17,6 +17,7 @@
 
 #include "locationdialog.h"
 
+#include "citydb.h"
 #include "kspaths.h"
 #include "kstarsdata.h"
 #include "Options.h"
@@ -133,26 +134,29 @@ LocationDialog::LocationDialog(QWidget *parent) : QDialog(parent), timer(nullptr
 void LocationDialog::initCityList()
 {
     KStarsData *data = KStarsData::Instance();
-    foreach (GeoLocation *loc, data->getGeoList())
-    {
-        ld->GeoBox->addItem(loc->fullName());
-        filteredCityList.append(loc);
 
+    // Only the names are listed, a city is created once it is selected
+    cityNames = data->citydb()->names();
+    for (const auto &name : cityNames)
+        ld->GeoBox->addItem(name.fullName);
+
+    foreach (double TZ0, data->citydb()->timeZones())
+    {
         //If TZ is not an even integer value, add it to listbox
-        if (loc->TZ0() - int(loc->TZ0()) && ld->TZBox->findText(QLocale().toString(loc->TZ0())) != -1)
+        if (TZ0 - int(TZ0) && ld->TZBox->findText(QLocale().toString(TZ0)) != -1)
         {
             for (int i = 0; i < ld->TZBox->count(); ++i)
             {
-                if (ld->TZBox->itemText(i).toDouble() > loc->TZ0())
+                if (ld->TZBox->itemText(i).toDouble() > TZ0)
                 {
-                    ld->TZBox->addItem(QLocale().toString(loc->TZ0()), i - 1);
+                    ld->TZBox->addItem(QLocale().toString(TZ0), i - 1);
                     break;
                 }
             }
         }
     }
 
-    //Sort the list of Cities alphabetically...note that filteredCityList may now have a different ordering!
+    //Sort the list of Cities alphabetically
     ld->GeoBox->sortItems();
 
     ld->CountLabel->setText(
@@ -190,23 +194,24 @@ void LocationDialog::filterCity()
     //Do NOT delete members of filteredCityList!
     while (!filteredCityList.isEmpty())
         filteredCityList.takeFirst();
+    cityNames.clear();
 
     nameModified = false;
     dataModified = false;
     ld->AddCityButton->setEnabled(false);
     ld->UpdateButton->setEnabled(false);
 
-    foreach (GeoLocation *loc, data->getGeoList())
+    // Without a filter, only the names are listed
+    if (ld->CityFilter->text().isEmpty() && ld->ProvinceFilter->text().isEmpty() && ld->CountryFilter->text().isEmpty())
     {
-        QString sc(loc->translatedName());
-        QString ss(loc->translatedCountry());
-        QString sp = "";
-        if (!loc->province().isEmpty())
-            sp = loc->translatedProvince();
-
-        if (sc.startsWith(ld->CityFilter->text(), Qt::CaseInsensitive) &&
-                sp.startsWith(ld->ProvinceFilter->text(), Qt::CaseInsensitive) &&
-                ss.startsWith(ld->CountryFilter->text(), Qt::CaseInsensitive))
+        cityNames = data->citydb()->names();
+        for (const auto &name : cityNames)
+            ld->GeoBox->addItem(name.fullName);
+    }
+    else
+    {
+        foreach (GeoLocation *loc,
+                 data->citydb()->findByPrefix(ld->CityFilter->text(), ld->ProvinceFilter->text(), ld->CountryFilter->text()))
         {
             ld->GeoBox->addItem(loc->fullName());
             filteredCityList.append(loc);
@@ -240,6 +245,19 @@ void LocationDialog::changeCity()
                 break;
             }
         }
+
+        // The list is not filtered, create the selected city
+        if (SelectedCity == nullptr)
+        {
+            for (const auto &name : cityNames)
+            {
+                if (name.fullName == ld->GeoBox->currentItem()->text())
+                {
+                    SelectedCity = data->citydb()->city(name);
+                    break;
+                }
+            }
+        }
     }
 
     ld->MapView->repaint();
@@ -414,9 +432,9 @@ bool LocationDialog::updateCity(CityOperation operation)
                 return false;
             }
 
-            //Add city to geoList...don't need to insert it alphabetically, since we always sort GeoList
+            //Add city to the user cities...don't need to insert it alphabetically, since we always sort GeoBox
             g = new GeoLocation(lng, lat, name, province, country, TZ, &KStarsData::Instance()->Rulebook[TZrule], Elevation);
-            KStarsData::Instance()->getGeoList().append(g);
+            KStarsData::Instance()->citydb()->addUserCity(g);
         }
         break;
 
@@ -472,8 +490,7 @@ bool LocationDialog::updateCity(CityOperation operation)
             }
 
             filteredCityList.removeOne(g);
-            KStarsData::Instance()->getGeoList().removeOne(g);
-            delete g;
+            KStarsData::Instance()->citydb()->removeUserCity(g);
             g = nullptr;
         }
         break;
@@ -510,8 +527,9 @@ void LocationDialog::findCitiesNear(int lng, int lat)
     //Remember, do NOT delete members of filteredCityList
     while (!filteredCityList.isEmpty())
         filteredCityList.takeFirst();
+    cityNames.clear();
 
-    foreach (GeoLocation *loc, data->getGeoList())
+    foreach (GeoLocation *loc, data->citydb()->findNear(lng, lat, 3))
     {
         if ((abs(lng - int(loc->lng()->Degrees())) < 3) && (abs(lat - int(loc->lat()->Degrees())) < 3))
         {
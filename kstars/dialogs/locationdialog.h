@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "citydb.h"
 #include "geolocation.h"
 #include "ui_locationdialog.h"
 
@@ -194,6 +195,8 @@ protected slots:
     LocationDialogUI *ld { nullptr };
     GeoLocation *SelectedCity { nullptr };
     QList<GeoLocation *> filteredCityList;
+    /// Names of all the cities while the list is not filtered, the cities are created once selected
+    QVector<CityDB::CityName> cityNames;
     QTimer *timer { nullptr };
     //Retrieve the name of city
 
@@ -2948,7 +2948,7 @@ void Align::newFITS(IBLOB *bp)
 
                 uint16_t offsetX = x / binx;
                 uint16_t offsetY = y / biny;
-                FITSData *darkData = DarkLibrary::Instance()->getDarkFrame(targetChip, exposureIN->value());
+                QSharedPointer<FITSData> darkData = DarkLibrary::Instance()->getDarkFrame(targetChip, exposureIN->value());
 
                 connect(DarkLibrary::Instance(), &DarkLibrary::darkFrameCompleted, this, [&](bool completed)
                 {
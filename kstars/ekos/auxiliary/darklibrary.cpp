@@ -18,8 +18,33 @@
 #include "fitsviewer/fitsdata.h"
 #include "fitsviewer/fitsview.h"
 
+#include <QSet>
+#include <QThread>
+#include <QtConcurrent>
+
+#include <algorithm>
+
 namespace Ekos
 {
+namespace
+{
+/// Maximum difference between the exposure of the frame and the one of its dark, in seconds
+const double DurationTolerance = 0.05;
+
+/** Subtract count dark samples from light samples, clamping at zero. Branchless so that it is vectorized. */
+template <typename T>
+void subtractRow(T * __restrict light, const T * __restrict dark, int count)
+{
+    for (int j = 0; j < count; j++)
+        light[j] = std::max(light[j], dark[j]) - dark[j];
+}
+}
+
+uint qHash(const DarkLibrary::DarkKey &key, uint seed)
+{
+    return qHash(key.ccd, seed) ^ qHash((key.chip << 16) ^ (key.binX << 8) ^ key.binY, seed);
+}
+
 DarkLibrary *DarkLibrary::_DarkLibrary = nullptr;
 
 DarkLibrary *DarkLibrary::Instance()
@@ -32,7 +57,7 @@ DarkLibrary *DarkLibrary::Instance()
 
 DarkLibrary::DarkLibrary(QObject *parent) : QObject(parent)
 {
-    KStarsData::Instance()->userdb()->GetAllDarkFrames(darkFrames);
+    refreshFromDB();
 
     subtractParams.duration    = 0;
     subtractParams.offsetX     = 0;
@@ -49,90 +74,144 @@ DarkLibrary::DarkLibrary(QObject *parent) : QObject(parent)
 
 DarkLibrary::~DarkLibrary()
 {
-    qDeleteAll(darkFiles);
 }
 
 void DarkLibrary::refreshFromDB()
 {
+    QList<QVariantMap> darkFrames;
     KStarsData::Instance()->userdb()->GetAllDarkFrames(darkFrames);
+    indexDarkFrames(darkFrames);
+}
+
+void DarkLibrary::indexDarkFrames(const QList<QVariantMap> &darkFrames)
+{
+    darkIndex.clear();
+
+    for (const QVariantMap &map : darkFrames)
+        addDarkFrame(map);
+
+    // Darks which are no longer in the database, e.g. cleared in the options, must not be used
+    QSet<QString> filenames;
+    for (const QVariantMap &map : darkFrames)
+        filenames.insert(map["filename"].toString());
+
+    for (const QString &filename : darkFiles.keys())
+    {
+        if (filenames.contains(filename) == false)
+            darkFiles.remove(filename);
+    }
 }
 
-FITSData *DarkLibrary::getDarkFrame(ISD::CCDChip *targetChip, double duration)
+void DarkLibrary::addDarkFrame(const QVariantMap &map)
 {
-    for (auto &map : darkFrames)
+    DarkKey const key { map["ccd"].toString(), map["chip"].toInt(), map["binX"].toInt(), map["binY"].toInt() };
+
+    DarkEntry entry;
+    entry.duration    = map["duration"].toDouble();
+    entry.temperature = map["temperature"].toDouble();
+    entry.filename    = map["filename"].toString();
+    // Frames saved during this session have no timestamp yet, they are current
+    entry.timestamp   = map.contains("timestamp") ? QDateTime::fromString(map["timestamp"].toString(), Qt::ISODate) :
+                        QDateTime::currentDateTime();
+
+    // Keep the darks sorted by duration, in database order for equal durations
+    QVector<DarkEntry> &entries = darkIndex[key];
+    auto position = std::upper_bound(entries.begin(), entries.end(), entry.duration,
+                                     [](double duration, const DarkEntry & other)
     {
-        // First check CCD name matches and check if we are on the correct chip
-        if (map["ccd"].toString() == targetChip->getCCD()->getDeviceName() &&
-                map["chip"].toInt() == static_cast<int>(targetChip->getType()))
-        {
-            int binX, binY;
-            targetChip->getBinning(&binX, &binY);
+        return duration < other.duration;
+    });
+    entries.insert(position, entry);
+}
 
-            // Then check if binning is the same
-            if (map["binX"].toInt() == binX && map["binY"].toInt() == binY)
-            {
-                // Then check for temperature
-                if (targetChip->getCCD()->hasCooler())
-                {
-                    double temperature = 0;
-                    targetChip->getCCD()->getTemperature(&temperature);
-                    // TODO make this configurable value, the threshold
-                    if (fabs(map["temperature"].toDouble() - temperature) > Options::maxDarkTemperatureDiff())
-                        continue;
-                }
-
-                // Then check for duration
-                // TODO make this value configurable
-                if (fabs(map["duration"].toDouble() - duration) > 0.05)
-                    continue;
-
-                // Finally check if the duration is acceptable
-                QDateTime frameTime = QDateTime::fromString(map["timestamp"].toString(), Qt::ISODate);
-                if (frameTime.daysTo(QDateTime::currentDateTime()) > Options::darkLibraryDuration())
-                    continue;
-
-                QString filename = map["filename"].toString();
-
-                if (darkFiles.contains(filename))
-                    return darkFiles[filename];
-
-                // Finally we made it, let's put it in the hash
-                if (loadDarkFile(filename))
-                    return darkFiles[filename];
-                else
-                {
-                    // Remove bad dark frame
-                    emit newLog(i18n("Removing bad dark frame file %1", filename));
-                    darkFiles.remove(filename);
-                    QFile::remove(filename);
-                    KStarsData::Instance()->userdb()->DeleteDarkFrame(filename);
-                    return nullptr;
-                }
-            }
+void DarkLibrary::cacheDarkFile(const QString &filename, const QSharedPointer<FITSData> &darkData)
+{
+    // Follow changes of the option, a smaller size releases darks right away
+    darkFiles.setMaxCost(std::max(1, static_cast<int>(Options::maxDarkCacheSize()) * 1024));
+
+    qint64 const size = static_cast<qint64>(darkData->width()) * darkData->height() * darkData->channels() *
+                        darkData->getBytesPerPixel();
+
+    // The dark just loaded is about to be used, so it may not be evicted even if it is larger than the cache
+    int const cost = static_cast<int>(std::min<qint64>(darkFiles.maxCost(), std::max<qint64>(1, size / 1024)));
+
+    darkFiles.insert(filename, new QSharedPointer<FITSData>(darkData), cost);
+}
+
+QSharedPointer<FITSData> DarkLibrary::getDarkFrame(ISD::CCDChip *targetChip, double duration)
+{
+    int binX, binY;
+    targetChip->getBinning(&binX, &binY);
+
+    // First find the darks of this CCD, chip and binning
+    DarkKey const key { targetChip->getCCD()->getDeviceName(), static_cast<int>(targetChip->getType()), binX, binY };
+    auto darks = darkIndex.constFind(key);
+    if (darks == darkIndex.constEnd())
+        return QSharedPointer<FITSData>();
+
+    bool const hasCooler = targetChip->getCCD()->hasCooler();
+    double temperature = 0;
+    if (hasCooler)
+        targetChip->getCCD()->getTemperature(&temperature);
+
+    QDateTime const now = QDateTime::currentDateTime();
+
+    // Then check for duration
+    // TODO make this value configurable
+    const QVector<DarkEntry> &entries = darks.value();
+    auto entry = std::lower_bound(entries.constBegin(), entries.constEnd(), duration - DurationTolerance,
+                                  [](const DarkEntry & other, double duration)
+    {
+        return other.duration < duration;
+    });
+
+    for (; entry != entries.constEnd() && entry->duration <= duration + DurationTolerance; ++entry)
+    {
+        // Then check for temperature
+        if (hasCooler && fabs(entry->temperature - temperature) > Options::maxDarkTemperatureDiff())
+            continue;
+
+        // Finally check if the duration is acceptable
+        if (entry->timestamp.daysTo(now) > Options::darkLibraryDuration())
+            continue;
+
+        QString filename = entry->filename;
+
+        if (darkFiles.contains(filename))
+            return *darkFiles.object(filename);
+
+        // Finally we made it, let's put it in the cache
+        if (loadDarkFile(filename))
+            return *darkFiles.object(filename);
+        else
+        {
+            // Remove bad dark frame
+            emit newLog(i18n("Removing bad dark frame file %1", filename));
+            QFile::remove(filename);
+            KStarsData::Instance()->userdb()->DeleteDarkFrame(filename);
+            refreshFromDB();
+            return QSharedPointer<FITSData>();
         }
     }
 
-    return nullptr;
+    return QSharedPointer<FITSData>();
 }
 
 bool DarkLibrary::loadDarkFile(const QString &filename)
 {
-    FITSData *darkData = new FITSData();
+    QSharedPointer<FITSData> darkData(new FITSData());
 
     bool rc = darkData->loadFITS(filename);
 
     if (rc)
-        darkFiles[filename] = darkData;
+        cacheDarkFile(filename, darkData);
     else
-    {
         emit newLog(i18n("Failed to load dark frame file %1", filename));
-        delete (darkData);
-    }
 
     return rc;
 }
 
-bool DarkLibrary::saveDarkFile(FITSData *darkData)
+bool DarkLibrary::saveDarkFile(const QSharedPointer<FITSData> &darkData)
 {
     // IS8601 contains colons but they are illegal under Windows OS, so replacing them with '-'
     // The timestamp is no longer ISO8601 but it should solve interoperality issues between different OS hosts
@@ -146,7 +225,7 @@ bool DarkLibrary::saveDarkFile(FITSData *darkData)
         return false;
     }
 
-    darkFiles[path] = darkData;
+    cacheDarkFile(path, darkData);
 
     QVariantMap map;
     int binX, binY;
@@ -163,7 +242,7 @@ bool DarkLibrary::saveDarkFile(FITSData *darkData)
     map["duration"]    = subtractParams.duration;
     map["filename"]    = path;
 
-    darkFrames.append(map);
+    addDarkFrame(map);
 
     emit newLog(i18n("Dark frame saved to %1", path));
 
@@ -172,8 +251,8 @@ bool DarkLibrary::saveDarkFile(FITSData *darkData)
     return true;
 }
 
-void DarkLibrary::subtract(FITSData *darkData, FITSView *lightImage, FITSScale filter, uint16_t offsetX,
-                           uint16_t offsetY)
+void DarkLibrary::subtract(const QSharedPointer<FITSData> &darkData, FITSView *lightImage, FITSScale filter,
+                           uint16_t offsetX, uint16_t offsetY)
 {
     Q_ASSERT(darkData);
     Q_ASSERT(lightImage);
@@ -218,8 +297,8 @@ void DarkLibrary::subtract(FITSData *darkData, FITSView *lightImage, FITSScale f
 }
 
 template <typename T>
-void DarkLibrary::subtract(FITSData *darkData, FITSView *lightImage, FITSScale filter, uint16_t offsetX,
-                           uint16_t offsetY)
+void DarkLibrary::subtract(const QSharedPointer<FITSData> &darkData, FITSView *lightImage, FITSScale filter,
+                           uint16_t offsetX, uint16_t offsetY)
 {
     // If telescope is covered, let's uncover it
     auto checkTelescopeCover = [this]()
@@ -271,7 +350,7 @@ void DarkLibrary::subtract(FITSData *darkData, FITSView *lightImage, FITSScale f
     {
         checkTelescopeCover();
 
-        // Otherwise, call this function again
+        // Otherwise, call this function again. The dark is held until then, even if the cache releases it.
         QTimer::singleShot(1000, this, [this, darkData, lightImage, filter, offsetX, offsetY]
         {
             subtract(darkData, lightImage, filter, offsetX, offsetY);
@@ -288,15 +367,30 @@ void DarkLibrary::subtract(FITSData *darkData, FITSView *lightImage, FITSScale f
 
     int darkW      = darkData->width();
     int darkoffset = offsetX + offsetY * darkW;
-    T *darkBuffer  = reinterpret_cast<T *>(darkData->getImageBuffer()) + darkoffset;
+    T const *darkBuffer = reinterpret_cast<T *>(darkData->getImageBuffer()) + darkoffset;
 
-    for (int i = 0; i < lightH; i++)
+    auto subtractRows = [ = ](int start, int end)
     {
-        for (int j = 0; j < lightW; j++)
-            lightBuffer[j] = (lightBuffer[j] > darkBuffer[j]) ? (lightBuffer[j] - darkBuffer[j]) : 0;
+        for (int i = start; i < end; i++)
+            subtractRow(lightBuffer + static_cast<size_t>(i) * lightW, darkBuffer + static_cast<size_t>(i) * darkW, lightW);
+    };
+
+    // Large frames are subtracted in bands on all cores
+    int nBands = 1;
+    if (lightW * lightH >= 1024 * 1024)
+        nBands = std::max(1, QThread::idealThreadCount());
+
+    if (nBands == 1)
+        subtractRows(0, lightH);
+    else
+    {
+        int const bandHeight = (lightH + nBands - 1) / nBands;
+        QList<QFuture<void>> futures;
+        for (int start = 0; start < lightH; start += bandHeight)
+            futures.append(QtConcurrent::run(subtractRows, start, std::min(lightH, start + bandHeight)));
 
-        lightBuffer += lightW;
-        darkBuffer += darkW;
+        for (QFuture<void> &future : futures)
+            future.waitForFinished();
     }
 
 #if 0
@@ -498,7 +592,7 @@ void DarkLibrary::newFITS(IBLOB * bp)
 
     emit newLog(i18n("Dark frame received."));
 
-    FITSData *calibrationData = new FITSData();
+    QSharedPointer<FITSData> calibrationData(new FITSData());
 
     // Deep copy of the data
     if (calibrationData->loadFITS(calibrationView->getImageData()->filename()))
@@ -509,7 +603,6 @@ void DarkLibrary::newFITS(IBLOB * bp)
     }
     else
     {
-        delete calibrationData;
         emit darkFrameCompleted(false);
         emit newLog(i18n("Warning: Cannot load calibration file %1", calibrationView->getImageData()->filename()));
     }
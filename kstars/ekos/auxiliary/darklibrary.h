@@ -12,7 +12,12 @@
 #include "indi/indiccd.h"
 #include "indi/indicap.h"
 
+#include <QCache>
+#include <QDateTime>
+#include <QHash>
 #include <QObject>
+#include <QSharedPointer>
+#include <QVector>
 
 namespace Ekos
 {
@@ -31,8 +36,14 @@ class DarkLibrary : public QObject
     public:
         static DarkLibrary *Instance();
 
-        FITSData *getDarkFrame(ISD::CCDChip *targetChip, double duration);
-        void subtract(FITSData *darkData, FITSView *lightImage, FITSScale filter, uint16_t offsetX, uint16_t offsetY);
+        /**
+         * @brief getDarkFrame Find a dark for a frame of the chip, loading it if needed
+         * @return the dark, null if there is none. The dark stays valid as long as the caller holds
+         * it, even if the cache releases it in the meantime.
+         */
+        QSharedPointer<FITSData> getDarkFrame(ISD::CCDChip *targetChip, double duration);
+        void subtract(const QSharedPointer<FITSData> &darkData, FITSView *lightImage, FITSScale filter, uint16_t offsetX,
+                      uint16_t offsetY);
         // Return false if canceled. True if dark capture proceeds
         void captureAndSubtract(ISD::CCDChip *targetChip, FITSView *targetImage, double duration, uint16_t offsetX,
                                 uint16_t offsetY);
@@ -60,14 +71,46 @@ class DarkLibrary : public QObject
 
         static DarkLibrary *_DarkLibrary;
 
+        /// Identifies the darks which may be used for the frames of a chip at a binning
+        struct DarkKey
+        {
+            QString ccd;
+            int chip;
+            int binX;
+            int binY;
+
+            bool operator==(const DarkKey &other) const
+            {
+                return chip == other.chip && binX == other.binX && binY == other.binY && ccd == other.ccd;
+            }
+        };
+        friend uint qHash(const DarkKey &key, uint seed);
+
+        struct DarkEntry
+        {
+            double duration;
+            double temperature;
+            QDateTime timestamp;
+            QString filename;
+        };
+
+        /** Rebuild the dark index from the database records */
+        void indexDarkFrames(const QList<QVariantMap> &darkFrames);
+        void addDarkFrame(const QVariantMap &map);
+
         bool loadDarkFile(const QString &filename);
-        bool saveDarkFile(FITSData *darkData);
+        bool saveDarkFile(const QSharedPointer<FITSData> &darkData);
+        void cacheDarkFile(const QString &filename, const QSharedPointer<FITSData> &darkData);
 
         template <typename T>
-        void subtract(FITSData *darkData, FITSView *lightImage, FITSScale filter, uint16_t offsetX, uint16_t offsetY);
-
-        QList<QVariantMap> darkFrames;
-        QHash<QString, FITSData *> darkFiles;
+        void subtract(const QSharedPointer<FITSData> &darkData, FITSView *lightImage, FITSScale filter, uint16_t offsetX,
+                      uint16_t offsetY);
+
+        /// Darks of each chip and binning, sorted by duration
+        QHash<DarkKey, QVector<DarkEntry>> darkIndex;
+        /// Loaded darks by filename, least recently used ones are released beyond the size set in the options, in KiB.
+        /// A released dark is only deleted once no subtraction holds it anymore.
+        QCache<QString, QSharedPointer<FITSData>> darkFiles;
 
         struct
         {
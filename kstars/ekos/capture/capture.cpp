@@ -1521,7 +1521,7 @@ void Capture::newFITS(IBLOB * bp)
             if (useGuideHead == false && darkSubCheck->isChecked() && activeJob->isPreview())
             {
                 FITSView * currentImage = targetChip->getImageView(FITS_NORMAL);
-                FITSData * darkData     = DarkLibrary::Instance()->getDarkFrame(targetChip, activeJob->getExposure());
+                QSharedPointer<FITSData> darkData = DarkLibrary::Instance()->getDarkFrame(targetChip, activeJob->getExposure());
                 uint16_t offsetX       = activeJob->getSubX() / activeJob->getXBin();
                 uint16_t offsetY       = activeJob->getSubY() / activeJob->getYBin();
 
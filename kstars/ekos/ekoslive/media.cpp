@@ -25,6 +25,24 @@
 namespace EkosLive
 {
 
+namespace
+{
+QByteArray encodeVideoFrame(std::shared_ptr<QImage> frame, int width)
+{
+    // TODO Scale should be configurable
+    QImage oneFrame = (frame->width() > width) ? frame->scaledToWidth(width) : *frame;
+
+    QByteArray array;
+    QBuffer buffer(&array);
+    QImageWriter writer;
+    writer.setDevice(&buffer);
+    writer.setFormat("JPEG");
+    writer.setCompression(7);
+    writer.write(oneFrame);
+    return array;
+}
+}
+
 Media::Media(Ekos::Manager * manager): m_Manager(manager)
 {
     connect(&m_WebSocket, &QWebSocket::connected, this, &Media::onConnected);
@@ -33,6 +51,8 @@ Media::Media(Ekos::Manager * manager): m_Manager(manager)
 
     connect(this, &Media::newMetadata, this, &Media::uploadMetadata);
     connect(this, &Media::newImage, this, &Media::uploadImage);
+
+    connect(&m_VideoFrameWatcher, &QFutureWatcher<QByteArray>::finished, this, &Media::sendEncodedVideoFrame);
 }
 
 void Media::connectServer()
@@ -273,21 +293,14 @@ void Media::sendVideoFrame(std::shared_ptr<QImage> frame)
     if (m_isConnected == false || m_Options[OPTION_SET_IMAGE_TRANSFER] == false || m_sendBlobs == false || !frame)
         return;
 
+    // The stream must not fall behind, so drop the frame if the previous one is still being encoded
+    if (m_VideoFrameWatcher.isRunning())
+        return;
+
     int32_t width = m_Options[OPTION_SET_HIGH_BANDWIDTH] ? HB_WIDTH : HB_WIDTH / 2;
 
-    // TODO Scale should be configurable
-    QImage oneFrame;
-    if (frame.get()->width() > width)
-        oneFrame = frame.get()->scaledToWidth(width);
+    m_VideoFrameWatcher.setFuture(QtConcurrent::run(encodeVideoFrame, frame, width));
 
-    QByteArray array;
-    QBuffer buffer(&array);
-    QImageWriter writer;
-    writer.setDevice(&buffer);
-    writer.setFormat("JPEG");
-    writer.setCompression(7);
-    writer.write(oneFrame);
-    m_WebSocket.sendBinaryMessage(array);
     //    QTemporaryFile jpegFile;
     //    jpegFile.open();
     //    jpegFile.close();
@@ -300,6 +313,14 @@ void Media::sendVideoFrame(std::shared_ptr<QImage> frame)
     //m_WebSocket.sendBinaryMessage(jpegFile.readAll());
 }
 
+void Media::sendEncodedVideoFrame()
+{
+    QByteArray const array = m_VideoFrameWatcher.result();
+
+    if (m_isConnected && array.isEmpty() == false)
+        m_WebSocket.sendBinaryMessage(array);
+}
+
 void Media::registerCameras()
 {
     if (m_isConnected == false)
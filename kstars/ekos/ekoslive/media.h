@@ -13,6 +13,7 @@
 #pragma once
 
 #include <QtWebSockets/QWebSocket>
+#include <QFutureWatcher>
 #include <memory>
 
 #include "ekos/ekos.h"
@@ -99,6 +100,9 @@ class Media : public QObject
         void uploadMetadata(const QByteArray &metadata);
         void uploadImage(const QByteArray &image);
 
+        // Video frame encoded
+        void sendEncodedVideoFrame();
+
     private:
         void upload(FITSView * view);
 
@@ -119,6 +123,9 @@ class Media : public QObject
         bool m_isConnected { false };
         bool m_sendBlobs { true};
 
+        // Video frames are scaled and encoded one at a time, frames arriving meanwhile are dropped
+        QFutureWatcher<QByteArray> m_VideoFrameWatcher;
+
         // Image width for high-bandwidth setting
         static const uint16_t HB_WIDTH = 640;
         // Image high bandwidth image quality (jpg)
@@ -754,6 +754,14 @@ void Focus::stop(bool aborted)
 
     captureTimeout.stop();
 
+    // Discard the stars being searched
+    starDetector.cancel();
+    if (restoreTrackingBox)
+    {
+        focusView->setTrackingBoxEnabled(true);
+        restoreTrackingBox = false;
+    }
+
     ISD::CCDChip *targetChip = currentCCD->getChip(ISD::CCDChip::PRIMARY_CCD);
 
     inAutoFocus        = false;
@@ -1018,7 +1026,7 @@ void Focus::newFITS(IBLOB *bp)
 
     if (darkFrameCheck->isChecked())
     {
-        FITSData *darkData   = DarkLibrary::Instance()->getDarkFrame(targetChip, exposureIN->value());
+        QSharedPointer<FITSData> darkData = DarkLibrary::Instance()->getDarkFrame(targetChip, exposureIN->value());
         QVariantMap settings = frameSettings[targetChip];
         uint16_t offsetX     = settings["x"].toInt() / settings["binx"].toInt();
         uint16_t offsetY     = settings["y"].toInt() / settings["biny"].toInt();
@@ -1053,11 +1061,6 @@ void Focus::setCaptureComplete()
 {
     DarkLibrary::Instance()->disconnect(this);
 
-    // Get Binning
-    ISD::CCDChip *targetChip = currentCCD->getChip(ISD::CCDChip::PRIMARY_CCD);
-    int subBinX = 1, subBinY = 1;
-    targetChip->getBinning(&subBinX, &subBinY);
-
     // If we have a box, sync the bounding box to its position.
     syncTrackingBoxPosition();
 
@@ -1091,62 +1094,99 @@ void Focus::setCaptureComplete()
     if (inFocusLoop == false || (inFocusLoop && (focusView->isTrackingBoxEnabled() || Options::focusUseFullField())))
     {
         // First check that we haven't already search for stars
-        // Since star-searching algorithm are time-consuming, we should only search when necessary
+        // Since star-searching algorithm are time-consuming, we search in the background and only when necessary
         if (image_data->areStarsSearched() == false)
         {
             // Reset current HFR
             currentHFR = -1;
 
+            StarAlgorithm algorithm = focusDetection;
+            QRect searchBox;
+            restoreTrackingBox = false;
+
             // When we're using FULL field view, we always use either CENTROID algorithm which is the default
             // standard algorithm in KStars, or SEP. The other algorithms are too inefficient to run on full frames and require
             // a bounding box for them to be effective in near real-time application.
             if (Options::focusUseFullField())
             {
                 if (focusDetection != ALGORITHM_CENTROID && focusDetection != ALGORITHM_SEP)
-                    focusView->findStars(ALGORITHM_CENTROID);
-                else
-                    focusView->findStars(focusDetection);
-                focusView->setStarFilterRange(static_cast <float> (fullFieldInnerRing->value() / 100.0),
-                                              static_cast <float> (fullFieldOuterRing->value() / 100.0));
-                focusView->filterStars();
-                focusView->updateFrame();
-
-                // Get the average HFR of the whole frame
-                currentHFR = image_data->getHFR(HFR_AVERAGE);
+                    algorithm = ALGORITHM_CENTROID;
             }
-            else
+            // If star is not selected yet, search the whole frame
+            else if (starSelected == false)
             {
-                // If star is already selected then use whatever algorithm currently selected.
-                if (starSelected)
-                {
-                    focusView->findStars(focusDetection);
-                    focusView->updateFrame();
-                    currentHFR = image_data->getHFR(HFR_MAX);
-                }
-                else
-                {
-                    // Disable tracking box
-                    focusView->setTrackingBoxEnabled(false);
-
-                    // If algorithm is set something other than Centeroid or SEP, then force Centroid
-                    // Since it is the most reliable detector when nothing was selected before.
-                    if (focusDetection != ALGORITHM_CENTROID && focusDetection != ALGORITHM_SEP)
-                        focusView->findStars(ALGORITHM_CENTROID);
-                    else
-                        // Otherwise, continue to find use using the selected algorithm
-                        focusView->findStars(focusDetection);
+                // Disable tracking box until the stars are found
+                focusView->setTrackingBoxEnabled(false);
+                restoreTrackingBox = true;
 
-                    // Reenable tracking box
-                    focusView->setTrackingBoxEnabled(true);
+                // If algorithm is set something other than Centeroid or SEP, then force Centroid
+                // Since it is the most reliable detector when nothing was selected before.
+                if (focusDetection != ALGORITHM_CENTROID && focusDetection != ALGORITHM_SEP)
+                    algorithm = ALGORITHM_CENTROID;
+            }
 
-                    focusView->updateFrame();
+            // Same search area as FITSView::findStars()
+            if (focusView->isTrackingBoxEnabled())
+                searchBox = focusView->getTrackingBox();
 
-                    // Get maximum HFR in the frame
-                    currentHFR = image_data->getHFR(HFR_MAX);
-                }
-            }
+            starDetector.detect(image_data, algorithm, searchBox);
+            return;
         }
+    }
+
+    processHFR();
+}
+
+void Focus::setStarDetectionComplete(FITSData *data, int count)
+{
+    Q_UNUSED(count);
 
+    // Reenable tracking box
+    if (restoreTrackingBox)
+    {
+        focusView->setTrackingBoxEnabled(true);
+        restoreTrackingBox = false;
+    }
+
+    // If a new frame replaced the one being analyzed, carry on without stars
+    if (data == nullptr || data != focusView->getImageData())
+    {
+        processHFR();
+        return;
+    }
+
+    if (Options::focusUseFullField())
+    {
+        focusView->setStarFilterRange(static_cast <float> (fullFieldInnerRing->value() / 100.0),
+                                      static_cast <float> (fullFieldOuterRing->value() / 100.0));
+        focusView->filterStars();
+        focusView->updateFrame();
+
+        // Get the average HFR of the whole frame
+        currentHFR = data->getHFR(HFR_AVERAGE);
+    }
+    else
+    {
+        focusView->updateFrame();
+
+        // Get maximum HFR in the frame
+        currentHFR = data->getHFR(HFR_MAX);
+    }
+
+    processHFR();
+}
+
+void Focus::processHFR()
+{
+    // Get Binning
+    ISD::CCDChip *targetChip = currentCCD->getChip(ISD::CCDChip::PRIMARY_CCD);
+    int subBinX = 1, subBinY = 1;
+    targetChip->getBinning(&subBinX, &subBinY);
+
+    FITSData *image_data = focusView->getImageData();
+
+    if (inFocusLoop == false || (inFocusLoop && (focusView->isTrackingBoxEnabled() || Options::focusUseFullField())))
+    {
         // Let's now report the current HFR
         qCDebug(KSTARS_EKOS_FOCUS) << "Focus newFITS #" << HFRFrames.count() + 1 << ": Current HFR " << currentHFR << " Num stars " << (starSelected ? 1 : image_data->getDetectedStars());
         // Add it to existing frames in case we need to take an average
@@ -3667,6 +3707,7 @@ void Focus::initView()
     vlayout->addWidget(focusView);
     focusingWidget->setLayout(vlayout);
     connect(focusView, &FITSView::trackingStarSelected, this, &Ekos::Focus::focusStarSelected, Qt::UniqueConnection);
+    connect(&starDetector, &FITSStarDetector::finished, this, &Ekos::Focus::setStarDetectionComplete);
     focusView->setStarsEnabled(true);
     focusView->setStarsHFREnabled(true);
 }
@@ -12,6 +12,7 @@
 #include "ui_focus.h"
 #include "ekos/ekos.h"
 #include "ekos/auxiliary/filtermanager.h"
+#include "fitsviewer/fitsstardetector.h"
 #include "fitsviewer/fitsviewer.h"
 #include "indi/indiccd.h"
 #include "indi/indifocuser.h"
@@ -353,6 +354,11 @@ class Focus : public QWidget, public Ui::Focus
 
         void setCaptureComplete();
 
+        /**
+         * @brief setStarDetectionComplete Measure the HFR of the stars found by starDetector in the background.
+         */
+        void setStarDetectionComplete(FITSData *data, int count);
+
         void showFITSViewer();
 
         void toggleFocusingWidgetFullScreen();
@@ -436,6 +442,11 @@ class Focus : public QWidget, public Ui::Focus
          */
         void syncTrackingBoxPosition();
 
+        /**
+         * @brief processHFR Use currentHFR of the last image, once its stars are measured.
+         */
+        void processHFR();
+
         /// Focuser device needed for focus operation
         ISD::Focuser *currentFocuser { nullptr };
         /// CCD device needed for focus operation
@@ -590,6 +601,11 @@ class Focus : public QWidget, public Ui::Focus
         /// Focus Frame
         FITSView *focusView { nullptr };
 
+        /// Finds the stars of the focus frame without blocking the interface
+        FITSStarDetector starDetector;
+        /// Whether the last search kept the tracking box disabled, to restore it once done
+        bool restoreTrackingBox { false };
+
         /// Star Select Timer
         QTimer waitStarSelectTimer;
 
@@ -98,11 +98,6 @@ cgmath::~cgmath()
 {
     delete[] drift[GUIDE_RA];
     delete[] drift[GUIDE_DEC];
-
-    foreach (float *region, referenceRegions)
-        delete[] region;
-
-    referenceRegions.clear();
 }
 
 bool cgmath::setVideoParameters(int vid_wd, int vid_ht, int binX, int binY)
@@ -528,12 +523,15 @@ void cgmath::start(void)
     // Create reference Image
     if (imageGuideEnabled)
     {
-        foreach (float *region, referenceRegions)
-            delete[] region;
-
         referenceRegions.clear();
 
-        referenceRegions = partitionImage();
+        // The reference spectra are computed once for the whole guiding session
+        for (float *region : partitionImage())
+        {
+            referenceRegions.emplace_back(new ImageAutoGuiding::PhaseCorrelator(regionAxis));
+            referenceRegions.back()->setReference(region);
+            delete[] region;
+        }
 
         reticle_pos = Vector(0, 0, 0);
     }
@@ -564,93 +562,18 @@ void cgmath::setLostStar(bool is_lost)
     lost_star = is_lost;
 }
 
-float *cgmath::createFloatImage(FITSData *target) const
+QVector<float> cgmath::createFloatImage(FITSData *target) const
 {
     FITSData *imageData = target;
     if (imageData == nullptr)
         imageData = guideView->getImageData();
 
-    // #1 Convert to float array
     // We only process 1st plane if it is a color image
-    uint32_t imgSize = imageData->width() * imageData->height();
-    float *imgFloat  = new float[imgSize];
-
-    if (imgFloat == nullptr)
-    {
-        qCritical() << "Not enough memory for float image array!";
-        return nullptr;
-    }
-
-    switch (imageData->property("dataType").toInt())
-    {
-        case TBYTE:
-        {
-            uint8_t *buffer = imageData->getImageBuffer();
-            for (uint32_t i = 0; i < imgSize; i++)
-                imgFloat[i] = buffer[i];
-        }
-        break;
-
-        case TSHORT:
-        {
-            int16_t *buffer = reinterpret_cast<int16_t *>(imageData->getImageBuffer());
-            for (uint32_t i = 0; i < imgSize; i++)
-                imgFloat[i] = buffer[i];
-        }
-        break;
-
-        case TUSHORT:
-        {
-            uint16_t *buffer = reinterpret_cast<uint16_t *>(imageData->getImageBuffer());
-            for (uint32_t i = 0; i < imgSize; i++)
-                imgFloat[i] = buffer[i];
-        }
-        break;
-
-        case TLONG:
-        {
-            int32_t *buffer = reinterpret_cast<int32_t *>(imageData->getImageBuffer());
-            for (uint32_t i = 0; i < imgSize; i++)
-                imgFloat[i] = buffer[i];
-        }
-        break;
-
-        case TULONG:
-        {
-            uint32_t *buffer = reinterpret_cast<uint32_t *>(imageData->getImageBuffer());
-            for (uint32_t i = 0; i < imgSize; i++)
-                imgFloat[i] = buffer[i];
-        }
-        break;
-
-        case TFLOAT:
-        {
-            float *buffer = reinterpret_cast<float *>(imageData->getImageBuffer());
-            for (uint32_t i = 0; i < imgSize; i++)
-                imgFloat[i] = buffer[i];
-        }
-        break;
+    // The conversion is done once per frame, and reused by star detection
+    QVector<float> imgFloat = imageData->getFloatPlane();
 
-        case TLONGLONG:
-        {
-            int64_t *buffer = reinterpret_cast<int64_t *>(imageData->getImageBuffer());
-            for (uint32_t i = 0; i < imgSize; i++)
-                imgFloat[i] = buffer[i];
-        }
-        break;
-
-        case TDOUBLE:
-        {
-            double *buffer = reinterpret_cast<double *>(imageData->getImageBuffer());
-            for (uint32_t i = 0; i < imgSize; i++)
-                imgFloat[i] = buffer[i];
-        }
-        break;
-
-        default:
-            delete[] imgFloat;
-            return nullptr;
-    }
+    if (imgFloat.isEmpty())
+        qCritical() << "Failed to create float image array!";
 
     return imgFloat;
 }
@@ -661,9 +584,9 @@ QVector<float *> cgmath::partitionImage() const
 
     FITSData *imageData = guideView->getImageData();
 
-    float *imgFloat = createFloatImage();
+    QVector<float> const imgFloat = createFloatImage();
 
-    if (imgFloat == nullptr)
+    if (imgFloat.isEmpty())
         return regions;
 
     const uint16_t width  = imageData->width();
@@ -674,7 +597,7 @@ QVector<float *> cgmath::partitionImage() const
     // Find number of regions to divide the image
     //uint8_t regions =  xRegions * yRegions;
 
-    float *regionPtr = imgFloat;
+    const float *regionPtr = imgFloat.constData();
 
     for (uint8_t i = 0; i < yRegions; i++)
     {
@@ -683,12 +606,13 @@ QVector<float *> cgmath::partitionImage() const
             // Allocate space for one region
             float *oneRegion = new float[regionAxis * regionAxis];
             // Create points to region and current location of the source image in the desired region
-            float *oneRegionPtr = oneRegion, *imgFloatPtr = regionPtr + j * regionAxis;
+            float *oneRegionPtr = oneRegion;
+            const float *imgFloatPtr = regionPtr + j * regionAxis;
 
             // copy from image to region line by line
             for (uint32_t line = 0; line < regionAxis; line++)
             {
-                memcpy(oneRegionPtr, imgFloatPtr, regionAxis);
+                memcpy(oneRegionPtr, imgFloatPtr, regionAxis * sizeof(float));
                 oneRegionPtr += regionAxis;
                 imgFloatPtr += width;
             }
@@ -700,9 +624,6 @@ QVector<float *> cgmath::partitionImage() const
         regionPtr += width * regionAxis;
     }
 
-    // We're done with imgFloat
-    delete[] imgFloat;
-
     return regions;
 }
 
@@ -735,9 +656,9 @@ Vector cgmath::findLocalStarPosition(void) const
             return Vector(-1, -1, -1);
         }
 
-        if (imagePartition.count() != referenceRegions.count())
+        if (static_cast<size_t>(imagePartition.count()) != referenceRegions.size())
         {
-            qWarning() << "Mismatch between reference regions #" << referenceRegions.count()
+            qWarning() << "Mismatch between reference regions #" << referenceRegions.size()
                        << "and image partition regions #" << imagePartition.count();
             // Clear memory in case of mis-match
             foreach (float *region, imagePartition)
@@ -750,7 +671,7 @@ Vector cgmath::findLocalStarPosition(void) const
 
         for (uint8_t i = 0; i < imagePartition.count(); i++)
         {
-            ImageAutoGuiding::ImageAutoGuiding1(referenceRegions[i], imagePartition[i], regionAxis, &xshift, &yshift);
+            referenceRegions[i]->shift(imagePartition[i], &xshift, &yshift);
             Vector shift(xshift, yshift, -1);
             qCDebug(KSTARS_EKOS_GUIDE) << "Region #" << i << ": X-Shift=" << xshift << "Y-Shift=" << yshift;
 
@@ -766,11 +687,11 @@ Vector cgmath::findLocalStarPosition(void) const
         }
         imagePartition.clear();
 
-        float average_x = xsum / referenceRegions.count();
-        float average_y = ysum / referenceRegions.count();
+        float average_x = xsum / referenceRegions.size();
+        float average_y = ysum / referenceRegions.size();
 
-        float median_x = shifts[referenceRegions.count() / 2 - 1].x;
-        float median_y = shifts[referenceRegions.count() / 2 - 1].y;
+        float median_x = shifts[referenceRegions.size() / 2 - 1].x;
+        float median_y = shifts[referenceRegions.size() / 2 - 1].y;
 
         qCDebug(KSTARS_EKOS_GUIDE) << "Average : X-Shift=" << average_x << "Y-Shift=" << average_y;
         qCDebug(KSTARS_EKOS_GUIDE) << "Median  : X-Shift=" << median_x << "Y-Shift=" << median_y;
@@ -1582,17 +1503,13 @@ QList<Edge*> cgmath::PSFAutoFind(int extraEdgeAllowance)
     int subH = smoothed->height();
     int size = subW * subH;
 
-    // convert to floating point
-    float *conv = createFloatImage(smoothed);
-
-    // run the PSF convolution
+    // run the PSF convolution on the floating point image
+    float *conv = new float[size];
     {
-        float *tmp = new float[size];
-        memset(tmp, 0, size * sizeof(float));
-        psf_conv(tmp, conv, subW, subH);
-        delete [] conv;
-        // Swap
-        conv = tmp;
+        QVector<float> const smoothedFloat = createFloatImage(smoothed);
+        memset(conv, 0, size * sizeof(float));
+        if (smoothedFloat.size() == size)
+            psf_conv(conv, smoothedFloat.constData(), subW, subH);
     }
 
     enum { CONV_RADIUS = 4 };
@@ -13,6 +13,7 @@
 
 #include "matr.h"
 #include "vect.h"
+#include "imageautoguiding.h"
 #include "indi/indicommon.h"
 
 #include <QObject>
@@ -22,6 +23,8 @@
 #include <QFile>
 
 #include <cstdint>
+#include <memory>
+#include <vector>
 #include <sys/types.h>
 
 class FITSView;
@@ -180,8 +183,8 @@ class cgmath : public QObject
     template <typename T>
     Vector findLocalStarPosition(void) const;
 
-    // Creates a new float image from the guideView image data. The returned image MUST be deleted later or memory will leak.
-    float *createFloatImage(FITSData *target=nullptr) const;
+    // Float image of the guideView image data, shared with the other users of the same frame.
+    QVector<float> createFloatImage(FITSData *target=nullptr) const;
 
     void do_ticks(void);
     Vector point2arcsec(const Vector &p) const;
@@ -249,7 +252,8 @@ class cgmath : public QObject
     // the newly allocated square images. It MUST be deleted later by delete[] or memory will leak.
     QVector<float *> partitionImage() const;
     uint32_t regionAxis { 64 };
-    QVector<float *> referenceRegions;
+    // One correlator per region, holding the spectrum of the reference region
+    std::vector<std::unique_ptr<ImageAutoGuiding::PhaseCorrelator>> referenceRegions;
 
     // dithering
     double ditherRate[2];
@@ -11,448 +11,287 @@
 
 #include <qglobal.h>
 
+#include <algorithm>
 #include <cmath>
-
-#define SWAP(a, b) \
-    tempr = (a);   \
-    (a)   = (b);   \
-    (b)   = tempr
-#define NR_END   1
-#define FREE_ARG char *
+#include <map>
+#include <mutex>
 
 #define TWOPI   6.28318530717959
 #define FFITMAX 0.05
 
-//void ImageAutoGuiding1(float *ref,float *im,int n,float *xshift,float *yshift);
-
-float ***f3tensorSP(long nrl, long nrh, long ncl, long nch, long ndl, long ndh);
-void free_f3tensorSP(float ***t, long nrl, long nrh, long ncl, long nch, long ndl, long ndh);
-
-float **matrixSP(long nrl, long nrh, long ncl, long nch);
-
-void free_matrixSP(float **m, long nrl, long nrh, long ncl, long nch);
-void nrerrorNR(void);
-
-void fournNR(float data[], unsigned long nn[], long ndim, long isign);
-
-void rlft3NR(float ***data, float **speq, unsigned long nn1, unsigned long nn2, unsigned long nn3, long isign);
-
-void ShiftEST(float ***testimage, float ***refimage, int n, float *xshift, float *yshift, int k);
-
 namespace ImageAutoGuiding
 {
-void ImageAutoGuiding1(float *ref, float *im, int n, float *xshift, float *yshift)
+namespace
 {
-    float ***RefImage, ***TestImage;
-    int i, j, k;
-    float x, y;
-
-    /* Allocate memory */
-
-    RefImage  = f3tensorSP(1, 1, 1, n, 1, n);
-    TestImage = f3tensorSP(1, 1, 1, n, 1, n);
-
-    /* Load Data */
-
-    k = 0;
-
-    for (j = 1; j <= n; ++j)
-    {
-        for (i = 1; i <= n; ++i)
-        {
-            RefImage[1][j][i]  = ref[k];
-            TestImage[1][j][i] = im[k];
-
-            k += 1;
-        }
-    }
-
-    /* Calculate Image Shifts  */
-
-    ShiftEST(TestImage, RefImage, n, &x, &y, 1);
+typedef FFTPlan::Complex Complex;
 
-    *xshift = x;
-    *yshift = y;
-
-    /* free memory */
+// std::complex multiplication checks for infinities and NaN, which keeps it from being inlined
+inline Complex multiply(const Complex &a, const Complex &b)
+{
+    return Complex(a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real());
+}
 
-    free_f3tensorSP(RefImage, 1, 1, 1, n, 1, n);
-    free_f3tensorSP(TestImage, 1, 1, 1, n, 1, n);
+inline Complex multiplyConjugate(const Complex &a, const Complex &b)
+{
+    // conj(a) * b
+    return Complex(a.real() * b.real() + a.imag() * b.imag(), a.real() * b.imag() - a.imag() * b.real());
 }
 }
 
-// Calculates Image Shifts
-
-void ShiftEST(float ***testimage, float ***refimage, int n, float *xshift, float *yshift, int k)
+std::shared_ptr<const FFTPlan> FFTPlan::get(int n)
 {
-    int ix, iy, nh, nhplusone;
-    double deltax, deltay, fx2sum, fy2sum, phifxsum, phifysum, fxfysum;
-    double fx, fy, ff, fn, re, im, testre, testim, rev, imv, phi;
-    double power, dem, f2, f2limit;
-    float **speq;
+    static std::mutex mutex;
+    static std::map<int, std::shared_ptr<const FFTPlan>> plans;
 
-    f2limit = FFITMAX * FFITMAX;
+    std::lock_guard<std::mutex> lock(mutex);
 
-    speq = matrixSP(1, 1, 1, 2 * n);
+    std::shared_ptr<const FFTPlan> &plan = plans[n];
+    if (!plan)
+        plan = std::make_shared<const FFTPlan>(n);
 
-    nh        = n / 2;
-    nhplusone = nh + 1;
+    return plan;
+}
 
-    fn = ((float)n);
-    ff = 1.0 / fn;
+FFTPlan::FFTPlan(int n) : m_Size(n), m_BitReverse(n), m_Twiddles(n / 2), m_InverseTwiddles(n / 2)
+{
+    Q_ASSERT(n >= 2 && (n & (n - 1)) == 0);
 
-    /* FFT of Reference */
+    int bits = 0;
+    while ((1 << bits) < n)
+        bits++;
 
-    for (ix = 1; ix <= 2 * n; ++ix)
+    for (int i = 0; i < n; i++)
     {
-        speq[1][ix] = 0.0;
+        int reversed = 0;
+        for (int b = 0; b < bits; b++)
+            reversed |= ((i >> b) & 1) << (bits - 1 - b);
+        m_BitReverse[i] = reversed;
     }
 
-    rlft3NR(refimage, speq, 1, n, n, 1);
-
-    /* FFT of Test Image */
-
-    for (ix = 1; ix <= 2 * n; ++ix)
+    for (int k = 0; k < n / 2; k++)
     {
-        speq[1][ix] = 0.0;
+        double const theta = -TWOPI * k / n;
+        m_Twiddles[k]        = Complex(std::cos(theta), std::sin(theta));
+        m_InverseTwiddles[k] = std::conj(m_Twiddles[k]);
     }
+}
 
-    rlft3NR(testimage, speq, 1, n, n, 1);
+void FFTPlan::transform(Complex *data, bool inverse) const
+{
+    int const n = m_Size;
+    const Complex *twiddles = inverse ? m_InverseTwiddles.data() : m_Twiddles.data();
 
-    /* Solving for slopes  */
+    for (int i = 0; i < n; i++)
+    {
+        int const j = m_BitReverse[i];
+        if (i < j)
+            std::swap(data[i], data[j]);
+    }
 
-    fx2sum = 0.0;
-    fy2sum = 0.0;
+    for (int length = 2; length <= n; length <<= 1)
+    {
+        int const half = length >> 1;
+        int const step = n / length;
 
-    phifxsum = 0.0;
-    phifysum = 0.0;
+        for (int start = 0; start < n; start += length)
+        {
+            Complex *even = data + start;
+            Complex *odd  = even + half;
 
-    fxfysum = 0.0;
+            for (int k = 0; k < half; k++)
+            {
+                Complex const t = multiply(twiddles[k * step], odd[k]);
+                odd[k]  = even[k] - t;
+                even[k] = even[k] + t;
+            }
+        }
+    }
+}
 
-    for (ix = 1; ix <= n; ++ix)
+PhaseCorrelator::PhaseCorrelator(int n)
+    : m_Size(n), m_Half(n / 2 + 1), m_Plan(FFTPlan::get(n)), m_Window(n),
+      m_ReferenceSpectrum(static_cast<size_t>(n) * (n / 2 + 1)), m_Spectrum(m_ReferenceSpectrum.size()),
+      m_Correlation(m_ReferenceSpectrum.size()), m_Line(n), m_Surface(static_cast<size_t>(n) * n)
+{
+    // Tukey window: flat, with cosine tapers over the outer eighths
+    int const taper = std::max(1, n / 8);
+    for (int i = 0; i < n; i++)
     {
-        if (ix <= nhplusone)
-        {
-            fx = ff * ((float)(ix - 1));
-        }
-        else
-        {
-            fx = -ff * ((float)(n + 1 - ix));
-        }
+        int const edge = std::min(i, n - 1 - i);
+        m_Window[i] = (edge >= taper) ? 1.0f : static_cast<float>(0.5 * (1 - std::cos(M_PI * (edge + 0.5) / taper)));
+    }
+}
 
-        for (iy = 1; iy <= nh; ++iy)
-        {
-            fy = ff * ((float)(iy - 1));
+void PhaseCorrelator::setReference(const float *ref)
+{
+    forward(ref, m_ReferenceSpectrum.data());
+}
 
-            f2 = fx * fx + fy * fy;
+void PhaseCorrelator::forward(const float *image, Complex *spectrum)
+{
+    int const n = m_Size;
+    Complex *line = m_Line.data();
 
-            /* Limit to Low Spatial Frequencies */
+    // A pedestal would correlate with itself at no shift
+    double sum = 0;
+    for (size_t i = 0; i < m_Surface.size(); i++)
+        sum += image[i];
+    float const mean = sum / m_Surface.size();
 
-            if (f2 < f2limit)
-            {
-                /* Real part reference image */
+    // Two real rows are transformed at once as the real and imaginary parts of a complex row
+    for (int row = 0; row < n; row += 2)
+    {
+        const float *a = image + static_cast<size_t>(row) * n;
+        const float *b = a + n;
+        float const wa = m_Window[row], wb = m_Window[row + 1];
 
-                re = refimage[k][ix][2 * iy - 1];
+        for (int x = 0; x < n; x++)
+            line[x] = Complex((a[x] - mean) * wa * m_Window[x], (b[x] - mean) * wb * m_Window[x]);
 
-                /* Imaginary part reference image */
+        m_Plan->transform(line, false);
 
-                im = refimage[k][ix][2 * iy];
+        Complex *spectrumA = spectrum + static_cast<size_t>(row) * m_Half;
+        Complex *spectrumB = spectrumA + m_Half;
+        for (int k = 0; k < m_Half; k++)
+        {
+            Complex const z  = line[k];
+            Complex const zc = std::conj(line[(n - k) & (n - 1)]);
+            Complex const d  = z - zc;
+            spectrumA[k] = (z + zc) * 0.5f;
+            spectrumB[k] = Complex(d.imag() * 0.5f, -d.real() * 0.5f);
+        }
+    }
 
-                power = re * re + im * im;
+    transformColumns(spectrum, false);
+}
 
-                /* Real part test image */
+void PhaseCorrelator::inverse(Complex *spectrum, float *image)
+{
+    int const n = m_Size;
+    Complex *line = m_Line.data();
 
-                testre = testimage[k][ix][2 * iy - 1];
+    transformColumns(spectrum, true);
 
-                /* Imaginary part image */
+    // The rows are the spectra of real rows, so two of them are restored at once
+    for (int row = 0; row < n; row += 2)
+    {
+        const Complex *p = spectrum + static_cast<size_t>(row) * m_Half;
+        const Complex *q = p + m_Half;
 
-                testim = testimage[k][ix][2 * iy];
+        for (int k = 0; k < m_Half; k++)
+            line[k] = Complex(p[k].real() - q[k].imag(), p[k].imag() + q[k].real());
+        for (int k = m_Half; k < n; k++)
+            line[k] = Complex(p[n - k].real() + q[n - k].imag(), q[n - k].real() - p[n - k].imag());
 
-                rev = re * testre + im * testim;
-                imv = re * testim - im * testre;
+        m_Plan->transform(line, true);
 
-                /* Find Phase */
+        float *a = image + static_cast<size_t>(row) * n;
+        float *b = a + n;
+        for (int x = 0; x < n; x++)
+        {
+            a[x] = line[x].real();
+            b[x] = line[x].imag();
+        }
+    }
+}
 
-                phi = atan2(imv, rev);
+void PhaseCorrelator::transformColumns(Complex *spectrum, bool inverse)
+{
+    int const n = m_Size;
+    Complex *line = m_Line.data();
 
-                fx2sum += power * fx * fx;
-                fy2sum += power * fy * fy;
+    for (int column = 0; column < m_Half; column++)
+    {
+        for (int row = 0; row < n; row++)
+            line[row] = spectrum[static_cast<size_t>(row) * m_Half + column];
 
-                phifxsum += power * fx * phi;
-                phifysum += power * fy * phi;
+        m_Plan->transform(line, inverse);
 
-                fxfysum += power * fx * fy;
-            }
-        }
+        for (int row = 0; row < n; row++)
+            spectrum[static_cast<size_t>(row) * m_Half + column] = line[row];
     }
+}
 
-    /* calculate subpixel shift */
+void PhaseCorrelator::shift(const float *im, float *xshift, float *yshift)
+{
+    int const n = m_Size;
 
-    dem = fx2sum * fy2sum - fxfysum * fxfysum;
+    forward(im, m_Spectrum.data());
 
-    deltax = (phifxsum * fy2sum - fxfysum * phifysum) / (dem * TWOPI);
-    deltay = (phifysum * fx2sum - fxfysum * phifxsum) / (dem * TWOPI);
+    // Cross power spectrum, and its phase only for the correlation surface
+    for (size_t i = 0; i < m_Spectrum.size(); i++)
+    {
+        Complex const cross = multiplyConjugate(m_ReferenceSpectrum[i], m_Spectrum[i]);
+        float const magnitude = std::sqrt(cross.real() * cross.real() + cross.imag() * cross.imag());
 
-    free_matrixSP(speq, 1, 1, 1, 2 * n);
+        m_Spectrum[i]    = cross;
+        m_Correlation[i] = (magnitude > 0) ? cross / magnitude : Complex(0, 0);
+    }
 
-    /* You can change the shift mapping here */
+    inverse(m_Correlation.data(), m_Surface.data());
 
-    *xshift = deltax;
-    *yshift = deltay;
-}
+    // Integer shift, the peak of the correlation surface
+    int const peak = std::max_element(m_Surface.begin(), m_Surface.end()) - m_Surface.begin();
+    int peakX = peak % n;
+    int peakY = peak / n;
+    if (peakX > n / 2)
+        peakX -= n;
+    if (peakY > n / 2)
+        peakY -= n;
 
-// 2 and 3 Dimensional FFT Routine for Real Data
-// Numerical Recipes in C Second Edition
-// The Art of Scientific Computing
-// 1999
+    // Sub-pixel shift, from the slope of the phase left once the integer shift is removed.
+    // Only low spatial frequencies are used, weighted by the power of the reference.
+    double fx2sum = 0, fy2sum = 0, fxfysum = 0, phifxsum = 0, phifysum = 0;
+    double const f2limit = FFITMAX * FFITMAX;
+    double const ff      = 1.0 / n;
 
-void rlft3NR(float ***data, float **speq, unsigned long nn1, unsigned long nn2, unsigned long nn3, long isign)
-{
-    void fournNR(float data[], unsigned long nn[], long ndim, long isign);
-    void nrerror();
-    unsigned long i1, i2, i3, j1, j2, j3, nn[4], ii3;
-    double theta, wpi, wpr, wtemp;
-    float c1, c2, h1r, h1i, h2r, h2i;
-    float wi, wr;
-
-    if ((unsigned long)(1 + &data[nn1][nn2][nn3] - &data[1][1][1]) != nn1 * nn2 * nn3)
-        nrerrorNR();
-    c1    = 0.5;
-    c2    = -0.5 * isign;
-    theta = isign * (6.28318530717959 / nn3);
-    wtemp = sin(0.5 * theta);
-    wpr   = -2.0 * wtemp * wtemp;
-    wpi   = sin(theta);
-    nn[1] = nn1;
-    nn[2] = nn2;
-    nn[3] = nn3 >> 1;
-    if (isign == 1)
+    for (int ky = 0; ky < n; ky++)
     {
-        fournNR(&data[1][1][1] - 1, nn, 3, isign);
-        for (i1 = 1; i1 <= nn1; i1++)
-            for (i2 = 1, j2 = 0; i2 <= nn2; i2++)
-            {
-                speq[i1][++j2] = data[i1][i2][1];
-                speq[i1][++j2] = data[i1][i2][2];
-            }
-    }
-    for (i1 = 1; i1 <= nn1; i1++)
-    {
-        j1 = (i1 != 1 ? nn1 - i1 + 2 : 1);
-        wr = 1.0;
-        wi = 0.0;
-        for (ii3 = 1, i3 = 1; i3 <= (nn3 >> 2) + 1; i3++, ii3 += 2)
+        double const fy = ff * ((ky <= n / 2) ? ky : ky - n);
+        if (fy * fy >= f2limit)
+            continue;
+
+        for (int kx = 0; kx < m_Half; kx++)
         {
-            for (i2 = 1; i2 <= nn2; i2++)
-            {
-                if (i3 == 1)
-                {
-                    j2               = (i2 != 1 ? ((nn2 - i2) << 1) + 3 : 1);
-                    h1r              = c1 * (data[i1][i2][1] + speq[j1][j2]);
-                    h1i              = c1 * (data[i1][i2][2] - speq[j1][j2 + 1]);
-                    h2i              = c2 * (data[i1][i2][1] - speq[j1][j2]);
-                    h2r              = -c2 * (data[i1][i2][2] + speq[j1][j2 + 1]);
-                    data[i1][i2][1]  = h1r + h2r;
-                    data[i1][i2][2]  = h1i + h2i;
-                    speq[j1][j2]     = h1r - h2r;
-                    speq[j1][j2 + 1] = h2i - h1i;
-                }
-                else
-                {
-                    j2                    = (i2 != 1 ? nn2 - i2 + 2 : 1);
-                    j3                    = nn3 + 3 - (i3 << 1);
-                    h1r                   = c1 * (data[i1][i2][ii3] + data[j1][j2][j3]);
-                    h1i                   = c1 * (data[i1][i2][ii3 + 1] - data[j1][j2][j3 + 1]);
-                    h2i                   = c2 * (data[i1][i2][ii3] - data[j1][j2][j3]);
-                    h2r                   = -c2 * (data[i1][i2][ii3 + 1] + data[j1][j2][j3 + 1]);
-                    data[i1][i2][ii3]     = h1r + wr * h2r - wi * h2i;
-                    data[i1][i2][ii3 + 1] = h1i + wr * h2i + wi * h2r;
-                    data[j1][j2][j3]      = h1r - wr * h2r + wi * h2i;
-                    data[j1][j2][j3 + 1]  = -h1i + wr * h2i + wi * h2r;
-                }
-            }
-            wr = (wtemp = wr) * wpr - wi * wpi + wr;
-            wi = wi * wpr + wtemp * wpi + wi;
+            double const fx = ff * kx;
+            if (fx * fx + fy * fy >= f2limit)
+                break;
+
+            size_t const i = static_cast<size_t>(ky) * m_Half + kx;
+            double const power = std::norm(m_ReferenceSpectrum[i]);
+
+            double const angle = TWOPI * (fx * peakX + fy * peakY);
+            Complex const residual = multiply(m_Spectrum[i], Complex(std::cos(angle), std::sin(angle)));
+            double const phi = std::atan2(residual.imag(), residual.real());
+
+            fx2sum += power * fx * fx;
+            fy2sum += power * fy * fy;
+            fxfysum += power * fx * fy;
+            phifxsum += power * fx * phi;
+            phifysum += power * fy * phi;
         }
     }
-    if (isign == -1)
-        fournNR(&data[1][1][1] - 1, nn, 3, isign);
-}
-
-// Multi-Dimensional FFT Routine for Complex Data
-// Numerical Recipes in C Second Edition
-// The Art of Scientific Computing
-// 1999
-// Used in rlft3
 
-void fournNR(float data[], unsigned long nn[], long ndim, long isign)
-{
-    long idim;
-    unsigned long i1, i2rev, i3rev, ip1, ip2, ip3, ifp1, ifp2;
-    unsigned long i2, i3;
-    unsigned long ibit, k1 = 0, k2, n, nprev, nrem, ntot;
-    float wi, wr, tempi, tempr;
-    double theta, wpi, wpr, wtemp;
-
-    for (ntot = 1, idim = 1; idim <= ndim; idim++)
-        ntot *= nn[idim];
-    nprev = 1;
-    for (idim = ndim; idim >= 1; idim--)
+    double deltax = peakX, deltay = peakY;
+    double const dem = fx2sum * fy2sum - fxfysum * fxfysum;
+    if (dem > 0)
     {
-        n     = nn[idim];
-        nrem  = ntot / (n * nprev);
-        ip1   = nprev << 1;
-        ip2   = ip1 * n;
-        ip3   = ip2 * nrem;
-        i2rev = 1;
-        for (i2 = 1; i2 <= ip2; i2 += ip1)
-        {
-            if (i2 < i2rev)
-            {
-                for (i1 = i2; i1 <= i2 + ip1 - 2; i1 += 2)
-                {
-                    for (i3 = i1; i3 <= ip3; i3 += ip2)
-                    {
-                        i3rev = i2rev + i3 - i2;
-                        SWAP(data[i3], data[i3rev]);
-                        SWAP(data[i3 + 1], data[i3rev + 1]);
-                    }
-                }
-            }
-            ibit = ip2 >> 1;
-            while (ibit >= ip1 && i2rev > ibit)
-            {
-                i2rev -= ibit;
-                ibit >>= 1;
-            }
-            i2rev += ibit;
-        }
-        ifp1 = ip1;
-        while (ifp1 < ip2)
-        {
-            ifp2  = ifp1 << 1;
-            theta = isign * 6.28318530717959 / (ifp2 / ip1);
-            wtemp = sin(0.5 * theta);
-            wpr   = -2.0 * wtemp * wtemp;
-            wpi   = sin(theta);
-            wr    = 1.0;
-            wi    = 0.0;
-            for (i3 = 1; i3 <= ifp1; i3 += ip1)
-            {
-                for (i1 = i3; i1 <= i3 + ip1 - 2; i1 += 2)
-                {
-                    for (i2 = i1; i2 <= ip3; i2 += ifp2)
-                    {
-                        k1           = i2;
-                        k2           = k1 + ifp1;
-                        tempr        = (double)wr * data[k2] - (double)wi * data[k2 + 1];
-                        tempi        = (double)wr * data[k2 + 1] + (double)wi * data[k2];
-                        data[k2]     = data[k1] - tempr;
-                        data[k2 + 1] = data[k1 + 1] - tempi;
-                        data[k1] += tempr;
-                        data[k1 + 1] += tempi;
-                    }
-                }
-                wr = (wtemp = wr) * wpr - wi * wpi + wr;
-                wi = wi * wpr + wtemp * wpi + wi;
-            }
-            ifp1 = ifp2;
-        }
-        nprev *= n;
+        // The phase of a shift d is -2 pi f.d
+        deltax -= (phifxsum * fy2sum - fxfysum * phifysum) / (dem * TWOPI);
+        deltay -= (phifysum * fx2sum - fxfysum * phifxsum) / (dem * TWOPI);
     }
-}
 
-void nrerrorNR(void)
-{
-}
-
-// Numerical Recipes memory allocation routines
-// One based arrays
+    /* You can change the shift mapping here */
 
-float **matrixSP(long nrl, long nrh, long ncl, long nch)
-/* allocate a float matrix with subscript range m[nrl..nrh][ncl..nch] */
-{
-    long i, nrow = nrh - nrl + 1, ncol = nch - ncl + 1;
-    float **m;
-
-    /* allocate pointers to rows */
-    m = (float **)malloc((size_t)((nrow + NR_END) * sizeof(float *)));
-    if (!m)
-        nrerrorNR();
-    m += NR_END;
-    m -= nrl;
-
-    /* allocate rows and set pointers to them */
-    m[nrl] = (float *)malloc((size_t)((nrow * ncol + NR_END) * sizeof(float)));
-    if (!m[nrl])
-        nrerrorNR();
-    m[nrl] += NR_END;
-    m[nrl] -= ncl;
-
-    for (i = nrl + 1; i <= nrh; i++)
-        m[i] = m[i - 1] + ncol;
-
-    /* return pointer to array of pointers to rows */
-    return m;
+    *xshift = deltay;
+    *yshift = deltax;
 }
 
-float ***f3tensorSP(long nrl, long nrh, long ncl, long nch, long ndl, long ndh)
-/* allocate a float 3tensor with range t[nrl..nrh][ncl..nch][ndl..ndh] */
+void ImageAutoGuiding1(float *ref, float *im, int n, float *xshift, float *yshift)
 {
-    long i, j, nrow = nrh - nrl + 1, ncol = nch - ncl + 1, ndep = ndh - ndl + 1;
-    float ***t;
-
-    /* allocate pointers to pointers to rows */
-    t = (float ***)malloc((size_t)((nrow + NR_END) * sizeof(float **)));
-    if (!t)
-        nrerrorNR();
-    t += NR_END;
-    t -= nrl;
-
-    /* allocate pointers to rows and set pointers to them */
-    t[nrl] = (float **)malloc((size_t)((nrow * ncol + NR_END) * sizeof(float *)));
-    if (!t[nrl])
-        nrerrorNR();
-    t[nrl] += NR_END;
-    t[nrl] -= ncl;
-
-    /* allocate rows and set pointers to them */
-    t[nrl][ncl] = (float *)malloc((size_t)((nrow * ncol * ndep + NR_END) * sizeof(float)));
-    if (!t[nrl][ncl])
-        nrerrorNR();
-    t[nrl][ncl] += NR_END;
-    t[nrl][ncl] -= ndl;
-
-    for (j = ncl + 1; j <= nch; j++)
-        t[nrl][j] = t[nrl][j - 1] + ndep;
-    for (i = nrl + 1; i <= nrh; i++)
-    {
-        t[i]      = t[i - 1] + ncol;
-        t[i][ncl] = t[i - 1][ncl] + ncol * ndep;
-        for (j = ncl + 1; j <= nch; j++)
-            t[i][j] = t[i][j - 1] + ndep;
-    }
-
-    /* return pointer to array of pointers to rows */
-    return t;
-}
+    PhaseCorrelator correlator(n);
 
-void free_matrixSP(float **m, long nrl, long nrh, long ncl, long nch)
-/* free a float matrix allocated by matrix() */
-{
-    Q_UNUSED(nrh);
-    Q_UNUSED(nch);
-    free((FREE_ARG)(m[nrl] + ncl - NR_END));
-    free((FREE_ARG)(m + nrl - NR_END));
+    correlator.setReference(ref);
+    correlator.shift(im, xshift, yshift);
 }
-
-void free_f3tensorSP(float ***t, long nrl, long nrh, long ncl, long nch, long ndl, long ndh)
-/* free a float f3tensor allocated by f3tensor() */
-{
-    Q_UNUSED(nrh);
-    Q_UNUSED(nch);
-    Q_UNUSED(ndh);
-    free((FREE_ARG)(t[nrl][ncl] + ndl - NR_END));
-    free((FREE_ARG)(t[nrl] + ncl - NR_END));
-    free((FREE_ARG)(t + nrl - NR_END));
 }
@@ -9,6 +9,10 @@
 
 #pragma once
 
+#include <complex>
+#include <memory>
+#include <vector>
+
 // Robert Majewski
 
 // ImageAutoGuiding1 is self contained
@@ -24,5 +28,97 @@
 
 namespace ImageAutoGuiding
 {
+/**
+ * @class FFTPlan
+ * @short Radix-2 complex FFT of one size, with its bit reversal and twiddle tables computed once
+ *
+ * Plans are shared by all users of the same size, see get().
+ */
+class FFTPlan
+{
+    public:
+        typedef std::complex<float> Complex;
+
+        /** @return the plan for n points, n a power of 2, created on first use */
+        static std::shared_ptr<const FFTPlan> get(int n);
+
+        explicit FFTPlan(int n);
+
+        int size() const
+        {
+            return m_Size;
+        }
+
+        /**
+         * @brief transform In-place unscaled FFT
+         * @param data size() points
+         * @param inverse false for exp(-i...) forward, true for exp(+i...) inverse
+         */
+        void transform(Complex *data, bool inverse) const;
+
+    private:
+        int m_Size;
+        std::vector<int> m_BitReverse;
+        /// exp(-2 pi i k / n) for k < n / 2, and their conjugates for the inverse transform
+        std::vector<Complex> m_Twiddles;
+        std::vector<Complex> m_InverseTwiddles;
+};
+
+/**
+ * @class PhaseCorrelator
+ * @short Measures the shift of n x n images against a reference by phase correlation
+ *
+ * The spectrum of the reference is computed once by setReference(), so each shift() costs one
+ * forward and one inverse 2D FFT. The images are mean subtracted and tapered at their borders
+ * before their transform, so that the image edges do not correlate. The integer shift is the peak
+ * of the phase correlation surface, it is then refined to a fraction of pixel by fitting the slope
+ * of the residual cross spectrum phase at low spatial frequencies.
+ *
+ * All buffers are allocated by the constructor and reused by every frame.
+ */
+class PhaseCorrelator
+{
+    public:
+        /** @param n width and height of the images, a power of 2 */
+        explicit PhaseCorrelator(int n);
+
+        int size() const
+        {
+            return m_Size;
+        }
+
+        /** Set the n x n reference image */
+        void setReference(const float *ref);
+
+        /**
+         * @brief shift Measure the shift of an n x n image against the reference
+         * @param xshift shift along the rows of the image, the axis ImageAutoGuiding1 always reported as x
+         * @param yshift shift along the columns of the image
+         */
+        void shift(const float *im, float *xshift, float *yshift);
+
+    private:
+        typedef FFTPlan::Complex Complex;
+
+        /** 2D FFT of the tapered image into n rows of n / 2 + 1 frequencies */
+        void forward(const float *image, Complex *spectrum);
+        /** Real 2D inverse FFT of n rows of n / 2 + 1 frequencies, spectrum is overwritten */
+        void inverse(Complex *spectrum, float *image);
+        /** FFT of each of the n / 2 + 1 spectrum columns */
+        void transformColumns(Complex *spectrum, bool inverse);
+
+        int m_Size;
+        /// Frequencies in a spectrum row, n / 2 + 1
+        int m_Half;
+        std::shared_ptr<const FFTPlan> m_Plan;
+        /// Separable tapering window
+        std::vector<float> m_Window;
+        std::vector<Complex> m_ReferenceSpectrum;
+        std::vector<Complex> m_Spectrum;
+        std::vector<Complex> m_Correlation;
+        std::vector<Complex> m_Line;
+        std::vector<float> m_Surface;
+};
+
 void ImageAutoGuiding1(float *ref, float *im, int n, float *xshift, float *yshift);
 }
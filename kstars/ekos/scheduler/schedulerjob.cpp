@@ -10,6 +10,7 @@
 #include "schedulerjob.h"
 
 #include "dms.h"
+#include "ephemeriscache.h"
 #include "kstarsdata.h"
 #include "skymapcomposite.h"
 #include "Options.h"
@@ -26,7 +27,6 @@
 
 SchedulerJob::SchedulerJob()
 {
-    moon = dynamic_cast<KSMoon *>(KStarsData::Instance()->skyComposite()->findByName(i18n("Moon")));
 }
 
 void SchedulerJob::setName(const QString &value)
@@ -58,7 +58,7 @@ void SchedulerJob::setStartupTime(const QDateTime &value)
         startupCondition = fileStartupCondition;
 
     // Refresh altitude - invalid date/time is taken care of when rendering
-    altitudeAtStartup = findAltitude(targetCoords, startupTime, &isSettingAtStartup);
+    altitudeAtStartup = getAltitude(startupTime, &isSettingAtStartup);
 
     /* Refresh estimated time - which update job cells */
     setEstimatedTime(estimatedTime);
@@ -96,21 +96,21 @@ void SchedulerJob::setCompletionTime(const QDateTime &value)
     {
         setCompletionCondition(FINISH_AT);
         completionTime = value;
-        altitudeAtCompletion = findAltitude(targetCoords, completionTime, &isSettingAtCompletion);
+        altitudeAtCompletion = getAltitude(completionTime, &isSettingAtCompletion);
         setEstimatedTime(-1);
     }
     /* If completion time is invalid, and job is looping, keep completion time undefined */
     else if (FINISH_LOOP == completionCondition)
     {
         completionTime = QDateTime();
-        altitudeAtCompletion = findAltitude(targetCoords, completionTime, &isSettingAtCompletion);
+        altitudeAtCompletion = getAltitude(completionTime, &isSettingAtCompletion);
         setEstimatedTime(-1);
     }
     /* If completion time is invalid, deduce completion from startup and duration */
     else if (startupTime.isValid())
     {
         completionTime = startupTime.addSecs(estimatedTime);
-        altitudeAtCompletion = findAltitude(targetCoords, completionTime, &isSettingAtCompletion);
+        altitudeAtCompletion = getAltitude(completionTime, &isSettingAtCompletion);
         updateJobCells();
     }
     /* Else just refresh estimated time - which update job cells */
@@ -344,7 +344,7 @@ void SchedulerJob::setEstimatedTime(const int64_t &value)
     {
         estimatedTime = value;
         completionTime = startupTime.addSecs(value);
-        altitudeAtCompletion = findAltitude(targetCoords, completionTime, &isSettingAtCompletion);
+        altitudeAtCompletion = getAltitude(completionTime, &isSettingAtCompletion);
     }
     /* Else estimated time is simply stored as is - covers FINISH_LOOP from setCompletionTime */
     else estimatedTime = value;
@@ -420,6 +420,7 @@ void SchedulerJob::setTargetCoords(dms &ra, dms &dec)
 {
     targetCoords.setRA0(ra);
     targetCoords.setDec0(dec);
+    visibility.invalidate();
 
     targetCoords.apparentCoord(static_cast<long double>(J2000), KStarsData::Instance()->ut().djd());
 }
@@ -538,9 +539,8 @@ void SchedulerJob::updateJobCells()
 
     if (nullptr != altitudeCell)
     {
-        // FIXME: Cache altitude calculations
         bool is_setting = false;
-        double const alt = findAltitude(targetCoords, QDateTime(), &is_setting);
+        double const alt = getAltitude(QDateTime(), &is_setting);
 
         altitudeCell->setText(QString("%1%L2°")
                               .arg(QChar(is_setting ? 0x2193 : 0x2191))
@@ -695,12 +695,12 @@ bool SchedulerJob::decreasingAltitudeOrder(SchedulerJob const *job1, SchedulerJo
 {
     bool A_is_setting = job1->isSettingAtStartup;
     double const altA = when.isValid() ?
-                        findAltitude(job1->getTargetCoords(), when, &A_is_setting) :
+                        job1->getAltitude(when, &A_is_setting) :
                         job1->altitudeAtStartup;
 
     bool B_is_setting = job2->isSettingAtStartup;
     double const altB = when.isValid() ?
-                        findAltitude(job2->getTargetCoords(), when, &B_is_setting) :
+                        job2->getAltitude(when, &B_is_setting) :
                         job2->altitudeAtStartup;
 
     // Sort with the setting target first
@@ -718,9 +718,8 @@ bool SchedulerJob::increasingStartupTimeOrder(SchedulerJob const *job1, Schedule
     return job1->getStartupTime() < job2->getStartupTime();
 }
 
-int16_t SchedulerJob::getAltitudeScore(QDateTime const &when) const
+double SchedulerJob::getAltitude(QDateTime const &when, bool *is_setting) const
 {
-    // FIXME: block calculating target coordinates at a particular time is duplicated in several places
     GeoLocation *geo = KStarsData::Instance()->geo();
 
     // Retrieve the argument date/time, or fall back to current time - don't use QDateTime's timezone!
@@ -728,20 +727,14 @@ int16_t SchedulerJob::getAltitudeScore(QDateTime const &when) const
                           Qt::UTC == when.timeSpec() ? geo->UTtoLT(KStarsDateTime(when)) : when :
                           KStarsData::Instance()->lt());
 
-    // Create a sky object with the target catalog coordinates
-    SkyPoint const target = getTargetCoords();
-    SkyObject o;
-    o.setRA0(target.ra0());
-    o.setDec0(target.dec0());
-
-    // Update RA/DEC of the target for the current fraction of the day
-    KSNumbers numbers(ltWhen.djd());
-    o.updateCoordsNow(&numbers);
+    return visibility.altitude(getTargetCoords(), geo, geo->LTtoUT(ltWhen).djd(), is_setting);
+}
 
-    // Compute local sidereal time for the current fraction of the day, calculate altitude
-    CachingDms const LST = geo->GSTtoLST(geo->LTtoUT(ltWhen).gst());
-    o.EquatorialToHorizontal(&LST, geo->lat());
-    double const altitude = o.alt().Degrees();
+int16_t SchedulerJob::getAltitudeScore(QDateTime const &when) const
+{
+    // Altitude of the target from the cached hour angle solution
+    bool isSetting = false;
+    double const altitude = getAltitude(when, &isSetting);
 
     double const SETTING_ALTITUDE_CUTOFF = Options::settingAltitudeCutoff();
     int16_t score = BAD_SCORE - 1;
@@ -759,16 +752,9 @@ int16_t SchedulerJob::getAltitudeScore(QDateTime const &when) const
             score = BAD_SCORE;
         // Else if setting and under altitude cutoff, job would end soon after starting, bad score
         // FIXME: half bad score when under altitude cutoff risk getting positive again
-        else
+        else if (isSetting && altitude - SETTING_ALTITUDE_CUTOFF < getMinAltitude())
         {
-            double offset = LST.Hours() - o.ra().Hours();
-            if (24.0 <= offset)
-                offset -= 24.0;
-            else if (offset < 0.0)
-                offset += 24.0;
-            if (0.0 <= offset && offset < 12.0)
-                if (altitude - SETTING_ALTITUDE_CUTOFF < getMinAltitude())
-                    score = BAD_SCORE / 2;
+            score = BAD_SCORE / 2;
         }
     }
     // If not constrained but below minimum hard altitude, set score to 10% of altitude value
@@ -792,7 +778,6 @@ int16_t SchedulerJob::getAltitudeScore(QDateTime const &when) const
 
 int16_t SchedulerJob::getMoonSeparationScore(QDateTime const &when) const
 {
-    // FIXME: block calculating target coordinates at a particular time is duplicated in several places
     GeoLocation *geo = KStarsData::Instance()->geo();
 
     // Retrieve the argument date/time, or fall back to current time - don't use QDateTime's timezone!
@@ -800,35 +785,22 @@ int16_t SchedulerJob::getMoonSeparationScore(QDateTime const &when) const
                           Qt::UTC == when.timeSpec() ? geo->UTtoLT(KStarsDateTime(when)) : when :
                           KStarsData::Instance()->lt());
 
-    // Create a sky object with the target catalog coordinates
-    SkyPoint const target = getTargetCoords();
-    SkyObject o;
-    o.setRA0(target.ra0());
-    o.setDec0(target.dec0());
-
-    // Update RA/DEC of the target for the current fraction of the day
-    KSNumbers numbers(ltWhen.djd());
-    o.updateCoordsNow(&numbers);
+    // Interpolate the Moon from the shared ephemeris instead of recomputing it for each job
+    double const jd = geo->LTtoUT(ltWhen).djd();
+    EphemerisCache::Sample const moon = EphemerisCache::Instance()->at(geo, jd);
 
-    // Update moon
-    //ut = geo->LTtoUT(ltWhen);
-    //KSNumbers ksnum(ut.djd()); // BUG: possibly LT.djd() != UT.djd() because of translation
-    //LST = geo->GSTtoLST(ut.gst());
-    CachingDms LST = geo->GSTtoLST(geo->LTtoUT(ltWhen).gst());
-    moon->updateCoords(&numbers, true, geo->lat(), &LST, true);
-
-    double const moonAltitude = moon->alt().Degrees();
+    double const moonAltitude = EphemerisCache::Instance()->moonAltitude(geo, jd);
 
     // Lunar illumination %
-    double const illum = moon->illum() * 100.0;
+    double const illum = moon.moonIllum() * 100.0;
 
     // Moon/Sky separation p
-    double const separation = moon->angularDistanceTo(&o).Degrees();
+    double const separation = getMoonSeparation(moon.moonRA, moon.moonDec, jd);
 
     // Zenith distance of the moon
     double const zMoon = (90 - moonAltitude);
     // Zenith distance of target
-    double const zTarget = (90 - o.alt().Degrees());
+    double const zTarget = (90 - visibility.altitude(getTargetCoords(), geo, jd));
 
     int16_t score = 0;
 
@@ -868,36 +840,30 @@ int16_t SchedulerJob::getMoonSeparationScore(QDateTime const &when) const
 
 double SchedulerJob::getCurrentMoonSeparation() const
 {
-    // FIXME: block calculating target coordinates at a particular time is duplicated in several places
     GeoLocation *geo = KStarsData::Instance()->geo();
+    double const jd  = KStarsData::Instance()->ut().djd();
 
-    // Retrieve the argument date/time, or fall back to current time - don't use QDateTime's timezone!
-    KStarsDateTime ltWhen(KStarsData::Instance()->lt());
+    // Moon/Sky separation p
+    EphemerisCache::Sample const moon = EphemerisCache::Instance()->at(geo, jd);
+    return getMoonSeparation(moon.moonRA, moon.moonDec, jd);
+}
 
-    // Create a sky object with the target catalog coordinates
+double SchedulerJob::getMoonSeparation(double moonRA, double moonDec, double jd) const
+{
+    // Update RA/DEC of the target for that time
     SkyPoint const target = getTargetCoords();
-    SkyObject o;
+    SkyPoint o;
     o.setRA0(target.ra0());
     o.setDec0(target.dec0());
-
-    // Update RA/DEC of the target for the current fraction of the day
-    KSNumbers numbers(ltWhen.djd());
+    KSNumbers numbers(jd);
     o.updateCoordsNow(&numbers);
 
-    // Update moon
-    //ut = geo->LTtoUT(ltWhen);
-    //KSNumbers ksnum(ut.djd()); // BUG: possibly LT.djd() != UT.djd() because of translation
-    //LST = geo->GSTtoLST(ut.gst());
-    CachingDms LST = geo->GSTtoLST(geo->LTtoUT(ltWhen).gst());
-    moon->updateCoords(&numbers, true, geo->lat(), &LST, true);
-
-    // Moon/Sky separation p
-    return moon->angularDistanceTo(&o).Degrees();
+    SkyPoint const moon(dms(moonRA), dms(moonDec));
+    return moon.angularDistanceTo(&o).Degrees();
 }
 
 QDateTime SchedulerJob::calculateAltitudeTime(QDateTime const &when) const
 {
-    // FIXME: block calculating target coordinates at a particular time is duplicated in several places
     GeoLocation *geo = KStarsData::Instance()->geo();
 
     // Retrieve the argument date/time, or fall back to current time - don't use QDateTime's timezone!
@@ -905,51 +871,22 @@ QDateTime SchedulerJob::calculateAltitudeTime(QDateTime const &when) const
                           Qt::UTC == when.timeSpec() ? geo->UTtoLT(KStarsDateTime(when)) : when :
                           KStarsData::Instance()->lt());
 
-    // Create a sky object with the target catalog coordinates
-    SkyPoint const target = getTargetCoords();
-    SkyObject o;
-    o.setRA0(target.ra0());
-    o.setDec0(target.dec0());
-
     // Calculate the UT at the argument time
-    KStarsDateTime const ut = geo->LTtoUT(ltWhen);
+    double const jd = geo->LTtoUT(ltWhen).djd();
 
-    double const SETTING_ALTITUDE_CUTOFF = Options::settingAltitudeCutoff();
+    TargetVisibility::Constraints constraints;
+    constraints.minAltitude       = getMinAltitude();
+    constraints.settingCutoff     = Options::settingAltitudeCutoff();
+    constraints.minMoonSeparation = getMinMoonSeparation();
 
-    // Within the next 24 hours, search when the job target matches the altitude and moon constraints
-    for (unsigned int minute = 0; minute < 24 * 60; minute++)
+    // Within the next 24 hours, find when the job target matches the altitude and moon constraints.
+    // Don't test proximity to dawn in this situation, we only cater for altitude here.
+    for (const TargetVisibility::Interval &interval : visibility.intervals(getTargetCoords(), geo, constraints, jd))
     {
-        KStarsDateTime const ltOffset(ltWhen.addSecs(minute * 60));
-
-        // Update RA/DEC of the target for the current fraction of the day
-        KSNumbers numbers(ltOffset.djd());
-        o.updateCoordsNow(&numbers);
-
-        // Compute local sidereal time for the current fraction of the day, calculate altitude
-        CachingDms const LST = geo->GSTtoLST(geo->LTtoUT(ltOffset).gst());
-        o.EquatorialToHorizontal(&LST, geo->lat());
-        double const altitude = o.alt().Degrees();
-
-        if (getMinAltitude() <= altitude)
-        {
-            // Don't test proximity to dawn in this situation, we only cater for altitude here
-
-            // Continue searching if Moon separation is not good enough
-            if (0 < getMinMoonSeparation() && getMoonSeparationScore(ltOffset) < 0)
-                continue;
-
-            // Continue searching if target is setting and under the cutoff
-            double offset = LST.Hours() - o.ra().Hours();
-            if (24.0 <= offset)
-                offset -= 24.0;
-            else if (offset < 0.0)
-                offset += 24.0;
-            if (0.0 <= offset && offset < 12.0)
-                if (altitude - SETTING_ALTITUDE_CUTOFF < getMinAltitude())
-                    continue;
-
-            return ltOffset;
-        }
+        // Stay on whole minutes from the argument time, rounding inside the interval
+        qint64 const minute = static_cast<qint64>(ceil((interval.first - jd) * 24 * 60 - 1e-6));
+        if (minute < 24 * 60 && jd + minute / (24.0 * 60) < interval.second)
+            return ltWhen.addSecs(minute * 60);
     }
 
     return QDateTime();
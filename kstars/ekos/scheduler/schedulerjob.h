@@ -10,6 +10,7 @@
 #pragma once
 
 #include "skypoint.h"
+#include "targetvisibility.h"
 
 #include <QUrl>
 #include <QMap>
@@ -433,6 +434,14 @@ class SchedulerJob
          */
     static double findAltitude(const SkyPoint &target, const QDateTime &when, bool *is_setting = nullptr, bool debug = false);
 
+    /**
+         * @brief getAltitude Find the altitude of this job's target at a specific time
+         * @param when date time to find altitude, now if omitted.
+         * @param is_setting whether target is setting at the argument time (optional).
+         * @return Altitude of the target, same as findAltitude() but from the cached visibility solution.
+         */
+    double getAltitude(QDateTime const &when = QDateTime(), bool *is_setting = nullptr) const;
+
 private:
     QString name;
     SkyPoint targetCoords;
@@ -500,6 +509,9 @@ private:
 
     QMap<QString, uint16_t> capturedFramesMap;
 
-    /// Pointer to Moon object
-    KSMoon *moon { nullptr };
+    /** @return separation in degrees between the target and the Moon at (moonRA, moonDec) at jd (UT) */
+    double getMoonSeparation(double moonRA, double moonDec, double jd) const;
+
+    /// Cached altitude and Moon separation intervals of the target
+    mutable TargetVisibility visibility;
 };
@@ -0,0 +1,267 @@
+/*  Ekos Scheduler target visibility solver
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "targetvisibility.h"
+
+#include "dms.h"
+#include "ephemeriscache.h"
+#include "geolocation.h"
+#include "ksnumbers.h"
+#include "kstarsdatetime.h"
+#include "skypoint.h"
+
+#include <cmath>
+
+namespace
+{
+/** Sidereal time advance in degrees per day of UT */
+const double SiderealRate = 360.98564736629;
+
+/** Number of bisection steps on a Moon sampling step, down to about 0.2 second */
+const int BisectionSteps = 12;
+
+/**
+ * @return the hour angle limit in degrees such that the altitude is at least alt while |H| is
+ * under it, 180 if the altitude is always high enough, negative if it never is
+ */
+double hourAngleLimit(double alt, double sinLat, double cosLat, double sinDec, double cosDec)
+{
+    double const s = sin(alt * dms::DegToRad) - sinLat * sinDec;
+    double const d = cosLat * cosDec;
+
+    // At the poles, the altitude does not change
+    if (fabs(d) < 1e-12)
+        return s <= 0 ? 180.0 : -1.0;
+
+    double const c = s / d;
+    if (c <= -1.0)
+        return 180.0;
+    if (c > 1.0)
+        return -1.0;
+    return acos(c) / dms::DegToRad;
+}
+
+/** Append [start, end[ to list, merging it with the last interval if they touch */
+void appendInterval(QList<TargetVisibility::Interval> &list, double start, double end)
+{
+    if (end <= start)
+        return;
+    if (!list.isEmpty() && list.last().second >= start)
+        list.last().second = qMax(list.last().second, end);
+    else
+        list.append(qMakePair(start, end));
+}
+}
+
+constexpr double TargetVisibility::WindowLength;
+constexpr double TargetVisibility::MoonStep;
+
+double TargetVisibility::altitude(const SkyPoint &target, const GeoLocation *geo, double jd, bool *isSetting)
+{
+    updateCoordinates(target, geo, jd, 0);
+
+    // Hour angle reduced to [-180,180[, the target is setting past the meridian
+    double H = fmod(hourAngle(jd), 360.0);
+    if (H >= 180.0)
+        H -= 360.0;
+    else if (H < -180.0)
+        H += 360.0;
+
+    if (isSetting)
+        *isSetting = H >= 0;
+
+    double sinLat, cosLat, sinDec, cosDec;
+    dms(m_Latitude).SinCos(sinLat, cosLat);
+    dms(m_Dec).SinCos(sinDec, cosDec);
+
+    double const sinAlt = sinLat * sinDec + cosLat * cosDec * cos(H * dms::DegToRad);
+    return asin(qBound(-1.0, sinAlt, 1.0)) / dms::DegToRad;
+}
+
+QList<TargetVisibility::Interval> TargetVisibility::intervals(const SkyPoint &target, const GeoLocation *geo,
+        const Constraints &constraints, double jd)
+{
+    updateCoordinates(target, geo, jd, 1.0);
+
+    if (!m_IntervalsValid || !(constraints == m_Constraints))
+    {
+        m_Constraints = constraints;
+
+        QList<Interval> const altitudes = altitudeIntervals();
+
+        if (0 < m_Constraints.minMoonSeparation && !altitudes.isEmpty())
+        {
+            // Intersect both sorted lists
+            QList<Interval> const moon = moonIntervals(geo);
+            m_Intervals.clear();
+            for (int i = 0, j = 0; i < altitudes.size() && j < moon.size();)
+            {
+                appendInterval(m_Intervals, qMax(altitudes[i].first, moon[j].first),
+                               qMin(altitudes[i].second, moon[j].second));
+                if (altitudes[i].second < moon[j].second)
+                    i++;
+                else
+                    j++;
+            }
+        }
+        else
+            m_Intervals = altitudes;
+
+        m_IntervalsValid = true;
+    }
+
+    // Clip to the requested day
+    QList<Interval> result;
+    for (const Interval &interval : m_Intervals)
+        appendInterval(result, qMax(interval.first, jd), qMin(interval.second, jd + 1.0));
+    return result;
+}
+
+void TargetVisibility::updateCoordinates(const SkyPoint &target, const GeoLocation *geo, double jd, double span)
+{
+    double const ra0 = target.ra0().Degrees(), dec0 = target.dec0().Degrees();
+    double const lat = geo->lat()->Degrees(), lng = geo->lng()->Degrees();
+
+    if (m_Valid && ra0 == m_RA0 && dec0 == m_Dec0 && lat == m_Latitude && lng == m_Longitude && m_Start <= jd &&
+            jd + span <= m_End)
+        return;
+
+    m_RA0       = ra0;
+    m_Dec0      = dec0;
+    m_Latitude  = lat;
+    m_Longitude = lng;
+    m_Start     = jd;
+    m_End       = jd + WindowLength;
+
+    // Apparent coordinates in the middle of the window, they drift by less than an arcsecond over it
+    SkyPoint p;
+    p.setRA0(target.ra0());
+    p.setDec0(target.dec0());
+    KSNumbers numbers(m_Start + WindowLength / 2);
+    p.updateCoordsNow(&numbers);
+    m_RA  = p.ra().Degrees();
+    m_Dec = p.dec().Degrees();
+
+    m_LST0 = geo->GSTtoLST(KStarsDateTime(static_cast<long double>(m_Start)).gst()).Degrees();
+
+    m_Valid          = true;
+    m_IntervalsValid = false;
+}
+
+double TargetVisibility::hourAngle(double jd) const
+{
+    return m_LST0 + SiderealRate * (jd - m_Start) - m_RA;
+}
+
+QList<TargetVisibility::Interval> TargetVisibility::altitudeIntervals() const
+{
+    QList<Interval> result;
+
+    double sinLat, cosLat, sinDec, cosDec;
+    dms(m_Latitude).SinCos(sinLat, cosLat);
+    dms(m_Dec).SinCos(sinDec, cosDec);
+
+    // Above the minimum altitude while |H| <= H0
+    double const H0 = hourAngleLimit(m_Constraints.minAltitude, sinLat, cosLat, sinDec, cosDec);
+    if (H0 < 0)
+        return result;
+
+    // Once past the meridian, above the minimum altitude plus the cutoff while H <= H1
+    double const H1 = hourAngleLimit(m_Constraints.minAltitude + m_Constraints.settingCutoff, sinLat, cosLat, sinDec,
+                                     cosDec);
+
+    // Allowed hour angles are [A, B], repeated every 360 degrees
+    double const A = -H0;
+    double const B = H1 < 0 ? 0 : qMin(H0, H1);
+
+    if (B - A >= 360.0)
+    {
+        result.append(qMakePair(m_Start, m_End));
+        return result;
+    }
+
+    double const hStart = hourAngle(m_Start);
+    double const hEnd   = hourAngle(m_End);
+
+    for (double k = floor((hStart - B) / 360.0); k <= ceil((hEnd - A) / 360.0); k += 1.0)
+    {
+        double const lo = qMax(A + 360.0 * k, hStart);
+        double const hi = qMin(B + 360.0 * k, hEnd);
+        if (lo < hi)
+            appendInterval(result, m_Start + (lo - hStart) / SiderealRate, m_Start + (hi - hStart) / SiderealRate);
+    }
+
+    return result;
+}
+
+QList<TargetVisibility::Interval> TargetVisibility::moonIntervals(const GeoLocation *geo) const
+{
+    QList<Interval> result;
+
+    // Sample on a regular grid, and refine each change of state by bisection
+    double previous    = m_Start;
+    bool wasViolated   = moonViolated(geo, previous);
+    double goodStart   = m_Start;
+    qint64 const first = static_cast<qint64>(floor(m_Start / MoonStep)) + 1;
+    qint64 const last  = static_cast<qint64>(ceil(m_End / MoonStep));
+
+    for (qint64 i = first; i <= last; i++)
+    {
+        double const jd     = qMin(i * MoonStep, m_End);
+        bool const violated = moonViolated(geo, jd);
+
+        if (violated != wasViolated)
+        {
+            double lo = previous, hi = jd;
+            for (int step = 0; step < BisectionSteps; step++)
+            {
+                double const mid = (lo + hi) / 2;
+                if (moonViolated(geo, mid) == wasViolated)
+                    lo = mid;
+                else
+                    hi = mid;
+            }
+
+            if (violated)
+                appendInterval(result, goodStart, hi);
+            else
+                goodStart = hi;
+
+            wasViolated = violated;
+        }
+
+        previous = jd;
+    }
+
+    if (!wasViolated)
+        appendInterval(result, goodStart, m_End);
+
+    return result;
+}
+
+bool TargetVisibility::moonViolated(const GeoLocation *geo, double jd) const
+{
+    EphemerisCache::Sample const moon = EphemerisCache::Instance()->at(geo, jd);
+
+    // Same conditions as SchedulerJob::getMoonSeparationScore()
+    if (moon.moonIllum() <= 0)
+        return false;
+
+    double sinLat, cosLat, sinDec, cosDec, sinMoonDec, cosMoonDec;
+    dms(m_Latitude).SinCos(sinLat, cosLat);
+    dms(m_Dec).SinCos(sinDec, cosDec);
+    dms(moon.moonDec).SinCos(sinMoonDec, cosMoonDec);
+
+    // Moon below the horizon
+    double const moonH = (m_LST0 + SiderealRate * (jd - m_Start) - moon.moonRA) * dms::DegToRad;
+    if (sinLat * sinMoonDec + cosLat * cosMoonDec * cos(moonH) <= 0)
+        return false;
+
+    double const cosSeparation = sinDec * sinMoonDec + cosDec * cosMoonDec * cos((m_RA - moon.moonRA) * dms::DegToRad);
+    return acos(qBound(-1.0, cosSeparation, 1.0)) / dms::DegToRad < m_Constraints.minMoonSeparation;
+}
@@ -0,0 +1,112 @@
+/*  Ekos Scheduler target visibility solver
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#pragma once
+
+#include <QList>
+#include <QPair>
+
+class GeoLocation;
+class SkyPoint;
+
+/**
+ * @class TargetVisibility
+ * @short Time intervals during which a scheduler job target satisfies its altitude and Moon constraints
+ *
+ * Instead of stepping minute by minute and recomputing the target and Moon coordinates at each step,
+ * the target apparent coordinates are computed once per window (they drift by less than an arcsecond
+ * in a day), and the altitude constraints are turned into hour angle limits:
+ *
+ * sin(alt) = sin(lat) sin(dec) + cos(lat) cos(dec) cos(H)
+ *
+ * The target is above the minimum altitude while |H| <= H0, and above the minimum altitude plus the
+ * setting cutoff after culmination while 0 <= H <= H1. As H grows linearly with sidereal time, the
+ * intervals follow directly. The Moon constraint is sampled every 15 minutes on the ephemeris
+ * shared by all jobs, see EphemerisCache, and its boundaries are found by bisection.
+ *
+ * The result is cached: a new window is only computed when the requested time leaves the current one,
+ * or when the target, the constraints or the geographic location change.
+ *
+ * Times are Julian days in UT.
+ */
+class TargetVisibility
+{
+  public:
+    /** Constraints of a job, see SchedulerJob::getMinAltitude() and SchedulerJob::getMinMoonSeparation() */
+    struct Constraints
+    {
+        double minAltitude { -90 };
+        /** Extra altitude required once the target is past the meridian, see Options::settingAltitudeCutoff() */
+        double settingCutoff { 0 };
+        /** Moon separation in degrees, disabled if not positive */
+        double minMoonSeparation { -1 };
+
+        bool operator==(const Constraints &o) const
+        {
+            return minAltitude == o.minAltitude && settingCutoff == o.settingCutoff &&
+                   minMoonSeparation == o.minMoonSeparation;
+        }
+    };
+
+    /** Half-open interval [first, second[ of Julian days */
+    typedef QPair<double, double> Interval;
+
+    /** Length of the windows for which the intervals are computed, in days */
+    static constexpr double WindowLength = 1.5;
+
+    /** Spacing of the Moon constraint samples, in days */
+    static constexpr double MoonStep = 1.0 / 96;
+
+    /**
+     * @short Altitude of the target at jd, and whether it is past the meridian
+     * @param target the target, only its catalog coordinates are used
+     * @param geo the observing location
+     * @param jd the Julian day (UT)
+     * @param isSetting if not null, receives true if the target is past the meridian
+     * @return the altitude in degrees, without refraction
+     */
+    double altitude(const SkyPoint &target, const GeoLocation *geo, double jd, bool *isSetting = nullptr);
+
+    /**
+     * @short Intervals in [jd, jd + 1[ during which the target satisfies the constraints
+     */
+    QList<Interval> intervals(const SkyPoint &target, const GeoLocation *geo, const Constraints &constraints, double jd);
+
+    /** Forget the cached window, e.g. after the target coordinates changed */
+    void invalidate() { m_Valid = false; }
+
+  private:
+    /** Make sure the cached window covers [jd, jd + span] for this target and location */
+    void updateCoordinates(const SkyPoint &target, const GeoLocation *geo, double jd, double span);
+
+    /** @return hour angle of the target at jd in degrees, not reduced */
+    double hourAngle(double jd) const;
+
+    /** @return intervals of the window during which the altitude constraints are satisfied */
+    QList<Interval> altitudeIntervals() const;
+
+    /** @return intervals of the window during which the Moon constraint is satisfied */
+    QList<Interval> moonIntervals(const GeoLocation *geo) const;
+
+    /** @return true if the Moon constraint is violated at jd */
+    bool moonViolated(const GeoLocation *geo, double jd) const;
+
+    bool m_Valid { false };
+    bool m_IntervalsValid { false };
+
+    // Cache keys
+    double m_RA0 { 0 }, m_Dec0 { 0 };
+    double m_Latitude { 0 }, m_Longitude { 0 };
+    Constraints m_Constraints;
+
+    // Window [m_Start, m_End[ and target state over it
+    double m_Start { 0 }, m_End { 0 };
+    double m_RA { 0 }, m_Dec { 0 };
+    double m_LST0 { 0 };
+    QList<Interval> m_Intervals;
+};
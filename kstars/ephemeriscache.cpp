@@ -0,0 +1,267 @@
+/***************************************************************************
+                   ephemeriscache.cpp  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sat 17 Oct 2026
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "ephemeriscache.h"
+
+#include "geolocation.h"
+#include "ksnumbers.h"
+#include "kstarsdatetime.h"
+#include "Options.h"
+#include "skyobjects/ksmoon.h"
+#include "skyobjects/ksplanet.h"
+#include "skyobjects/kssun.h"
+
+#include <KLocalizedString>
+
+#include <QMutexLocker>
+
+#include <cmath>
+#include <limits>
+
+namespace
+{
+/** Sidereal time advance in degrees per day of UT */
+const double SiderealRate = 360.98564736629;
+
+/** Number of bisection steps on the 3-minute altitude grid, down to about 0.2 second */
+const int BisectionSteps = 10;
+
+/** @return the Catmull-Rom interpolation between y1 and y2 at f in [0, 1] */
+double catmullRom(double y0, double y1, double y2, double y3, double f)
+{
+    return y1 + 0.5 * f * (y2 - y0 + f * (2 * y0 - 5 * y1 + 4 * y2 - y3 + f * (3 * (y1 - y2) + y3 - y0)));
+}
+
+/** @return the angle a plus or minus a multiple of 360 degrees, closest to ref */
+double unwind(double a, double ref)
+{
+    return a - 360.0 * std::round((a - ref) / 360.0);
+}
+
+/** @return the Catmull-Rom interpolation of angles in degrees, reduced to [0, 360[ */
+double catmullRomAngle(double y0, double y1, double y2, double y3, double f)
+{
+    double const y = catmullRom(unwind(y0, y1), y1, unwind(y2, y1), unwind(y3, y1), f);
+    return y - 360.0 * std::floor(y / 360.0);
+}
+}
+
+constexpr double EphemerisCache::Step;
+
+EphemerisCache *EphemerisCache::pinstance = nullptr;
+
+EphemerisCache *EphemerisCache::Instance()
+{
+    if (!pinstance)
+        pinstance = new EphemerisCache();
+    return pinstance;
+}
+
+double EphemerisCache::Sample::moonIllum() const
+{
+    return 0.5 * (1.0 - cos(moonPhase * dms::DegToRad));
+}
+
+EphemerisCache::EphemerisCache()
+    : m_Sun(new KSSun()), m_Moon(new KSMoon()),
+      m_Earth(new KSPlanet(i18n("Earth"), QString(), QColor("white"), 12756.28 /*diameter in km*/))
+{
+}
+
+EphemerisCache::~EphemerisCache() = default;
+
+EphemerisCache::Sample EphemerisCache::at(const GeoLocation *geo, double jd)
+{
+    QMutexLocker locker(&m_Mutex);
+    return interpolate(prepare(geo, jd));
+}
+
+double EphemerisCache::sunAltitude(const GeoLocation *geo, double jd)
+{
+    Sample const s = at(geo, jd);
+    return altitude(s.sunRA, s.sunDec, localSiderealTime(geo, jd), geo);
+}
+
+double EphemerisCache::moonAltitude(const GeoLocation *geo, double jd)
+{
+    Sample const s = at(geo, jd);
+    return altitude(s.moonRA, s.moonDec, localSiderealTime(geo, jd), geo);
+}
+
+void EphemerisCache::sunCrossings(const GeoLocation *geo, double jd, double alt, double *dawn, double *dusk,
+                                  double *minAlt, double *maxAlt)
+{
+    double const HourStep = 0.05;
+    double const LST0     = localSiderealTime(geo, jd);
+
+    auto sunAlt = [&](double hour)
+    {
+        Sample const s = at(geo, jd + hour / 24.0);
+        return altitude(s.sunRA, s.sunDec, LST0 + SiderealRate * hour / 24.0, geo);
+    };
+
+    // Bisect between two hours on each side of the altitude
+    auto refine = [&](double lo, double hi, bool rising)
+    {
+        for (int i = 0; i < BisectionSteps; i++)
+        {
+            double const mid = (lo + hi) / 2;
+            if ((sunAlt(mid) < alt) == rising)
+                lo = mid;
+            else
+                hi = mid;
+        }
+        return (lo + hi) / 2;
+    };
+
+    double const NaN = std::numeric_limits<double>::quiet_NaN();
+    double lastHour = -12.0, lastAlt = sunAlt(lastHour);
+    double lowest = lastAlt, highest = lastAlt;
+
+    *dawn = *dusk = NaN;
+
+    for (int i = 1; i <= 480; i++)
+    {
+        double const hour = -12.0 + i * HourStep;
+        double const a    = sunAlt(hour);
+
+        lowest  = qMin(lowest, a);
+        highest = qMax(highest, a);
+
+        if (lastAlt < alt && a >= alt)
+            *dawn = refine(lastHour, hour, true);
+        else if (lastAlt >= alt && a < alt)
+            *dusk = refine(lastHour, hour, false);
+
+        lastHour = hour;
+        lastAlt  = a;
+    }
+
+    if (minAlt)
+        *minAlt = lowest;
+    if (maxAlt)
+        *maxAlt = highest;
+}
+
+double EphemerisCache::localSiderealTime(const GeoLocation *geo, double jd)
+{
+    return geo->GSTtoLST(KStarsDateTime(static_cast<long double>(jd)).gst()).Degrees();
+}
+
+void EphemerisCache::clear()
+{
+    QMutexLocker locker(&m_Mutex);
+    m_Samples.clear();
+    m_Computed.clear();
+}
+
+double EphemerisCache::prepare(const GeoLocation *geo, double jd)
+{
+    double const lat = geo->lat()->Degrees(), lng = geo->lng()->Degrees();
+    if (lat != m_Latitude || lng != m_Longitude)
+    {
+        m_Samples.clear();
+        m_Computed.clear();
+        m_Latitude  = lat;
+        m_Longitude = lng;
+    }
+    m_Geo = geo;
+
+    int const count = static_cast<int>(qMax(2u, Options::ephemerisCacheSpan()) / Step) + 1;
+    double offset   = (jd - m_Start) / Step;
+
+    // Interpolation uses the two samples on each side of jd
+    if (m_Samples.size() != count || offset < 1 || offset >= count - 2)
+    {
+        // Center the window on jd, on a fixed grid so that the samples do not depend on the queries
+        double const start = (std::floor(jd / Step) - count / 2) * Step;
+        int const shift    = static_cast<int>(std::lround((start - m_Start) / Step));
+
+        // Keep the samples the old and new windows share
+        QVector<Sample> samples(count);
+        QVector<bool> computed(count, false);
+        for (int i = 0; i < count; i++)
+        {
+            int const j = i + shift;
+            if (0 <= j && j < m_Computed.size() && m_Computed[j])
+            {
+                samples[i]  = m_Samples[j];
+                computed[i] = true;
+            }
+        }
+
+        m_Start    = start;
+        m_Samples  = samples;
+        m_Computed = computed;
+        offset     = (jd - m_Start) / Step;
+    }
+
+    return offset;
+}
+
+const EphemerisCache::Sample &EphemerisCache::sample(int index)
+{
+    if (!m_Computed[index])
+    {
+        long double const jd = m_Start + index * static_cast<long double>(Step);
+        KSNumbers num(jd);
+        CachingDms const LST = m_Geo->GSTtoLST(KStarsDateTime(jd).gst());
+
+        // A private Earth too, the sky map one is left alone
+        m_Earth->findPosition(&num);
+        m_Sun->findPosition(&num, m_Geo->lat(), &LST, m_Earth.get());
+        m_Moon->findPosition(&num, m_Geo->lat(), &LST, m_Earth.get());
+
+        Sample &s   = m_Samples[index];
+        s.sunRA     = m_Sun->ra().Degrees();
+        s.sunDec    = m_Sun->dec().Degrees();
+        s.moonRA    = m_Moon->ra().Degrees();
+        s.moonDec   = m_Moon->dec().Degrees();
+        s.moonPhase = dms(m_Moon->ecLong().Degrees() - m_Sun->ecLong().Degrees()).reduce().Degrees();
+
+        m_Computed[index] = true;
+    }
+
+    return m_Samples[index];
+}
+
+EphemerisCache::Sample EphemerisCache::interpolate(double offset)
+{
+    int const i    = static_cast<int>(std::floor(offset));
+    double const f = offset - i;
+
+    Sample const s0 = sample(i - 1);
+    Sample const s1 = sample(i);
+    Sample const s2 = sample(i + 1);
+    Sample const s3 = sample(i + 2);
+
+    Sample result;
+    result.sunRA     = catmullRomAngle(s0.sunRA, s1.sunRA, s2.sunRA, s3.sunRA, f);
+    result.sunDec    = catmullRom(s0.sunDec, s1.sunDec, s2.sunDec, s3.sunDec, f);
+    result.moonRA    = catmullRomAngle(s0.moonRA, s1.moonRA, s2.moonRA, s3.moonRA, f);
+    result.moonDec   = catmullRom(s0.moonDec, s1.moonDec, s2.moonDec, s3.moonDec, f);
+    result.moonPhase = catmullRomAngle(s0.moonPhase, s1.moonPhase, s2.moonPhase, s3.moonPhase, f);
+    return result;
+}
+
+double EphemerisCache::altitude(double ra, double dec, double lst, const GeoLocation *geo)
+{
+    double sinLat, cosLat, sinDec, cosDec;
+    geo->lat()->SinCos(sinLat, cosLat);
+    dms(dec).SinCos(sinDec, cosDec);
+
+    double const sinAlt = sinLat * sinDec + cosLat * cosDec * cos((lst - ra) * dms::DegToRad);
+    return asin(qBound(-1.0, sinAlt, 1.0)) / dms::DegToRad;
+}
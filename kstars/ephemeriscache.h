@@ -0,0 +1,134 @@
+/***************************************************************************
+                    ephemeriscache.h  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sat 17 Oct 2026
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QMutex>
+#include <QVector>
+
+#include <memory>
+
+class GeoLocation;
+class KSMoon;
+class KSPlanet;
+class KSSun;
+
+/**
+ * @class EphemerisCache
+ * @short Interpolated Sun and Moon ephemeris shared by the planning tools
+ *
+ * The Scheduler, the What's Up Tonight dialog, the Altitude vs. Time tool and KSAlmanac keep
+ * asking where the Sun and the Moon are at times close to each other. Instead of running the
+ * full VSOP87 and ELP2000 series for each of these queries, the positions are sampled once per
+ * hour over a window of Options::ephemerisCacheSpan() days around the requested time, and
+ * interpolated with cubic Hermite splines whose tangents are the central differences of the
+ * samples (Catmull-Rom). The interpolation error is a few arcseconds for the topocentric Moon
+ * and much less for the Sun.
+ *
+ * Samples are computed lazily with private copies of the Sun and the Moon, so that the bodies
+ * displayed on the sky map are never disturbed. The window moves when a query falls out of it,
+ * and the cache is dropped when the geographic location changes, since the Moon positions are
+ * topocentric.
+ *
+ * Times are Julian days in UT, angles are in degrees. Access is serialized, the cache may be
+ * queried from worker threads.
+ */
+class EphemerisCache
+{
+  public:
+    /** Positions at one instant */
+    struct Sample
+    {
+        /** Apparent geocentric coordinates of the Sun */
+        double sunRA { 0 }, sunDec { 0 };
+        /** Apparent topocentric coordinates of the Moon */
+        double moonRA { 0 }, moonDec { 0 };
+        /** Moon phase angle as in KSMoon::phase(), in [0, 360[ */
+        double moonPhase { 0 };
+
+        /** @return the illuminated fraction of the Moon, see KSMoon::illum() */
+        double moonIllum() const;
+    };
+
+    /** Spacing of the samples, in days */
+    static constexpr double Step = 1.0 / 24;
+
+    static EphemerisCache *Instance();
+
+    /** @return the interpolated Sun and Moon positions seen from geo at jd */
+    Sample at(const GeoLocation *geo, double jd);
+
+    /** @return the geometric altitude of the Sun seen from geo at jd */
+    double sunAltitude(const GeoLocation *geo, double jd);
+
+    /** @return the geometric altitude of the Moon seen from geo at jd */
+    double moonAltitude(const GeoLocation *geo, double jd);
+
+    /**
+     * @short Find when the Sun crosses an altitude during the 24 hours centered on a local midnight
+     *
+     * The altitude is sampled every 3 minutes as KSAlmanac always did, and the crossings are refined
+     * by bisection. If the Sun crosses the altitude several times, the last crossings are returned.
+     *
+     * @param geo the observing location
+     * @param jd the Julian day (UT) of the local midnight
+     * @param alt the altitude of the Sun, e.g. -18 for the astronomical twilight
+     * @param dawn receives the hours after midnight at which the Sun rises above the altitude, NaN if it doesn't
+     * @param dusk receives the hours after midnight, negative, at which the Sun sets below the altitude, NaN if it doesn't
+     * @param minAlt if not null, receives the lowest altitude of the Sun over these 24 hours
+     * @param maxAlt if not null, receives the highest altitude of the Sun over these 24 hours
+     */
+    void sunCrossings(const GeoLocation *geo, double jd, double alt, double *dawn, double *dusk,
+                      double *minAlt = nullptr, double *maxAlt = nullptr);
+
+    /** @return the local sidereal time at geo and jd, in degrees */
+    static double localSiderealTime(const GeoLocation *geo, double jd);
+
+    /** Drop all samples */
+    void clear();
+
+  private:
+    EphemerisCache();
+    ~EphemerisCache();
+
+    /** Make sure the window is set up for geo and covers the samples around jd, return the offset of jd in steps */
+    double prepare(const GeoLocation *geo, double jd);
+
+    /** @return the sample at index in the window, computing it if needed */
+    const Sample &sample(int index);
+
+    /** @return the interpolated sample at offset in steps from the start of the window */
+    Sample interpolate(double offset);
+
+    /** @return the geometric altitude of a body at (ra, dec) seen from geo when the local sidereal time is lst */
+    static double altitude(double ra, double dec, double lst, const GeoLocation *geo);
+
+    static EphemerisCache *pinstance;
+
+    QMutex m_Mutex;
+
+    std::unique_ptr<KSSun> m_Sun;
+    std::unique_ptr<KSMoon> m_Moon;
+    std::unique_ptr<KSPlanet> m_Earth;
+
+    // Location of the samples
+    double m_Latitude { 0 }, m_Longitude { 0 };
+    const GeoLocation *m_Geo { nullptr };
+
+    // Window of samples, the first one at m_Start
+    double m_Start { 0 };
+    QVector<Sample> m_Samples;
+    QVector<bool> m_Computed;
+};
@@ -19,8 +19,8 @@
 
 #include "fitsdata.h"
 
+#include "paralleldebayer.h"
 #include "sep/sep.h"
-#include "fpack.h"
 
 #include "kstarsdata.h"
 #include "ksutils.h"
@@ -30,7 +30,11 @@
 #include "auxiliary/ksnotification.h"
 
 #include <QApplication>
+#include <QCache>
+#include <QFileInfo>
 #include <QImage>
+#include <QMutex>
+#include <QThread>
 #include <QtConcurrent>
 #include <QImageReader>
 
@@ -43,11 +47,14 @@
 #include "fitshistogram.h"
 #endif
 
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 
 #include <fits_debug.h>
 
+#define FITS_BLOCK_SIZE 2880
+
 #define ZOOM_DEFAULT   100.0
 #define ZOOM_MIN       10
 #define ZOOM_MAX       400
@@ -95,6 +102,9 @@ FITSData::~FITSData()
 {
     int status = 0;
 
+    // The star search running in the background uses the image buffer
+    m_StarSearch.waitForFinished();
+
     clearImageBuffers();
 
 #ifdef HAVE_WCSLIB
@@ -145,6 +155,7 @@ void FITSData::loadCommon(const QString &inFilename)
     }
 
     m_Filename = inFilename;
+    m_FileBuffer.clear();
 }
 
 bool FITSData::loadFITSFromMemory(const QString &inFilename, void *fits_buffer,
@@ -155,6 +166,16 @@ bool FITSData::loadFITSFromMemory(const QString &inFilename, void *fits_buffer,
     return privateLoad(fits_buffer, fits_buffer_size, silent);
 }
 
+bool FITSData::loadFITSFromMemory(const QString &inFilename, const QByteArray &buffer, bool silent)
+{
+    loadCommon(inFilename);
+    qCInfo(KSTARS_FITS) << "Reading FITS file buffer ";
+
+    // cfitsio reads from the buffer as long as the file is open
+    m_FileBuffer = buffer;
+    return privateLoad(const_cast<char *>(m_FileBuffer.constData()), m_FileBuffer.size(), silent);
+}
+
 QFuture<bool> FITSData::loadFITS(const QString &inFilename, bool silent)
 {
     loadCommon(inFilename);
@@ -167,6 +188,91 @@ QFuture<bool> FITSData::loadFITS(const QString &inFilename, bool silent)
 
 namespace
 {
+/** Decompressed .fz files shared by all FITSData, the cost is in KiB */
+QCache<QString, QByteArray> decompressedCache;
+QMutex decompressedCacheMutex;
+
+// Decompress the first tile-compressed image of a .fz file into a FITS memory file.
+// Returns an empty array on failure, with the cfitsio error in status.
+QByteArray decompressFITS(const QString &filename, int *status)
+{
+    fitsfile *in = nullptr, *out = nullptr;
+    int closeStatus = 0;
+
+    if (fits_open_diskfile(&in, filename.toLatin1(), READONLY, status))
+        return QByteArray();
+
+    // fpack leaves an empty primary array and stores the image in an extension
+    int hdus = 0;
+    bool found = false;
+    fits_get_num_hdus(in, &hdus, status);
+    for (int hdu = 1; hdu <= hdus && !found && *status == 0; ++hdu)
+    {
+        fits_movabs_hdu(in, hdu, nullptr, status);
+        found = *status == 0 && fits_is_compressed_image(in, status);
+    }
+
+    if (!found)
+    {
+        if (*status == 0)
+            *status = NOT_IMAGE;
+        fits_close_file(in, &closeStatus);
+        return QByteArray();
+    }
+
+    // cfitsio grows the buffer with realloc as the image is written
+    size_t size = FITS_BLOCK_SIZE;
+    void *buffer = malloc(size);
+    LONGLONG headStart = 0, dataStart = 0, dataEnd = 0;
+
+    if (fits_create_memfile(&out, &buffer, &size, std::max<size_t>(FITS_BLOCK_SIZE, QFileInfo(filename).size()),
+                            realloc, status) == 0)
+    {
+        fits_img_decompress(in, out, status);
+        fits_flush_file(out, status);
+        fits_get_hduaddrll(out, &headStart, &dataStart, &dataEnd, status);
+        fits_close_file(out, &closeStatus);
+    }
+    fits_close_file(in, &closeStatus);
+
+    QByteArray result;
+    if (*status == 0)
+    {
+        // The buffer is larger than the file, which ends with the data padded to a whole block
+        LONGLONG const length = (dataEnd + FITS_BLOCK_SIZE - 1) / FITS_BLOCK_SIZE * FITS_BLOCK_SIZE;
+        result = QByteArray(static_cast<const char *>(buffer), static_cast<int>(std::min<LONGLONG>(length, size)));
+    }
+    free(buffer);
+
+    return result;
+}
+
+// Same as decompressFITS(), going through the cache of decompressed files.
+QByteArray decompressedFITS(const QString &filename, bool cacheable, int *status)
+{
+    QFileInfo const info(filename);
+    QString const key = QString("%1:%2:%3").arg(info.absoluteFilePath())
+                        .arg(info.lastModified().toMSecsSinceEpoch()).arg(info.size());
+    int const maxCost = static_cast<int>(Options::compressedFITSCacheSize()) * 1024;
+
+    {
+        QMutexLocker locker(&decompressedCacheMutex);
+        decompressedCache.setMaxCost(maxCost);
+        if (QByteArray *data = decompressedCache.object(key))
+            return *data;
+    }
+
+    QByteArray const data = decompressFITS(filename, status);
+
+    if (cacheable && !data.isEmpty() && maxCost > 0)
+    {
+        QMutexLocker locker(&decompressedCacheMutex);
+        decompressedCache.insert(key, new QByteArray(data), qMax(1, data.size() / 1024));
+    }
+
+    return data;
+}
+
 // Common code for reporting fits read errors. Always returns false.
 bool fitsOpenError(int status, const QString &message, bool silent)
 {
@@ -194,26 +300,16 @@ bool FITSData::privateLoad(void *fits_buffer, size_t fits_buffer_size, bool sile
     {
         // Store so we don't lose.
         m_compressedFilename = m_Filename;
+        m_isCompressed = true;
 
-        QString uncompressedFile = QDir::tempPath() + QString("/%1").arg(QUuid::createUuid().toString().remove(QRegularExpression("[-{}]")));
-        fpstate	fpvar;
-        fp_init (&fpvar);
-        if (fp_unpack(m_Filename.toLatin1().data(), uncompressedFile.toLatin1().data(), fpvar) < 0)
-        {
-            errMessage = i18n("Failed to unpack compressed fits");
-            if (!silent)
-                KSNotification::error(errMessage, i18n("FITS Open"));
-            qCCritical(KSTARS_FITS) << errMessage;
-            return false;
-        }
-
-        // Remove compressed .fz if it was temporary
-        if (m_isTemporary && autoRemoveTemporaryFITS)
-            QFile::remove(m_Filename);
+        // Decompress in memory, temporary frames are not worth caching as they are read once
+        m_FileBuffer = decompressedFITS(m_Filename, !m_isTemporary, &status);
+        if (m_FileBuffer.isEmpty())
+            return fitsOpenError(status, i18n("Failed to unpack compressed fits"), silent);
 
-        m_Filename = uncompressedFile;
-        m_isTemporary = true;
-        m_isCompressed = true;
+        // The memory file is opened read-only, so the shared data is never written to
+        fits_buffer = const_cast<char *>(m_FileBuffer.constData());
+        fits_buffer_size = m_FileBuffer.size();
     }
 
     if (fits_buffer == nullptr)
@@ -543,10 +639,28 @@ void FITSData::clearImageBuffers()
     delete[] m_ImageBuffer;
     m_ImageBuffer = nullptr;
     //m_BayerBuffer = nullptr;
+    clearFloatPlanes();
+}
+
+void FITSData::clearFloatPlanes()
+{
+    {
+        QMutexLocker locker(&m_FloatPlaneMutex);
+        m_FloatPlane.clear();
+        m_FloatBoxPlane.clear();
+        m_FloatBox = QRect();
+    }
+
+    m_SEPBackground.clear();
+    m_SEPBackground.squeeze();
+    m_SEPBackgroundBox = QRect();
 }
 
 void FITSData::calculateStats(bool refresh)
 {
+    // Statistics are refreshed whenever the pixels change, e.g. after dark subtraction
+    clearFloatPlanes();
+
     // Calculate min max
     calculateMinMax(refresh);
 
@@ -898,33 +1012,33 @@ bool FITSData::checkCollision(Edge * s1, Edge * s2)
     return false;
 }
 
-int FITSData::findCannyStar(FITSData * data, const QRect &boundary)
+int FITSData::findCannyStar(FITSData * data, QList<Edge *> &stars, const QRect &boundary)
 {
     switch (data->property("dataType").toInt())
     {
         case TBYTE:
-            return FITSData::findCannyStar<uint8_t>(data, boundary);
+            return FITSData::findCannyStar<uint8_t>(data, stars, boundary);
 
         case TSHORT:
-            return FITSData::findCannyStar<int16_t>(data, boundary);
+            return FITSData::findCannyStar<int16_t>(data, stars, boundary);
 
         case TUSHORT:
-            return FITSData::findCannyStar<uint16_t>(data, boundary);
+            return FITSData::findCannyStar<uint16_t>(data, stars, boundary);
 
         case TLONG:
-            return FITSData::findCannyStar<int32_t>(data, boundary);
+            return FITSData::findCannyStar<int32_t>(data, stars, boundary);
 
         case TULONG:
-            return FITSData::findCannyStar<uint16_t>(data, boundary);
+            return FITSData::findCannyStar<uint16_t>(data, stars, boundary);
 
         case TFLOAT:
-            return FITSData::findCannyStar<float>(data, boundary);
+            return FITSData::findCannyStar<float>(data, stars, boundary);
 
         case TLONGLONG:
-            return FITSData::findCannyStar<int64_t>(data, boundary);
+            return FITSData::findCannyStar<int64_t>(data, stars, boundary);
 
         case TDOUBLE:
-            return FITSData::findCannyStar<double>(data, boundary);
+            return FITSData::findCannyStar<double>(data, stars, boundary);
 
         default:
             break;
@@ -935,34 +1049,54 @@ int FITSData::findCannyStar(FITSData * data, const QRect &boundary)
 
 int FITSData::findStars(StarAlgorithm algorithm, const QRect &trackingBox)
 {
-    int count = 0;
-    starAlgorithm = algorithm;
+    m_StarSearch.waitForFinished();
 
-    qDeleteAll(starCenters);
-    starCenters.clear();
+    QList<Edge *> stars;
+    int const count = detectStars(algorithm, trackingBox, stars);
+    setStarCenters(stars, algorithm);
+
+    return count;
+}
 
+int FITSData::detectStars(StarAlgorithm algorithm, const QRect &trackingBox, QList<Edge *> &stars)
+{
     switch (algorithm)
     {
         case ALGORITHM_SEP:
-            count = findSEPStars(trackingBox);
-            break;
+            return findSEPStars(stars, trackingBox);
 
         case ALGORITHM_GRADIENT:
-            count = findCannyStar(this, trackingBox);
-            break;
+            return findCannyStar(this, stars, trackingBox);
 
         case ALGORITHM_CENTROID:
-            count = findCentroid(trackingBox);
-            break;
+            return findCentroid(stars, trackingBox);
 
         case ALGORITHM_THRESHOLD:
-            count = findOneStar(trackingBox);
-            break;
+            return findOneStar(stars, trackingBox);
     }
 
-    starsSearched = true;
+    return 0;
+}
 
-    return count;
+QFuture<QList<Edge *>> FITSData::findStarsAsync(StarAlgorithm algorithm, const QRect &trackingBox)
+{
+    m_StarSearch.waitForFinished();
+    m_StarSearch = QtConcurrent::run([this, algorithm, trackingBox]()
+    {
+        // Detected into a list of the worker, starCenters belongs to the GUI thread
+        QList<Edge *> stars;
+        detectStars(algorithm, trackingBox, stars);
+        return stars;
+    });
+    return m_StarSearch;
+}
+
+void FITSData::setStarCenters(const QList<Edge *> &stars, StarAlgorithm algorithm)
+{
+    qDeleteAll(starCenters);
+    starCenters   = stars;
+    starAlgorithm = algorithm;
+    starsSearched = true;
 }
 
 int FITSData::filterStars(const float innerRadius, const float outerRadius)
@@ -984,7 +1118,7 @@ int FITSData::filterStars(const float innerRadius, const float outerRadius)
 }
 
 template <typename T>
-int FITSData::findCannyStar(FITSData * data, const QRect &boundary)
+int FITSData::findCannyStar(FITSData * data, QList<Edge *> &stars, const QRect &boundary)
 {
     int subX = qMax(0, boundary.isNull() ? 0 : boundary.x());
     int subY = qMax(0, boundary.isNull() ? 0 : boundary.y());
@@ -1206,40 +1340,40 @@ int FITSData::findCannyStar(FITSData * data, const QRect &boundary)
     center->x += subX;
     center->y += subY;
 
-    data->appendStar(center);
+    stars.append(center);
 
     qCDebug(KSTARS_FITS) << "Flux: " << FSum << " Half-Flux: " << HF << " HFR: " << center->HFR;
 
     return 1;
 }
 
-int FITSData::findOneStar(const QRect &boundary)
+int FITSData::findOneStar(QList<Edge *> &stars, const QRect &boundary)
 {
     switch (m_DataType)
     {
         case TBYTE:
-            return findOneStar<uint8_t>(boundary);
+            return findOneStar<uint8_t>(stars, boundary);
 
         case TSHORT:
-            return findOneStar<int16_t>(boundary);
+            return findOneStar<int16_t>(stars, boundary);
 
         case TUSHORT:
-            return findOneStar<uint16_t>(boundary);
+            return findOneStar<uint16_t>(stars, boundary);
 
         case TLONG:
-            return findOneStar<int32_t>(boundary);
+            return findOneStar<int32_t>(stars, boundary);
 
         case TULONG:
-            return findOneStar<uint32_t>(boundary);
+            return findOneStar<uint32_t>(stars, boundary);
 
         case TFLOAT:
-            return findOneStar<float>(boundary);
+            return findOneStar<float>(stars, boundary);
 
         case TLONGLONG:
-            return findOneStar<int64_t>(boundary);
+            return findOneStar<int64_t>(stars, boundary);
 
         case TDOUBLE:
-            return findOneStar<double>(boundary);
+            return findOneStar<double>(stars, boundary);
 
         default:
             break;
@@ -1249,7 +1383,7 @@ int FITSData::findOneStar(const QRect &boundary)
 }
 
 template <typename T>
-int FITSData::findOneStar(const QRect &boundary)
+int FITSData::findOneStar(QList<Edge *> &stars, const QRect &boundary)
 {
     if (boundary.isEmpty())
         return -1;
@@ -1340,7 +1474,7 @@ int FITSData::findOneStar(const QRect &boundary)
     // 30% fuzzy
     //center->width += center->width*0.3 * (running_threshold / threshold);
 
-    starCenters.append(center);
+    stars.append(center);
 
     double FSum = 0, HF = 0, TF = 0, min = stats.min[0];
     const double resolution = 1.0 / 20.0;
@@ -1397,33 +1531,33 @@ int FITSData::findOneStar(const QRect &boundary)
 }
 
 /*** Find center of stars and calculate Half Flux Radius */
-int FITSData::findCentroid(const QRect &boundary, int initStdDev, int minEdgeWidth)
+int FITSData::findCentroid(QList<Edge *> &stars, const QRect &boundary, int initStdDev, int minEdgeWidth)
 {
     switch (m_DataType)
     {
         case TBYTE:
-            return findCentroid<uint8_t>(boundary, initStdDev, minEdgeWidth);
+            return findCentroid<uint8_t>(stars, boundary, initStdDev, minEdgeWidth);
 
         case TSHORT:
-            return findCentroid<int16_t>(boundary, initStdDev, minEdgeWidth);
+            return findCentroid<int16_t>(stars, boundary, initStdDev, minEdgeWidth);
 
         case TUSHORT:
-            return findCentroid<uint16_t>(boundary, initStdDev, minEdgeWidth);
+            return findCentroid<uint16_t>(stars, boundary, initStdDev, minEdgeWidth);
 
         case TLONG:
-            return findCentroid<int32_t>(boundary, initStdDev, minEdgeWidth);
+            return findCentroid<int32_t>(stars, boundary, initStdDev, minEdgeWidth);
 
         case TULONG:
-            return findCentroid<uint32_t>(boundary, initStdDev, minEdgeWidth);
+            return findCentroid<uint32_t>(stars, boundary, initStdDev, minEdgeWidth);
 
         case TFLOAT:
-            return findCentroid<float>(boundary, initStdDev, minEdgeWidth);
+            return findCentroid<float>(stars, boundary, initStdDev, minEdgeWidth);
 
         case TLONGLONG:
-            return findCentroid<int64_t>(boundary, initStdDev, minEdgeWidth);
+            return findCentroid<int64_t>(stars, boundary, initStdDev, minEdgeWidth);
 
         case TDOUBLE:
-            return findCentroid<double>(boundary, initStdDev, minEdgeWidth);
+            return findCentroid<double>(stars, boundary, initStdDev, minEdgeWidth);
 
         default:
             return -1;
@@ -1431,7 +1565,7 @@ int FITSData::findCentroid(const QRect &boundary, int initStdDev, int minEdgeWid
 }
 
 template <typename T>
-int FITSData::findCentroid(const QRect &boundary, int initStdDev, int minEdgeWidth)
+int FITSData::findCentroid(QList<Edge *> &stars, const QRect &boundary, int initStdDev, int minEdgeWidth)
 {
     double threshold = 0, sum = 0, avg = 0, min = 0;
     int starDiameter     = 0;
@@ -1762,33 +1896,33 @@ int FITSData::findCentroid(const QRect &boundary, int initStdDev, int minEdgeWid
 
             qCDebug(KSTARS_FITS) << "HFR for this center is " << rCenter->HFR << " pixels and the total flux is " << FSum;
 
-            starCenters.append(rCenter);
+            stars.append(rCenter);
         }
     }
 
-    if (starCenters.count() > 1 && m_Mode != FITS_FOCUS)
+    if (stars.count() > 1 && m_Mode != FITS_FOCUS)
     {
-        float width_avg = (float)width_sum / starCenters.count();
+        float width_avg = (float)width_sum / stars.count();
         float lsum = 0, sdev = 0;
 
-        for (auto &center : starCenters)
+        for (auto &center : stars)
             lsum += (center->width - width_avg) * (center->width - width_avg);
 
-        sdev = (std::sqrt(lsum / (starCenters.count() - 1))) * 4;
+        sdev = (std::sqrt(lsum / (stars.count() - 1))) * 4;
 
         // Reject stars > 4 * stddev
-        foreach (Edge * center, starCenters)
+        foreach (Edge * center, stars)
             if (center->width > sdev)
-                starCenters.removeOne(center);
+                stars.removeOne(center);
 
-        //foreach(Edge *center, starCenters)
+        //foreach(Edge *center, stars)
         //qDebug() << center->x << "," << center->y << "," << center->width << "," << center->val << endl;
     }
 
     // Release memory
     qDeleteAll(edges);
 
-    return starCenters.count();
+    return stars.count();
 }
 
 double FITSData::getHFR(HFRType type)
@@ -1877,6 +2011,9 @@ void FITSData::applyFilter(FITSScale type, uint8_t * image, QVector<double> * mi
     if (type == FITS_NONE)
         return;
 
+    if (image == nullptr)
+        clearFloatPlanes();
+
     QVector<double> dataMin(3);
     QVector<double> dataMax(3);
 
@@ -3263,6 +3400,7 @@ void FITSData::setImageBuffer(uint8_t * buffer)
 {
     delete[] m_ImageBuffer;
     m_ImageBuffer = buffer;
+    clearFloatPlanes();
 }
 
 bool FITSData::checkDebayer()
@@ -3338,6 +3476,8 @@ bool FITSData::debayer()
     //        }
     //    }
 
+    clearFloatPlanes();
+
     switch (m_DataType)
     {
         case TBYTE:
@@ -3353,36 +3493,19 @@ bool FITSData::debayer()
 
 bool FITSData::debayer_8bit()
 {
-    dc1394error_t error_code;
-
     uint32_t rgb_size = stats.samples_per_channel * 3 * stats.bytesPerPixel;
     auto * destinationBuffer = new uint8_t[rgb_size];
 
-    auto * bayer_source_buffer      = reinterpret_cast<uint8_t *>(m_ImageBuffer);
-    auto * bayer_destination_buffer = reinterpret_cast<uint8_t *>(destinationBuffer);
-
-    if (bayer_destination_buffer == nullptr)
+    if (destinationBuffer == nullptr)
     {
         KSNotification::error(i18n("Unable to allocate memory for temporary bayer buffer."), i18n("Debayer error"));
         return false;
     }
 
-    int ds1394_height = stats.height;
-    auto dc1394_source = bayer_source_buffer;
-
-    if (debayerParams.offsetY == 1)
-    {
-        dc1394_source += stats.width;
-        ds1394_height--;
-    }
-
-    if (debayerParams.offsetX == 1)
-    {
-        dc1394_source++;
-    }
-
-    error_code = dc1394_bayer_decoding_8bit(dc1394_source, bayer_destination_buffer, stats.width, ds1394_height, debayerParams.filter,
-                                            debayerParams.method);
+    // Decoded straight into the three FITS layers
+    ParallelDebayer bayerDecoder;
+    dc1394error_t error_code = bayerDecoder.debayer(m_ImageBuffer, destinationBuffer, stats.width, stats.height, debayerParams,
+                               ParallelDebayer::RGB_PLANAR);
 
     if (error_code != DC1394_SUCCESS)
     {
@@ -3392,74 +3515,30 @@ bool FITSData::debayer_8bit()
         return false;
     }
 
-    if (m_ImageBufferSize != rgb_size)
-    {
-        delete[] m_ImageBuffer;
-        m_ImageBuffer = new uint8_t[rgb_size];
-
-        if (m_ImageBuffer == nullptr)
-        {
-            delete[] destinationBuffer;
-            KSNotification::error(i18n("Unable to allocate memory for temporary bayer buffer."), i18n("Debayer error"));
-            return false;
-        }
-
-        m_ImageBufferSize = rgb_size;
-    }
-
-    auto bayered_buffer = reinterpret_cast<uint8_t *>(m_ImageBuffer);
-
-    // Data in R1G1B1, we need to copy them into 3 layers for FITS
-
-    uint8_t * rBuff = bayered_buffer;
-    uint8_t * gBuff = bayered_buffer + (stats.width * stats.height);
-    uint8_t * bBuff = bayered_buffer + (stats.width * stats.height * 2);
-
-    int imax = stats.samples_per_channel * 3 - 3;
-    for (int i = 0; i <= imax; i += 3)
-    {
-        *rBuff++ = bayer_destination_buffer[i];
-        *gBuff++ = bayer_destination_buffer[i + 1];
-        *bBuff++ = bayer_destination_buffer[i + 2];
-    }
+    delete[] m_ImageBuffer;
+    m_ImageBuffer     = destinationBuffer;
+    m_ImageBufferSize = rgb_size;
 
     m_Channels = (m_Mode == FITS_NORMAL) ? 3 : 1;
-    delete[] destinationBuffer;
     return true;
 }
 
 bool FITSData::debayer_16bit()
 {
-    dc1394error_t error_code;
-
     uint32_t rgb_size = stats.samples_per_channel * 3 * stats.bytesPerPixel;
     auto * destinationBuffer = new uint8_t[rgb_size];
 
-    auto * bayer_source_buffer      = reinterpret_cast<uint16_t *>(m_ImageBuffer);
-    auto * bayer_destination_buffer = reinterpret_cast<uint16_t *>(destinationBuffer);
-
-    if (bayer_destination_buffer == nullptr)
+    if (destinationBuffer == nullptr)
     {
         KSNotification::error(i18n("Unable to allocate memory for temporary bayer buffer."), i18n("Debayer error"));
         return false;
     }
 
-    int ds1394_height = stats.height;
-    auto dc1394_source = bayer_source_buffer;
-
-    if (debayerParams.offsetY == 1)
-    {
-        dc1394_source += stats.width;
-        ds1394_height--;
-    }
-
-    if (debayerParams.offsetX == 1)
-    {
-        dc1394_source++;
-    }
-
-    error_code = dc1394_bayer_decoding_16bit(dc1394_source, bayer_destination_buffer, stats.width, ds1394_height, debayerParams.filter,
-                 debayerParams.method, 16);
+    // Decoded straight into the three FITS layers
+    ParallelDebayer bayerDecoder;
+    dc1394error_t error_code = bayerDecoder.debayer(reinterpret_cast<uint16_t *>(m_ImageBuffer),
+                               reinterpret_cast<uint16_t *>(destinationBuffer), stats.width, stats.height,
+                               debayerParams, ParallelDebayer::RGB_PLANAR, 0, 16);
 
     if (error_code != DC1394_SUCCESS)
     {
@@ -3469,39 +3548,11 @@ bool FITSData::debayer_16bit()
         return false;
     }
 
-    if (m_ImageBufferSize != rgb_size)
-    {
-        delete[] m_ImageBuffer;
-        m_ImageBuffer = new uint8_t[rgb_size];
-
-        if (m_ImageBuffer == nullptr)
-        {
-            delete[] destinationBuffer;
-            KSNotification::error(i18n("Unable to allocate memory for temporary bayer buffer."), i18n("Debayer error"));
-            return false;
-        }
-
-        m_ImageBufferSize = rgb_size;
-    }
-
-    auto bayered_buffer = reinterpret_cast<uint16_t *>(m_ImageBuffer);
-
-    // Data in R1G1B1, we need to copy them into 3 layers for FITS
-
-    uint16_t * rBuff = bayered_buffer;
-    uint16_t * gBuff = bayered_buffer + (stats.width * stats.height);
-    uint16_t * bBuff = bayered_buffer + (stats.width * stats.height * 2);
-
-    int imax = stats.samples_per_channel * 3 - 3;
-    for (int i = 0; i <= imax; i += 3)
-    {
-        *rBuff++ = bayer_destination_buffer[i];
-        *gBuff++ = bayer_destination_buffer[i + 1];
-        *bBuff++ = bayer_destination_buffer[i + 2];
-    }
+    delete[] m_ImageBuffer;
+    m_ImageBuffer     = destinationBuffer;
+    m_ImageBufferSize = rgb_size;
 
     m_Channels = (m_Mode == FITS_NORMAL) ? 3 : 1;
-    delete[] destinationBuffer;
     return true;
 }
 
@@ -4192,84 +4243,65 @@ bool FITSData::contains(const QPointF &point) const
     return (point.x() >= 0 && point.y() >= 0 && point.x() <= stats.width && point.y() <= stats.height);
 }
 
-int FITSData::findSEPStars(const QRect &boundary)
+int FITSData::findSEPStars(QList<Edge *> &stars, const QRect &boundary)
 {
-    int x = 0, y = 0, w = stats.width, h = stats.height, maxRadius = 50;
+    QRect const frame(0, 0, stats.width, stats.height);
+    QRect const box = boundary.isNull() ? frame : boundary.intersected(frame);
+    int const x = box.x(), y = box.y(), w = box.width(), h = box.height();
+    int const maxRadius = boundary.isNull() ? 50 : w;
+    int status = 0;
 
-    if (!boundary.isNull())
+    if (box.isEmpty())
+        return -1;
+
+    // #1 Subtract the background from the float plane, unless the previous search of this area did
+    if (m_SEPBackgroundBox != box || m_SEPBackground.size() != w * h)
     {
-        x = boundary.x();
-        y = boundary.y();
-        w = boundary.width();
-        h = boundary.height();
-        maxRadius = w;
-    }
+        // Detached from the shared plane, the background is subtracted in place
+        m_SEPBackground = getFloatPlane(box);
+        if (m_SEPBackground.size() != w * h)
+        {
+            m_SEPBackground.clear();
+            return -1;
+        }
 
-    auto * data = new float[w * h];
+        float * data = m_SEPBackground.data();
+        sep_image bkgImage = {data, nullptr, nullptr, SEP_TFLOAT, 0, 0, w, h, 0.0, SEP_NOISE_NONE, 1.0, 0.0};
+        sep_bkg * bkg = nullptr;
 
-    switch (stats.bitpix)
-    {
-        case BYTE_IMG:
-            getFloatBuffer<uint8_t>(data, x, y, w, h);
-            break;
-        case SHORT_IMG:
-            getFloatBuffer<int16_t>(data, x, y, w, h);
-            break;
-        case USHORT_IMG:
-            getFloatBuffer<uint16_t>(data, x, y, w, h);
-            break;
-        case LONG_IMG:
-            getFloatBuffer<int32_t>(data, x, y, w, h);
-            break;
-        case ULONG_IMG:
-            getFloatBuffer<uint32_t>(data, x, y, w, h);
-            break;
-        case FLOAT_IMG:
-            delete [] data;
-            data = reinterpret_cast<float *>(m_ImageBuffer);
-            break;
-        case LONGLONG_IMG:
-            getFloatBuffer<int64_t>(data, x, y, w, h);
-            break;
-        case DOUBLE_IMG:
-            getFloatBuffer<double>(data, x, y, w, h);
-            break;
-        default:
-            delete [] data;
+        status = sep_background(&bkgImage, 64, 64, 3, 3, 0.0, &bkg);
+        if (status == 0)
+            status = sep_bkg_subarray(bkg, data, SEP_TFLOAT);
+        if (status == 0)
+            m_SEPGlobalRMS = bkg->globalrms;
+        sep_bkg_free(bkg);
+
+        if (status != 0)
+        {
+            m_SEPBackground.clear();
+            m_SEPBackgroundBox = QRect();
+            char errorMessage[512];
+            sep_get_errmsg(status, errorMessage);
+            qCritical(KSTARS_FITS) << errorMessage;
             return -1;
+        }
+
+        m_SEPBackgroundBox = box;
     }
 
-    float * imback = nullptr;
-    double * flux = nullptr, *fluxerr = nullptr, *area = nullptr;
-    short * flag = nullptr;
     short flux_flag = 0;
-    int status = 0;
-    sep_bkg * bkg = nullptr;
     sep_catalog * catalog = nullptr;
     float conv[] = {1, 2, 1, 2, 4, 2, 1, 2, 1};
     double flux_fractions[2] = {0};
     double requested_frac[2] = { 0.5, 0.99 };
     QList<Edge *> edges;
 
-    // #0 Create SEP Image structure
-    sep_image im = {data, nullptr, nullptr, SEP_TFLOAT, 0, 0, w, h, 0.0, SEP_NOISE_NONE, 1.0, 0.0};
-
-    // #1 Background estimate
-    status = sep_background(&im, 64, 64, 3, 3, 0.0, &bkg);
-    if (status != 0) goto exit;
-
-    // #2 Background evaluation
-    imback = (float *)malloc((w * h) * sizeof(float));
-    status = sep_bkg_array(bkg, imback, SEP_TFLOAT);
-    if (status != 0) goto exit;
-
-    // #3 Background subtraction
-    status = sep_bkg_subarray(bkg, im.data, im.dtype);
-    if (status != 0) goto exit;
+    // #2 Create SEP Image structure over the background subtracted pixels
+    sep_image im = {m_SEPBackground.data(), nullptr, nullptr, SEP_TFLOAT, 0, 0, w, h, 0.0, SEP_NOISE_NONE, 1.0, 0.0};
 
-    // #4 Source Extraction
+    // #3 Source Extraction
     // Note that we set deblend_cont = 1.0 to turn off deblending.
-    status = sep_extract(&im, 2 * bkg->globalrms, SEP_THRESH_ABS, 10, conv, 3, 3, SEP_FILTER_CONV, 32, 1.0, 1, 1.0, &catalog);
+    status = sep_extract(&im, 2 * m_SEPGlobalRMS, SEP_THRESH_ABS, 10, conv, 3, 3, SEP_FILTER_CONV, 32, 1.0, 1, 1.0, &catalog);
     if (status != 0) goto exit;
 
     // TODO
@@ -4301,26 +4333,18 @@ int FITSData::findSEPStars(const QRect &boundary)
     {
         int starCount = qMin(100, edges.count());
         for (int i = 0; i < starCount; i++)
-            starCenters.append(edges[i]);
+            stars.append(edges[i]);
     }
 
     edges.clear();
 
     qCDebug(KSTARS_FITS) << qSetFieldWidth(10) << "#" << "#X" << "#Y" << "#Flux" << "#Width" << "#HFR";
-    for (int i = 0; i < starCenters.count(); i++)
-        qCDebug(KSTARS_FITS) << qSetFieldWidth(10) << i << starCenters[i]->x << starCenters[i]->y
-                             << starCenters[i]->sum << starCenters[i]->width << starCenters[i]->HFR;
+    for (int i = 0; i < stars.count(); i++)
+        qCDebug(KSTARS_FITS) << qSetFieldWidth(10) << i << stars[i]->x << stars[i]->y
+                             << stars[i]->sum << stars[i]->width << stars[i]->HFR;
 
 exit:
-    if (stats.bitpix != FLOAT_IMG)
-        delete [] data;
-    sep_bkg_free(bkg);
     sep_catalog_free(catalog);
-    free(imback);
-    free(flux);
-    free(fluxerr);
-    free(area);
-    free(flag);
 
     if (status != 0)
     {
@@ -4330,27 +4354,119 @@ exit:
         return -1;
     }
 
-    return starCenters.count();
+    return stars.count();
 }
 
-template <typename T>
-void FITSData::getFloatBuffer(float * buffer, int x, int y, int w, int h)
+QVector<float> FITSData::getFloatPlane(const QRect &box)
 {
-    auto * rawBuffer = reinterpret_cast<T *>(m_ImageBuffer);
+    QRect const frame(0, 0, stats.width, stats.height);
+    QRect const area = box.isNull() ? frame : box.intersected(frame);
+
+    if (m_ImageBuffer == nullptr || area.isEmpty())
+        return QVector<float>();
+
+    QMutexLocker locker(&m_FloatPlaneMutex);
+
+    if (area == frame)
+    {
+        if (m_FloatPlane.isEmpty())
+        {
+            QVector<float> plane(area.width() * area.height());
+            if (convertToFloat(plane.data(), area) == false)
+                return QVector<float>();
+            m_FloatPlane = plane;
+        }
+        return m_FloatPlane;
+    }
+
+    if (m_FloatBoxPlane.isEmpty() || m_FloatBox != area)
+    {
+        QVector<float> plane(area.width() * area.height());
+
+        if (m_FloatPlane.isEmpty() == false)
+        {
+            // Already converted, only copy the rows of the box
+            for (int row = 0; row < area.height(); row++)
+                memcpy(plane.data() + row * area.width(),
+                       m_FloatPlane.constData() + (area.y() + row) * stats.width + area.x(),
+                       area.width() * sizeof(float));
+        }
+        else if (convertToFloat(plane.data(), area) == false)
+            return QVector<float>();
+
+        m_FloatBoxPlane = plane;
+        m_FloatBox      = area;
+    }
+
+    return m_FloatBoxPlane;
+}
+
+bool FITSData::convertToFloat(float * buffer, const QRect &box) const
+{
+    switch (m_DataType)
+    {
+        case TBYTE:
+            convertToFloat<uint8_t>(buffer, box);
+            break;
+        case TSHORT:
+            convertToFloat<int16_t>(buffer, box);
+            break;
+        case TUSHORT:
+            convertToFloat<uint16_t>(buffer, box);
+            break;
+        case TLONG:
+            convertToFloat<int32_t>(buffer, box);
+            break;
+        case TULONG:
+            convertToFloat<uint32_t>(buffer, box);
+            break;
+        case TFLOAT:
+            convertToFloat<float>(buffer, box);
+            break;
+        case TLONGLONG:
+            convertToFloat<int64_t>(buffer, box);
+            break;
+        case TDOUBLE:
+            convertToFloat<double>(buffer, box);
+            break;
+        default:
+            return false;
+    }
 
-    float * floatPtr = buffer;
+    return true;
+}
 
-    int x2 = x + w;
-    int y2 = y + h;
+template <typename T>
+void FITSData::convertToFloat(float * buffer, const QRect &box) const
+{
+    auto const * rawBuffer = reinterpret_cast<const T *>(m_ImageBuffer);
+    int const width = box.width();
 
-    for (int y1 = y; y1 < y2; y1++)
+    // Contiguous rows, which the compiler vectorizes
+    auto convertRows = [ = ](int start, int end)
     {
-        int offset = y1 * stats.width;
-        for (int x1 = x; x1 < x2; x1++)
+        for (int row = start; row < end; row++)
         {
-            *floatPtr++ = rawBuffer[offset + x1];
+            const T * source = rawBuffer + static_cast<size_t>(box.y() + row) * stats.width + box.x();
+            std::copy(source, source + width, buffer + static_cast<size_t>(row) * width);
         }
+    };
+
+    // Small boxes, e.g. guiding, are not worth the threads
+    int const nThreads = (width * box.height() < 1024 * 1024) ? 1 : QThread::idealThreadCount();
+    if (nThreads <= 1)
+    {
+        convertRows(0, box.height());
+        return;
     }
+
+    int const stride = box.height() / nThreads;
+    QList<QFuture<void>> futures;
+    for (int i = 0; i < nThreads; i++)
+        futures.append(QtConcurrent::run(convertRows, i * stride, (i == nThreads - 1) ? box.height() : (i + 1) * stride));
+
+    for (QFuture<void> &future : futures)
+        future.waitForFinished();
 }
 
 void FITSData::saveStatistics(Statistic &other)
@@ -32,6 +32,7 @@
 #include <fitsio.h>
 
 #include <QFuture>
+#include <QMutex>
 #include <QObject>
 #include <QRect>
 #include <QVariant>
@@ -160,6 +161,16 @@ class FITSData : public QObject
          */
         bool loadFITSFromMemory(const QString &inFilename, void *fits_buffer,
                                 size_t fits_buffer_size, bool silent);
+
+        /**
+         * @brief loadFITSFromMemory Loading FITS from a shared memory buffer.
+         * The buffer is kept as long as the data is open, so it may be released by the caller right away.
+         * @param inFilename Potential future path to FITS file (or compressed fits.gz), stored in a fitsdata class variable
+         * @param buffer The memory buffer containing the fits data, never written to.
+         * @param silent If set, error messages are ignored. If set to false, the error message will get displayed in a popup.
+         * @return bool indicating success or failure.
+         */
+        bool loadFITSFromMemory(const QString &inFilename, const QByteArray &buffer, bool silent = true);
         /* Save FITS */
         int saveFITS(const QString &newFilename);
         /* Rescale image lineary from image_buffer, fit to window if desired */
@@ -173,6 +184,14 @@ class FITSData : public QObject
         void clearImageBuffers();
         void setImageBuffer(uint8_t *buffer);
         uint8_t *getImageBuffer();
+        /**
+         * @brief getFloatPlane Samples of the first channel converted to float, e.g. for star detection.
+         * The plane is converted once and shared by the callers until the pixels change. The planes
+         * of the whole frame and of the last requested box are kept.
+         * @param box area to convert, the whole frame if null
+         * @return the samples of box row by row, empty if the data type is not supported
+         */
+        QVector<float> getFloatPlane(const QRect &box = QRect());
 
         // Statistics
         void saveStatistics(Statistic &other);
@@ -286,19 +305,31 @@ class FITSData : public QObject
         QList<Edge *> getStarCentersInSubFrame(QRect subFrame) const;
 
         int findStars(StarAlgorithm algorithm = ALGORITHM_CENTROID, const QRect &trackingBox = QRect());
+        /**
+         * @brief findStarsAsync Detect stars on the global thread pool, see FITSStarDetector.
+         * The detected stars are returned instead of being stored, so that the star centers used by
+         * the views are not touched by the worker. Hand them to setStarCenters() on the GUI thread.
+         * The data must not be modified until the search is done, the destructor waits for it.
+         * @return A QFuture that can be watched until the detected stars are available.
+         */
+        QFuture<QList<Edge *>> findStarsAsync(StarAlgorithm algorithm, const QRect &trackingBox = QRect());
+        /**
+         * @brief setStarCenters Replace the star centers with stars detected by findStarsAsync()
+         * @param stars the detected stars, FITSData takes ownership of them
+         * @param algorithm the algorithm that detected them
+         */
+        void setStarCenters(const QList<Edge *> &stars, StarAlgorithm algorithm);
 
         void getCenterSelection(int *x, int *y);
-        int findOneStar(const QRect &boundary);
+        int findOneStar(QList<Edge *> &stars, const QRect &boundary);
 
         // Star Detection - Partially customized Canny edge detection algorithm
-        static int findCannyStar(FITSData *data, const QRect &boundary = QRect());
+        static int findCannyStar(FITSData *data, QList<Edge *> &stars, const QRect &boundary = QRect());
         template <typename T>
-        static int findCannyStar(FITSData *data, const QRect &boundary);
+        static int findCannyStar(FITSData *data, QList<Edge *> &stars, const QRect &boundary);
 
         // Use SEP (Sextractor Library) to find stars
-        template <typename T>
-        void getFloatBuffer(float *buffer, int x, int y, int w, int h);
-        int findSEPStars(const QRect &boundary = QRect());
+        int findSEPStars(QList<Edge *> &stars, const QRect &boundary = QRect());
 
         // Apply ring filter to searched stars
         int filterStars(const float innerRadius, const float outerRadius);
@@ -447,6 +478,11 @@ class FITSData : public QObject
         int calculateMinMax(bool refresh = false);
         bool checkDebayer();
         void readWCSKeys();
+        /// Drop the float planes and the SEP background of the previous search, the pixels changed
+        void clearFloatPlanes();
+        bool convertToFloat(float *buffer, const QRect &box) const;
+        template <typename T>
+        void convertToFloat(float *buffer, const QRect &box) const;
 
         // FITS Record
         bool parseHeader();
@@ -464,12 +500,14 @@ class FITSData : public QObject
         void applyFilter(FITSScale type, uint8_t *targetImage, QVector<double> * min = nullptr, QVector<double> * max = nullptr);
         // Star Detect - Centroid
         template <typename T>
-        int findCentroid(const QRect &boundary, int initStdDev, int minEdgeWidth);
-        int findCentroid(const QRect &boundary = QRect(), int initStdDev = MINIMUM_STDVAR,
+        int findCentroid(QList<Edge *> &stars, const QRect &boundary, int initStdDev, int minEdgeWidth);
+        int findCentroid(QList<Edge *> &stars, const QRect &boundary = QRect(), int initStdDev = MINIMUM_STDVAR,
                          int minEdgeWidth = MINIMUM_PIXEL_RANGE);
         // Star Detect - Threshold
         template <typename T>
-        int findOneStar(const QRect &boundary);
+        int findOneStar(QList<Edge *> &stars, const QRect &boundary);
+        // Star detection of findStars() and findStarsAsync(), into stars. Returns the count, -1 on error.
+        int detectStars(StarAlgorithm algorithm, const QRect &trackingBox, QList<Edge *> &stars);
 
         template <typename T>
         void calculateMinMax();
@@ -514,6 +552,8 @@ class FITSData : public QObject
         bool m_isCompressed { false };
         /// Did we search for stars yet?
         bool starsSearched { false };
+        /// Search started by findStarsAsync(), if any
+        QFuture<QList<Edge *>> m_StarSearch;
         ///Star Selection Algorithm
         StarAlgorithm starAlgorithm { ALGORITHM_GRADIENT };
         /// Do we have WCS keywords in this FITS data?
@@ -527,6 +567,8 @@ class FITSData : public QObject
 
         /// Our very own file name
         QString m_Filename, m_compressedFilename;
+        /// FITS memory file read by fptr, decompressed from m_compressedFilename or shared with the loader
+        QByteArray m_FileBuffer;
         /// FITS Mode (Normal, WCS, Guide, Focus..etc)
         FITSMode m_Mode;
 
@@ -550,6 +592,15 @@ class FITSData : public QObject
         QList<Edge *> localStarCenters;
         /// The biggest fattest star in the image.
         Edge *maxHFRStar { nullptr };
+        /// Float planes shared by getFloatPlane(), of the whole frame and of m_FloatBox
+        QVector<float> m_FloatPlane;
+        QVector<float> m_FloatBoxPlane;
+        QRect m_FloatBox;
+        QMutex m_FloatPlaneMutex;
+        /// Background subtracted float copy of m_SEPBackgroundBox, kept for the next SEP search of the same area
+        QVector<float> m_SEPBackground;
+        QRect m_SEPBackgroundBox;
+        float m_SEPGlobalRMS { 0 };
 
         //uint8_t *m_BayerBuffer { nullptr };
         /// Bayer parameters
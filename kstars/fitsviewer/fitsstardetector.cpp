@@ -0,0 +1,83 @@
+/*  FITS Star Detector
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#include "fitsstardetector.h"
+
+#include "fitsdata.h"
+
+#include <fits_debug.h>
+
+FITSStarDetector::FITSStarDetector(QObject *parent) : QObject(parent)
+{
+}
+
+FITSStarDetector::~FITSStarDetector()
+{
+    cancel();
+}
+
+void FITSStarDetector::detect(FITSData *data, StarAlgorithm algorithm, const QRect &box)
+{
+    cancel();
+
+    m_Data      = data;
+    m_Algorithm = algorithm;
+    m_Watcher   = new QFutureWatcher<QList<Edge *>>();
+    connect(m_Watcher, &QFutureWatcher<QList<Edge *>>::finished, this, &FITSStarDetector::processResult);
+    m_Watcher->setFuture(data->findStarsAsync(algorithm, box));
+}
+
+void FITSStarDetector::cancel()
+{
+    if (m_Watcher == nullptr)
+        return;
+
+    // The detection cannot be interrupted. Let it finish on its own, and drop its stars then.
+    QFutureWatcher<QList<Edge *>> *watcher = m_Watcher;
+    m_Watcher = nullptr;
+    m_Data    = nullptr;
+
+    disconnect(watcher, nullptr, this, nullptr);
+    connect(watcher, &QFutureWatcher<QList<Edge *>>::finished, watcher, [watcher]()
+    {
+        qDeleteAll(watcher->result());
+        watcher->deleteLater();
+    });
+}
+
+bool FITSStarDetector::isRunning() const
+{
+    return m_Watcher != nullptr;
+}
+
+void FITSStarDetector::processResult()
+{
+    if (m_Watcher == nullptr)
+        return;
+
+    QList<Edge *> const stars = m_Watcher->result();
+    FITSData *data = m_Data;
+
+    m_Watcher->deleteLater();
+    m_Watcher = nullptr;
+    m_Data    = nullptr;
+
+    // The frame was deleted in the meantime
+    if (data == nullptr)
+    {
+        qDeleteAll(stars);
+        emit finished(nullptr, -1);
+        return;
+    }
+
+    // Back on the GUI thread, where the views use the star centers
+    data->setStarCenters(stars, m_Algorithm);
+
+    qCDebug(KSTARS_FITS) << "Star detection done," << stars.count() << "stars";
+    emit finished(data, stars.count());
+}
@@ -0,0 +1,78 @@
+/*  FITS Star Detector
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#pragma once
+
+#include "fitscommon.h"
+
+#include <QFutureWatcher>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QRect>
+
+class Edge;
+class FITSData;
+
+/**
+ * @class FITSStarDetector
+ * @short Runs FITSData::findStars() on the global thread pool
+ *
+ * Star detection on a full frame of a large sensor takes long enough to freeze the interface
+ * when it runs on the GUI thread. The modules hand the frame to a detector instead, and carry on
+ * when finished() is emitted, the stars being then available from the FITSData as usual.
+ *
+ * The stars are detected into a list of the worker, and only replace the star centers of the data
+ * on the GUI thread, when the detection is done, so that views painting the data never see them
+ * change under their feet.
+ *
+ * The data must not be modified while the detection runs. cancel() discards the result of a
+ * running detection without waiting for it, its stars are deleted when it is done. Deleting the
+ * data waits for the detection, whose result is then discarded.
+ *
+ * Detections of the same frame reuse the float conversion and background map computed by the
+ * first SEP pass, see FITSData::findSEPStars().
+ */
+class FITSStarDetector : public QObject
+{
+        Q_OBJECT
+
+    public:
+        explicit FITSStarDetector(QObject *parent = nullptr);
+        ~FITSStarDetector() override;
+
+        /**
+         * @brief Start detecting stars, discarding any running detection
+         * @param data the frame, must stay unmodified until finished() or cancel()
+         * @param algorithm the detection algorithm
+         * @param box the area to search, the whole frame if null
+         */
+        void detect(FITSData *data, StarAlgorithm algorithm, const QRect &box = QRect());
+
+        /** Discard the running detection, if any, without waiting for it */
+        void cancel();
+
+        /** @return true while a detection runs */
+        bool isRunning() const;
+
+    signals:
+        /**
+         * @brief The detection started by detect() is done
+         * @param data the frame, null if it was deleted in the meantime
+         * @param count the number of stars found, -1 if the data was deleted
+         */
+        void finished(FITSData *data, int count);
+
+    private:
+        void processResult();
+
+        /** Watcher of the running detection, null if none runs */
+        QFutureWatcher<QList<Edge *>> *m_Watcher { nullptr };
+        QPointer<FITSData> m_Data;
+        StarAlgorithm m_Algorithm { ALGORITHM_SEP };
+};
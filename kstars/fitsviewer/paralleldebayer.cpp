@@ -0,0 +1,242 @@
+/*  Parallel Debayer
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#include "paralleldebayer.h"
+
+#include <QFuture>
+#include <QList>
+#include <QThread>
+#include <QVector>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+/// Rows decoded above and below each band, over the 5x5 neighbourhood of VNG and a multiple of the bayer period
+const uint32_t BandMargin = 8;
+/// Frames with fewer pixels are decoded in one piece
+const uint32_t MinParallelPixels = 1024 * 1024;
+
+/** Copy rows [start, end) of a decoded band to their place in the destination */
+template <typename T>
+void storeRows(const T *band, uint32_t bandTop, uint32_t start, uint32_t end, T *rgb, uint32_t width,
+               uint32_t height, ParallelDebayer::Layout layout, uint32_t rowStride)
+{
+    const T *source = band + static_cast<size_t>(start - bandTop) * width * 3;
+
+    if (layout == ParallelDebayer::RGB_INTERLEAVED)
+    {
+        for (uint32_t row = start; row < end; row++, source += width * 3)
+            memcpy(rgb + static_cast<size_t>(row) * rowStride, source, width * 3 * sizeof(T));
+        return;
+    }
+
+    size_t const plane = static_cast<size_t>(width) * height;
+    size_t const count = static_cast<size_t>(end - start) * width;
+    T *red   = rgb + static_cast<size_t>(start) * width;
+    T *green = red + plane;
+    T *blue  = green + plane;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        red[i]   = source[i * 3];
+        green[i] = source[i * 3 + 1];
+        blue[i]  = source[i * 3 + 2];
+    }
+}
+
+/**
+ * Decode height rows of bayer into rgb with decode(bayer, rgb, width, height), in parallel bands
+ * when allowed. frameHeight is the height of the destination planes.
+ */
+template <typename T, typename Decoder>
+dc1394error_t decodeBands(const T *bayer, T *rgb, uint32_t width, uint32_t height, uint32_t frameHeight,
+                          ParallelDebayer::Layout layout, uint32_t rowStride, bool parallel,
+                          std::vector<uint8_t> &scratch, Decoder decode)
+{
+    uint32_t nBands = 1;
+    if (parallel && width * height >= MinParallelPixels)
+        nBands = std::max(1, QThread::idealThreadCount());
+
+    // Bands start on a multiple of the margin, so that each one starts on the same bayer row
+    uint32_t bandHeight = (height + nBands - 1) / nBands;
+    bandHeight = std::max(BandMargin, (bandHeight + BandMargin - 1) / BandMargin * BandMargin);
+    nBands = (height + bandHeight - 1) / bandHeight;
+
+    if (nBands <= 1)
+    {
+        if (layout == ParallelDebayer::RGB_INTERLEAVED && rowStride == width * 3)
+            return decode(bayer, rgb, width, height);
+
+        scratch.resize(static_cast<size_t>(width) * height * 3 * sizeof(T));
+        T *band = reinterpret_cast<T *>(scratch.data());
+        dc1394error_t const error = decode(bayer, band, width, height);
+        if (error == DC1394_SUCCESS)
+            storeRows(band, 0, 0, height, rgb, width, frameHeight, layout, rowStride);
+        return error;
+    }
+
+    // Place of each band with its margins in the scratch buffer
+    QVector<size_t> offsets(nBands + 1);
+    offsets[0] = 0;
+    for (uint32_t i = 0; i < nBands; i++)
+    {
+        uint32_t const start  = i * bandHeight;
+        uint32_t const end    = std::min(height, start + bandHeight);
+        uint32_t const top    = start > BandMargin ? start - BandMargin : 0;
+        uint32_t const bottom = std::min(height, end + BandMargin);
+        offsets[i + 1] = offsets[i] + static_cast<size_t>(bottom - top) * width * 3;
+    }
+    scratch.resize(offsets[nBands] * sizeof(T));
+
+    QList<QFuture<dc1394error_t>> futures;
+    for (uint32_t i = 0; i < nBands; i++)
+    {
+        uint32_t const start  = i * bandHeight;
+        uint32_t const end    = std::min(height, start + bandHeight);
+        uint32_t const top    = start > BandMargin ? start - BandMargin : 0;
+        uint32_t const bottom = std::min(height, end + BandMargin);
+        T *band = reinterpret_cast<T *>(scratch.data()) + offsets[i];
+
+        futures.append(QtConcurrent::run([ = ]()
+        {
+            dc1394error_t const error = decode(bayer + static_cast<size_t>(top) * width, band, width, bottom - top);
+            if (error == DC1394_SUCCESS)
+                storeRows(band, top, start, end, rgb, width, frameHeight, layout, rowStride);
+            return error;
+        }));
+    }
+
+    dc1394error_t result = DC1394_SUCCESS;
+    for (QFuture<dc1394error_t> &future : futures)
+    {
+        if (future.result() != DC1394_SUCCESS)
+            result = future.result();
+    }
+
+    return result;
+}
+}
+
+dc1394error_t ParallelDebayer::debayer(const uint8_t *bayer, uint8_t *rgb, uint32_t width, uint32_t height,
+                                       const BayerParams &params, Layout layout, uint32_t rowStride)
+{
+    uint32_t decodedHeight = height;
+    const uint8_t *source  = bayer;
+
+    if (params.offsetY == 1)
+    {
+        source += width;
+        decodedHeight--;
+    }
+    if (params.offsetX == 1)
+        source++;
+
+    bool const parallel = params.method != DC1394_BAYER_METHOD_AHD && params.method != DC1394_BAYER_METHOD_DOWNSAMPLE;
+
+    return decodeBands(source, rgb, width, decodedHeight, height, layout, rowStride ? rowStride : width * 3, parallel,
+                       m_Scratch, [params](const uint8_t *in, uint8_t *out, uint32_t w, uint32_t h)
+    {
+        return dc1394_bayer_decoding_8bit(in, out, w, h, params.filter, params.method);
+    });
+}
+
+dc1394error_t ParallelDebayer::debayer(const uint16_t *bayer, uint16_t *rgb, uint32_t width, uint32_t height,
+                                       const BayerParams &params, Layout layout, uint32_t rowStride, uint32_t bits)
+{
+    uint32_t decodedHeight = height;
+    const uint16_t *source = bayer;
+
+    if (params.offsetY == 1)
+    {
+        source += width;
+        decodedHeight--;
+    }
+    if (params.offsetX == 1)
+        source++;
+
+    bool const parallel = params.method != DC1394_BAYER_METHOD_AHD && params.method != DC1394_BAYER_METHOD_DOWNSAMPLE;
+
+    return decodeBands(source, rgb, width, decodedHeight, height, layout, rowStride ? rowStride : width * 3, parallel,
+                       m_Scratch, [params, bits](const uint16_t *in, uint16_t *out, uint32_t w, uint32_t h)
+    {
+        return dc1394_bayer_decoding_16bit(in, out, w, h, params.filter, params.method, bits);
+    });
+}
+
+dc1394error_t ParallelDebayer::superPixel(const uint8_t *bayer, uint8_t *rgb, uint32_t width, uint32_t height,
+                                          const BayerParams &params, uint32_t rowStride)
+{
+    // Position of red and blue in the 2x2 cell, green is on the other diagonal
+    int redX = 0, redY = 0;
+    switch (params.filter)
+    {
+        case DC1394_COLOR_FILTER_RGGB:
+            break;
+        case DC1394_COLOR_FILTER_BGGR:
+            redX = redY = 1;
+            break;
+        case DC1394_COLOR_FILTER_GRBG:
+            redX = 1;
+            break;
+        case DC1394_COLOR_FILTER_GBRG:
+            redY = 1;
+            break;
+        default:
+            return DC1394_INVALID_COLOR_FILTER;
+    }
+
+    uint32_t const outWidth  = (width - params.offsetX) / 2;
+    uint32_t const outHeight = (height - params.offsetY) / 2;
+    uint32_t const stride    = rowStride ? rowStride : outWidth * 3;
+
+    auto decodeRows = [ = ](uint32_t start, uint32_t end)
+    {
+        for (uint32_t y = start; y < end; y++)
+        {
+            const uint8_t *cell[2];
+            cell[0] = bayer + static_cast<size_t>(2 * y + params.offsetY) * width + params.offsetX;
+            cell[1] = cell[0] + width;
+
+            const uint8_t *red    = cell[redY] + redX;
+            const uint8_t *blue   = cell[1 - redY] + 1 - redX;
+            const uint8_t *green1 = cell[redY] + 1 - redX;
+            const uint8_t *green2 = cell[1 - redY] + redX;
+            uint8_t *out = rgb + static_cast<size_t>(y) * stride;
+
+            for (uint32_t x = 0; x < outWidth; x++)
+            {
+                out[x * 3]     = red[x * 2];
+                out[x * 3 + 1] = static_cast<uint8_t>((green1[x * 2] + green2[x * 2] + 1) >> 1);
+                out[x * 3 + 2] = blue[x * 2];
+            }
+        }
+    };
+
+    uint32_t nBands = 1;
+    if (outWidth * outHeight * 4 >= MinParallelPixels)
+        nBands = std::max(1, QThread::idealThreadCount());
+
+    if (nBands <= 1)
+    {
+        decodeRows(0, outHeight);
+        return DC1394_SUCCESS;
+    }
+
+    uint32_t const bandHeight = (outHeight + nBands - 1) / nBands;
+    QList<QFuture<void>> futures;
+    for (uint32_t start = 0; start < outHeight; start += bandHeight)
+        futures.append(QtConcurrent::run(decodeRows, start, std::min(outHeight, start + bandHeight)));
+
+    for (QFuture<void> &future : futures)
+        future.waitForFinished();
+
+    return DC1394_SUCCESS;
+}
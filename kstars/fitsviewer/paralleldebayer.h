@@ -0,0 +1,76 @@
+/*  Parallel Debayer
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#pragma once
+
+#include "bayer.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class ParallelDebayer
+ * @short Decodes bayer frames on all cores with the dc1394 methods
+ *
+ * The frame is cut in row bands, each decoded by dc1394 on the global thread pool. Every band is
+ * decoded with a margin of rows above and below, which covers the neighbourhood of the methods,
+ * and only its own rows are kept, so the result is the same as decoding the whole frame at once.
+ * AHD, whose setup is not thread safe, and DOWNSAMPLE, which writes a half size frame, are
+ * decoded in one piece.
+ *
+ * The decoded bands are written interleaved (RGBRGB...) with any row stride, e.g. straight into a
+ * QImage, or planar (RR...GG...BB...) as in FITS. The band buffers are kept between frames, so a
+ * debayer instance should live as long as the stream it decodes.
+ *
+ * superPixel() turns each 2x2 bayer cell into one pixel, for previews which are displayed at half
+ * the size of the sensor or less anyway.
+ *
+ * The offsets of the BayerParams are applied the same way as by the former direct dc1394 calls:
+ * the first row and column are skipped, and the last row of the destination is left untouched.
+ */
+class ParallelDebayer
+{
+    public:
+        typedef enum
+        {
+            RGB_INTERLEAVED,
+            RGB_PLANAR
+        } Layout;
+
+        ParallelDebayer() = default;
+
+        /**
+         * @brief debayer Decode a bayer frame
+         * @param bayer width x height source samples
+         * @param rgb width x height x 3 destination samples, must not overlap the source
+         * @param width width of the frame in pixels
+         * @param height height of the frame in pixels
+         * @param params dc1394 method, pattern and offsets
+         * @param layout layout of the destination
+         * @param rowStride samples between the starts of two destination rows when interleaved,
+         * 0 for width x 3
+         * @return DC1394_SUCCESS or the error of dc1394
+         */
+        dc1394error_t debayer(const uint8_t *bayer, uint8_t *rgb, uint32_t width, uint32_t height,
+                              const BayerParams &params, Layout layout, uint32_t rowStride = 0);
+        dc1394error_t debayer(const uint16_t *bayer, uint16_t *rgb, uint32_t width, uint32_t height,
+                              const BayerParams &params, Layout layout, uint32_t rowStride = 0, uint32_t bits = 16);
+
+        /**
+         * @brief superPixel Decode a bayer frame at half resolution, interleaved
+         * @param rgb (width - offsetX) / 2 x (height - offsetY) / 2 x 3 destination samples
+         * @param rowStride samples between the starts of two destination rows, 0 for packed rows
+         * @return DC1394_SUCCESS, or DC1394_INVALID_COLOR_FILTER
+         */
+        static dc1394error_t superPixel(const uint8_t *bayer, uint8_t *rgb, uint32_t width, uint32_t height,
+                                        const BayerParams &params, uint32_t rowStride = 0);
+
+    private:
+        /// Band buffers, reused by the next frames of the same size
+        std::vector<uint8_t> m_Scratch;
+};
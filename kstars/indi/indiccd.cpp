@@ -98,8 +98,8 @@ bool WriteImageFileInternal(const QString &filename, char *buffer, const size_t
     return true;
 }
 
-// Internal function to write a temporary file image blob to disk.
-bool writeTempImageFile(const QString &format, char * buffer, size_t size, QString *filename)
+// Internal function to create an empty temporary image file, to be written later.
+bool createTempImageFile(const QString &format, QString *filename)
 {
     QTemporaryFile tmpFile(QDir::tempPath() + "/fitsXXXXXX" + format);
     tmpFile.setAutoRemove(false);
@@ -110,17 +110,20 @@ bool writeTempImageFile(const QString &format, char * buffer, size_t size, QStri
                                 tmpFile.fileName();
         return false;
     }
-
-    QDataStream out(&tmpFile);
-    size_t n = 0;
-    for (size_t nr = 0; nr < size; nr += n)
-        n = out.writeRawData(buffer + nr, size - nr);
-    tmpFile.flush();
     tmpFile.close();
 
     *filename = tmpFile.fileName();
     return true;
 }
+
+// Internal function to write a temporary file image blob to disk.
+bool writeTempImageFile(const QString &format, char * buffer, size_t size, QString *filename)
+{
+    if (!createTempImageFile(format, filename))
+        return false;
+
+    return WriteImageFileInternal(*filename, buffer, size, false, QString());
+}
 }
 
 namespace ISD
@@ -917,6 +920,7 @@ CCD::CCD(GDInterface *iPtr) : DeviceDecorator(iPtr)
     connect(m_Media.get(), &WSMedia::newFile, this, &CCD::setWSBLOB);
 
     connect(clientManager, &ClientManager::newBLOBManager, this, &CCD::setBLOBManager, Qt::UniqueConnection);
+    connect(&m_FITSFrameWatcher, &QFutureWatcher<LoadedFITSFrame>::finished, this, &CCD::processLoadedFITSFrame);
     m_LastNotificationTS = QDateTime::currentDateTime();
 }
 
@@ -924,10 +928,13 @@ CCD::~CCD()
 {
     if (m_ImageViewerWindow)
         m_ImageViewerWindow->close();
-    if (fileWriteThread.isRunning())
-        fileWriteThread.waitForFinished();
-    if (fileWriteBuffer != nullptr)
-        delete [] fileWriteBuffer;
+
+    // Wait for the frame being written, the queued ones are dropped
+    if (m_LoadingFITSFrame.chip != nullptr)
+    {
+        m_FITSFrameWatcher.waitForFinished();
+        delete m_FITSFrameWatcher.result().data;
+    }
 }
 
 void CCD::setBLOBManager(const char *device, INDI::Property *prop)
@@ -1443,50 +1450,140 @@ bool CCD::generateFilename(const QString &format, bool batch_mode, QString *file
     return true;
 }
 
-bool CCD::writeImageFile(IBLOB *bp, const QString &format, bool is_fits,
-                         bool batch_mode, QString *filename)
+bool CCD::writeImageFile(IBLOB *bp, const QString &format, bool batch_mode, QString *filename)
 {
     if (!generateFilename(format, batch_mode, filename))
         return false;
 
-    // TODO: Not yet threading the writes for non-fits files.
-    // Would need to deal with the raw conversion, etc.
-    if (is_fits)
-    {
+    return WriteImageFileInternal(*filename, static_cast<char*>(bp->blob), bp->size, false, filter);
+}
 
-        // Check if the last write is still ongoing, and if so wait.
-        // It is using the fileWriteBuffer.
-        if (fileWriteThread.isRunning())
+void CCD::queueFITSFrame(const FITSFrame &frame)
+{
+    // A temporary frame (preview, focus, guide...) is superseded by the next one of its chip and
+    // capture mode, so when frames arrive faster than they can be loaded only the latest one is
+    // kept. A frame of another mode has a different consumer waiting for it, and frames of a batch
+    // must reach the disk, so those are all kept.
+    if (frame.temporary)
+    {
+        for (auto it = m_PendingFITSFrames.begin(); it != m_PendingFITSFrames.end();)
         {
-            fileWriteThread.waitForFinished();
+            if (it->temporary && it->chip == frame.chip && it->mode == frame.mode)
+            {
+                qCDebug(KSTARS_INDI) << "Dropping stale frame" << it->filename;
+                QFile::remove(it->filename);
+                it = m_PendingFITSFrames.erase(it);
+            }
+            else
+                ++it;
         }
+    }
+
+    m_PendingFITSFrames.enqueue(frame);
+    processNextFITSFrame();
+}
+
+void CCD::processNextFITSFrame()
+{
+    if (m_LoadingFITSFrame.chip != nullptr || m_PendingFITSFrames.isEmpty())
+        return;
+
+    m_LoadingFITSFrame = m_PendingFITSFrames.dequeue();
+    m_FITSFrameWatcher.setFuture(QtConcurrent::run(&CCD::loadFITSFrame, m_LoadingFITSFrame));
+}
+
+CCD::LoadedFITSFrame CCD::loadFITSFrame(const FITSFrame &frame)
+{
+    LoadedFITSFrame result;
+
+    // Write the file while the frame is decoded
+    QFuture<bool> writer;
+    if (!frame.data.isEmpty())
+        writer = QtConcurrent::run(WriteImageFileInternal, frame.filename, const_cast<char *>(frame.data.constData()),
+                                   static_cast<size_t>(frame.data.size()), true, frame.filter);
+
+    FITSData *data = new FITSData(frame.mode);
+    bool const loaded = frame.data.isEmpty() ? data->loadFITS(frame.filename).result() :
+                        data->loadFITSFromMemory(frame.filename, frame.data);
+
+    result.written = frame.data.isEmpty() || writer.result();
+
+    if (loaded && result.written)
+    {
+        // Created here, but used on the GUI thread
+        data->moveToThread(QCoreApplication::instance()->thread());
+        result.data = data;
+    }
+    else
+        delete data;
+
+    return result;
+}
+
+void CCD::processLoadedFITSFrame()
+{
+    FITSFrame const frame = m_LoadingFITSFrame;
+    LoadedFITSFrame const loaded = m_FITSFrameWatcher.result();
+    m_LoadingFITSFrame = FITSFrame();
+
+    if (!loaded.written)
+    {
+        qCCritical(KSTARS_INDI) << "ISD:CCD Error: Unable to write" << frame.filename;
+        emit BLOBUpdated(nullptr);
+    }
+    else if (loaded.data == nullptr)
+    {
+        // If reading the blob fails, we treat it the same as exposure failure
+        // and recapture again if possible
+        qCCritical(KSTARS_INDI) << "failed reading FITS memory buffer";
+        emit newExposureValue(frame.chip, 0, IPS_ALERT);
+    }
+    else
+    {
+        // store file name
+        strncpy(BLOBFilename, frame.filename.toLatin1(), MAXINDIFILENAME);
+        BType = BLOB_FITS;
+        m_FITSFrameBLOB      = frame.blob;
+        m_FITSFrameBLOB.aux0 = frame.chip;
+        m_FITSFrameBLOB.aux1 = &BType;
+        m_FITSFrameBLOB.aux2 = BLOBFilename;
 
-        // Will write blob data in a separate thread, and can't depend on the blob
-        // memory, so copy it first.
+        displayFits(frame.chip, frame.filename, &m_FITSFrameBLOB, loaded.data, frame.mode, frame.batchMode);
+    }
+
+    processNextFITSFrame();
+}
 
-        // Check buffer size.
-        if (fileWriteBufferSize != bp->size)
+QByteArray CCD::pooledBLOBBuffer(const char *data, int size)
+{
+    // A buffer is free once the pool holds its only reference
+    for (QByteArray &buffer : m_BLOBBuffers)
+    {
+        if (buffer.isDetached() && buffer.capacity() >= size)
         {
-            if (fileWriteBuffer != nullptr)
-                delete [] fileWriteBuffer;
-            fileWriteBufferSize = bp->size;
-            fileWriteBuffer = new char[fileWriteBufferSize];
+            buffer.resize(size);
+            memcpy(buffer.data(), data, size);
+            return buffer;
         }
-
-        // Copy memory, and write file on a separate thread.
-        // Probably too late to return an error if the file couldn't write.
-        memcpy(fileWriteBuffer, bp->blob, bp->size);
-        fileWriteThread = QtConcurrent::run(WriteImageFileInternal, *filename,
-                                            fileWriteBuffer, bp->size, is_fits, filter);
-        filter = "";
     }
+
+    QByteArray buffer(data, size);
+    if (m_BLOBBuffers.size() < MaxBLOBBuffers)
+        m_BLOBBuffers.append(buffer);
     else
     {
-        if (!WriteImageFileInternal(*filename, static_cast<char*>(bp->blob), bp->size,
-                                    false, filter))
-            return false;
+        // Replace a free buffer, too small for this frame, so that the pool follows the frame size
+        for (QByteArray &pooled : m_BLOBBuffers)
+        {
+            if (pooled.isDetached())
+            {
+                pooled = buffer;
+                break;
+            }
+        }
     }
-    return true;
+
+    return buffer;
 }
 
 void CCD::setupFITSViewerWindows()
@@ -1564,21 +1661,64 @@ void CCD::processBLOB(IBLOB *bp)
     // 1. file is preview or batch mode is not enabled
     // 2. file type is not FITS_NORMAL (focus, guide..etc)
     QString filename;
-    if (targetChip->isBatchMode() == false || targetChip->getCaptureMode() != FITS_NORMAL)
+    bool const temporary = targetChip->isBatchMode() == false || targetChip->getCaptureMode() != FITS_NORMAL;
+
+#ifdef HAVE_CFITSIO
+    // FITS frames are written and decoded on the thread pool, only the file is created here
+    if (BType == BLOB_FITS)
     {
-        if (!writeTempImageFile(format, static_cast<char *>(bp->blob), bp->size, &filename))
+        if (temporary ? !createTempImageFile(format, &filename) : !generateFilename(format, true, &filename))
         {
             emit BLOBUpdated(nullptr);
             return;
         }
-        if (BType == BLOB_FITS)
-            addFITSKeywords(filename, filter);
 
+        FITSFrame frame;
+        frame.chip      = targetChip;
+        frame.blob      = *bp;
+        frame.mode      = targetChip->getCaptureMode();
+        frame.batchMode = targetChip->isBatchMode();
+        frame.filename  = filename;
+        frame.filter    = filter;
+        frame.data      = pooledBLOBBuffer(static_cast<const char *>(bp->blob), bp->size);
+        frame.temporary = temporary;
+        // The content is in frame.data
+        frame.blob.blob    = nullptr;
+        frame.blob.bloblen = frame.blob.size = 0;
+
+        if (!temporary)
+        {
+            // The filter name is only added to the first frame of a batch
+            filter = "";
+
+            KStars::Instance()->statusBar()->showMessage(i18n("%1 file saved to %2", shortFormat.toUpper(), filename), 0);
+            qCInfo(KSTARS_INDI) << shortFormat.toUpper() << "file saved to" << filename;
+        }
+
+        // Don't spam, just one notification per 3 seconds
+        if (QDateTime::currentDateTime().secsTo(m_LastNotificationTS) <= -3)
+        {
+            KNotification::event(QLatin1String("FITSReceived"), i18n("Image file is received"));
+            m_LastNotificationTS = QDateTime::currentDateTime();
+        }
+
+        queueFITSFrame(frame);
+        return;
+    }
+#endif
+
+    if (temporary)
+    {
+        if (!writeTempImageFile(format, static_cast<char *>(bp->blob), bp->size, &filename))
+        {
+            emit BLOBUpdated(nullptr);
+            return;
+        }
     }
     // Create file name for others
     else
     {
-        if (!writeImageFile(bp, format, BType == BLOB_FITS, targetChip->isBatchMode(), &filename))
+        if (!writeImageFile(bp, format, targetChip->isBatchMode(), &filename))
         {
             emit BLOBUpdated(nullptr);
             return;
@@ -1653,20 +1793,17 @@ void CCD::processBLOB(IBLOB *bp)
 
             emit previewFITSGenerated(output);
 
-            FITSData *blob_fits_data = new FITSData(targetChip->getCaptureMode());
-
-            QFuture<bool> fitsloader = blob_fits_data->loadFITS(filename, false);
-            fitsloader.waitForFinished();
-            if (!fitsloader.result())
-            {
-                // If reading the blob fails, we treat it the same as exposure failure
-                // and recapture again if possible
-                delete (blob_fits_data);
-                qCCritical(KSTARS_INDI) << "failed reading FITS memory buffer";
-                emit newExposureValue(targetChip, 0, IPS_ALERT);
-                return;
-            }
-            displayFits(targetChip, filename, bp, blob_fits_data);
+            // Loaded from the converted file on the thread pool
+            FITSFrame frame;
+            frame.chip      = targetChip;
+            frame.blob      = *bp;
+            frame.mode      = targetChip->getCaptureMode();
+            frame.batchMode = targetChip->isBatchMode();
+            frame.filename  = filename;
+            frame.temporary = temporary;
+            frame.blob.blob    = nullptr;
+            frame.blob.bloblen = frame.blob.size = 0;
+            queueFITSFrame(frame);
             return;
         }
         else if (useDSLRViewer)
@@ -1680,36 +1817,19 @@ void CCD::processBLOB(IBLOB *bp)
         }
     }
     // Unless we have cfitsio, we're done.
-#ifdef HAVE_CFITSIO
-    if (BType == BLOB_FITS)
-    {
-        FITSData *blob_fits_data = new FITSData(targetChip->getCaptureMode());
-
-        if (!blob_fits_data->loadFITSFromMemory(filename, bp->blob, bp->size, false))
-        {
-            // If reading the blob fails, we treat it the same as exposure failure
-            // and recapture again if possible
-            delete (blob_fits_data);
-            qCCritical(KSTARS_INDI) << "failed reading FITS memory buffer";
-            emit newExposureValue(targetChip, 0, IPS_ALERT);
-            return;
-        }
-
-        displayFits(targetChip, filename, bp, blob_fits_data);
-    }
-    else
-        emit BLOBUpdated(bp);
-#endif
+    emit BLOBUpdated(bp);
 }
 
-void CCD::displayFits(CCDChip *targetChip, const QString &filename, IBLOB *bp, FITSData *blob_fits_data)
+void CCD::displayFits(CCDChip *targetChip, const QString &filename, IBLOB *bp, FITSData *blob_fits_data,
+                      FITSMode captureMode, bool batchMode)
 {
-    FITSMode captureMode = targetChip->getCaptureMode();
+    // The chip may have moved on to another capture since the frame was received, so the modes
+    // of the frame are passed in.
 
     // Get or Create FITSViewer if we are using FITSViewer
     // or if capture mode is calibrate since for now we are forced to open the file in the viewer
     // this should be fixed in the future and should only use FITSData
-    if (Options::useFITSViewer() || targetChip->isBatchMode() == false)
+    if (Options::useFITSViewer() || batchMode == false)
     {
         if (m_FITSViewerWindows.isNull() &&
                 (captureMode == FITS_NORMAL || captureMode == FITS_CALIBRATE))
@@ -1722,7 +1842,7 @@ void CCD::displayFits(CCDChip *targetChip, const QString &filename, IBLOB *bp, F
         case FITS_CALIBRATE:
         {
             // Check if we need to display the image
-            if (Options::useFITSViewer() || targetChip->isBatchMode() == false)
+            if (Options::useFITSViewer() || batchMode == false)
             {
                 bool success;
                 int tabIndex;
@@ -1735,7 +1855,7 @@ void CCD::displayFits(CCDChip *targetChip, const QString &filename, IBLOB *bp, F
                     // single tab called "Preview", then set the title to "Preview",
                     // Otherwise, the title will be the captured image name
                     QString previewTitle;
-                    if (targetChip->isBatchMode() == false && Options::singlePreviewFITS())
+                    if (batchMode == false && Options::singlePreviewFITS())
                     {
                         // If we are displaying all images from all cameras in a single FITS
                         // Viewer window, then we prefix the camera name to the "Preview" string
@@ -1778,14 +1898,13 @@ void CCD::displayFits(CCDChip *targetChip, const QString &filename, IBLOB *bp, F
         case FITS_FOCUS:
         case FITS_GUIDE:
         case FITS_ALIGN:
-            loadImageInView(bp, targetChip, blob_fits_data);
+            loadImageInView(bp, targetChip, blob_fits_data, captureMode, batchMode);
             break;
     }
 }
 
-void CCD::loadImageInView(IBLOB *bp, ISD::CCDChip *targetChip, FITSData *data)
+void CCD::loadImageInView(IBLOB *bp, ISD::CCDChip *targetChip, FITSData *data, FITSMode mode, bool batchMode)
 {
-    FITSMode mode = targetChip->getCaptureMode();
     FITSView *view = targetChip->getImageView(mode);
     QString filename = QString(static_cast<const char *>(bp->aux2));
 
@@ -1802,7 +1921,7 @@ void CCD::loadImageInView(IBLOB *bp, ISD::CCDChip *targetChip, FITSData *data)
         // Image in preview mode, or useFITSViewer is true; AND
         // Image type is either NORMAL or CALIBRATION since the rest have their dedicated windows.
         // NORMAL is used for raw INDI drivers without Ekos.
-        if ( (Options::useFITSViewer() || targetChip->isBatchMode() == false) &&
+        if ( (Options::useFITSViewer() || batchMode == false) &&
                 (mode == FITS_NORMAL || mode == FITS_CALIBRATE))
             m_FITSViewerWindows->show();
 
@@ -18,6 +18,7 @@
 
 #include <QStringList>
 #include <QPointer>
+#include <QQueue>
 #include <QtConcurrent>
 
 #include <memory>
@@ -350,15 +351,52 @@ class CCD : public DeviceDecorator
         void captureFailed();
 
     private:
+        /**
+         * A FITS frame received from the driver. It is written to disk and decoded on the thread pool
+         * by loadFITSFrame(), and only the loaded FITSData comes back to the GUI thread.
+         */
+        struct FITSFrame
+        {
+            CCDChip *chip { nullptr };
+            /** Copy of the BLOB header, the driver reuses its IBLOB for the next BLOB */
+            IBLOB blob {};
+            /** Capture and batch mode of the chip when the frame was received */
+            FITSMode mode { FITS_NORMAL };
+            bool batchMode { false };
+            QString filename;
+            QString filter;
+            /** Content of the BLOB, empty if the frame is to be loaded from filename */
+            QByteArray data;
+            /** The file is a temporary one, not part of a batch */
+            bool temporary { true };
+        };
+
+        /** Outcome of loadFITSFrame() */
+        struct LoadedFITSFrame
+        {
+            bool written { false };
+            FITSData *data { nullptr };
+        };
+
         void processStream(IBLOB *bp);
-        void loadImageInView(IBLOB *bp, ISD::CCDChip *targetChip, FITSData *data);
+        void loadImageInView(IBLOB *bp, ISD::CCDChip *targetChip, FITSData *data, FITSMode mode, bool batchMode);
         bool generateFilename(const QString &format, bool batch_mode, QString *filename);
-        // Saves an image to disk on a separate thread.
-        bool writeImageFile(IBLOB *bp, const QString &format, bool is_fits,
-                            bool batch_mode, QString *filename);
+        // Saves a non-FITS image to disk, FITS frames go through queueFITSFrame().
+        bool writeImageFile(IBLOB *bp, const QString &format, bool batch_mode, QString *filename);
+        // Queue a FITS frame for loading, dropping the stale temporary frames of its chip.
+        void queueFITSFrame(const FITSFrame &frame);
+        // Start loading the next queued FITS frame unless one is being loaded.
+        void processNextFITSFrame();
+        // Hand the loaded FITS frame to the view and the modules.
+        void processLoadedFITSFrame();
+        // Write and decode a FITS frame in parallel, runs on the thread pool.
+        static LoadedFITSFrame loadFITSFrame(const FITSFrame &frame);
+        // Copy BLOB data into a buffer of the pool.
+        QByteArray pooledBLOBBuffer(const char *data, int size);
         // Creates or finds the FITSViewer.
         void setupFITSViewerWindows();
-        void displayFits(CCDChip *targetChip, const QString &filename, IBLOB *bp, FITSData *blob_fits_data);
+        void displayFits(CCDChip *targetChip, const QString &filename, IBLOB *bp, FITSData *blob_fits_data,
+                         FITSMode captureMode, bool batchMode);
 
         QString filter;
         bool ISOMode { true };
@@ -381,6 +419,8 @@ class CCD : public DeviceDecorator
         int alignTabID { -1 };
 
         char BLOBFilename[MAXINDIFILENAME + 1];
+        // BLOB handed to the modules with a loaded FITS frame
+        IBLOB m_FITSFrameBLOB {};
         IBLOB *primaryCCDBLOB { nullptr };
 
         std::unique_ptr<QTimer> readyTimer;
@@ -404,9 +444,13 @@ class CCD : public DeviceDecorator
         QMap<QString, double> m_ExposurePresets;
         QPair<double, double> m_ExposurePresetsMinMax;
 
-        // Used when writing the image fits file to disk in a separate thread.
-        char *fileWriteBuffer { nullptr };
-        int fileWriteBufferSize { 0 };
-        QFuture<void> fileWriteThread;
+        // FITS frames waiting to be loaded, and the one being loaded.
+        QQueue<FITSFrame> m_PendingFITSFrames;
+        FITSFrame m_LoadingFITSFrame;
+        QFutureWatcher<LoadedFITSFrame> m_FITSFrameWatcher;
+
+        // Buffers of the received FITS frames, reused once no frame or FITSData refers to them.
+        static const int MaxBLOBBuffers = 4;
+        QVector<QByteArray> m_BLOBBuffers;
 };
 }
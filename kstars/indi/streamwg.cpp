@@ -116,6 +116,7 @@ StreamWG::StreamWG(ISD::CCD *ccd) : QDialog(KStars::Instance())
 
     connect(videoFrame, &VideoWG::newSelection, this, &StreamWG::setStreamingFrame);
     connect(videoFrame, &VideoWG::imageChanged, this, &StreamWG::imageChanged);
+    connect(videoFrame, &VideoWG::newStatistics, this, &StreamWG::updateStatistics);
 
     resize(Options::streamWindowWidth(), Options::streamWindowHeight());
 
@@ -286,6 +287,7 @@ void StreamWG::enableStream(bool enable)
     if (enable)
     {
         processStream = true;
+        videoFrame->resetStatistics();
         show();
     }
     else
@@ -293,6 +295,8 @@ void StreamWG::enableStream(bool enable)
         processStream = false;
         //instFPS->setText("--");
         avgFPS->setText("--");
+        latencyMS->setText("--");
+        droppedFrames->setText("--");
         hide();
     }
 }
@@ -415,3 +419,9 @@ void StreamWG::updateFPS(double instantFPS, double averageFPS)
     //instFPS->setText(QString::number(instantFPS, 'f', 1));
     avgFPS->setText(QString::number(averageFPS, 'f', 1));
 }
+
+void StreamWG::updateStatistics(double latency, uint32_t dropped)
+{
+    latencyMS->setText(i18n("%1 ms", QString::number(latency, 'f', 0)));
+    droppedFrames->setText(QString::number(dropped));
+}
@@ -84,6 +84,7 @@ class StreamWG : public QDialog, public Ui::streamForm
     protected slots:
         void setStreamingFrame(QRect newFrame);
         void updateFPS(double instantFPS, double averageFPS);
+        void updateStatistics(double latency, uint32_t dropped);
 
     signals:
         void hidden();
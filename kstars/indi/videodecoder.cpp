@@ -0,0 +1,213 @@
+/*  Video Stream Decoder
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+*/
+
+#include "videodecoder.h"
+
+#include "kstars_debug.h"
+
+#include <QtConcurrent>
+
+#include <cstring>
+
+VideoDecoder::VideoDecoder(QObject *parent) : QObject(parent)
+{
+    m_BufferFree.fill(true);
+    m_Clock.start();
+
+    connect(&m_Watcher, &QFutureWatcher<DecodedFrame>::finished, this, &VideoDecoder::processDecodedFrame);
+}
+
+VideoDecoder::~VideoDecoder()
+{
+    // The decoding frame uses the buffers
+    m_Watcher.waitForFinished();
+}
+
+qint64 VideoDecoder::now() const
+{
+    return m_Clock.elapsed();
+}
+
+void VideoDecoder::resetStatistics()
+{
+    m_DroppedFrames = 0;
+}
+
+int VideoDecoder::takeFreeBuffer()
+{
+    for (int i = 0; i < PoolSize; i++)
+    {
+        if (m_BufferFree[i])
+        {
+            m_BufferFree[i] = false;
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+void VideoDecoder::submit(const IBLOB *bp, FrameType type, const QSize &streamSize, const QSize &displaySize,
+                          const BayerParams &params)
+{
+    if (bp->size <= 0)
+        return;
+
+    // Latest frame wins, the one still waiting will never be displayed
+    if (m_Waiting)
+    {
+        m_BufferFree[m_WaitingFrame.buffer] = true;
+        m_Waiting = false;
+        m_DroppedFrames++;
+    }
+
+    Frame frame;
+    frame.buffer = takeFreeBuffer();
+    if (frame.buffer < 0)
+    {
+        qCWarning(KSTARS) << "No free video frame buffer.";
+        m_DroppedFrames++;
+        return;
+    }
+
+    // The buffers keep their capacity, so that frames of the same size are copied without allocation
+    QByteArray &buffer = m_Buffers[frame.buffer];
+    buffer.resize(bp->size);
+    memcpy(buffer.data(), bp->blob, bp->size);
+
+    frame.type        = type;
+    frame.format      = QByteArray(bp->format).remove(0, bp->format[0] == '.' ? 1 : 0).replace("stream_", "");
+    frame.streamSize  = streamSize;
+    frame.displaySize = displaySize;
+    frame.params      = params;
+    frame.received    = now();
+
+    if (m_Decoding)
+    {
+        m_WaitingFrame = frame;
+        m_Waiting      = true;
+    }
+    else
+        start(frame);
+}
+
+void VideoDecoder::start(const Frame &frame)
+{
+    m_DecodingFrame = frame;
+    m_Decoding      = true;
+    m_Watcher.setFuture(QtConcurrent::run(this, &VideoDecoder::decode, frame));
+}
+
+VideoDecoder::DecodedFrame VideoDecoder::decode(const Frame &frame)
+{
+    DecodedFrame decoded;
+    decoded.received = frame.received;
+
+    const QByteArray &buffer = m_Buffers[frame.buffer];
+    auto const * samples     = reinterpret_cast<const uchar *>(buffer.constData());
+    int const width          = frame.streamSize.width();
+    int const height         = frame.streamSize.height();
+    int const pixels         = width * height;
+
+    switch (frame.type)
+    {
+        case FRAME_ENCODED:
+        {
+            QImage image;
+            if (image.loadFromData(samples, buffer.size(), frame.format.constData()) == false)
+                return decoded;
+            decoded.image = std::make_shared<QImage>(image);
+        }
+        break;
+
+        // The buffer goes back to the pool, so raw frames are copied out of it
+        case FRAME_GRAY:
+            if (pixels <= 0 || buffer.size() < pixels)
+                return decoded;
+            decoded.image = std::make_shared<QImage>(QImage(samples, width, height, width, QImage::Format_Grayscale8).copy());
+            break;
+
+        case FRAME_RGB:
+            if (pixels <= 0 || buffer.size() < pixels * 3)
+                return decoded;
+            decoded.image = std::make_shared<QImage>(QImage(samples, width, height, width * 3, QImage::Format_RGB888).copy());
+            break;
+
+        case FRAME_BAYER:
+        {
+            if (pixels <= 0 || buffer.size() < pixels)
+                return decoded;
+
+            // A frame displayed at half the sensor size or less is decoded at half resolution, which is much faster
+            BayerParams const &params = frame.params;
+            QSize const halfSize((width - params.offsetX) / 2, (height - params.offsetY) / 2);
+            bool const superPixel = params.method != DC1394_BAYER_METHOD_DOWNSAMPLE &&
+                                    frame.displaySize.width() <= halfSize.width() &&
+                                    frame.displaySize.height() <= halfSize.height();
+            QSize const imageSize = superPixel ? halfSize : frame.streamSize;
+
+            // Reused unless a receiver still holds the previous frame
+            if (m_DebayerImage.size() != imageSize)
+                m_DebayerImage = QImage(imageSize, QImage::Format_RGB888);
+            if (m_DebayerImage.isNull())
+                return decoded;
+
+            dc1394error_t error_code = superPixel ?
+                                       ParallelDebayer::superPixel(samples, m_DebayerImage.bits(), width, height, params,
+                                               m_DebayerImage.bytesPerLine()) :
+                                       m_Debayer.debayer(samples, m_DebayerImage.bits(), width, height, params,
+                                               ParallelDebayer::RGB_INTERLEAVED, m_DebayerImage.bytesPerLine());
+
+            if (error_code != DC1394_SUCCESS)
+            {
+                qCCritical(KSTARS) << "Debayer failed" << error_code;
+                return decoded;
+            }
+
+            decoded.image = std::make_shared<QImage>(m_DebayerImage);
+        }
+        break;
+    }
+
+    if (decoded.image->isNull())
+    {
+        decoded.image.reset();
+        return decoded;
+    }
+
+    if (frame.displaySize.isEmpty() == false)
+        decoded.displayImage = decoded.image->scaled(frame.displaySize, Qt::KeepAspectRatio);
+    else
+        decoded.displayImage = *decoded.image;
+
+    return decoded;
+}
+
+void VideoDecoder::processDecodedFrame()
+{
+    if (m_Decoding == false)
+        return;
+
+    DecodedFrame decoded = m_Watcher.result();
+    m_Watcher.setFuture(QFuture<DecodedFrame>());
+
+    m_BufferFree[m_DecodingFrame.buffer] = true;
+    m_Decoding = false;
+
+    if (m_Waiting)
+    {
+        m_Waiting = false;
+        start(m_WaitingFrame);
+    }
+
+    if (decoded.image)
+        emit frameDecoded(decoded.image, decoded.displayImage, decoded.received);
+    else
+        emit frameFailed();
+}
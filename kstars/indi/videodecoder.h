@@ -0,0 +1,143 @@
+/*  Video Stream Decoder
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+*/
+
+#pragma once
+
+#include "fitsviewer/bayer.h"
+#include "fitsviewer/paralleldebayer.h"
+
+#include <indidevapi.h>
+
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+#include <QImage>
+#include <QObject>
+#include <QSize>
+#include <QString>
+
+#include <array>
+#include <memory>
+
+/**
+ * @class VideoDecoder
+ * @short Decodes and scales streamed video frames off the GUI thread
+ *
+ * submit() copies the blob of a frame into one of a fixed pool of buffers and returns right away.
+ * Frames are decoded one at a time on the global thread pool: encoded images are loaded with
+ * QImage, raw 8-bit gray and RGB frames are copied, and bayer frames are debayered. Each frame is
+ * then scaled to the size it is displayed at, so that the GUI thread only has to turn it into a
+ * pixmap.
+ *
+ * While a frame is decoded, only the latest submitted frame is kept waiting: a frame still waiting
+ * when a newer one arrives is dropped and counted, so the display never falls behind the camera.
+ */
+class VideoDecoder : public QObject
+{
+        Q_OBJECT
+
+    public:
+        typedef enum
+        {
+            /// Image format known to QImageReader, e.g. JPEG
+            FRAME_ENCODED,
+            /// Raw 8-bit gray samples
+            FRAME_GRAY,
+            /// Raw 8-bit RGB samples
+            FRAME_RGB,
+            /// Raw 8-bit bayer samples
+            FRAME_BAYER
+        } FrameType;
+
+        explicit VideoDecoder(QObject *parent = nullptr);
+        ~VideoDecoder() override;
+
+        /**
+         * @brief submit Queue a frame for decoding, dropping the frame waiting for the decoder if any
+         * @param bp blob of the frame, copied before returning
+         * @param type how the frame must be decoded
+         * @param streamSize size of the raw frames
+         * @param displaySize size the frame is scaled to, keeping its aspect ratio
+         * @param params debayer parameters of bayer frames
+         */
+        void submit(const IBLOB *bp, FrameType type, const QSize &streamSize, const QSize &displaySize,
+                    const BayerParams &params = BayerParams());
+
+        /** @return milliseconds since the decoder was created, the clock of the frame timestamps */
+        qint64 now() const;
+
+        /** @return number of frames dropped since the last reset */
+        uint32_t droppedFrames() const
+        {
+            return m_DroppedFrames;
+        }
+
+        /** Reset the counter of dropped frames */
+        void resetStatistics();
+
+    signals:
+        /**
+         * @brief frameDecoded A frame is ready to be displayed
+         * @param frame the frame at the size it was streamed, debayered frames may be half that size
+         * @param displayImage the frame scaled to the display size
+         * @param received when the frame was submitted, on the now() clock
+         */
+        void frameDecoded(std::shared_ptr<QImage> frame, const QImage &displayImage, qint64 received);
+
+        /** A frame could not be decoded */
+        void frameFailed();
+
+    private:
+        /// Frames in the pool: one decoding, one waiting and one being copied in
+        static const int PoolSize = 3;
+
+        struct Frame
+        {
+            int buffer { -1 };
+            FrameType type { FRAME_ENCODED };
+            QByteArray format;
+            QSize streamSize;
+            QSize displaySize;
+            BayerParams params;
+            qint64 received { 0 };
+        };
+
+        struct DecodedFrame
+        {
+            std::shared_ptr<QImage> image;
+            QImage displayImage;
+            qint64 received { 0 };
+        };
+
+        /** Start decoding frame on the thread pool */
+        void start(const Frame &frame);
+
+        /** Runs on the thread pool */
+        DecodedFrame decode(const Frame &frame);
+
+        /** Deliver the decoded frame and start on the waiting one */
+        void processDecodedFrame();
+
+        int takeFreeBuffer();
+
+        std::array<QByteArray, PoolSize> m_Buffers;
+        std::array<bool, PoolSize> m_BufferFree;
+
+        Frame m_DecodingFrame;
+        Frame m_WaitingFrame;
+        bool m_Decoding { false };
+        bool m_Waiting { false };
+
+        QFutureWatcher<DecodedFrame> m_Watcher;
+        QElapsedTimer m_Clock;
+        uint32_t m_DroppedFrames { 0 };
+
+        /// Only used by the decoding frame
+        ParallelDebayer m_Debayer;
+        QImage m_DebayerImage;
+};
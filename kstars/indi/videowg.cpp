@@ -19,17 +19,20 @@
 
 VideoWG::VideoWG(QWidget *parent) : QLabel(parent)
 {
-    streamImage.reset(new QImage());
-
-    grayTable.resize(256);
-
-    for (int i = 0; i < 256; i++)
-        grayTable[i] = qRgb(i, i, i);
+    connect(&m_Decoder, &VideoDecoder::frameDecoded, this, &VideoWG::displayFrame);
+    connect(&m_Decoder, &VideoDecoder::frameFailed, this, []()
+    {
+        qCWarning(KSTARS) << "Failed to decode video frame.";
+    });
 }
 
 bool VideoWG::newBayerFrame(IBLOB *bp, const BayerParams &params)
 {
-    return debayer(bp, params);
+    if (static_cast<uint32_t>(bp->size) < totalBaseCount)
+        return false;
+
+    m_Decoder.submit(bp, VideoDecoder::FRAME_BAYER, QSize(streamW, streamH), size(), params);
+    return true;
 }
 
 bool VideoWG::newFrame(IBLOB *bp)
@@ -37,39 +40,47 @@ bool VideoWG::newFrame(IBLOB *bp)
     if (bp->size <= 0)
         return false;
 
-    bool rc = false;
     QString format(bp->format);
     if (m_RawFormat != format)
     {
+        m_RawFormat = format;
         format.remove('.');
         format.remove("stream_");
         m_RawFormatSupported = QImageReader::supportedImageFormats().contains(format.toLatin1());
-        m_RawFormat = format;
     }
 
+    VideoDecoder::FrameType type;
     if (m_RawFormatSupported)
-        rc = streamImage->loadFromData(static_cast<uchar *>(bp->blob), bp->size);
+        type = VideoDecoder::FRAME_ENCODED;
     else if (static_cast<uint32_t>(bp->size) == totalBaseCount)
-    {
-        streamImage.reset(new QImage(static_cast<uchar *>(bp->blob), streamW, streamH, QImage::Format_Indexed8));
-        streamImage->setColorTable(grayTable);
-        rc = !streamImage->isNull();
-    }
+        type = VideoDecoder::FRAME_GRAY;
     else if (static_cast<uint32_t>(bp->size) == totalBaseCount * 3)
-    {
-        streamImage.reset(new QImage(static_cast<uchar *>(bp->blob), streamW, streamH, QImage::Format_RGB888));
-        rc = !streamImage->isNull();
-    }
+        type = VideoDecoder::FRAME_RGB;
+    else
+        return false;
 
-    if (rc)
-    {
-        kPix = QPixmap::fromImage(streamImage->scaled(size(), Qt::KeepAspectRatio));
-        setPixmap(kPix);
-    }
+    m_Decoder.submit(bp, type, QSize(streamW, streamH), size());
+    return true;
+}
+
+void VideoWG::displayFrame(std::shared_ptr<QImage> frame, const QImage &displayImage, qint64 received)
+{
+    kPix = QPixmap::fromImage(displayImage);
+    setPixmap(kPix);
+
+    emit imageChanged(frame);
 
-    emit imageChanged(streamImage);
+    // Smoothed, so that the display stays readable at high frame rates
+    double const latency = m_Decoder.now() - received;
+    m_Latency = (m_Latency < 0) ? latency : 0.9 * m_Latency + 0.1 * latency;
 
-    return rc;
+    emit newStatistics(m_Latency, m_Decoder.droppedFrames());
+}
+
+void VideoWG::resetStatistics()
+{
+    m_Latency = -1;
+    m_Decoder.resetStatistics();
 }
 
 bool VideoWG::save(const QString &filename, const char *format)
@@ -120,8 +131,9 @@ void VideoWG::mouseReleaseEvent(QMouseEvent *event)
 
     QRect finalSelection;
 
-    double scaleX = static_cast<double>(streamImage->width()) / kPix.width();
-    double scaleY = static_cast<double>(streamImage->height()) / kPix.height();
+    // Relative to the sensor, the displayed frame may have been decoded at half resolution
+    double scaleX = static_cast<double>(streamW) / kPix.width();
+    double scaleY = static_cast<double>(streamH) / kPix.height();
 
     finalSelection.setX((rawSelection.x() - pixmapX) * scaleX);
     finalSelection.setY((rawSelection.y() - pixmapY) * scaleY);
@@ -132,52 +144,3 @@ void VideoWG::mouseReleaseEvent(QMouseEvent *event)
     // determine selection, for example using QRect::intersects()
     // and QRect::contains().
 }
-
-bool VideoWG::debayer(const IBLOB *bp, const BayerParams &params)
-{
-    uint32_t rgb_size = streamW * streamH * 3;
-    auto * destinationBuffer = new uint8_t[rgb_size];
-
-    if (destinationBuffer == nullptr)
-    {
-        qCCritical(KSTARS) << "Unable to allocate memory for temporary bayer buffer.";
-        return false;
-    }
-
-    int ds1394_height = streamH;
-
-    uint8_t * dc1394_source = reinterpret_cast<uint8_t*>(bp->blob);
-    if (params.offsetY == 1)
-    {
-        dc1394_source += streamW;
-        ds1394_height--;
-    }
-    if (params.offsetX == 1)
-    {
-        dc1394_source++;
-    }
-    dc1394error_t error_code = dc1394_bayer_decoding_8bit(dc1394_source, destinationBuffer, streamW, ds1394_height,
-                               params.filter, params.method);
-
-    if (error_code != DC1394_SUCCESS)
-    {
-        qCCritical(KSTARS) << "Debayer failed" << error_code;
-        delete[] destinationBuffer;
-        return false;
-    }
-
-    streamImage.reset(new QImage(destinationBuffer, streamW, streamH, QImage::Format_RGB888));
-    bool rc = !streamImage->isNull();
-
-    if (rc)
-    {
-        kPix = QPixmap::fromImage(streamImage->scaled(size(), Qt::KeepAspectRatio));
-        setPixmap(kPix);
-    }
-
-    emit imageChanged(streamImage);
-
-    delete[] destinationBuffer;
-    return rc;
-}
-
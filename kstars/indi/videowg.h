@@ -10,19 +10,17 @@
 
 #pragma once
 
+#include "videodecoder.h"
 #include "fitsviewer/bayer.h"
 
 #include <indidevapi.h>
 
 #include <QPixmap>
-#include <QVector>
-#include <QColor>
+#include <QImage>
 #include <QLabel>
 
 #include <memory>
-#include <mutex>
 
-class QImage;
 class QRubberBand;
 
 class VideoWG : public QLabel
@@ -33,6 +31,7 @@ class VideoWG : public QLabel
         explicit VideoWG(QWidget *parent = nullptr);
         virtual ~VideoWG() override = default;
 
+        /** Queue a frame for display, returns false if its format is unknown */
         bool newFrame(IBLOB *bp);
         bool newBayerFrame(IBLOB *bp, const BayerParams &params);
 
@@ -40,6 +39,9 @@ class VideoWG : public QLabel
 
         void setSize(uint16_t w, uint16_t h);
 
+        /** Reset the latency and the dropped frames counter */
+        void resetStatistics();
+
     protected:
         //virtual void resizeEvent(QResizeEvent *ev) override;
         void mousePressEvent(QMouseEvent *event) override;
@@ -49,18 +51,26 @@ class VideoWG : public QLabel
     signals:
         void newSelection(QRect);
         void imageChanged(std::shared_ptr<QImage> frame);
+        /**
+         * @brief newStatistics Emitted after each displayed frame
+         * @param latency average milliseconds between receiving a frame and displaying it
+         * @param droppedFrames frames dropped because the display could not keep up
+         */
+        void newStatistics(double latency, uint32_t droppedFrames);
 
-    private:
-        bool debayer(const IBLOB *bp, const BayerParams &params);
+    private slots:
+        void displayFrame(std::shared_ptr<QImage> frame, const QImage &displayImage, qint64 received);
 
+    private:
         uint16_t streamW { 0 };
         uint16_t streamH { 0 };
         uint32_t totalBaseCount { 0 };
-        QVector<QRgb> grayTable;
-        std::shared_ptr<QImage> streamImage;
         QPixmap kPix;
         QRubberBand *rubberBand { nullptr };
         QPoint origin;
         QString m_RawFormat;
         bool m_RawFormatSupported { false };
+        /// Decodes the frames off the GUI thread
+        VideoDecoder m_Decoder;
+        double m_Latency { -1 };
 };
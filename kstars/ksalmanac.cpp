@@ -18,10 +18,13 @@
 
 #include "ksalmanac.h"
 
+#include "ephemeriscache.h"
 #include "geolocation.h"
 #include "ksnumbers.h"
 #include "kstarsdata.h"
 
+#include <cmath>
+
 KSAlmanac::KSAlmanac()
 {
     KStarsData *data = KStarsData::Instance();
@@ -84,70 +87,29 @@ void KSAlmanac::RiseSetTime(SkyObject *o, double *riseTime, double *setTime, QTi
     }
 }
 
-// FIXME: This is utter code duplication. All this should be handled
-// in the KStars engine. Forgive me for adding to the nonsense, but I
-// want to get the Observation Planner functional first. -- asimha
-// seems to be copied from AltVsTime::setDawnDusk
 void KSAlmanac::findDawnDusk()
 {
-    KStarsDateTime today = dt;
-    KSNumbers num(today.djd());
-    CachingDms LST = geo->GSTtoLST(today.gst());
-
-    m_Sun.updateCoords(&num, true, geo->lat(), &LST, true); // We can abuse our own copy of the sun
-    double dawn, da, dusk, du, max_alt, min_alt;
-    double last_h   = -12.0;
-    double last_alt = findAltitude(&m_Sun, last_h);
-    dawn = dusk = -13.0;
-    max_alt     = -100.0;
-    min_alt     = 100.0;
-    for (double h = -11.95; h <= 12.0; h += 0.05)
-    {
-        double alt = findAltitude(&m_Sun, h);
-        bool asc   = alt - last_alt > 0;
-        if (alt > max_alt)
-            max_alt = alt;
-        if (alt < min_alt)
-            min_alt = alt;
-
-        if (asc && last_alt <= -18.0 && alt >= -18.0)
-            dawn = h;
-        if (!asc && last_alt >= -18.0 && alt <= -18.0)
-            dusk = h;
-
-        // Never used
-//        last_h   = h;
-        last_alt = alt;
-    }
+    // The Sun is interpolated from the shared ephemeris instead of being recomputed here
+    double dawn, dusk;
+    EphemerisCache::Instance()->sunCrossings(geo, dt.djd(), -18.0, &dawn, &dusk, &SunMinAlt, &SunMaxAlt);
 
-    if (dawn < -12.0 || dusk < -12.0)
+    if (std::isnan(dawn) || std::isnan(dusk))
     {
-        da = -1.0;
-        du = -1.0;
+        DawnAstronomicalTwilight = -1.0;
+        DuskAstronomicalTwilight = -1.0;
     }
     else
     {
-        da = dawn / 24.0;
-        du = (dusk + 24.0) / 24.0;
+        DawnAstronomicalTwilight = dawn / 24.0;
+        DuskAstronomicalTwilight = (dusk + 24.0) / 24.0;
     }
-
-    DawnAstronomicalTwilight = da;
-    DuskAstronomicalTwilight = du;
-
-    SunMaxAlt = max_alt;
-    SunMinAlt = min_alt;
 }
 
 void KSAlmanac::findMoonPhase()
 {
-    const KStarsDateTime today = dt;
-    KSNumbers num(today.djd());
-    CachingDms LST = geo->GSTtoLST(today.gst());
-
-    m_Sun.updateCoords(&num, true, geo->lat(), &LST, true); // We can abuse our own copy of the sun and/or moon
-    m_Moon.updateCoords(&num, true, geo->lat(), &LST, true);
-    m_Moon.findPhase(&m_Sun);
-    MoonPhase = m_Moon.phase().Degrees();
+    EphemerisCache::Sample const s = EphemerisCache::Instance()->at(geo, dt.djd());
+    MoonPhase = s.moonPhase;
+    MoonIllum = s.moonIllum();
 }
 
 void KSAlmanac::setDate(const KStarsDateTime *newdt)
@@ -170,8 +132,3 @@ double KSAlmanac::sunZenithAngleToTime(double z)
     double HASunset = acos((-m_Sun.dec().sin() * geo->lat()->sin()) / (m_Sun.dec().cos() * geo->lat()->cos()));
     return SunSet + (HA - HASunset) / 24.0;
 }
-
-double KSAlmanac::findAltitude(const SkyPoint *p, double hour)
-{
-    return SkyPoint::findAltitude(p, dt, geo, hour).Degrees();
-}
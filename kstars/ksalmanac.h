@@ -81,7 +81,7 @@ class KSAlmanac
     /**
          *@return get the moon illuminated fraction at the given date/time. Range is [0.,1.]
          */
-    inline double getMoonIllum() { return m_Moon.illum(); }
+    inline double getMoonIllum() { return MoonIllum; }
 
     inline QTime sunRise() { return SunRiseT; }
     inline QTime sunSet() { return SunSetT; }
@@ -109,23 +109,15 @@ class KSAlmanac
     void RiseSetTime(SkyObject *o, double *riseTime, double *setTime, QTime *RiseTime, QTime *SetTime);
 
     /**
-         * Computes astronomical twilight for dawn and dusk
-         * @note Code duplication -- copied from Alt vs Time
+         * Computes astronomical twilight for dawn and dusk, from the shared EphemerisCache
          */
     void findDawnDusk();
 
     /**
-         * Computes the moon phase at the given date/time
+         * Computes the moon phase at the given date/time, from the shared EphemerisCache
          */
     void findMoonPhase();
 
-    /**
-         * FIXME: More code duplication!
-         * findAltitude should really be part of KSEngine. Copying from ObservingList.
-         * returns in degrees
-         */
-    double findAltitude(const SkyPoint *p, double hour);
-
     KSSun m_Sun;
     KSMoon m_Moon;
     KStarsDateTime dt;
@@ -140,5 +132,6 @@ class KSAlmanac
     double SunMinAlt { 0 };
     double SunMaxAlt { 0 };
     double MoonPhase { 0 };
+    double MoonIllum { 0 };
     QTime SunRiseT, SunSetT, MoonRiseT, MoonSetT, DuskAstronomicalTwilightT, DawnAstronomicalTwilightT;
 };
@@ -483,6 +483,19 @@ class KStars : public KXmlGuiWindow
              */
         Q_SCRIPTABLE Q_NOREPLY void openFITS(const QUrl &imageUrl);
 
+        /** DBUS interface function.  Turn the draw / update profiling (and its sky map overlay) on or off.
+             * @param enable true to start collecting timing statistics
+             */
+        Q_SCRIPTABLE Q_NOREPLY void setFrameProfiling(bool enable);
+
+        /** DBUS interface function.  Forget the timing statistics collected so far. */
+        Q_SCRIPTABLE Q_NOREPLY void resetFrameProfile();
+
+        /** DBUS interface function.  Return the rolling timing statistics of the sky map draw and update
+             * cycles as a JSON document, with one object per profiled section. Durations are in milliseconds.
+             */
+        Q_SCRIPTABLE QString getFrameProfile();
+
         /** @}*/
 
         /**
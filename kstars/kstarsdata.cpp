@@ -19,7 +19,10 @@
 
 #include "ksutils.h"
 #include "Options.h"
+#include "auxiliary/citydb.h"
+#include "auxiliary/frameprofiler.h"
 #include "auxiliary/kspaths.h"
+#include "auxiliary/startuploader.h"
 #include "skycomponents/supernovaecomponent.h"
 #include "skycomponents/skymapcomposite.h"
 #include "ksnotification.h"
@@ -37,9 +40,9 @@
 #include <KMessageBox>
 #endif
 
+#include <QEventLoop>
 #include <QSqlQuery>
 #include <QSqlRecord>
-#include <QtConcurrent>
 
 #include "kstars_debug.h"
 
@@ -121,8 +124,6 @@ KStarsData::~KStarsData()
     Q_ASSERT(pinstance);
 
     //delete locale;
-    qDeleteAll(geoList);
-    geoList.clear();
     qDeleteAll(ADVtreeList);
     ADVtreeList.clear();
 
@@ -133,20 +134,174 @@ KStarsData::~KStarsData()
 
 bool KStarsData::initialize()
 {
-    //Initialize CatalogDB//
-    catalogdb()->Initialize();
+    // Tasks which do not depend on each other are loaded at the same time. The city and user
+    // databases are opened on this thread, which keeps using their connections.
+    StartupLoader loader("KStars data");
 
-    //Load Time Zone Rules//
-    emit progressText(i18n("Reading time zone rules"));
-    if (!readTimeZoneRulebook())
+    loader.addTask("Catalog DB", StartupLoader::MainThread, QStringList(), QStringList(), [this]()
+    {
+        catalogdb()->Initialize();
+        return true;
+    });
+
+    loader.addTask("Time zone rules", StartupLoader::AnyThread, QStringList(), QStringList(), [this]()
+    {
+        emit progressText(i18n("Reading time zone rules"));
+        return readTimeZoneRulebook();
+    });
+
+    loader.addTask("City DB upgrade", StartupLoader::AnyThread, QStringList(), QStringList(), [this]()
+    {
+        upgradeCityDB();
+        return true;
+    });
+
+    loader.addTask("Cities", StartupLoader::MainThread, QStringList() << "Time zone rules" << "City DB upgrade",
+                   QStringList(), [this]()
+    {
+        emit progressText(i18n("Loading city data"));
+        return readCityData();
+    });
+
+    loader.addTask("User DB", StartupLoader::MainThread, QStringList(), QStringList(), [this]()
+    {
+        emit progressText(i18n("Loading User Information"));
+        m_ksuserdb.Initialize();
+        return true;
+    });
+
+    loader.addTask("Sky objects", StartupLoader::MainThread, QStringList() << "Catalog DB" << "User DB", QStringList(),
+                   [this]()
+    {
+        emit progressText(i18n("Loading sky objects"));
+        m_SkyComposite.reset(new SkyMapComposite());
+        return true;
+    });
+
+#ifndef KSTARS_LITE
+    loader.addTask("Observing list", StartupLoader::MainThread, QStringList() << "Sky objects", QStringList(),
+                   [this]()
+    {
+        m_ObservingList = new ObservingList();
+        return true;
+    });
+
+    loader.addTask("Online lookups", StartupLoader::AnyThread, QStringList(), QStringList(), [this]()
+    {
+        readADVTreeData();
+        return true;
+    });
+#endif
+
+    loader.run();
+
+    if (loader.state("Time zone rules") != StartupLoader::Succeeded)
     {
         fatalErrorMessage("TZrules.dat");
         return false;
     }
 
+    if (loader.state("Cities") != StartupLoader::Succeeded)
+    {
+        fatalErrorMessage("citydb.sqlite");
+        return false;
+    }
 
-    emit progressText(i18n("Upgrade existing user city db to support geographic elevation."));
+    // Image and information URLs and the user log are loaded with the objects not drawn at
+    // startup, see loadDeferredData()
+    return true;
+}
+
+void KStarsData::loadDeferredData(bool wait)
+{
+    if (m_DeferredLoader)
+    {
+        if (wait && m_DeferredLoader->isRunning())
+        {
+            QEventLoop loop;
+            connect(m_DeferredLoader.get(), &StartupLoader::finished, &loop, &QEventLoop::quit);
+            loop.exec(QEventLoop::ExcludeUserInputEvents);
+        }
+        return;
+    }
 
+    m_DeferredLoader.reset(new StartupLoader("Deferred sky objects"));
+
+    // The links and logs are attached to objects which may be loaded by the deferred tasks, e.g.
+    // asteroids and comets. The files are parsed in the background, but the objects allocate
+    // their auxiliary information on first use and the popup menu reads it, so the links and
+    // logs are attached on the main thread.
+    QStringList const objects = m_SkyComposite->addDeferredTasks(m_DeferredLoader.get());
+
+    std::shared_ptr<QList<ObjectLink>> imageLinks(new QList<ObjectLink>());
+    m_DeferredLoader->addTask("Image URL file", StartupLoader::AnyThread, QStringList(), QStringList(),
+                              [this, imageLinks]()
+    {
+        return readURLData("image_url.dat", *imageLinks);
+    });
+
+    m_DeferredLoader->addTask("Image URLs", StartupLoader::MainThread, QStringList(objects) << "Image URL file",
+                              QStringList(), [this, imageLinks]()
+    {
+        addURLData(*imageLinks, 0);
+        imageLinks->clear();
+        return true;
+    });
+
+    std::shared_ptr<QList<ObjectLink>> infoLinks(new QList<ObjectLink>());
+    m_DeferredLoader->addTask("Information URL file", StartupLoader::AnyThread, QStringList(), QStringList(),
+                              [this, infoLinks]()
+    {
+        return readURLData("info_url.dat", *infoLinks);
+    });
+
+    m_DeferredLoader->addTask("Information URLs", StartupLoader::MainThread,
+                              QStringList(objects) << "Information URL file", QStringList(), [this, infoLinks]()
+    {
+        addURLData(*infoLinks, 1);
+        infoLinks->clear();
+        return true;
+    });
+
+    std::shared_ptr<QList<QPair<QString, QString>>> logs(new QList<QPair<QString, QString>>());
+    m_DeferredLoader->addTask("User log file", StartupLoader::AnyThread, QStringList(), QStringList(), [this, logs]()
+    {
+        readUserLog(*logs);
+        return true;
+    });
+
+    m_DeferredLoader->addTask("User log", StartupLoader::MainThread, QStringList(objects) << "User log file",
+                              QStringList(), [this, logs]()
+    {
+        addUserLog(*logs);
+        logs->clear();
+        return true;
+    });
+
+    connect(m_DeferredLoader.get(), &StartupLoader::finished, this, [this]()
+    {
+        if (m_DeferredLoader->state("Image URL file") == StartupLoader::Failed)
+            nonFatalErrorMessage("image_url.dat");
+        if (m_DeferredLoader->state("Information URL file") == StartupLoader::Failed)
+            nonFatalErrorMessage("info_url.dat");
+
+        emit deferredDataLoaded();
+    });
+
+    if (wait)
+        m_DeferredLoader->run();
+    else
+        m_DeferredLoader->start();
+}
+
+bool KStarsData::isDeferredDataLoaded() const
+{
+    return m_DeferredLoader && !m_DeferredLoader->isRunning();
+}
+
+void KStarsData::upgradeCityDB()
+{
+    emit progressText(i18n("Upgrade existing user city db to support geographic elevation."));
 
     QString dbfile = KSPaths::writableLocation(QStandardPaths::GenericDataLocation) + QDir::separator() + "mycitydb.sqlite";
 
@@ -183,52 +338,6 @@ bool KStarsData::initialize()
         }
         fixcitydb.close();
     }
-
-
-    //Load Cities//
-    emit progressText(i18n("Loading city data"));
-    if (!readCityData())
-    {
-        fatalErrorMessage("citydb.sqlite");
-        return false;
-    }
-
-    //Initialize User Database//
-    emit progressText(i18n("Loading User Information"));
-    m_ksuserdb.Initialize();
-
-    //Initialize SkyMapComposite//
-    emit progressText(i18n("Loading sky objects"));
-    m_SkyComposite.reset(new SkyMapComposite());
-    //Load Image URLs//
-    //#ifndef Q_OS_ANDROID
-    //On Android these 2 calls produce segfault. WARNING
-    emit progressText(i18n("Loading Image URLs"));
-
-    if( !readURLData( "image_url.dat", 0 ) && !nonFatalErrorMessage( "image_url.dat" ) )
-        return false;
-    //QtConcurrent::run(this, &KStarsData::readURLData, QString("image_url.dat"), 0, false);
-
-    //Load Information URLs//
-    //emit progressText(i18n("Loading Information URLs"));
-    if( !readURLData( "info_url.dat", 1 ) && !nonFatalErrorMessage( "info_url.dat" ) )
-        return false;
-    QtConcurrent::run(this, &KStarsData::readURLData, QString("info_url.dat"), 1, false);
-
-    //#endif
-    //emit progressText( i18n("Loading Variable Stars" ) );
-
-#ifndef KSTARS_LITE
-    //Initialize Observing List
-    m_ObservingList = new ObservingList();
-#endif
-
-    readUserLog();
-
-#ifndef KSTARS_LITE
-    readADVTreeData();
-#endif
-    return true;
 }
 
 void KStarsData::updateTime(GeoLocation *geo, const bool automaticDSTchange)
@@ -257,7 +366,9 @@ void KStarsData::updateTime(GeoLocation *geo, const bool automaticDSTchange)
         }
     }
 
+    FrameProfiler::Timer timer;
     KSNumbers num(ut().djd());
+    timer.lap("update/Numbers");
 
     if (std::abs(ut().djd() - LastNumUpdate.djd()) > 1.0)
     {
@@ -265,12 +376,14 @@ void KStarsData::updateTime(GeoLocation *geo, const bool automaticDSTchange)
         m_preUpdateNumID++;
         m_preUpdateNum = KSNumbers(num);
         skyComposite()->update(&num);
+        timer.lap("update/Precession");
     }
 
     if (std::abs(ut().djd() - LastPlanetUpdate.djd()) > 0.01)
     {
         LastPlanetUpdate = KStarsDateTime(ut().djd());
         skyComposite()->updateSolarSystemBodies(&num);
+        timer.lap("update/SolarSystem");
     }
 
     // Moon moves ~30 arcmin/hr, so update its position every minute.
@@ -278,6 +391,7 @@ void KStarsData::updateTime(GeoLocation *geo, const bool automaticDSTchange)
     {
         LastMoonUpdate = ut();
         skyComposite()->updateMoons(&num);
+        timer.lap("update/Moons");
     }
 
     //Update Alt/Az coordinates.  Timescale varies with zoom level
@@ -288,6 +402,7 @@ void KStarsData::updateTime(GeoLocation *geo, const bool automaticDSTchange)
         m_preUpdateID++;
         //omit KSNumbers arg == just update Alt/Az coords // <-- Eh? -- asimha. Looks like this behavior / ideology has changed drastically.
         skyComposite()->update(&num);
+        timer.lap("update/Sky");
 
         emit skyUpdate(clock()->isManualMode());
     }
@@ -363,34 +478,12 @@ void KStarsData::setTimeDirection(float scale)
 
 GeoLocation *KStarsData::locationNamed(const QString &city, const QString &province, const QString &country)
 {
-    foreach (GeoLocation *loc, geoList)
-    {
-        if (loc->translatedName() == city && (province.isEmpty() || loc->translatedProvince() == province) &&
-                (country.isEmpty() || loc->translatedCountry() == country))
-        {
-            return loc;
-        }
-    }
-    return nullptr;
+    return m_CityDB ? m_CityDB->find(city, province, country) : nullptr;
 }
 
 GeoLocation *KStarsData::nearestLocation(double longitude, double latitude)
 {
-    GeoLocation *nearest = nullptr;
-    double distance = 1e6;
-
-    dms lng(longitude), lat(latitude);
-    for (auto oneCity : geoList)
-    {
-        double newDistance = oneCity->distanceTo(lng, lat);
-        if (newDistance < distance)
-        {
-            distance = newDistance;
-            nearest = oneCity;
-        }
-    }
-
-    return nearest;
+    return m_CityDB ? m_CityDB->nearest(longitude, latitude) : nullptr;
 }
 
 void KStarsData::setLocationFromOptions()
@@ -435,78 +528,8 @@ SkyObject *KStarsData::objectNamed(const QString &name)
 
 bool KStarsData::readCityData()
 {
-    QSqlDatabase citydb = QSqlDatabase::addDatabase("QSQLITE", "citydb");
-    QString dbfile      = KSPaths::locate(QStandardPaths::GenericDataLocation, "citydb.sqlite");
-    citydb.setDatabaseName(dbfile);
-    if (citydb.open() == false)
-    {
-        qCCritical(KSTARS) << "Unable to open city database file " << dbfile << citydb.lastError().text();
-        return false;
-    }
-
-    QSqlQuery get_query(citydb);
-
-    //get_query.prepare("SELECT * FROM city");
-    if (!get_query.exec("SELECT * FROM city"))
-    {
-        qCCritical(KSTARS) << get_query.lastError();
-        return false;
-    }
-
-    bool citiesFound = false;
-    // get_query.size() always returns -1 so we set citiesFound if at least one city is found
-    while (get_query.next())
-    {
-        citiesFound          = true;
-        QString name         = get_query.value(1).toString();
-        QString province     = get_query.value(2).toString();
-        QString country      = get_query.value(3).toString();
-        dms lat              = dms(get_query.value(4).toString());
-        dms lng              = dms(get_query.value(5).toString());
-        double TZ            = get_query.value(6).toDouble();
-        TimeZoneRule *TZrule = &(Rulebook[get_query.value(7).toString()]);
-        double elevation     = get_query.value(8).toDouble();
-
-        // appends city names to list
-        geoList.append(new GeoLocation(lng, lat, name, province, country, TZ, TZrule, elevation, true, 4));
-    }
-    citydb.close();
-
-    // Reading local database
-    QSqlDatabase mycitydb = QSqlDatabase::addDatabase("QSQLITE", "mycitydb");
-    dbfile = KSPaths::writableLocation(QStandardPaths::GenericDataLocation) + QDir::separator() + "mycitydb.sqlite";
-
-    if (QFile::exists(dbfile))
-    {
-        mycitydb.setDatabaseName(dbfile);
-        if (mycitydb.open())
-        {
-            QSqlQuery get_query(mycitydb);
-
-            if (!get_query.exec("SELECT * FROM city"))
-            {
-                qDebug() << get_query.lastError();
-                return false;
-            }
-            while (get_query.next())
-            {
-                QString name         = get_query.value(1).toString();
-                QString province     = get_query.value(2).toString();
-                QString country      = get_query.value(3).toString();
-                dms lat              = dms(get_query.value(4).toString());
-                dms lng              = dms(get_query.value(5).toString());
-                double TZ            = get_query.value(6).toDouble();
-                TimeZoneRule *TZrule = &(Rulebook[get_query.value(7).toString()]);
-                double elevation     = get_query.value(8).toDouble();
-
-                // appends city names to list
-                geoList.append(new GeoLocation(lng, lat, name, province, country, TZ, TZrule, elevation, false, 4));
-            }
-            mycitydb.close();
-        }
-    }
-
-    return citiesFound;
+    m_CityDB.reset(new CityDB(Rulebook));
+    return m_CityDB->open();
 }
 
 bool KStarsData::readTimeZoneRulebook()
@@ -683,8 +706,7 @@ bool KStarsData::openUrlFile(const QString &urlfile, QFile &file)
     return fileFound;
 }
 
-// FIXME: This is a significant contributor to KStars start-up time
-bool KStarsData::readURLData(const QString &urlfile, int type, bool deepOnly)
+bool KStarsData::readURLData(const QString &urlfile, QList<ObjectLink> &links)
 {
 #ifndef KSTARS_LITE
     if (KStars::Closing)
@@ -720,38 +742,53 @@ bool KStarsData::readURLData(const QString &urlfile, int type, bool deepOnly)
             idx           = sub.indexOf(':');
             QString title = sub.left(idx);
             QString url   = sub.mid(idx + 1);
-            // Dirty hack to fix things up for planets
 
-            //            if (name == "Mercury" || name == "Venus" || name == "Mars" || name == "Jupiter" || name == "Saturn" ||
-            //                    name == "Uranus" || name == "Neptune" /* || name == "Pluto" */)
-            //                o = skyComposite()->findByName(i18n(name.toLocal8Bit().data()));
-            //            else
-            SkyObject *o = skyComposite()->findByName(name);
+            links.append({ name, title, url });
+        }
+    }
+    file.close();
+    return true;
+}
+
+// FIXME: This is a significant contributor to KStars start-up time
+void KStarsData::addURLData(const QList<ObjectLink> &links, int type, bool deepOnly)
+{
+    for (const ObjectLink &link : links)
+    {
+#ifndef KSTARS_LITE
+        if (KStars::Closing)
+            return;
+#endif
 
-            if (!o)
-            {
-                qCWarning(KSTARS) << i18n("Object named %1 not found", name);
-            }
-            else
+        // Dirty hack to fix things up for planets
+
+        //            if (name == "Mercury" || name == "Venus" || name == "Mars" || name == "Jupiter" || name == "Saturn" ||
+        //                    name == "Uranus" || name == "Neptune" /* || name == "Pluto" */)
+        //                o = skyComposite()->findByName(i18n(name.toLocal8Bit().data()));
+        //            else
+        SkyObject *o = skyComposite()->findByName(link.name);
+
+        if (!o)
+        {
+            qCWarning(KSTARS) << i18n("Object named %1 not found", link.name);
+        }
+        else
+        {
+            if (!deepOnly || (o->type() > 2 && o->type() < 9))
             {
-                if (!deepOnly || (o->type() > 2 && o->type() < 9))
+                if (type == 0) //image URL
                 {
-                    if (type == 0) //image URL
-                    {
-                        o->ImageList().append(url);
-                        o->ImageTitle().append(title);
-                    }
-                    else if (type == 1) //info URL
-                    {
-                        o->InfoList().append(url);
-                        o->InfoTitle().append(title);
-                    }
+                    o->ImageList().append(link.url);
+                    o->ImageTitle().append(link.title);
+                }
+                else if (type == 1) //info URL
+                {
+                    o->InfoList().append(link.url);
+                    o->InfoTitle().append(link.title);
                 }
             }
         }
     }
-    file.close();
-    return true;
 }
 
 // FIXME: Improve the user log system
@@ -775,8 +812,7 @@ bool KStarsData::readURLData(const QString &urlfile, int type, bool deepOnly)
 
 // --asimha 2016 Aug 17
 
-// FIXME: This is a significant contributor to KStars startup time.
-bool KStarsData::readUserLog()
+bool KStarsData::readUserLog(QList<QPair<QString, QString>> &logs)
 {
     QFile file;
     QString buffer;
@@ -804,22 +840,30 @@ bool KStarsData::readUserLog()
         data   = sub.mid(sub.indexOf(']') + 2, endIndex - (sub.indexOf(']') + 2));
         buffer = buffer.mid(endIndex + 11);
 
+        logs.append(qMakePair(name, data));
+    } // end while
+    file.close();
+    return true;
+}
+
+// FIXME: This is a significant contributor to KStars startup time.
+void KStarsData::addUserLog(const QList<QPair<QString, QString>> &logs)
+{
+    for (const auto &log : logs)
+    {
         //Find the sky object named 'name'.
         //Note that ObjectNameList::find() looks for the ascii representation
         //of star genetive names, so stars are identified that way in the user log.
-        SkyObject *o = skyComposite()->findByName(name);
+        SkyObject *o = skyComposite()->findByName(log.first);
         if (!o)
         {
-            qWarning() << name << " not found";
+            qWarning() << log.first << " not found";
         }
         else
         {
-            o->userLog() = data;
+            o->userLog() = log.second;
         }
-
-    } // end while
-    file.close();
-    return true;
+    }
 }
 
 bool KStarsData::readADVTreeData()
@@ -1452,21 +1496,13 @@ bool KStarsData::executeScript(const QString &scriptname, SkyMap *map)
                     country  = fn[3];
                 }
 
-                bool cityFound(false);
-                foreach (GeoLocation *loc, geoList)
+                GeoLocation *loc = country.isEmpty() ? nullptr : locationNamed(city, province, country);
+                if (loc)
                 {
-                    if (loc->translatedName() == city &&
-                            (province.isEmpty() || loc->translatedProvince() == province) &&
-                            loc->translatedCountry() == country)
-                    {
-                        cityFound = true;
-                        setLocation(*loc);
-                        cmdCount++;
-                        break;
-                    }
+                    setLocation(*loc);
+                    cmdCount++;
                 }
-
-                if (!cityFound)
+                else
                     qWarning() << i18n("Could not set location named %1, %2, %3", city, province, country);
             }
         }
@@ -31,6 +31,7 @@
 
 #include <QList>
 #include <QMap>
+#include <QPair>
 #include <QKeySequence>
 
 #include <iostream>
@@ -44,12 +45,14 @@
 
 class QFile;
 
+class CityDB;
 class Execute;
 class FOV;
 class ImageExporter;
 class SkyMap;
 class SkyMapComposite;
 class SkyObject;
+class StartupLoader;
 class ObservingList;
 class TimeZoneRule;
 
@@ -89,7 +92,7 @@ class KStarsData : public QObject
         friend class KStars;
         // FIXME: it uses temporary trail and resumeKey
         friend class SkyMap;
-        // FIXME: uses geoList and changes it.
+        // FIXME: uses Rulebook for the cities it edits.
         friend class LocationDialog;
         friend class LocationDialogLite;
 
@@ -106,6 +109,18 @@ class KStarsData : public QObject
          */
         bool initialize();
 
+        /**
+         * @short Load the objects which are not drawn at startup, and the links and logs attached to objects.
+         *
+         * This is done in the background once the sky map is first drawn. Calling it again does not
+         * load anything again.
+         * @param wait if true, return once the data is loaded
+         */
+        void loadDeferredData(bool wait = false);
+
+        /** @return true once the data loaded by loadDeferredData() is available */
+        bool isDeferredDataLoaded() const;
+
         /** Destructor.  Delete data objects. */
         ~KStarsData() override;
 
@@ -217,10 +232,10 @@ class KStarsData : public QObject
             return &m_Geo;
         }
 
-        /** @return list of all geographic locations */
-        QList<GeoLocation *> &getGeoList()
+        /** @return the geographic locations, looked up on demand */
+        CityDB *citydb()
         {
-            return geoList;
+            return m_CityDB.get();
         }
 
         GeoLocation *locationNamed(const QString &city, const QString &province = QString(),
@@ -373,6 +388,9 @@ class KStarsData : public QObject
         /** Emitted when geo location changed */
         void geoChanged();
 
+        /** Emitted once the data loaded by loadDeferredData() is available */
+        void deferredDataLoaded();
+
     public slots:
         /** @short send a message to the console*/
         void slotConsoleMessage(QString s)
@@ -400,18 +418,21 @@ class KStarsData : public QObject
 
     private:
         /**
-         * Populate list of geographic locations from "citydb.sqlite" database. Also check for custom
-         * locations file "mycitydb.sqlite" database, but don't require it.  Each line in the file
-         * provides the information required to create one GeoLocation object.
-         * @short Fill list of geographic locations from file(s)
-         * @return true if at least one city read successfully.
-         * @see KStarsData::processCity()
+         * Open the "citydb.sqlite" database of geographic locations, whose cities are only read when
+         * looked up. Also check for custom locations file "mycitydb.sqlite" database, but don't require
+         * it. Each row provides the information required to create one GeoLocation object.
+         * @short Open the database(s) of geographic locations
+         * @return true if at least one city is found.
+         * @see CityDB
          */
         bool readCityData();
 
         /** Read the data file that contains daylight savings time rules. */
         bool readTimeZoneRulebook();
 
+        /** Add the Elevation column to the city table of an existing "mycitydb.sqlite" database */
+        void upgradeCityDB();
+
         //TODO JM: ADV tree should use XML instead
         /**
          * Read Advanced interface structure to be used later to construct the list view in
@@ -437,9 +458,26 @@ class KStarsData : public QObject
          * @li KSLABEL designates the beginning of a log
          * @li KSLogEnd designates the end of a log.
          *
+         * Only the file is parsed, so this may run on any thread. The logs are attached to
+         * their objects by addUserLog().
+         *
+         * @param logs the logs read, by object name
          * @return true if data is successfully read.
          */
-        bool readUserLog();
+        bool readUserLog(QList<QPair<QString, QString>> &logs);
+
+        /** Attach the logs read by readUserLog() to their objects, on the main thread */
+        void addUserLog(const QList<QPair<QString, QString>> &logs);
+
+        /** Link read from a URL file */
+        struct ObjectLink
+        {
+            /// Primary name of the object
+            QString name;
+            /// Menu text of the link
+            QString title;
+            QString url;
+        };
 
         /**
          * Read in URLs to be attached to a named object's right-click popup menu.  At this
@@ -453,10 +491,23 @@ class KStarsData : public QObject
          * @li Object name.  This must be the "primary" name of the object (the name at the top of the popup menu).
          * @li Menu text.  The string that should appear in the popup menu to activate the link.
          * @li URL.
+         *
+         * Only the file is parsed, so this may run on any thread. The links are attached to
+         * their objects by addURLData().
+         *
          * @short Read in image and information URLs.
+         * @param links the links read
          * @return true if data files were successfully read.
          */
-        bool readURLData(const QString &url, int type = 0, bool deepOnly = false);
+        bool readURLData(const QString &url, QList<ObjectLink> &links);
+
+        /**
+         * @short Attach the links read by readURLData() to their objects, on the main thread
+         * @param links the links to attach
+         * @param type 0 for image links, 1 for information links
+         * @param deepOnly only attach links of deep sky objects
+         */
+        void addURLData(const QList<ObjectLink> &links, int type = 0, bool deepOnly = false);
 
         /**
          * @short open a file containing URL links.
@@ -474,6 +525,8 @@ class KStarsData : public QObject
 
         QList<ADVTreeData *> ADVtreeList;
         std::unique_ptr<SkyMapComposite> m_SkyComposite;
+        /// Destroyed first, its tasks use the sky composite
+        std::unique_ptr<StartupLoader> m_DeferredLoader;
 
         GeoLocation m_Geo;
         SimClock Clock;
@@ -510,8 +563,8 @@ class KStarsData : public QObject
         // FIXME: Used in kstarsdcop.cpp only
         KStarsDateTime StoredDate;
 
-        QList<GeoLocation *> geoList;
         QMap<QString, TimeZoneRule> Rulebook;
+        std::unique_ptr<CityDB> m_CityDB;
 
         quint32 m_preUpdateID, m_updateID;
         quint32 m_preUpdateNumID, m_updateNumID;
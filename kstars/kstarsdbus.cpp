@@ -21,6 +21,7 @@
 
 #include "colorscheme.h"
 #include "eyepiecefield.h"
+#include "frameprofiler.h"
 #include "imageexporter.h"
 #include "ksdssdownloader.h"
 #include "kstarsdata.h"
@@ -46,6 +47,7 @@
 #include <QPrintDialog>
 #include <QPrinter>
 #include <QElapsedTimer>
+#include <QJsonDocument>
 
 #include "kstars_debug.h"
 
@@ -259,42 +261,34 @@ QString KStars::location()
 bool KStars::setGeoLocation(const QString &city, const QString &province, const QString &country)
 {
     //Set the geographic location
-    bool cityFound(false);
+    GeoLocation *loc = country.isEmpty() ? nullptr : data()->locationNamed(city, province, country);
+    bool const cityFound(loc != nullptr);
 
-    foreach (GeoLocation *loc, data()->geoList)
+    if (cityFound)
     {
-        if (loc->translatedName() == city && (province.isEmpty() || loc->translatedProvince() == province) &&
-                loc->translatedCountry() == country)
-        {
-            cityFound = true;
-
-            data()->setLocation(*loc);
-
-            //configure time zone rule
-            KStarsDateTime ltime = loc->UTtoLT(data()->ut());
-            loc->tzrule()->reset_with_ltime(ltime, loc->TZ0(), data()->isTimeRunningForward());
-            data()->setNextDSTChange(loc->tzrule()->nextDSTChange());
+        data()->setLocation(*loc);
 
-            //reset LST
-            data()->syncLST();
+        //configure time zone rule
+        KStarsDateTime ltime = loc->UTtoLT(data()->ut());
+        loc->tzrule()->reset_with_ltime(ltime, loc->TZ0(), data()->isTimeRunningForward());
+        data()->setNextDSTChange(loc->tzrule()->nextDSTChange());
 
-            //make sure planets, etc. are updated immediately
-            data()->setFullTimeUpdate();
-
-            // If the sky is in Horizontal mode and not tracking, reset focus such that
-            // Alt/Az remain constant.
-            if (!Options::isTracking() && Options::useAltAz())
-            {
-                map()->focus()->HorizontalToEquatorial(data()->lst(), data()->geo()->lat());
-            }
+        //reset LST
+        data()->syncLST();
 
-            // recalculate new times and objects
-            data()->setSnapNextFocus();
-            updateTime();
+        //make sure planets, etc. are updated immediately
+        data()->setFullTimeUpdate();
 
-            //no need to keep looking, we're done.
-            break;
+        // If the sky is in Horizontal mode and not tracking, reset focus such that
+        // Alt/Az remain constant.
+        if (!Options::isTracking() && Options::useAltAz())
+        {
+            map()->focus()->HorizontalToEquatorial(data()->lst(), data()->geo()->lat());
         }
+
+        // recalculate new times and objects
+        data()->setSnapNextFocus();
+        updateTime();
     }
 
     if (!cityFound)
@@ -955,6 +949,23 @@ QString KStars::getSkyMapDimensions()
 {
     return (QString::number(map()->width()) + 'x' + QString::number(map()->height()));
 }
+
+void KStars::setFrameProfiling(bool enable)
+{
+    FrameProfiler::setEnabled(enable);
+    map()->forceUpdate();
+}
+
+void KStars::resetFrameProfile()
+{
+    FrameProfiler::Instance()->reset();
+}
+
+QString KStars::getFrameProfile()
+{
+    return QString::fromUtf8(QJsonDocument(FrameProfiler::Instance()->toJson()).toJson(QJsonDocument::Indented));
+}
+
 void KStars::printImage(bool usePrintDialog, bool useChartColors)
 {
     //QPRINTER_FOR_NOW
@@ -48,6 +48,8 @@
 #include <QMenu>
 #include <QStatusBar>
 
+#include <memory>
+
 //This file contains functions that kstars calls at startup (except constructors).
 //These functions are declared in kstars.h
 
@@ -796,9 +798,22 @@ void KStars::datainitFinished()
     //Propagate config settings
     applyConfig(false);
 
+    // The objects which are not drawn at startup are loaded in the background once the sky is drawn
+    auto deferredLoading = std::make_shared<QMetaObject::Connection>();
+    *deferredLoading = connect(map(), &SkyMap::frameDrawn, this, [this, deferredLoading]()
+    {
+        disconnect(*deferredLoading);
+        data()->loadDeferredData();
+    }, Qt::QueuedConnection);
+
     //show the window.  must be before kswizard and messageboxes
     show();
 
+    // The tracked object may be one of those, e.g. a comet, so they are needed now
+    if (Options::isTracking() && Options::focusObject() != i18n("nothing") && Options::focusObject() != i18n("star") &&
+            data()->objectNamed(Options::focusObject()) == nullptr)
+        data()->loadDeferredData(true);
+
     //Initialize focus
     initFocus();
 
@@ -821,11 +836,19 @@ void KStars::datainitFinished()
     //Show TotD
     KTipDialog::showTip(this, "kstars/tips");
 
-    // Update comets and asteroids if enabled.
+    // Update comets and asteroids if enabled, once they are loaded
     if (Options::orbitalElementsAutoUpdate())
     {
-        slotUpdateComets(true);
-        slotUpdateAsteroids(true);
+        auto updateOrbitalElements = [this]()
+        {
+            slotUpdateComets(true);
+            slotUpdateAsteroids(true);
+        };
+
+        if (data()->isDeferredDataLoaded())
+            updateOrbitalElements();
+        else
+            connect(data(), &KStarsData::deferredDataLoaded, this, updateOrbitalElements);
     }
 }
 
@@ -16,6 +16,7 @@
 
 #include "locationdialoglite.h"
 
+#include "citydb.h"
 #include "kspaths.h"
 #include "kstarsdata.h"
 #include "kstarslite.h"
@@ -105,14 +106,15 @@ void LocationDialogLite::initCityList()
 {
     KStarsData *data = KStarsData::Instance();
     QStringList cities;
-    foreach (GeoLocation *loc, data->getGeoList())
+
+    // Only the names are listed, a city is created once it is needed
+    foreach (const CityDB::CityName &name, data->citydb()->names())
     {
-        QString name = loc->fullName();
-        cities.append(name);
-        filteredCityList.insert(name, loc);
+        cities.append(name.fullName);
+        filteredCityList.insert(name.fullName, name);
     }
 
-    //Sort the list of Cities alphabetically...note that filteredCityList may now have a different ordering!
+    //Sort the list of Cities alphabetically
     m_cityList.setStringList(cities);
     m_cityList.sort(0);
 
@@ -138,20 +140,24 @@ void LocationDialogLite::filterCity(const QString &city, const QString &province
     QStringList cities;
     filteredCityList.clear();
 
-    foreach (GeoLocation *loc, data->getGeoList())
+    // Without a filter, only the names are listed
+    if (city.isEmpty() && province.isEmpty() && country.isEmpty())
+    {
+        foreach (const CityDB::CityName &name, data->citydb()->names())
+        {
+            cities.append(name.fullName);
+            filteredCityList.insert(name.fullName, name);
+        }
+    }
+    else
     {
-        QString sc(loc->translatedName());
-        QString ss(loc->translatedCountry());
-        QString sp = "";
-        if (!loc->province().isEmpty())
-            sp = loc->translatedProvince();
-
-        if (sc.toLower().startsWith(city.toLower()) && sp.toLower().startsWith(province.toLower()) &&
-            ss.toLower().startsWith(country.toLower()))
+        foreach (GeoLocation *loc, data->citydb()->findByPrefix(city, province, country))
         {
-            QString name = loc->fullName();
-            cities.append(name);
-            filteredCityList.insert(name, loc);
+            CityDB::CityName name;
+            name.fullName = loc->fullName();
+            name.city     = loc;
+            cities.append(name.fullName);
+            filteredCityList.insert(name.fullName, name);
         }
     }
     m_cityList.setStringList(cities);
@@ -221,9 +227,9 @@ bool LocationDialogLite::addCity(const QString &city, const QString &province, c
             return false;
         }
 
-        //Add city to geoList
+        //Add city to the user cities
         g = new GeoLocation(lng, lat, City, Province, Country, TZ, &KStarsData::Instance()->Rulebook[TZRule]);
-        KStarsData::Instance()->getGeoList().append(g);
+        KStarsData::Instance()->citydb()->addUserCity(g);
 
         mycitydb.commit();
         mycitydb.close();
@@ -236,7 +242,7 @@ bool LocationDialogLite::addCity(const QString &city, const QString &province, c
 bool LocationDialogLite::deleteCity(const QString &fullName)
 {
     QSqlDatabase mycitydb = getDB();
-    GeoLocation *geo      = filteredCityList.value(fullName);
+    GeoLocation *geo      = cityNamed(fullName);
 
     if (mycitydb.isValid() && geo && !geo->isReadOnly())
     {
@@ -252,8 +258,7 @@ bool LocationDialogLite::deleteCity(const QString &fullName)
         }
 
         filteredCityList.remove(geo->fullName());
-        KStarsData::Instance()->getGeoList().removeOne(geo);
-        delete (geo);
+        KStarsData::Instance()->citydb()->removeUserCity(geo);
         mycitydb.commit();
         mycitydb.close();
         return true;
@@ -266,7 +271,7 @@ bool LocationDialogLite::editCity(const QString &fullName, const QString &city,
                                   const QString &longitude, const QString &TimeZoneString, const QString &TZRule)
 {
     QSqlDatabase mycitydb = getDB();
-    GeoLocation *geo      = filteredCityList.value(fullName);
+    GeoLocation *geo      = cityNamed(fullName);
 
     bool latOk(false), lngOk(false), tzOk(false);
     dms lat   = createDms(latitude, true, &latOk);
@@ -318,7 +323,7 @@ bool LocationDialogLite::editCity(const QString &fullName, const QString &city,
 
 QString LocationDialogLite::getCity(const QString &fullName)
 {
-    GeoLocation *geo = filteredCityList.value(fullName);
+    GeoLocation *geo = cityNamed(fullName);
 
     if (geo)
     {
@@ -329,7 +334,7 @@ QString LocationDialogLite::getCity(const QString &fullName)
 
 QString LocationDialogLite::getProvince(const QString &fullName)
 {
-    GeoLocation *geo = filteredCityList.value(fullName);
+    GeoLocation *geo = cityNamed(fullName);
 
     if (geo)
     {
@@ -340,7 +345,7 @@ QString LocationDialogLite::getProvince(const QString &fullName)
 
 QString LocationDialogLite::getCountry(const QString &fullName)
 {
-    GeoLocation *geo = filteredCityList.value(fullName);
+    GeoLocation *geo = cityNamed(fullName);
 
     if (geo)
     {
@@ -351,7 +356,7 @@ QString LocationDialogLite::getCountry(const QString &fullName)
 
 double LocationDialogLite::getLatitude(const QString &fullName)
 {
-    GeoLocation *geo = filteredCityList.value(fullName);
+    GeoLocation *geo = cityNamed(fullName);
 
     if (geo)
     {
@@ -362,7 +367,7 @@ double LocationDialogLite::getLatitude(const QString &fullName)
 
 double LocationDialogLite::getLongitude(const QString &fullName)
 {
-    GeoLocation *geo = filteredCityList.value(fullName);
+    GeoLocation *geo = cityNamed(fullName);
 
     if (geo)
     {
@@ -373,7 +378,7 @@ double LocationDialogLite::getLongitude(const QString &fullName)
 
 int LocationDialogLite::getTZ(const QString &fullName)
 {
-    GeoLocation *geo = filteredCityList.value(fullName);
+    GeoLocation *geo = cityNamed(fullName);
     if (geo)
     {
         return m_TZList.indexOf(QString::number(geo->TZ0()));
@@ -383,7 +388,7 @@ int LocationDialogLite::getTZ(const QString &fullName)
 
 int LocationDialogLite::getDST(const QString &fullName)
 {
-    GeoLocation *geo                      = filteredCityList.value(fullName);
+    GeoLocation *geo                      = cityNamed(fullName);
     QMap<QString, TimeZoneRule> &Rulebook = KStarsData::Instance()->Rulebook;
 
     if (geo)
@@ -401,16 +406,11 @@ bool LocationDialogLite::isDuplicate(const QString &city, const QString &provinc
 {
     KStarsData *data = KStarsData::Instance();
 
-    foreach (GeoLocation *loc, data->getGeoList())
+    // The prefix search ignores case, the names must also have the same length
+    foreach (GeoLocation *loc, data->citydb()->findByPrefix(city, province, country))
     {
-        QString sc(loc->translatedName());
-        QString ss(loc->translatedCountry());
-        QString sp;
-
-        if (!loc->province().isEmpty())
-            sp = loc->translatedProvince();
-
-        if (sc.toLower() == city.toLower() && sp.toLower() == province.toLower() && ss.toLower() == country.toLower())
+        if (loc->translatedName().size() == city.size() && loc->translatedProvince().size() == province.size() &&
+                loc->translatedCountry().size() == country.size())
         {
             return true;
         }
@@ -420,7 +420,7 @@ bool LocationDialogLite::isDuplicate(const QString &city, const QString &provinc
 
 bool LocationDialogLite::isReadOnly(const QString &fullName)
 {
-    GeoLocation *geo = filteredCityList.value(fullName);
+    GeoLocation *geo = cityNamed(fullName);
 
     if (geo)
     {
@@ -432,6 +432,11 @@ bool LocationDialogLite::isReadOnly(const QString &fullName)
     }
 }
 
+GeoLocation *LocationDialogLite::cityNamed(const QString &fullName)
+{
+    return KStarsData::Instance()->citydb()->city(filteredCityList.value(fullName));
+}
+
 QSqlDatabase LocationDialogLite::getDB()
 {
     QSqlDatabase mycitydb = QSqlDatabase::database("mycitydb");
@@ -493,14 +498,14 @@ bool LocationDialogLite::setLocation(const QString &fullName)
 {
     KStarsData *data = KStarsData::Instance();
 
-    GeoLocation *geo = filteredCityList.value(fullName);
+    GeoLocation *geo = cityNamed(fullName);
     if (!geo)
     {
-        foreach (GeoLocation *loc, data->getGeoList())
+        foreach (const CityDB::CityName &name, data->citydb()->names())
         {
-            if (loc->fullName() == fullName)
+            if (name.fullName == fullName)
             {
-                geo = loc;
+                geo = data->citydb()->city(name);
                 break;
             }
         }
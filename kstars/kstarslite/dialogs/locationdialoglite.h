@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "citydb.h"
 #include "dms.h"
 
 #include <QHash>
@@ -116,8 +117,12 @@ class LocationDialogLite : public QObject
      */
     QSqlDatabase getDB();
 
+    /** @return the listed city with the given full name, created if needed, nullptr if none */
+    GeoLocation *cityNamed(const QString &fullName);
+
     QStringListModel m_cityList;
-    QHash<QString, GeoLocation *> filteredCityList;
+    /// Listed cities by full name, created once needed
+    QHash<QString, CityDB::CityName> filteredCityList;
     GeoLocation *SelectedCity { nullptr };
     GeoLocation *currentGeo { nullptr };
     QString m_currentLocation;
@@ -62,6 +62,9 @@ void KStarsLite::datainitFinished()
     dataLoadFinished();
     map()->forceUpdate();
 
+    // Asteroids, comets and satellites are loaded in the background
+    data()->loadDeferredData();
+
     //Default options
     Options::setShowEquator(true);
     Options::setShowHorizon(true);
@@ -30,6 +30,7 @@
 #include "version.h"
 #if !defined(KSTARS_LITE)
 #include "kstars.h"
+#include "logwriter.h"
 #include "skymap.h"
 #endif
 
@@ -93,6 +94,8 @@ int main(int argc, char *argv[])
 #ifndef KSTARS_LITE
 
     KCrash::initialize();
+    // Write the log lines not yet written by LogWriter before the crash handler takes over
+    KCrash::setEmergencySaveFunction([](int) { LogWriter::crashFlush(); });
 
     KAboutData aboutData("kstars", i18n("KStars"), KSTARS_VERSION, i18n(description), KAboutLicense::GPL,
                          "2001-" + QString::number(QDate::currentDate().year()) + i18n("(c), The KStars Team"),
@@ -210,6 +213,7 @@ int main(int argc, char *argv[])
         KStarsData *dat = KStarsData::Create();
         QObject::connect(dat, SIGNAL(progressText(QString)), dat, SLOT(slotConsoleMessage(QString)));
         dat->initialize();
+        dat->loadDeferredData(true);
 
         //Set Geographic Location
         dat->setLocationFromOptions();
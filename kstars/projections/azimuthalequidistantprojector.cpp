@@ -44,6 +44,15 @@ double AzimuthalEquidistantProjector::projectionK(double x) const
     return ((crad != 0) ? crad / sin(crad) : 1); // This handles the 0/0 case. The limit of x / sin(x) is 1 as x -> 0.
 }
 
+void AzimuthalEquidistantProjector::projectionKBatch(int n, double *c) const
+{
+    for (int i = 0; i < n; ++i)
+    {
+        double crad = acos(c[i]);
+        c[i]        = ((crad != 0) ? crad / sin(crad) : 1);
+    }
+}
+
 double AzimuthalEquidistantProjector::projectionL(double x) const
 {
     return x;
@@ -71,6 +71,52 @@ Vector2f EquirectangularProjector::toScreenVec(const SkyPoint *o, bool oRefract,
     return p;
 }
 
+int EquirectangularProjector::toScreenBatch(int n, const double *ra, const double *dec, const double *alt,
+                                            const double *az, Vector2f *points, bool *visible, bool oRefract) const
+{
+    if (n <= 0)
+        return 0;
+
+    oRefract &= m_vp.useRefraction;
+    checkVisibilityBatch(n, ra, dec, alt, az, visible);
+
+    const double halfWidth  = 0.5 * m_vp.width;
+    const double halfHeight = 0.5 * m_vp.height;
+    const double zoom       = m_vp.zoomFactor;
+    int nVisible            = 0;
+
+    if (m_vp.useAltAz)
+    {
+        const double focusAz  = m_vp.focus->az().reduce().radians();
+        const double focusAlt = m_vp.focus->alt().radians();
+        for (int i = 0; i < n; ++i)
+        {
+            double Y  = (oRefract ? SkyPoint::refract(alt[i]) : alt[i]) * dms::DegToRad;
+            double dX = KSUtils::reduceAngle(focusAz - dms(az[i]).reduce().radians(), -dms::PI, dms::PI);
+            points[i] = Vector2f(halfWidth - zoom * dX, halfHeight - zoom * (Y - focusAlt));
+        }
+    }
+    else
+    {
+        const double focusRA  = m_vp.focus->ra().reduce().radians();
+        const double focusDec = m_vp.focus->dec().radians();
+        for (int i = 0; i < n; ++i)
+        {
+            double dX = KSUtils::reduceAngle(dms(ra[i]).reduce().radians() - focusRA, -dms::PI, dms::PI);
+            points[i] = Vector2f(halfWidth - zoom * dX, halfHeight - zoom * (dec[i] * dms::DegToRad - focusDec));
+        }
+    }
+
+    for (int i = 0; i < n; ++i)
+    {
+        const float x = points[i].x(), y = points[i].y();
+        visible[i]    = visible[i] && 0 < x && x < m_vp.width && 0 <= y && y <= m_vp.height;
+        nVisible += visible[i];
+    }
+
+    return nVisible;
+}
+
 SkyPoint EquirectangularProjector::fromScreen(const QPointF &p, dms *LST, const dms *lat) const
 {
     SkyPoint result;
@@ -39,6 +39,12 @@ double GnomonicProjector::projectionK(double x) const
     return 1.0 / x;
 }
 
+void GnomonicProjector::projectionKBatch(int n, double *c) const
+{
+    for (int i = 0; i < n; ++i)
+        c[i] = 1.0 / c[i];
+}
+
 double GnomonicProjector::projectionL(double x) const
 {
     return atan(x);
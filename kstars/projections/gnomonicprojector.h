@@ -35,6 +35,7 @@ class GnomonicProjector : public Projector
     Projection type() const override;
     double radius() const override;
     double projectionK(double x) const override;
+    void projectionKBatch(int n, double *c) const override;
     double projectionL(double x) const override;
     double cosMaxFieldAngle() const override;
 };
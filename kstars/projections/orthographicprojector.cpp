@@ -40,6 +40,12 @@ double OrthographicProjector::projectionK(double x) const
     return 1.0;
 }
 
+void OrthographicProjector::projectionKBatch(int n, double *c) const
+{
+    for (int i = 0; i < n; ++i)
+        c[i] = 1.0;
+}
+
 double OrthographicProjector::projectionL(double x) const
 {
     return asin(x);
@@ -243,6 +243,120 @@ bool Projector::checkVisibility(const SkyPoint *p) const
     return dX < m_xrange;
 }
 
+int Projector::toScreenBatch(int n, const double *ra, const double *dec, const double *alt, const double *az,
+                             Vector2f *points, bool *visible, bool oRefract) const
+{
+    if (n <= 0)
+        return 0;
+
+    oRefract &= m_vp.useRefraction;
+
+    QVector<double> Y(n), dX(n), c(n), sinY(n), cosY(n), sindX(n), cosdX(n);
+
+    checkVisibilityBatch(n, ra, dec, alt, az, visible);
+
+    const double focusX = m_vp.useAltAz ? m_vp.focus->az().Degrees() : m_vp.focus->ra().Degrees();
+
+    for (int i = 0; i < n; ++i)
+    {
+        if (m_vp.useAltAz)
+        {
+            Y[i]  = (oRefract ? SkyPoint::refract(alt[i]) : alt[i]) * dms::DegToRad;
+            dX[i] = (focusX - az[i]) * dms::DegToRad;
+        }
+        else
+        {
+            Y[i]  = dec[i] * dms::DegToRad;
+            dX[i] = (ra[i] - focusX) * dms::DegToRad;
+        }
+        dX[i] = KSUtils::reduceAngle(dX[i], -dms::PI, dms::PI);
+    }
+
+    for (int i = 0; i < n; ++i)
+    {
+#if (__GLIBC__ >= 2 && __GLIBC_MINOR__ >= 1)
+        sincos(dX[i], &sindX[i], &cosdX[i]);
+        sincos(Y[i], &sinY[i], &cosY[i]);
+#else
+        sindX[i] = sin(dX[i]);
+        cosdX[i] = cos(dX[i]);
+        sinY[i]  = sin(Y[i]);
+        cosY[i]  = cos(Y[i]);
+#endif
+    }
+
+    //c is the cosine of the angular distance from the center
+    for (int i = 0; i < n; ++i)
+        c[i] = m_sinY0 * sinY[i] + m_cosY0 * cosY[i] * cosdX[i];
+
+    const double cosMax = cosMaxFieldAngle();
+    for (int i = 0; i < n; ++i)
+        visible[i] = visible[i] && (c[i] > cosMax);
+
+    // c is turned into k in place
+    projectionKBatch(n, c.data());
+
+    const double origX = m_vp.width / 2;
+    const double origY = m_vp.height / 2;
+    int nVisible       = 0;
+
+#ifdef KSTARS_LITE
+    double cosT = 1, sinT = 0;
+    double skyRotation = SkyMapLite::Instance()->getSkyRotation();
+    if (skyRotation != 0)
+        dms(skyRotation).SinCos(sinT, cosT);
+#endif
+
+    for (int i = 0; i < n; ++i)
+    {
+        const double k = c[i];
+        double x       = origX - m_vp.zoomFactor * k * cosY[i] * sindX[i];
+        double y       = origY - m_vp.zoomFactor * k * (m_cosY0 * sinY[i] - m_sinY0 * cosY[i] * cosdX[i]);
+#ifdef KSTARS_LITE
+        double newX = origX + (x - origX) * cosT - (y - origY) * sinT;
+        double newY = origY + (x - origX) * sinT + (y - origY) * cosT;
+
+        x = newX;
+        y = newY;
+#endif
+
+        points[i]  = Vector2f(x, y);
+        visible[i] = visible[i] && std::isfinite(x) && std::isfinite(y) && 0 <= x && x <= m_vp.width && 0 <= y &&
+                     y <= m_vp.height;
+        nVisible += visible[i];
+    }
+
+    return nVisible;
+}
+
+void Projector::checkVisibilityBatch(int n, const double *ra, const double *dec, const double *alt, const double *az,
+                                     bool *visible) const
+{
+    // NOTE: Same heuristics as checkVisibility(), keep them in sync
+    const double focusY  = m_vp.useAltAz ? m_vp.focus->alt().Degrees() : m_vp.focus->dec().Degrees();
+    const double focusX  = m_vp.useAltAz ? m_vp.focus->az().Degrees() : m_vp.focus->ra().Degrees();
+    const double yFactor = m_isPoleVisible ? 0.75 : 1.0;
+    const double yOffset = m_vp.useAltAz ? 2.0 : 0.0;
+    const double *X      = m_vp.useAltAz ? az : ra;
+    const double *Y      = m_vp.useAltAz ? alt : dec;
+
+    for (int i = 0; i < n; ++i)
+    {
+        double dY = (fabs(Y[i] - focusY) - yOffset) * yFactor;
+        double dX = fabs(X[i] - focusX);
+        if (dX > 180.0)
+            dX = 360.0 - dX;
+
+        visible[i] = !(m_vp.fillGround && alt[i] < -1.0) && dY <= m_fov && (m_isPoleVisible || dX < m_xrange);
+    }
+}
+
+void Projector::projectionKBatch(int n, double *c) const
+{
+    for (int i = 0; i < n; ++i)
+        c[i] = projectionK(c[i]);
+}
+
 // FIXME: There should be a MUCH more efficient way to do this (see EyepieceField for example)
 double Projector::findNorthPA(SkyPoint *o, float x, float y) const
 {
@@ -132,6 +132,35 @@ class Projector
      */
     virtual Vector2f toScreenVec(const SkyPoint *o, bool oRefract = true, bool *onVisibleHemisphere = nullptr) const;
 
+    /**
+     * @short Project many points at once
+     *
+     * Batch version of checkVisibility() + toScreenVec() + onScreen() for points that are held
+     * in plain arrays (see StarBlock). The common spherical part is computed in passes over the
+     * arrays, and the projection-specific scale factor by projectionKBatch(), so the inner loops
+     * have no virtual calls and can be vectorized.
+     *
+     * @param n number of points
+     * @param ra, dec equatorial coordinates of date, in degrees
+     * @param alt, az horizontal coordinates, in degrees
+     * @param points output screen positions, n entries
+     * @param visible output mask, true if the point passes checkVisibility(), lies on the visible
+     *   hemisphere and falls on the screen
+     * @param oRefract as for toScreenVec()
+     * @return the number of visible points
+     */
+    virtual int toScreenBatch(int n, const double *ra, const double *dec, const double *alt, const double *az,
+                              Vector2f *points, bool *visible, bool oRefract = true) const;
+
+    /**
+     * @short Batch version of checkVisibility()
+     * @param n number of points
+     * @param ra, dec, alt, az coordinates of the points in degrees, as for toScreenBatch()
+     * @param visible output, result of checkVisibility() for each point
+     */
+    void checkVisibilityBatch(int n, const double *ra, const double *dec, const double *alt, const double *az,
+                              bool *visible) const;
+
     /**
      * This is exactly the same as toScreenVec but it returns a QPointF.
      * It just calls toScreenVec and converts the result.
@@ -270,6 +299,14 @@ class Projector
      */
     virtual double projectionL(double x) const { return x; }
 
+    /**
+     * Batch version of projectionK(), used by toScreenBatch(). Replaces each cosine of the field
+     * angle in c by the corresponding value of projectionK().
+     * The default implementation calls projectionK() for every entry; projections override it with
+     * a loop the compiler can vectorize.
+     */
+    virtual void projectionKBatch(int n, double *c) const;
+
     /**
      * This function returns the cosine of the maximum field angle, i.e., the maximum angular
      * distance from the focus for which a point should be projected. Default is 0, i.e.,
@@ -49,7 +49,6 @@
 AsteroidsComponent::AsteroidsComponent(SolarSystemComposite *parent) : BinaryListComponent(this, "asteroids"),
     SolarSystemListComponent(parent)
 {
-    loadData();
 }
 
 bool AsteroidsComponent::selected()
@@ -87,8 +86,9 @@ bool AsteroidsComponent::selected()
  * @li 22 earth minimum orbit intersection distance [double]
  * @li 23 orbit classification [string]
  */
-void AsteroidsComponent::loadDataFromText()
+QList<KSAsteroid *> AsteroidsComponent::readDataFromText()
 {
+    QList<KSAsteroid *> asteroids;
     QString name, full_name, orbit_id, orbit_class, dimensions;
     int mJD;
     double q, a, e, dble_i, dble_w, dble_N, dble_M, H, G, earth_moid;
@@ -125,11 +125,30 @@ void AsteroidsComponent::loadDataFromText()
 
     KSParser asteroid_parser(filepath_txt, '#', sequence);
 
-    QHash<QString, QVariant> row_content;
-    while (asteroid_parser.HasNextRow())
+    int const fullNameColumn  = asteroid_parser.ColumnIndex("full name");
+    int const epochColumn     = asteroid_parser.ColumnIndex("epoch_mjd");
+    int const qColumn         = asteroid_parser.ColumnIndex("q");
+    int const aColumn         = asteroid_parser.ColumnIndex("a");
+    int const eColumn         = asteroid_parser.ColumnIndex("e");
+    int const iColumn         = asteroid_parser.ColumnIndex("i");
+    int const wColumn         = asteroid_parser.ColumnIndex("w");
+    int const omColumn        = asteroid_parser.ColumnIndex("om");
+    int const maColumn        = asteroid_parser.ColumnIndex("ma");
+    int const orbitIDColumn   = asteroid_parser.ColumnIndex("orbit_id");
+    int const hColumn         = asteroid_parser.ColumnIndex("H");
+    int const gColumn         = asteroid_parser.ColumnIndex("G");
+    int const neoColumn       = asteroid_parser.ColumnIndex("neo");
+    int const diameterColumn  = asteroid_parser.ColumnIndex("diameter");
+    int const extentColumn    = asteroid_parser.ColumnIndex("extent");
+    int const albedoColumn    = asteroid_parser.ColumnIndex("albedo");
+    int const rotationColumn  = asteroid_parser.ColumnIndex("rot_period");
+    int const periodColumn    = asteroid_parser.ColumnIndex("per_y");
+    int const moidColumn      = asteroid_parser.ColumnIndex("moid");
+    int const classColumn     = asteroid_parser.ColumnIndex("class");
+
+    while (asteroid_parser.NextRow())
     {
-        row_content = asteroid_parser.ReadNextRow();
-        full_name   = row_content["full name"].toString();
+        full_name   = asteroid_parser.FieldString(fullNameColumn);
         full_name   = full_name.trimmed();
         int catN    = full_name.section(' ', 0, 0).toInt();
 
@@ -140,25 +159,25 @@ void AsteroidsComponent::loadDataFromText()
                 name == i18nc("Asteroid name (optional)", "Asterope"))
             name += i18n(" (Asteroid)");
 
-        mJD         = row_content["epoch_mjd"].toInt();
-        q           = row_content["q"].toDouble();
-        a           = row_content["a"].toDouble();
-        e           = row_content["e"].toDouble();
-        dble_i      = row_content["i"].toDouble();
-        dble_w      = row_content["w"].toDouble();
-        dble_N      = row_content["om"].toDouble();
-        dble_M      = row_content["ma"].toDouble();
-        orbit_id    = row_content["orbit_id"].toString();
-        H           = row_content["H"].toDouble();
-        G           = row_content["G"].toDouble();
-        neo         = row_content["neo"].toString() == "Y";
-        diameter    = row_content["diameter"].toFloat();
-        dimensions  = row_content["extent"].toString();
-        albedo      = row_content["albedo"].toFloat();
-        rot_period  = row_content["rot_period"].toFloat();
-        period      = row_content["per_y"].toFloat();
-        earth_moid  = row_content["moid"].toDouble();
-        orbit_class = row_content["class"].toString();
+        mJD         = asteroid_parser.FieldInt(epochColumn);
+        q           = asteroid_parser.FieldDouble(qColumn);
+        a           = asteroid_parser.FieldDouble(aColumn);
+        e           = asteroid_parser.FieldDouble(eColumn);
+        dble_i      = asteroid_parser.FieldDouble(iColumn);
+        dble_w      = asteroid_parser.FieldDouble(wColumn);
+        dble_N      = asteroid_parser.FieldDouble(omColumn);
+        dble_M      = asteroid_parser.FieldDouble(maColumn);
+        orbit_id    = asteroid_parser.FieldString(orbitIDColumn);
+        H           = asteroid_parser.FieldDouble(hColumn);
+        G           = asteroid_parser.FieldDouble(gColumn);
+        neo         = asteroid_parser.FieldLatin1(neoColumn) == QLatin1String("Y");
+        diameter    = asteroid_parser.FieldFloat(diameterColumn);
+        dimensions  = asteroid_parser.FieldString(extentColumn);
+        albedo      = asteroid_parser.FieldFloat(albedoColumn);
+        rot_period  = asteroid_parser.FieldFloat(rotationColumn);
+        period      = asteroid_parser.FieldFloat(periodColumn);
+        earth_moid  = asteroid_parser.FieldDouble(moidColumn);
+        orbit_class = asteroid_parser.FieldString(classColumn);
 
         JD = static_cast<double>(mJD) + 2400000.5;
 
@@ -183,12 +202,10 @@ void AsteroidsComponent::loadDataFromText()
         new_asteroid->setPhysicalSize(diameter);
         //new_asteroid->setAngularSize(0.005);
 
-        appendListObject(new_asteroid);
-
-        // Add name to the list of object names
-        objectNames(SkyObject::ASTEROID).append(name);
-        objectLists(SkyObject::ASTEROID).append(QPair<QString, const SkyObject *>(name, new_asteroid));
+        asteroids.append(new_asteroid);
     }
+
+    return asteroids;
 }
 
 void AsteroidsComponent::draw(SkyPainter *skyp)
@@ -44,11 +44,17 @@ class AsteroidsComponent : public QObject, public SolarSystemListComponent,
         /**
          * @short Default constructor.
          *
+         * The asteroids are read by loadData(), once the sky map is shown. They may also be read
+         * on another thread by readData(), and then added on the main thread by addData().
          * @p parent pointer to the parent SolarSystemComposite
          */
         explicit AsteroidsComponent(SolarSystemComposite *parent);
         virtual ~AsteroidsComponent() override = default;
 
+        using BinaryListComponent<KSAsteroid, AsteroidsComponent>::loadData;
+        using BinaryListComponent<KSAsteroid, AsteroidsComponent>::readData;
+        using BinaryListComponent<KSAsteroid, AsteroidsComponent>::addData;
+
         void draw(SkyPainter *skyp) override;
         bool selected() override;
         SkyObject *objectNearest(SkyPoint *p, double &maxrad) override;
@@ -62,7 +68,7 @@ class AsteroidsComponent : public QObject, public SolarSystemListComponent,
         void downloadError(const QString &errorString);
 
     private:
-        void loadDataFromText() override;
+        QList<KSAsteroid *> readDataFromText() override;
 
         QPointer<FileDownloader> downloadJob;
 };
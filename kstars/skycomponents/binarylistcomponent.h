@@ -36,10 +36,13 @@
  * must provide a static `TYPE` property of the type `SkyObject::TYPE`. This is required
  * because access to the `type()` method is inconvenient here!
  *
- * The derived class must provide a `void loadFromText()` method, which loads the component
- * via `addListObject` or similar. (This method implements parsing etc, and cannot be
+ * The derived class must provide a `QList<T *> readDataFromText()` method, which returns the
+ * objects parsed from the text file. (This method implements parsing etc, and cannot be
  * abstracted by this class.)
  *
+ * Reading the data does not touch the component, so it may be done on any thread with
+ * readData(), and the objects added to the component later on with addData().
+ *
  * Finally, one has to add this template as a friend class upon deriving it.
  * This is a concession to the already present architecture.
  *
@@ -85,41 +88,53 @@ protected:
     virtual void loadData(bool dropBinaryFile);
 
     /**
-     * @brief loadDataFromBinary
-     * @short Opens the default binfile and calls `loadDataFromBinary([FILE])`
+     * @brief readData
+     * @short Read the component data from binary (if available) or from text, without adding it
+     * @param dropBinaryFile whether to drop the current binary (and to recreate it)
+     * @return the objects read, owned by the caller until they are passed to addData()
+     *
+     * The component is not modified, so this may run on any thread.
+     */
+    QList<T *> readData(bool dropBinaryFile = false);
+
+    /**
+     * @brief addData
+     * @short Replace the component data with the objects returned by readData()
+     * @param objects the objects, now owned by the component
      */
-    virtual void loadDataFromBinary();
+    void addData(const QList<T *> &objects);
 
     /**
-     * @brief loadDataFromBinary
+     * @brief readDataFromBinary
      * @param binfile the binary file
-     * @short Loads the component data from the given binary.
+     * @short Reads the component data from the given binary.
      */
-    virtual void loadDataFromBinary(QFile &binfile);
+    virtual QList<T *> readDataFromBinary(QFile &binfile);
 
     /**
      * @brief writeBinary
-     * @short Opens the default binfile and calls `writeBinary([FILE])`
+     * @short Opens the default binfile and writes the component data to it
      */
     virtual void writeBinary();
 
     /**
      * @brief writeBinary
      * @param binfile
-     * @short Writes the component data to the specified binary. (Destructive)
+     * @param objects the objects to write
+     * @short Writes the objects to the specified binary. (Destructive)
      */
-    virtual void writeBinary(QFile &binfile);
+    virtual void writeBinary(QFile &binfile, const QList<T *> &objects);
 
     /**
-     * @brief loadDataFromText
-     * @short Load the component data from text.
+     * @brief readDataFromText
+     * @short Read the component data from text.
      *
      * This method shall be implemented by those who derive this class.
      *
-     * This method should load the component data from text by the use of
-     * `addListObject`  or similar.
+     * This method should return the objects parsed from the text file, without
+     * touching the component.
      */
-    virtual void loadDataFromText() = 0;
+    virtual QList<T *> readDataFromText() = 0;
 
     // TODO: Rename, and integrate it into a wrapper
     //virtual void updateDataFile() = 0; // legacy from current implementation!
@@ -172,32 +187,44 @@ void  BinaryListComponent<T, Component>::loadData()
 template<class T, typename Component>
 void  BinaryListComponent<T, Component>::loadData(bool dropBinaryFile)
 {
-    // Clear old Stuff (in case of reload)
-    clearData();
+    addData(readData(dropBinaryFile));
+}
 
+template<class T, typename Component>
+QList<T *>  BinaryListComponent<T, Component>::readData(bool dropBinaryFile)
+{
     // Drop Binary file for a fresh reload
     if(dropBinaryFile)
         dropBinary();
 
     QFile binfile(filepath_bin);
-    if (binfile.exists()) {
-        loadDataFromBinary(binfile);
-    } else {
-        loadDataFromText();
-        writeBinary(binfile);
-    }
+    if (binfile.exists())
+        return readDataFromBinary(binfile);
+
+    QList<T *> objects = readDataFromText();
+    writeBinary(binfile, objects);
+    return objects;
 }
 
 template<class T, typename Component>
-void  BinaryListComponent<T, Component>::loadDataFromBinary()
+void  BinaryListComponent<T, Component>::addData(const QList<T *> &objects)
 {
-    QFile binfile(filepath_bin);
-    loadDataFromBinary(binfile);
+    // Clear old Stuff (in case of reload)
+    clearData();
+
+    for(auto new_object : objects){
+        parent->appendListObject(new_object);
+        // Add name to the list of object names
+        parent->objectNames(T::TYPE).append(new_object->name());
+        parent->objectLists(T::TYPE).append(QPair<QString, const SkyObject *>(new_object->name(), new_object));
+    }
 }
 
 template<class T, typename Component>
-void  BinaryListComponent<T, Component>::loadDataFromBinary(QFile &binfile)
+QList<T *>  BinaryListComponent<T, Component>::readDataFromBinary(QFile &binfile)
 {
+    QList<T *> objects;
+
     // Open our binary file and create a Stream
     binfile.open(QIODevice::ReadOnly);
     QDataStream in(&binfile);
@@ -210,24 +237,25 @@ void  BinaryListComponent<T, Component>::loadDataFromBinary(QFile &binfile)
     while(!in.atEnd()){
         T *new_object = nullptr;
         in >> new_object;
-
-        parent->appendListObject(new_object);
-        // Add name to the list of object names
-        parent->objectNames(T::TYPE).append(new_object->name());
-        parent->objectLists(T::TYPE).append(QPair<QString, const SkyObject *>(new_object->name(), new_object));
+        objects.append(new_object);
     }
     binfile.close();
+    return objects;
 }
 
 template<class T, typename Component>
 void  BinaryListComponent<T, Component>::writeBinary()
 {
+    QList<T *> objects;
+    for(auto object : parent->m_ObjectList)
+        objects.append((T*)object);
+
     QFile binfile(filepath_bin);
-    writeBinary(binfile);
+    writeBinary(binfile, objects);
 }
 
 template<class T, typename Component>
-void  BinaryListComponent<T, Component>::writeBinary(QFile &binfile)
+void  BinaryListComponent<T, Component>::writeBinary(QFile &binfile, const QList<T *> &objects)
 {
     // Open our file and create a stream
     binfile.open(QIODevice::WriteOnly | QIODevice::Truncate);
@@ -236,8 +264,8 @@ void  BinaryListComponent<T, Component>::writeBinary(QFile &binfile)
     out.setFloatingPointPrecision(QDataStream::DoublePrecision);
 
     // Now just dump out everything
-    for(auto object : parent->m_ObjectList){
-         out << *((T*)object);
+    for(auto object : objects){
+         out << *object;
     }
 
     binfile.close();
@@ -18,15 +18,49 @@
 #include "catalogcomponent.h"
 
 #include "catalogdata.h"
+#include "deepskycomponent.h"
 #include "kstarsdata.h"
+#include "skymesh.h"
 #include "skypainter.h"
+#include "htmesh/MeshIterator.h"
 #include "skyobjects/starobject.h"
 #include "skyobjects/deepskyobject.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+/** Unknown magnitudes sort after all the others */
+float magnitudeKey(const SkyObject *obj)
+{
+    float const mag = obj->mag();
+    return (std::isnan(mag) || mag > 36.0) ? std::numeric_limits<float>::infinity() : mag;
+}
+
+template <typename T>
+void updateCoordinates(T *obj, KStarsData *data)
+{
+    if (obj->updateID == data->updateID())
+        return;
+
+    obj->updateID = data->updateID();
+    if (obj->updateNumID != data->updateNumID())
+    {
+        obj->updateCoords(data->updateNum());
+        obj->updateNumID = data->updateNumID();
+    }
+    obj->EquatorialToHorizontal(data->lst(), data->geo()->lat());
+}
+}
+
 CatalogComponent::CatalogComponent(SkyComposite *parent, const QString &catname, bool showerrs, int index,
                                    bool callLoadData)
     : ListComponent(parent), m_catName(catname), m_Showerrs(showerrs), m_ccIndex(index)
 {
+    m_skyMesh = SkyMesh::Instance();
+
     if (callLoadData)
         loadData();
 }
@@ -56,17 +90,34 @@ CatalogComponent::~CatalogComponent()
 }
 
 void CatalogComponent::_loadData(bool includeCatalogDesignation)
+{
+    readData(includeCatalogDesignation);
+    addNames();
+}
+
+void CatalogComponent::readData(bool includeCatalogDesignation)
 {
     if (includeCatalogDesignation)
         emitProgressText(i18n("Loading custom catalog: %1", m_catName));
     else
         emitProgressText(i18n("Loading internal catalog: %1", m_catName));
 
-    QList<QPair<int, QString>> names;
+    m_readNames.clear();
+    KStarsData::Instance()->catalogdb()->GetAllObjects(m_catName, m_ObjectList, m_readNames, this,
+                                                       includeCatalogDesignation);
 
-    KStarsData::Instance()->catalogdb()->GetAllObjects(m_catName, m_ObjectList, names, this, includeCatalogDesignation);
+    CatalogData loaded_catalog_data;
+    KStarsData::Instance()->catalogdb()->GetCatalogData(m_catName, loaded_catalog_data);
+    m_catColor    = loaded_catalog_data.color;
+    m_catFluxFreq = loaded_catalog_data.fluxfreq;
+    m_catFluxUnit = loaded_catalog_data.fluxunit;
 
-    for (const auto &name : names)
+    indexObjects();
+}
+
+void CatalogComponent::addNames()
+{
+    for (const auto &name : m_readNames)
     {
         if (name.first <= SkyObject::TYPE_UNKNOWN)
         {
@@ -140,52 +191,90 @@ void CatalogComponent::_loadData(bool includeCatalogDesignation)
     for (auto &list : objectNames())
         list.removeDuplicates();
 
-    CatalogData loaded_catalog_data;
-    KStarsData::Instance()->catalogdb()->GetCatalogData(m_catName, loaded_catalog_data);
-    m_catColor    = loaded_catalog_data.color;
-    m_catFluxFreq = loaded_catalog_data.fluxfreq;
-    m_catFluxUnit = loaded_catalog_data.fluxunit;
+    m_readNames.clear();
+}
+
+void CatalogComponent::indexObjects()
+{
+    m_ObjectIndex.clear();
+
+    // Sorting each trixel once is much faster than inserting in order for large catalogs
+    for (auto obj : m_ObjectList)
+    {
+        IndexedObject item;
+        item.obj  = obj;
+        item.star = dynamic_cast<StarObject *>(obj);
+        item.dso  = dynamic_cast<DeepSkyObject *>(obj);
+        item.mag  = magnitudeKey(obj);
+
+        Q_ASSERT(item.star || item.dso); // We either have stars, or deep sky objects
+        m_ObjectIndex[m_skyMesh->index(obj)].append(item);
+    }
+
+    for (auto &objects : m_ObjectIndex)
+    {
+        std::stable_sort(objects.begin(), objects.end(),
+                         [](const IndexedObject &a, const IndexedObject &b) { return a.mag < b.mag; });
+    }
+}
+
+void CatalogComponent::indexObject(SkyObject *obj)
+{
+    IndexedObject item;
+    item.obj  = obj;
+    item.star = dynamic_cast<StarObject *>(obj);
+    item.dso  = dynamic_cast<DeepSkyObject *>(obj);
+    item.mag  = magnitudeKey(obj);
+
+    QVector<IndexedObject> &objects = m_ObjectIndex[m_skyMesh->index(obj)];
+    auto position = std::upper_bound(objects.begin(), objects.end(), item.mag,
+                                     [](float mag, const IndexedObject &other) { return mag < other.mag; });
+    objects.insert(position, item);
+}
+
+void CatalogComponent::unindexObject(SkyObject *obj)
+{
+    auto it = m_ObjectIndex.find(m_skyMesh->index(obj));
+    if (it == m_ObjectIndex.end())
+        return;
+
+    QVector<IndexedObject> &objects = *it;
+    for (int i = 0; i < objects.size(); i++)
+    {
+        if (objects[i].obj == obj)
+        {
+            objects.remove(i);
+            break;
+        }
+    }
+
+    if (objects.isEmpty())
+        m_ObjectIndex.erase(it);
+}
+
+void CatalogComponent::updateObject(const IndexedObject &item)
+{
+    KStarsData *data = KStarsData::Instance();
+
+    if (item.dso)
+        updateCoordinates(item.dso, data);
+    else if (item.star)
+        updateCoordinates(item.star, data);
 }
 
 void CatalogComponent::update(KSNumbers *)
 {
+#ifdef KSTARS_LITE
     if (selected())
     {
-        KStarsData *data = KStarsData::Instance();
-        foreach (SkyObject *obj, m_ObjectList)
+        for (const auto &objects : m_ObjectIndex)
         {
-            DeepSkyObject *dso = dynamic_cast<DeepSkyObject *>(obj);
-            StarObject *so     = dynamic_cast<StarObject *>(obj);
-            Q_ASSERT(dso || so); // We either have stars, or deep sky objects
-            if (dso)
-            {
-                // Update the deep sky object if need be
-                if (dso->updateID != data->updateID())
-                {
-                    dso->updateID = data->updateID();
-                    if (dso->updateNumID != data->updateNumID())
-                    {
-                        dso->updateCoords(data->updateNum());
-                    }
-                    dso->EquatorialToHorizontal(data->lst(), data->geo()->lat());
-                }
-            }
-            else
-            {
-                // Do exactly the same thing for stars
-                if (so->updateID != data->updateID())
-                {
-                    so->updateID = data->updateID();
-                    if (so->updateNumID != data->updateNumID())
-                    {
-                        so->updateCoords(data->updateNum());
-                    }
-                    so->EquatorialToHorizontal(data->lst(), data->geo()->lat());
-                }
-            }
+            for (const auto &item : objects)
+                updateObject(item);
         }
-        this->updateID = data->updateID();
+        this->updateID = KStarsData::Instance()->updateID();
     }
+#endif
 }
 
 void CatalogComponent::draw(SkyPainter *skyp)
@@ -196,21 +285,19 @@ void CatalogComponent::draw(SkyPainter *skyp)
     skyp->setBrush(Qt::NoBrush);
     skyp->setPen(QColor(m_catColor));
 
-    // Check if the coordinates have been updated
-    if (updateID != KStarsData::Instance()->updateID())
-        update(nullptr);
+    float const maglim         = DeepSkyComponent::zoomMagnitudeLimit();
+    bool showUnknownMagObjects = Options::showUnknownMagObjects();
 
-    //Draw Custom Catalog objects
-    // FIXME: Improve using HTM!
-    foreach (SkyObject *obj, m_ObjectList)
+    auto drawObject = [&](const IndexedObject &item)
     {
-        if (obj->type() == 0)
+        updateObject(item);
+
+        if (item.star)
         {
-            StarObject *starobj = static_cast<StarObject *>(obj);
             // FIXME SKYPAINTER
-            skyp->drawPointSource(starobj, starobj->mag(), starobj->spchar());
+            skyp->drawPointSource(item.star, item.star->mag(), item.star->spchar());
         }
-        else
+        else if (item.dso)
         {
             // FIXME: this PA calc is totally different from the one that was
             // in DeepSkyComponent which is now in SkyPainter .... O_o
@@ -220,9 +307,73 @@ void CatalogComponent::draw(SkyPainter *skyp)
             // double pa = 90. + map->findPA( dso, o.x(), o.y() );
             //
             // ^ Not sure if above is still valid -- asimha 2016/08/16
-            DeepSkyObject *dso = static_cast<DeepSkyObject *>(obj);
-            skyp->drawDeepSkyObject(dso, true);
+            skyp->drawDeepSkyObject(item.dso, true);
         }
+    };
+
+    //Draw Custom Catalog objects in the visible trixels, each list stops at the magnitude limit
+    MeshIterator region(m_skyMesh, DRAW_BUF);
+    while (region.hasNext())
+    {
+        auto it = m_ObjectIndex.constFind(region.next());
+        if (it == m_ObjectIndex.constEnd())
+            continue;
+
+        auto begin = it->constBegin();
+        auto end   = it->constEnd();
+        auto magnitudeLess = [](const IndexedObject &item, float mag) { return item.mag < mag; };
+
+        for (auto item = begin, faint = std::lower_bound(begin, end, maglim, magnitudeLess); item != faint; ++item)
+            drawObject(*item);
+
+        if (showUnknownMagObjects)
+        {
+            auto unknown = std::lower_bound(begin, end, std::numeric_limits<float>::infinity(), magnitudeLess);
+            for (auto item = unknown; item != end; ++item)
+                drawObject(*item);
+        }
+    }
+
+    updateID = KStarsData::Instance()->updateID();
+}
+
+SkyObject *CatalogComponent::objectNearest(SkyPoint *p, double &maxrad)
+{
+    if (!selected())
+        return nullptr;
+
+    SkyObject *oBest = nullptr;
+
+    MeshIterator region(m_skyMesh, OBJ_NEAREST_BUF);
+    while (region.hasNext())
+    {
+        auto it = m_ObjectIndex.constFind(region.next());
+        if (it == m_ObjectIndex.constEnd())
+            continue;
+
+        for (const auto &item : *it)
+        {
+            double r = item.obj->angularDistanceTo(p).Degrees();
+            if (r < maxrad)
+            {
+                oBest  = item.obj;
+                maxrad = r;
+            }
+        }
+    }
+    return oBest;
+}
+
+void CatalogComponent::objectsInArea(QList<SkyObject *> &list, const SkyRegion &region)
+{
+    for (SkyRegion::const_iterator it = region.constBegin(); it != region.constEnd(); ++it)
+    {
+        auto objects = m_ObjectIndex.constFind(it.key());
+        if (objects == m_ObjectIndex.constEnd())
+            continue;
+
+        for (const auto &item : *objects)
+            list.append(item.obj);
     }
 }
 
@@ -19,7 +19,14 @@
 
 #include "listcomponent.h"
 #include "Options.h"
+#include "typedef.h"
 
+#include <QHash>
+#include <QVector>
+
+class DeepSkyObject;
+class SkyMesh;
+class StarObject;
 struct stat;
 
 /**
@@ -51,8 +58,17 @@ class CatalogComponent : public ListComponent
      */
     void draw(SkyPainter *skyp) override;
 
+    /**
+     * @short Update the coordinates of all the objects of the catalog.
+     * The sky map updates the objects it draws just in time, this is only needed
+     * by KStars Lite, which draws the whole catalog.
+     */
     void update(KSNumbers *num) override;
 
+    SkyObject *objectNearest(SkyPoint *p, double &maxrad) override;
+
+    void objectsInArea(QList<SkyObject *> &list, const SkyRegion &region) override;
+
     /** @return the name of the catalog */
     inline QString name() const { return m_catName; }
 
@@ -84,6 +100,16 @@ class CatalogComponent : public ListComponent
      **/
     bool selected() override;
 
+    /**
+     * @short Read the objects of the catalog, without publishing their names
+     * Only the catalog is modified, so this may run on any thread before the catalog is added
+     * to its parent. The names are published on the main thread by addNames().
+     */
+    void readData(bool includeCatalogDesignation = true);
+
+    /** @short Add the names of the objects read by readData() to the names of all objects */
+    void addNames();
+
   protected:
     /** @short Load data into custom catalog */
     virtual void loadData() { _loadData(true); }
@@ -91,10 +117,42 @@ class CatalogComponent : public ListComponent
     /** @short Load data into custom catalog */
     virtual void _loadData(bool includeCatalogDesignation);
 
+    /** @short Add an object of m_ObjectList to the trixel index */
+    void indexObject(SkyObject *obj);
+
+    /** @short Remove an object from the trixel index */
+    void unindexObject(SkyObject *obj);
+
     // FIXME: There seems to be no way to remove catalogs from the program. -- asimha
 
     QString m_catName, m_catColor, m_catFluxFreq, m_catFluxUnit;
     bool m_Showerrs { false };
     int m_ccIndex { 0 };
     quint32 updateID { 0 };
+
+  private:
+    /**
+     * An object of the catalog with its concrete type resolved once, so that
+     * its coordinates are updated without casting it on every frame.
+     */
+    struct IndexedObject
+    {
+        SkyObject *obj { nullptr };
+        StarObject *star { nullptr };
+        DeepSkyObject *dso { nullptr };
+        /// Sort key of the trixel lists, infinity for unknown magnitudes
+        float mag { 0 };
+    };
+
+    /** @short Update the coordinates of an object if they are stale */
+    void updateObject(const IndexedObject &item);
+
+    /** @short Rebuild the trixel index from m_ObjectList */
+    void indexObjects();
+
+    SkyMesh *m_skyMesh { nullptr };
+    /// Names read by readData(), until addNames() publishes them
+    QList<QPair<int, QString>> m_readNames;
+    /// Objects in each trixel, sorted by magnitude so that drawing stops at the magnitude limit
+    QHash<Trixel, QVector<IndexedObject>> m_ObjectIndex;
 };
@@ -50,7 +50,6 @@
 
 CometsComponent::CometsComponent(SolarSystemComposite *parent) : SolarSystemListComponent(parent)
 {
-    loadData();
 }
 
 bool CometsComponent::selected()
@@ -88,17 +87,17 @@ bool CometsComponent::selected()
  * @note See KSComet constructor for more details.
  */
 void CometsComponent::loadData()
+{
+    addData(readData());
+}
+
+QList<KSComet *> CometsComponent::readData()
 {
     QString name, orbit_id, orbit_class, dimensions;
+    QList<KSComet *> comets;
 
     emitProgressText(i18n("Loading comets"));
 
-    qDeleteAll(m_ObjectList);
-    m_ObjectList.clear();
-
-    objectNames(SkyObject::COMET).clear();
-    objectLists(SkyObject::COMET).clear();
-
     QList<QPair<QString, KSParser::DataTypes>> sequence;
     sequence.append(qMakePair(QString("full name"), KSParser::D_QSTRING));
     sequence.append(qMakePair(QString("epoch_mjd"), KSParser::D_INT));
@@ -125,44 +124,61 @@ void CometsComponent::loadData()
     QString file_name = KSPaths::locate(QStandardPaths::GenericDataLocation, QString("comets.dat"));
     KSParser cometParser(file_name, '#', sequence);
 
-    QHash<QString, QVariant> row_content;
-    while (cometParser.HasNextRow())
+    int const fullNameColumn  = cometParser.ColumnIndex("full name");
+    int const qColumn         = cometParser.ColumnIndex("q");
+    int const eColumn         = cometParser.ColumnIndex("e");
+    int const iColumn         = cometParser.ColumnIndex("i");
+    int const wColumn         = cometParser.ColumnIndex("w");
+    int const omColumn        = cometParser.ColumnIndex("om");
+    int const tpColumn        = cometParser.ColumnIndex("tp_calc");
+    int const orbitIDColumn   = cometParser.ColumnIndex("orbit_id");
+    int const neoColumn       = cometParser.ColumnIndex("neo");
+    int const m1Column        = cometParser.ColumnIndex("M1");
+    int const m2Column        = cometParser.ColumnIndex("M2");
+    int const diameterColumn  = cometParser.ColumnIndex("diameter");
+    int const extentColumn    = cometParser.ColumnIndex("extent");
+    int const albedoColumn    = cometParser.ColumnIndex("albedo");
+    int const rotationColumn  = cometParser.ColumnIndex("rot_period");
+    int const periodColumn    = cometParser.ColumnIndex("per_y");
+    int const moidColumn      = cometParser.ColumnIndex("moid");
+    int const classColumn     = cometParser.ColumnIndex("class");
+    int const hColumn         = cometParser.ColumnIndex("H");
+    int const gColumn         = cometParser.ColumnIndex("G");
+
+    while (cometParser.NextRow())
     {
         KSComet *com = nullptr;
-        row_content  = cometParser.ReadNextRow();
-        name         = row_content["full name"].toString();
+        name         = cometParser.FieldString(fullNameColumn);
         name         = name.trimmed();
         bool neo;
         double q, e, dble_i, dble_w, dble_N, Tp, earth_moid;
         float M1, M2, K1, K2, diameter, albedo, rot_period, period;
-        q            = row_content["q"].toDouble();
-        e            = row_content["e"].toDouble();
-        dble_i       = row_content["i"].toDouble();
-        dble_w       = row_content["w"].toDouble();
-        dble_N       = row_content["om"].toDouble();
-        Tp           = row_content["tp_calc"].toDouble();
-        orbit_id     = row_content["orbit_id"].toString();
-        neo          = row_content["neo"] == "Y";
-
-        if (row_content["M1"].toFloat() == 0.0)
+        q            = cometParser.FieldDouble(qColumn);
+        e            = cometParser.FieldDouble(eColumn);
+        dble_i       = cometParser.FieldDouble(iColumn);
+        dble_w       = cometParser.FieldDouble(wColumn);
+        dble_N       = cometParser.FieldDouble(omColumn);
+        Tp           = cometParser.FieldDouble(tpColumn);
+        orbit_id     = cometParser.FieldString(orbitIDColumn);
+        neo          = cometParser.FieldLatin1(neoColumn) == QLatin1String("Y");
+
+        M1 = cometParser.FieldFloat(m1Column);
+        if (M1 == 0.0)
             M1 = 101.0;
-        else
-            M1 = row_content["M1"].toFloat();
 
-        if (row_content["M2"].toFloat() == 0.0)
+        M2 = cometParser.FieldFloat(m2Column);
+        if (M2 == 0.0)
             M2 = 101.0;
-        else
-            M2 = row_content["M2"].toFloat();
-
-        diameter    = row_content["diameter"].toFloat();
-        dimensions  = row_content["extent"].toString();
-        albedo      = row_content["albedo"].toFloat();
-        rot_period  = row_content["rot_period"].toFloat();
-        period      = row_content["per_y"].toFloat();
-        earth_moid  = row_content["moid"].toDouble();
-        orbit_class = row_content["class"].toString();
-        K1          = row_content["H"].toFloat();
-        K2          = row_content["G"].toFloat();
+
+        diameter    = cometParser.FieldFloat(diameterColumn);
+        dimensions  = cometParser.FieldString(extentColumn);
+        albedo      = cometParser.FieldFloat(albedoColumn);
+        rot_period  = cometParser.FieldFloat(rotationColumn);
+        period      = cometParser.FieldFloat(periodColumn);
+        earth_moid  = cometParser.FieldDouble(moidColumn);
+        orbit_class = cometParser.FieldString(classColumn);
+        K1          = cometParser.FieldFloat(hColumn);
+        K2          = cometParser.FieldFloat(gColumn);
 
         com = new KSComet(name, QString(), q, e, dms(dble_i), dms(dble_w), dms(dble_N), Tp, M1, M2, K1, K2);
         com->setOrbitID(orbit_id);
@@ -175,6 +191,23 @@ void CometsComponent::loadData()
         com->setEarthMOID(earth_moid);
         com->setOrbitClass(orbit_class);
         com->setAngularSize(0.005);
+        comets.append(com);
+    }
+
+    return comets;
+}
+
+void CometsComponent::addData(const QList<KSComet *> &comets)
+{
+    qDeleteAll(m_ObjectList);
+    m_ObjectList.clear();
+    m_ObjectHash.clear();
+
+    objectNames(SkyObject::COMET).clear();
+    objectLists(SkyObject::COMET).clear();
+
+    for (auto com : comets)
+    {
         appendListObject(com);
 
         // Add *short* name to the list of object names
@@ -24,6 +24,7 @@
 #include <QList>
 #include <QPointer>
 
+class KSComet;
 class SkyLabeler;
 
 /**
@@ -42,6 +43,8 @@ class CometsComponent : public QObject, public SolarSystemListComponent
         /**
          * @short Default constructor.
          *
+         * The comets are read by loadData(), once the sky map is shown. They may also be read
+         * on another thread by readData(), and then added on the main thread by addData().
          * @p parent pointer to the parent SolarSystemComposite
          */
         explicit CometsComponent(SolarSystemComposite *parent);
@@ -52,12 +55,23 @@ class CometsComponent : public QObject, public SolarSystemListComponent
         void draw(SkyPainter *skyp) override;
         void updateDataFile(bool isAutoUpdate = false);
 
+        /** Read the comets from comets.dat */
+        void loadData();
+
+        /**
+         * @short Read the comets from comets.dat, without adding them
+         * The component is not modified, so this may run on any thread.
+         * @return the comets, owned by the caller until they are passed to addData()
+         */
+        QList<KSComet *> readData();
+
+        /** Replace the comets with the ones returned by readData(), which are now owned by the component */
+        void addData(const QList<KSComet *> &comets);
+
     protected slots:
         void downloadReady();
         void downloadError(const QString &errorString);
 
     private:
-        void loadData();
-
         QPointer<FileDownloader> downloadJob;
 };
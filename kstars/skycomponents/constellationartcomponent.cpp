@@ -21,6 +21,8 @@
 #include "culturelist.h"
 #include "kspaths.h"
 #include "Options.h"
+#include "skymesh.h"
+#include "htmesh/MeshIterator.h"
 #ifndef KSTARS_LITE
 #include "skymap.h"
 #include "skypainter.h"
@@ -29,6 +31,8 @@
 #include <QSqlError>
 #include <QSqlQuery>
 
+#include <cmath>
+
 ConstellationArtComponent::ConstellationArtComponent(SkyComposite *parent, CultureList *cultures) : SkyComponent(parent)
 {
     cultureName = cultures->current();
@@ -45,6 +49,9 @@ void ConstellationArtComponent::deleteData()
 {
     qDeleteAll(m_ConstList);
     m_ConstList.clear();
+    m_ArtIndex.clear();
+    m_DrawIDs.clear();
+    records = 0;
 }
 
 void ConstellationArtComponent::loadData()
@@ -100,6 +107,34 @@ void ConstellationArtComponent::loadData()
         }
         //qDebug()<<"Successfully processed"<<records<<"records for"<<cultureName<<"sky culture";
         skydb.close();
+
+        indexArt();
+    }
+}
+
+void ConstellationArtComponent::indexArt()
+{
+    SkyMesh *skyMesh = SkyMesh::Instance();
+
+    m_ArtIndex.clear();
+    m_DrawIDs.fill(0, m_ConstList.size());
+
+    if (skyMesh == nullptr)
+        return;
+
+    for (int i = 0; i < m_ConstList.size(); i++)
+    {
+        ConstellationsArt *art = m_ConstList[i];
+
+        // The image is rotated around its midpoint, so it stays within half its diagonal of it
+        double const radius = 0.5 * std::hypot(art->getWidth(), art->getHeight());
+        SkyPoint midpoint(art->ra0().Hours(), art->dec0().Degrees());
+
+        skyMesh->index(&midpoint, radius, OBJ_NEAREST_BUF);
+
+        MeshIterator region(skyMesh, OBJ_NEAREST_BUF);
+        while (region.hasNext())
+            m_ArtIndex[region.next()].append(i);
     }
 }
 
@@ -119,8 +154,26 @@ void ConstellationArtComponent::draw(SkyPainter *skyp)
 #ifndef KSTARS_LITE
     if (Options::showConstellationArt() && SkyMap::IsSlewing() == false)
     {
-        for (int i = 0; i < records; i++)
-            skyp->drawConstellationArtImage(m_ConstList[i]);
+        SkyMesh *skyMesh = SkyMesh::Instance();
+        DrawID drawID    = skyMesh->drawID();
+
+        // Only the images overlapping the visible trixels can be on screen
+        MeshIterator region(skyMesh, DRAW_BUF);
+        while (region.hasNext())
+        {
+            auto it = m_ArtIndex.constFind(region.next());
+            if (it == m_ArtIndex.constEnd())
+                continue;
+
+            for (int i : *it)
+            {
+                if (m_DrawIDs[i] == drawID)
+                    continue;
+                m_DrawIDs[i] = drawID;
+
+                skyp->drawConstellationArtImage(m_ConstList[i]);
+            }
+        }
     }
 
 //Loops through the QList containing all data required to draw constellations.
@@ -18,6 +18,10 @@
 #pragma once
 
 #include "skycomponent.h"
+#include "typedef.h"
+
+#include <QHash>
+#include <QVector>
 
 class ConstellationsArt;
 class CultureList;
@@ -60,6 +64,13 @@ class ConstellationArtComponent : public SkyComponent
     QList<ConstellationsArt *> m_ConstList;
 
   private:
+    /** @short index each image in the trixels covering it, so draw() only looks at the visible ones */
+    void indexArt();
+
     QString cultureName;
     int records { 0 };
+    /// Indices in m_ConstList of the images overlapping each trixel
+    QHash<Trixel, QVector<int>> m_ArtIndex;
+    /// Last draw cycle each image was considered in, an image covers several trixels
+    QVector<DrawID> m_DrawIDs;
 };
@@ -27,12 +27,10 @@
 #include "projections/projector.h"
 #include "skycomponents/culturelist.h"
 
-#include <QtConcurrent>
-
 ConstellationNamesComponent::ConstellationNamesComponent(SkyComposite *parent, CultureList *cultures)
     : ListComponent(parent)
 {
-    QtConcurrent::run(this, &ConstellationNamesComponent::loadData, cultures);
+    loadData(cultures);
 }
 
 void ConstellationNamesComponent::loadData(CultureList *cultures)
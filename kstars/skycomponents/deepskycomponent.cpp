@@ -32,6 +32,8 @@
 #include "projections/projector.h"
 #include "skyobjects/deepskyobject.h"
 
+#include <QSet>
+
 DeepSkyComponent::DeepSkyComponent(SkyComposite *parent) : SkyComponent(parent)
 {
     m_skyMesh = SkyMesh::Instance();
@@ -151,14 +153,35 @@ void DeepSkyComponent::loadData()
     deep_sky_parser.SetProgress(i18n("Loading NGC/IC objects"), 13444, 10);
     qCInfo(KSTARS) << "Loading NGC/IC objects";
 
-    QHash<QString, QVariant> row_content;
-    while (deep_sky_parser.HasNextRow())
+    int const flagColumn      = deep_sky_parser.ColumnIndex("Flag");
+    int const idColumn        = deep_sky_parser.ColumnIndex("ID");
+    int const suffixColumn    = deep_sky_parser.ColumnIndex("suffix");
+    int const raHColumn       = deep_sky_parser.ColumnIndex("RA_H");
+    int const raMColumn       = deep_sky_parser.ColumnIndex("RA_M");
+    int const raSColumn       = deep_sky_parser.ColumnIndex("RA_S");
+    int const decSignColumn   = deep_sky_parser.ColumnIndex("D_Sign");
+    int const decDColumn      = deep_sky_parser.ColumnIndex("Dec_d");
+    int const decMColumn      = deep_sky_parser.ColumnIndex("Dec_m");
+    int const decSColumn      = deep_sky_parser.ColumnIndex("Dec_s");
+    int const bMagColumn      = deep_sky_parser.ColumnIndex("BMag");
+    int const typeColumn      = deep_sky_parser.ColumnIndex("type");
+    int const aColumn         = deep_sky_parser.ColumnIndex("a");
+    int const bColumn         = deep_sky_parser.ColumnIndex("b");
+    int const paColumn        = deep_sky_parser.ColumnIndex("pa");
+    int const pgcColumn       = deep_sky_parser.ColumnIndex("PGC");
+    int const otherCatColumn  = deep_sky_parser.ColumnIndex("other cat");
+    int const other1Column    = deep_sky_parser.ColumnIndex("other1");
+    int const messierColumn   = deep_sky_parser.ColumnIndex("Messr");
+    int const messierNColumn  = deep_sky_parser.ColumnIndex("MessrNum");
+    int const longnameColumn  = deep_sky_parser.ColumnIndex("Longname");
+
+    QSet<int> deepSkyTypes;
+
+    while (deep_sky_parser.NextRow())
     {
-        row_content = deep_sky_parser.ReadNextRow();
-
-        QString iflag;
+        QLatin1String iflag;
         QString cat;
-        iflag = row_content["Flag"].toString().mid(0, 1); //check for NGC/IC catalog flag
+        iflag = deep_sky_parser.FieldLatin1(flagColumn); //check for NGC/IC catalog flag
         /*
         Q_ASSERT(iflag == "I" || iflag == "N" || iflag == " ");
         // (spacetime): ^ Why an assert? Change in implementation of ksparser
@@ -169,7 +192,7 @@ void DeepSkyComponent::loadData()
         float mag(1000.0);
         int type, ingc, imess(-1), pa;
         int pgc, ugc;
-        QString ss, name, name2, longname;
+        QString name, name2, longname;
         QString cat2;
 
         // Designation
@@ -178,22 +201,22 @@ void DeepSkyComponent::loadData()
         else if (iflag == "N")
             cat = "NGC";
 
-        ingc = row_content["ID"].toInt(); // NGC/IC catalog number
+        ingc = deep_sky_parser.FieldInt(idColumn); // NGC/IC catalog number
         if (ingc == 0)
             cat.clear(); //object is not in NGC or IC catalogs
 
-        QString suffix = row_content["suffix"].toString(); // multipliticity suffixes, eg: the 'A' in NGC 4945A
+        QString suffix = deep_sky_parser.FieldString(suffixColumn); // multipliticity suffixes, eg: the 'A' in NGC 4945A
 
         //Q_ASSERT(suffix.isEmpty() || (suffix.isEmpty() == false && suffix.at(0) > 0x40 && suffix.at(0) < 0x7B));
 
         //coordinates
-        int rah     = row_content["RA_H"].toInt();
-        int ram     = row_content["RA_M"].toInt();
-        double ras  = row_content["RA_S"].toDouble();
-        QString sgn = row_content["D_Sign"].toString();
-        int dd      = row_content["Dec_d"].toInt();
-        int dm      = row_content["Dec_m"].toInt();
-        int ds      = row_content["Dec_s"].toInt();
+        int rah           = deep_sky_parser.FieldInt(raHColumn);
+        int ram           = deep_sky_parser.FieldInt(raMColumn);
+        double ras        = deep_sky_parser.FieldDouble(raSColumn);
+        QLatin1String sgn = deep_sky_parser.FieldLatin1(decSignColumn);
+        int dd            = deep_sky_parser.FieldInt(decDColumn);
+        int dm            = deep_sky_parser.FieldInt(decMColumn);
+        int ds            = deep_sky_parser.FieldInt(decSColumn);
 
         if (!((0.0 <= rah && rah < 24.0) || (0.0 <= ram && ram < 60.0) || (0.0 <= ras && ras < 60.0) ||
               (0.0 <= dd && dd <= 90.0) || (0.0 <= dm && dm < 60.0) || (0.0 <= ds && ds < 60.0)))
@@ -208,43 +231,41 @@ void DeepSkyComponent::loadData()
             continue;
 
         //B magnitude
-        ss = row_content["BMag"].toString();
-        if (ss.isEmpty())
+        if (deep_sky_parser.FieldIsEmpty(bMagColumn))
         {
             mag = 99.9f;
         }
         else
         {
-            mag = ss.toFloat();
+            mag = deep_sky_parser.FieldFloat(bMagColumn);
         }
 
         //object type
-        type = row_content["type"].toInt();
+        type = deep_sky_parser.FieldInt(typeColumn);
 
         //major and minor axes
-        float a = row_content["a"].toFloat();
-        float b = row_content["b"].toFloat();
+        float a = deep_sky_parser.FieldFloat(aColumn);
+        float b = deep_sky_parser.FieldFloat(bColumn);
 
         //position angle.  The catalog PA is zero when the Major axis
         //is horizontal.  But we want the angle measured from North, so
         //we set PA = 90 - pa.
-        ss = row_content["pa"].toString();
-        if (ss.isEmpty())
+        if (deep_sky_parser.FieldIsEmpty(paColumn))
         {
             pa = 90;
         }
         else
         {
-            pa = 90 - ss.toInt();
+            pa = 90 - deep_sky_parser.FieldInt(paColumn);
         }
 
         //PGC number
-        pgc = row_content["PGC"].toInt();
+        pgc = deep_sky_parser.FieldInt(pgcColumn);
 
         //UGC number
-        if (row_content["other cat"].toString().trimmed() == "UGC")
+        if (deep_sky_parser.FieldLatin1(otherCatColumn) == QLatin1String("UGC"))
         {
-            ugc = row_content["other1"].toString().toInt();
+            ugc = deep_sky_parser.FieldInt(other1Column);
         }
         else
         {
@@ -252,16 +273,16 @@ void DeepSkyComponent::loadData()
         }
 
         //Messier number
-        if (row_content["Messr"].toString().trimmed() == "M")
+        if (deep_sky_parser.FieldLatin1(messierColumn) == QLatin1String("M"))
         {
             cat2 = cat;
             if (ingc == 0)
                 cat2.clear();
             cat   = 'M';
-            imess = row_content["MessrNum"].toInt();
+            imess = deep_sky_parser.FieldInt(messierNColumn);
         }
 
-        longname = row_content["Longname"].toString();
+        longname = deep_sky_parser.FieldString(longnameColumn);
 
         dms r;
         //r.setH(rah, ram, int(ras));
@@ -358,6 +379,7 @@ void DeepSkyComponent::loadData()
         //if ( ! name.isEmpty() && !objectNames(type).contains(name))
         if (!name.isEmpty())
         {
+            deepSkyTypes.insert(type);
             objectNames(type).append(name);
             objectLists(type).append(QPair<QString, SkyObject *>(name, o));
         }
@@ -366,6 +388,7 @@ void DeepSkyComponent::loadData()
         //if ( ! longname.isEmpty() && longname != name  && !objectNames(type).contains(longname))
         if (!longname.isEmpty() && longname != name)
         {
+            deepSkyTypes.insert(type);
             objectNames(type).append(longname);
             objectLists(type).append(QPair<QString, SkyObject *>(longname, o));
         }
@@ -373,8 +396,9 @@ void DeepSkyComponent::loadData()
         deep_sky_parser.ShowProgress();
     }
 
-    for (auto &list : objectNames())
-        list.removeDuplicates();
+    // Only the names of deep sky types, the other components may be loading theirs at the same time
+    for (int type : deepSkyTypes)
+        objectNames(type).removeDuplicates();
 }
 
 void DeepSkyComponent::mergeSplitFiles()
@@ -481,17 +505,13 @@ void DeepSkyComponent::drawDeepSkyCatalog(SkyPainter *skyp, bool drawObject, Dee
     m_hideLabels = (map->isSlewing() && Options::hideOnSlew()) ||
                    !(Options::showDeepSkyMagnitudes() || Options::showDeepSkyNames());
 
-    double maglim              = Options::magLimitDrawDeepSky();
+    double maglim              = zoomMagnitudeLimit();
     bool showUnknownMagObjects = Options::showUnknownMagObjects();
+    m_zoomMagLimit             = maglim;
 
-    //adjust maglimit for ZoomLevel
     double lgmin = log10(MINZOOM);
     double lgmax = log10(MAXZOOM);
     double lgz   = log10(Options::zoomFactor());
-    if (lgz <= 0.75 * lgmax)
-        maglim -= (Options::magLimitDrawDeepSky() - Options::magLimitDrawDeepSkyZoomOut()) * (0.75 * lgmax - lgz) /
-                  (0.75 * lgmax - lgmin);
-    m_zoomMagLimit = maglim;
 
     double labelMagLim = Options::deepSkyLabelDensity();
     labelMagLim += (Options::magLimitDrawDeepSky() - labelMagLim) * (lgz - lgmin) / (lgmax - lgmin);
@@ -549,6 +569,21 @@ void DeepSkyComponent::drawDeepSkyCatalog(SkyPainter *skyp, bool drawObject, Dee
 #endif
 }
 
+double DeepSkyComponent::zoomMagnitudeLimit()
+{
+    double maglim = Options::magLimitDrawDeepSky();
+
+    //adjust maglimit for ZoomLevel
+    double lgmin = log10(MINZOOM);
+    double lgmax = log10(MAXZOOM);
+    double lgz   = log10(Options::zoomFactor());
+    if (lgz <= 0.75 * lgmax)
+        maglim -= (Options::magLimitDrawDeepSky() - Options::magLimitDrawDeepSkyZoomOut()) * (0.75 * lgmax - lgz) /
+                  (0.75 * lgmax - lgmin);
+
+    return maglim;
+}
+
 void DeepSkyComponent::addLabel(const QPointF &p, DeepSkyObject *obj)
 {
     int idx = int(obj->mag() * 10.0);
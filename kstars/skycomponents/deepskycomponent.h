@@ -104,6 +104,12 @@ class DeepSkyComponent : public SkyComponent
 
     bool selected() override;
 
+    /**
+     * @return the faintest magnitude of the deep-sky objects drawn at the current zoom level,
+     * which is lowered from the magLimitDrawDeepSky option when zoomed out
+     */
+    static double zoomMagnitudeLimit();
+
   private:
     /**
      * @short Read the ngcic.dat deep-sky database.
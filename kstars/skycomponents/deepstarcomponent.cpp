@@ -22,6 +22,7 @@
 #include "Options.h"
 #ifndef KSTARS_LITE
 #include "skymap.h"
+#include "skymapcomposite.h"
 #endif
 #include "skymesh.h"
 #include "skypainter.h"
@@ -56,8 +57,52 @@ DeepStarComponent::~DeepStarComponent()
     if (fileOpened)
         starReader.closeFile();
     fileOpened = false;
+#ifndef KSTARS_LITE
+    qDeleteAll(m_MaterializedStars);
+#endif
+}
+
+#ifndef KSTARS_LITE
+StarObject *DeepStarComponent::materializedStar(quint64 id)
+{
+    m_DetachedStars.remove(id);
+    return m_MaterializedStars.value(id, nullptr);
+}
+
+void DeepStarComponent::addMaterializedStar(quint64 id, StarObject *star)
+{
+    m_MaterializedStars.insert(id, star);
+}
+
+void DeepStarComponent::releaseMaterializedStar(quint64 id)
+{
+    m_DetachedStars.insert(id);
+
+    // Also drop the stars kept from earlier recycled blocks that are not referenced anymore
+    for (auto it = m_DetachedStars.begin(); it != m_DetachedStars.end();)
+    {
+        StarObject *star = m_MaterializedStars.value(*it, nullptr);
+        if (star && isStarReferenced(star))
+        {
+            ++it;
+            continue;
+        }
+        m_MaterializedStars.remove(*it);
+        delete star;
+        it = m_DetachedStars.erase(it);
+    }
 }
 
+bool DeepStarComponent::isStarReferenced(StarObject *star) const
+{
+    SkyMap *map = SkyMap::Instance();
+    if (map && (map->clickedObject() == star || map->focusObject() == star))
+        return true;
+
+    return KStarsData::Instance()->skyComposite()->labelObjects().contains(star);
+}
+#endif
+
 bool DeepStarComponent::loadStaticStars()
 {
     FILE *dataFile;
@@ -139,12 +184,8 @@ bool DeepStarComponent::loadStaticStars()
                     byteSwap(&stardata);
 
                 /* Initialize star with data just read. */
-                StarObject *star;
 #ifdef KSTARS_LITE
-                star = &(SB->addStar(stardata)->star);
-#else
-                star = SB->addStar(stardata);
-#endif
+                StarObject *star = &(SB->addStar(stardata)->star);
                 if (star)
                 {
                     //KStarsData* data = KStarsData::Instance();
@@ -153,6 +194,15 @@ bool DeepStarComponent::loadStaticStars()
                     if (stardata.HD)
                         m_CatalogNumber.insert(stardata.HD, star);
                 }
+#else
+                int index = SB->addStar(stardata);
+                if (index >= 0)
+                {
+                    // The StarObject is only materialized when looked up by findByHDIndex()
+                    if (stardata.HD)
+                        m_CatalogNumber.insert(stardata.HD, qMakePair(SB.get(), index));
+                }
+#endif
                 else
                 {
                     qCCritical(KSTARS) << "CODE ERROR: More unnamed static stars in trixel " << trixel
@@ -191,12 +241,8 @@ bool DeepStarComponent::loadStaticStars()
                     byteSwap(&deepstardata);
 
                 /* Initialize star with data just read. */
-                StarObject *star;
 #ifdef KSTARS_LITE
-                star = &(SB->addStar(stardata)->star);
-#else
-                star = SB->addStar(deepstardata);
-#endif
+                StarObject *star = &(SB->addStar(stardata)->star);
                 if (star)
                 {
                     //KStarsData* data = KStarsData::Instance();
@@ -210,6 +256,14 @@ bool DeepStarComponent::loadStaticStars()
                     qCCritical(KSTARS) << "CODE ERROR: More unnamed static stars in trixel " << trixel
                              << " than we allocated space for!";
                 }
+#else
+                // DeepStarData carries no HD number, so there is nothing to index here
+                if (SB->addStar(deepstardata) < 0)
+                {
+                    qCCritical(KSTARS) << "CODE ERROR: More unnamed static stars in trixel " << trixel
+                             << " than we allocated space for!";
+                }
+#endif
             }
         }
     }
@@ -257,9 +311,6 @@ void DeepStarComponent::draw(SkyPainter *skyp)
     StarObject::starsUpdated        = 0;
 #endif
     SkyMap *map       = SkyMap::Instance();
-    KStarsData *data  = KStarsData::Instance();
-    UpdateID updateID = data->updateID();
-
     //FIXME_FOV -- maybe not clamp like that...
     float radius = map->projector()->fov();
     if (radius > 90.0)
@@ -362,15 +413,9 @@ void DeepStarComponent::draw(SkyPainter *skyp)
         //        qDebug() << "Drawing SBL for trixel " << currentRegion << ", SBL has "
         //                 <<  m_starBlockList[ currentRegion ]->getBlockCount() << " blocks";
 
-        // REMARK: The following should never carry state, except for const parameters like updateID and maglim
-        std::function<void(std::shared_ptr<StarBlock>)> mapFunction = [&updateID, &maglim](std::shared_ptr<StarBlock> myBlock) {
-            for (StarObject &star : myBlock->contents())
-            {
-                if (star.updateID != updateID)
-                    star.JITupdate();
-                if (star.mag() > maglim)
-                    break;
-            }
+        // REMARK: The following should never carry state, except for const parameters like maglim
+        std::function<void(std::shared_ptr<StarBlock>)> mapFunction = [&maglim](std::shared_ptr<StarBlock> myBlock) {
+            myBlock->JITupdate(maglim);
         };
 
         QtConcurrent::blockingMap(m_starBlockList.at(currentRegion)->contents(), mapFunction);
@@ -380,21 +425,11 @@ void DeepStarComponent::draw(SkyPainter *skyp)
             std::shared_ptr<StarBlock> block = m_starBlockList.at(currentRegion)->block(i);
             //            qDebug() << "---> Drawing stars from block " << i << " of trixel " <<
             //                currentRegion << ". SB has " << block->getStarCount() << " stars";
-            for (int j = 0; j < block->getStarCount(); j++)
-            {
-                StarObject *curStar = block->star(j);
-
-                //                qDebug() << "We claim that he's from trixel " << currentRegion
-                //<< ", and indexStar says he's from " << m_skyMesh->indexStar( curStar );
+            int n = block->starCountToMag(maglim);
 
-                float mag = curStar->mag();
-
-                if (mag > maglim)
-                    break;
-
-                if (skyp->drawPointSource(curStar, mag, curStar->spchar()))
-                    visibleStarCount++;
-            }
+            // Project and draw the whole block at once
+            visibleStarCount += skyp->drawPointSources(n, block->raData(), block->decData(), block->altData(),
+                                                       block->azData(), block->magData(), block->spTypeData());
         }
 
         // DEBUG: Uncomment to identify problems with Star Block Factory / preservation of Magnitude Order in the LRU Cache
@@ -465,6 +500,9 @@ bool DeepStarComponent::openDataFile()
         ret = fread(&MSpT, 2, 1, starReader.getFileHandle());
         if (starReader.getByteSwap())
             MSpT = bswap_16(MSpT);
+        // Dynamically loaded catalogs are read trixel by trixel while drawing, so avoid the seek + read per record
+        if (!staticStars && Options::memoryMapStarCatalogs() && !starReader.mapFile())
+            qCWarning(KSTARS) << "Could not memory-map deep star catalog " << dataFileName << ", falling back to file reads.";
         fileOpened = true;
         qCInfo(KSTARS) << "  Sky Mesh Size: " << m_skyMesh->size();
         for (long int i = 0; i < m_skyMesh->size(); i++)
@@ -486,7 +524,14 @@ bool DeepStarComponent::openDataFile()
 StarObject *DeepStarComponent::findByHDIndex(int HDnum)
 {
     // Currently, we only handle HD catalog indexes
+#ifdef KSTARS_LITE
     return m_CatalogNumber.value(HDnum, nullptr); // TODO: Maybe, make this more general.
+#else
+    auto entry = m_CatalogNumber.constFind(HDnum);
+    if (entry == m_CatalogNumber.constEnd())
+        return nullptr;
+    return entry->first->star(entry->second);
+#endif
 }
 
 // This uses the main star index for looking up nearby stars but then
@@ -498,6 +543,10 @@ StarObject *DeepStarComponent::findByHDIndex(int HDnum)
 SkyObject *DeepStarComponent::objectNearest(SkyPoint *p, double &maxrad)
 {
     StarObject *oBest = nullptr;
+#ifndef KSTARS_LITE
+    std::shared_ptr<StarBlock> bestBlock;
+    int bestIndex = -1;
+#endif
 
 #ifdef KSTARS_LITE
     m_zoomMagLimit = StarComponent::zoomMagnitudeLimit();
@@ -524,9 +573,6 @@ SkyObject *DeepStarComponent::objectNearest(SkyPoint *p, double &maxrad)
             {
 #ifdef KSTARS_LITE
                 StarObject *star = &(block->star(j)->star);
-#else
-                StarObject *star = block->star(j);
-#endif
                 if (!star)
                     continue;
                 if (star->mag() > m_zoomMagLimit)
@@ -538,10 +584,29 @@ SkyObject *DeepStarComponent::objectNearest(SkyPoint *p, double &maxrad)
                     oBest  = star;
                     maxrad = r;
                 }
+#else
+                if (block->mag(j) > m_zoomMagLimit)
+                    continue;
+
+                // Only the winner is materialized as a StarObject
+                SkyPoint starPoint(block->ra(j) / 15.0, block->dec(j));
+                double r = starPoint.angularDistanceTo(p).Degrees();
+                if (r < maxrad)
+                {
+                    bestBlock = block;
+                    bestIndex = j;
+                    maxrad    = r;
+                }
+#endif
             }
         }
     }
 
+#ifndef KSTARS_LITE
+    if (bestBlock)
+        oBest = bestBlock->star(bestIndex);
+#endif
+
     // TODO: What if we are looking around a point that's not on
     // screen? objectNearest() will need to keep on filling up all
     // trixels around the SkyPoint to find the best match in case it
@@ -588,13 +653,17 @@ bool DeepStarComponent::starsInAperture(QList<StarObject *> &list, const SkyPoin
             {
 #ifdef KSTARS_LITE
                 StarObject *star = &(block->star(j)->star);
-#else
-                StarObject *star = block->star(j);
-#endif
                 if (star->mag() > maglim)
                     break; // Stars are organized by magnitude, so this should work
                 if (star->angularDistanceTo(&center).Degrees() <= radius)
                     list.append(star);
+#else
+                if (block->mag(j) > maglim)
+                    break; // Stars are organized by magnitude, so this should work
+                SkyPoint starPoint(block->ra(j) / 15.0, block->dec(j));
+                if (starPoint.angularDistanceTo(&center).Degrees() <= radius)
+                    list.append(block->star(j));
+#endif
             }
         }
     }
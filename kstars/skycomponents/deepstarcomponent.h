@@ -33,8 +33,11 @@
 #include "skyobjects/deepstardata.h"
 #include "skyobjects/stardata.h"
 
+#include <QSet>
+
 class SkyLabeler;
 class SkyMesh;
+class StarBlock;
 class StarBlockFactory;
 class StarBlockList;
 class StarObject;
@@ -112,6 +115,37 @@ class DeepStarComponent : public ListComponent
 
     static StarBlockFactory m_StarBlockFactory;
 
+#ifndef KSTARS_LITE
+    /**
+     * @short Look up a StarObject materialized by StarBlock::star()
+     *
+     * A star that was kept alive after its StarBlock was recycled (see releaseMaterializedStar())
+     * is attached to its new block again.
+     *
+     * @param id Trixel in the upper 32 bits, index of the star in the trixel in the lower 32 bits
+     * @return the StarObject, nullptr if the star is not materialized
+     */
+    StarObject *materializedStar(quint64 id);
+
+    /**
+     * @short Take ownership of a StarObject materialized by StarBlock::star()
+     *
+     * Pointers to these objects are handed out to the rest of KStars (clicked and focused objects,
+     * labels...), so they are owned by the component rather than by the StarBlock the star was
+     * loaded into.
+     */
+    void addMaterializedStar(quint64 id, StarObject *star);
+
+    /**
+     * @short Called by StarBlock::reset() for each materialized star of a recycled block
+     *
+     * The StarObject is deleted, unless it is still the clicked or focused object of the sky map or
+     * carries a name label. Such stars are kept until they are not referenced anymore, and handed
+     * out again if the star is reloaded in the meantime.
+     */
+    void releaseMaterializedStar(quint64 id);
+#endif
+
   private:
     SkyMesh *m_skyMesh { nullptr };
     KSNumbers m_reindexNum;
@@ -133,7 +167,20 @@ class DeepStarComponent : public ListComponent
     long unsigned t_updateCache { 0 };
 
     QVector<std::shared_ptr<StarBlockList>> m_starBlockList;
+#ifdef KSTARS_LITE
     QHash<int, StarObject *> m_CatalogNumber;
+#else
+    /// Static stars by HD number, as (block, index in block)
+    QHash<int, QPair<StarBlock *, int>> m_CatalogNumber;
+
+    /// @return true if the sky map or the name labels still point to star
+    bool isStarReferenced(StarObject *star) const;
+
+    /// StarObjects materialized from the blocks, by (trixel << 32 | index in trixel)
+    QHash<quint64, StarObject *> m_MaterializedStars;
+    /// Materialized stars whose StarBlock was recycled while they were still referenced
+    QSet<quint64> m_DetachedStars;
+#endif
 
     bool staticStars { false };
 
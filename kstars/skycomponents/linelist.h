@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "skycap.h"
 #include "typedef.h"
 
 #include <QList>
@@ -56,6 +57,13 @@ class LineList
     UpdateID updateID;
     UpdateID updateNumID;
 
+    /**
+     * Circle around the points, set by LineListIndex::appendLine() so that a
+     * list far from the visible part of the sky is skipped without looking it
+     * up in every visible trixel.
+     */
+    SkyCap cap;
+
   private:
     SkyList pointList;
 };
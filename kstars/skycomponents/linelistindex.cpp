@@ -87,6 +87,8 @@ void LineListIndex::appendLine(const std::shared_ptr<LineList> &lineList)
         }
         m_lineIndex->value(trixel)->append(lineList);
     }
+    // A degree of margin for the precession of the points since J2000
+    lineList->cap = SkyCap::bounding(lineList->points(), 1.0);
     m_listList.append(lineList);
 }
 
@@ -193,20 +195,55 @@ void LineListIndex::drawLines(SkyPainter *skyp)
     DrawID drawID     = skyMesh()->drawID();
     UpdateID updateID = KStarsData::Instance()->updateID();
 
-    for (auto &lineListList : m_lineIndex->values())
+    auto drawLineList = [&](const std::shared_ptr<LineList> &lineList)
     {
+        // draw each LineList at most once
+        if (lineList->drawID == drawID)
+            return;
+        lineList->drawID = drawID;
+
+        if (lineList->updateID != updateID)
+            JITupdate(lineList.get());
+
+        skyp->drawSkyPolyline(lineList.get(), skipList(lineList.get()), label());
+    };
+
+    if (!cullToVisibleTrixels())
+    {
+        for (auto &lineListList : *m_lineIndex)
+        {
+            for (int i = 0; i < lineListList->size(); i++)
+                drawLineList(lineListList->at(i));
+        }
+        return;
+    }
+
+    // Lists whose cap misses the aperture are skipped here, before they are
+    // updated and projected only to be clipped.
+    const SkyCap &view = skyMesh()->apertureCap(drawBuffer());
+    MeshIterator region(skyMesh(), drawBuffer());
+
+    while (region.hasNext())
+    {
+        auto lineListList = m_lineIndex->value(region.next());
+
+        if (lineListList == nullptr)
+            continue;
+
         for (int i = 0; i < lineListList->size(); i++)
         {
-            std::shared_ptr<LineList> lineList = lineListList->at(i);
+            const std::shared_ptr<LineList> &lineList = lineListList->at(i);
 
             if (lineList->drawID == drawID)
                 continue;
-            lineList->drawID = drawID;
 
-            if (lineList->updateID != updateID)
-                JITupdate(lineList.get());
+            if (!lineList->cap.intersects(view))
+            {
+                lineList->drawID = drawID;
+                continue;
+            }
 
-            skyp->drawSkyPolyline(lineList.get(), skipList(lineList.get()), label());
+            drawLineList(lineList);
         }
     }
 }
@@ -152,6 +152,14 @@ class LineListIndex : public SkyComponent
      */
     virtual MeshBufNum_t drawBuffer() { return DRAW_BUF; }
 
+    /**
+     * @short a callback overridden by the components whose points do not
+     * stay put in equatorial coordinates, such as the horizontal grid.  Their
+     * trixels say nothing about where they are drawn, so drawLines() then
+     * draws all of their lines instead of only those in the visible trixels.
+     */
+    virtual bool cullToVisibleTrixels() { return true; }
+
     /**
      * @short Returns an IndexHash from the SkyMesh that contains the set of
      * trixels that cover lineList.  Overridden by SkipListIndex so it can
@@ -33,4 +33,8 @@ class LocalMeridianComponent : public CoordinateGrid
     void update(KSNumbers *) override;
 
     bool selected() override;
+
+  protected:
+    /** The points are fixed in horizontal coordinates, so are not in their trixels */
+    bool cullToVisibleTrixels() override { return false; }
 };
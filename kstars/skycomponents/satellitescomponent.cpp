@@ -29,11 +29,9 @@
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QProgressDialog>
-#include <QtConcurrent>
 
 SatellitesComponent::SatellitesComponent(SkyComposite *parent) : SkyComponent(parent)
 {
-    QtConcurrent::run(this, &SatellitesComponent::loadData);
 }
 
 SatellitesComponent::~SatellitesComponent()
@@ -43,15 +41,21 @@ SatellitesComponent::~SatellitesComponent()
 }
 
 void SatellitesComponent::loadData()
+{
+    emitProgressText(i18n("Loading satellites"));
+
+    setGroups(readGroups());
+}
+
+QList<SatelliteGroup *> SatellitesComponent::readGroups()
 {
     KSFileReader fileReader;
     QString line;
     QStringList group_infos;
+    QList<SatelliteGroup *> groups;
 
     if (!fileReader.open("satellites.dat"))
-        return;
-
-    emitProgressText(i18n("Loading satellites"));
+        return groups;
 
     while (fileReader.hasMoreLines())
     {
@@ -59,11 +63,20 @@ void SatellitesComponent::loadData()
         if (line.trimmed().isEmpty() || line.at(0) == '#')
             continue;
         group_infos = line.split(';');
-        m_groups.append(new SatelliteGroup(group_infos.at(0), group_infos.at(1), QUrl(group_infos.at(2))));
+        groups.append(new SatelliteGroup(group_infos.at(0), group_infos.at(1), QUrl(group_infos.at(2))));
     }
 
+    return groups;
+}
+
+void SatellitesComponent::setGroups(const QList<SatelliteGroup *> &groups)
+{
+    qDeleteAll(m_groups);
+    m_groups = groups;
+
     objectNames(SkyObject::SATELLITE).clear();
     objectLists(SkyObject::SATELLITE).clear();
+    nameHash.clear();
 
     foreach (SatelliteGroup *group, m_groups)
     {
@@ -100,8 +100,20 @@ class SatellitesComponent : public SkyComponent
          */
         SkyObject *findByName(const QString &name) override;
 
+        /** Read the satellites listed in satellites.dat and their TLE files */
         void loadData();
 
+        /**
+         * @short Read the groups listed in satellites.dat, with the satellites of their TLE files.
+         *
+         * This does not use the component, so that it can be done on another thread.
+         * @return the new groups, owned by the caller
+         */
+        static QList<SatelliteGroup *> readGroups();
+
+        /** Replace the groups of satellites, which are then owned by the component */
+        void setGroups(const QList<SatelliteGroup *> &groups);
+
     protected:
         void drawTrails(SkyPainter *skyp) override;
 
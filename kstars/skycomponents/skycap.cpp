@@ -0,0 +1,95 @@
+/***************************************************************************
+                          skycap.cpp  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sat 17 Oct 2026
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "skycap.h"
+
+#include "skyobjects/skypoint.h"
+
+#include <algorithm>
+#include <cmath>
+
+SkyCap::SkyCap(double ra, double dec, double radius)
+{
+    double const raRad  = ra * dms::DegToRad;
+    double const decRad = dec * dms::DegToRad;
+
+    m_x      = cos(decRad) * cos(raRad);
+    m_y      = cos(decRad) * sin(raRad);
+    m_z      = sin(decRad);
+    m_radius = std::min(radius, 180.0) * dms::DegToRad;
+}
+
+SkyCap SkyCap::bounding(SkyList *points, double margin)
+{
+    SkyCap cap;
+
+    if (points->isEmpty())
+        return cap;
+
+    // The center is the mean direction of the points
+    QVector<double> x(points->size()), y(points->size()), z(points->size());
+    double sx = 0, sy = 0, sz = 0;
+    for (int i = 0; i < points->size(); i++)
+    {
+        double const ra  = points->at(i)->ra0().radians();
+        double const dec = points->at(i)->dec0().radians();
+
+        x[i] = cos(dec) * cos(ra);
+        y[i] = cos(dec) * sin(ra);
+        z[i] = sin(dec);
+
+        sx += x[i];
+        sy += y[i];
+        sz += z[i];
+    }
+
+    double const norm = sqrt(sx * sx + sy * sy + sz * sz);
+    if (norm < 1e-6)
+    {
+        cap.m_radius = dms::PI;
+        return cap;
+    }
+
+    cap.m_x = sx / norm;
+    cap.m_y = sy / norm;
+    cap.m_z = sz / norm;
+
+    double minDot = 1;
+    for (int i = 0; i < points->size(); i++)
+        minDot = std::min(minDot, cap.m_x * x[i] + cap.m_y * y[i] + cap.m_z * z[i]);
+
+    // An arc between two points of a cap smaller than a hemisphere stays in the cap
+    if (minDot <= 0)
+        cap.m_radius = dms::PI;
+    else
+    {
+        double const radius = acos(std::min(1.0, minDot)) + margin * dms::DegToRad;
+        cap.m_radius        = radius < dms::PI ? radius : dms::PI;
+    }
+
+    return cap;
+}
+
+bool SkyCap::intersects(const SkyCap &other) const
+{
+    if (isEmpty() || other.isEmpty())
+        return false;
+
+    double const sum = m_radius + other.m_radius;
+    if (sum >= dms::PI)
+        return true;
+
+    return m_x * other.m_x + m_y * other.m_y + m_z * other.m_z >= cos(sum);
+}
@@ -0,0 +1,60 @@
+/***************************************************************************
+                          skycap.h  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sat 17 Oct 2026
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include "typedef.h"
+
+/**
+ * @class SkyCap
+ * A circle on the celestial sphere, kept as the unit vector of its center and
+ * its radius so that two caps are tested for overlap with a dot product.
+ *
+ * Used to reject whole line lists and images which cannot be on screen before
+ * they are updated and projected.
+ */
+class SkyCap
+{
+  public:
+    /** @short an empty cap, which intersects nothing */
+    SkyCap() = default;
+
+    /**
+     * @short the cap of the given radius around a center
+     * @param ra right ascension of the center, in degrees
+     * @param dec declination of the center, in degrees
+     * @param radius in degrees, 180 or more covers the whole sky
+     */
+    SkyCap(double ra, double dec, double radius);
+
+    /**
+     * @short returns a cap covering the index coordinates (ra0, dec0) of all
+     * the points and the great circle arcs between them, widened by margin
+     * degrees.  Points spread over more than a hemisphere get the whole sky.
+     */
+    static SkyCap bounding(SkyList *points, double margin);
+
+    bool isEmpty() const { return m_radius < 0; }
+
+    /** @short true if the two caps overlap */
+    bool intersects(const SkyCap &other) const;
+
+  private:
+    double m_x { 0 };
+    double m_y { 0 };
+    double m_z { 0 };
+    /// Radius in radians, negative for an empty cap
+    double m_radius { -1 };
+};
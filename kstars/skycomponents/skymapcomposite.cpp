@@ -18,7 +18,9 @@
 #include "skymapcomposite.h"
 
 #include "artificialhorizoncomponent.h"
+#include "asteroidscomponent.h"
 #include "catalogcomponent.h"
+#include "cometscomponent.h"
 #include "constellationartcomponent.h"
 #include "constellationboundarylines.h"
 #include "constellationlines.h"
@@ -47,13 +49,16 @@
 #include "supernovaecomponent.h"
 #include "syncedcatalogcomponent.h"
 #include "targetlistcomponent.h"
+#include "auxiliary/startuploader.h"
 #include "projections/projector.h"
 #include "skyobjects/deepskyobject.h"
 #include "skyobjects/ksplanet.h"
 #include "skyobjects/constellationsart.h"
+#include "skyobjects/satellitegroup.h"
 
 #ifndef KSTARS_LITE
 #include "flagcomponent.h"
+#include "auxiliary/frameprofiler.h"
 #include "ksutils.h"
 #include "observinglist.h"
 #include "skymap.h"
@@ -75,9 +80,11 @@ SkyMapComposite::SkyMapComposite(SkyComposite *parent) : SkyComposite(parent), m
     // You can also set the debug level of individual
     // appendLine() and appendPoly() calls.
 
+    connect(this, SIGNAL(progressText(QString)), KStarsData::Instance(), SIGNAL(progressText(QString)));
+
+#ifdef KSTARS_LITE
     //Add all components
     //Stars must come before constellation lines
-#ifdef KSTARS_LITE
     addComponent(m_MilkyWay = new MilkyWay(this), 50);
     addComponent(m_Stars = StarComponent::Create(this), 10);
     addComponent(m_EquatorialCoordinateGrid = new EquatorialCoordinateGrid(this));
@@ -131,46 +138,128 @@ SkyMapComposite::SkyMapComposite(SkyComposite *parent) : SkyComposite(parent), m
     addComponent(m_Supernovae = new SupernovaeComponent(this), 7);
     SkyMapLite::Instance()->loadingFinished();
 #else
-    addComponent(m_MilkyWay = new MilkyWay(this), 50);
-    addComponent(m_Stars = StarComponent::Create(this), 10);
-    addComponent(m_EquatorialCoordinateGrid = new EquatorialCoordinateGrid(this));
-    addComponent(m_HorizontalCoordinateGrid = new HorizontalCoordinateGrid(this));
-    addComponent(m_LocalMeridianComponent = new LocalMeridianComponent(this));
+    // The components are loaded at the same time when they share no state. Those using the result
+    // buffers of the sky mesh take turns, and so do those adding names of the same object types.
+    // The names of every type exist beforehand, so that they can be appended to concurrently.
+    for (int type = 0; type < SkyObject::NUMBER_OF_KNOWN_TYPES; type++)
+    {
+        m_ObjectNames[type];
+        m_ObjectLists[type];
+    }
+    m_ObjectNames[SkyObject::TYPE_UNKNOWN];
+    m_ObjectLists[SkyObject::TYPE_UNKNOWN];
 
-    // Do add to components.
-    addComponent(m_CBoundLines = new ConstellationBoundaryLines(this), 80);
     m_Cultures.reset(new CultureList());
-    addComponent(m_CLines = new ConstellationLines(this, m_Cultures.get()), 85);
-    addComponent(m_CNames = new ConstellationNamesComponent(this, m_Cultures.get()), 90);
-    addComponent(m_Equator = new Equator(this), 95);
-    addComponent(m_Ecliptic = new Ecliptic(this), 95);
+
+    StartupLoader loader("Sky components");
+
+    // First, so that it is picked before the other users of the mesh. Its star images are pixmaps.
+    loader.addTask("Stars", StartupLoader::MainThread, QStringList(), QStringList() << "mesh", [this]()
+    {
+        m_Stars = StarComponent::Create(this);
+        return true;
+    });
+    loader.addTask("Milky Way", StartupLoader::AnyThread, QStringList(), QStringList() << "mesh", [this]()
+    {
+        m_MilkyWay = new MilkyWay(this);
+        return true;
+    });
+    loader.addTask("Coordinate grids", StartupLoader::AnyThread, QStringList(), QStringList() << "mesh", [this]()
+    {
+        m_EquatorialCoordinateGrid = new EquatorialCoordinateGrid(this);
+        m_HorizontalCoordinateGrid = new HorizontalCoordinateGrid(this);
+        m_LocalMeridianComponent   = new LocalMeridianComponent(this);
+        m_Equator                  = new Equator(this);
+        m_Ecliptic                 = new Ecliptic(this);
+        return true;
+    });
+    loader.addTask("Constellation boundaries", StartupLoader::AnyThread, QStringList(), QStringList() << "mesh",
+                   [this]()
+    {
+        m_CBoundLines = new ConstellationBoundaryLines(this);
+        return true;
+    });
+    // Stars must come before constellation lines
+    loader.addTask("Constellation lines", StartupLoader::AnyThread, QStringList() << "Stars", QStringList() << "mesh",
+                   [this]()
+    {
+        m_CLines = new ConstellationLines(this, m_Cultures.get());
+        return true;
+    });
+    loader.addTask("Constellation names", StartupLoader::AnyThread, QStringList(),
+                   QStringList() << "names:constellations", [this]()
+    {
+        m_CNames = new ConstellationNamesComponent(this, m_Cultures.get());
+        return true;
+    });
+    loader.addTask("Constellation art", StartupLoader::AnyThread, QStringList(), QStringList() << "mesh", [this]()
+    {
+        m_ConstellationArt = new ConstellationArtComponent(this, m_Cultures.get());
+        return true;
+    });
+    loader.addTask("Deep sky", StartupLoader::AnyThread, QStringList(), QStringList() << "names:deepsky", [this]()
+    {
+        m_DeepSky = new DeepSkyComponent(this);
+        return true;
+    });
+    loader.addTask("Artificial horizon", StartupLoader::MainThread, QStringList(), QStringList(), [this]()
+    {
+        m_ArtificialHorizon = new ArtificialHorizonComponent(this);
+        return true;
+    });
+    // Removes the duplicates of the names of all types
+    loader.addTask("Synced catalogs", StartupLoader::MainThread, QStringList(),
+                   QStringList() << "names:deepsky" << "names:constellations", [this]()
+    {
+        m_internetResolvedCat       = "_Internet_Resolved";
+        m_manualAdditionsCat        = "_Manual_Additions";
+        m_internetResolvedComponent = new SyncedCatalogComponent(this, m_internetResolvedCat, true, 0);
+        m_manualAdditionsComponent  = new SyncedCatalogComponent(this, m_manualAdditionsCat, true, 0);
+        return true;
+    });
+    loader.addTask("Solar system", StartupLoader::MainThread, QStringList(), QStringList(), [this]()
+    {
+        m_SolarSystem = new SolarSystemComposite(this);
+        return true;
+    });
+    loader.addTask("Flags", StartupLoader::MainThread, QStringList(), QStringList(), [this]()
+    {
+        m_Flags = new FlagComponent(this);
+        return true;
+    });
+
+    loader.run();
+
+    //Add all components, in the order they are drawn in
+    addComponent(m_MilkyWay, 50);
+    addComponent(m_Stars, 10);
+    addComponent(m_EquatorialCoordinateGrid);
+    addComponent(m_HorizontalCoordinateGrid);
+    addComponent(m_LocalMeridianComponent);
+
+    // Do add to components.
+    addComponent(m_CBoundLines, 80);
+    addComponent(m_CLines, 85);
+    addComponent(m_CNames, 90);
+    addComponent(m_Equator, 95);
+    addComponent(m_Ecliptic, 95);
     addComponent(m_Horizon = new HorizonComponent(this), 100);
-    addComponent(m_DeepSky = new DeepSkyComponent(this), 5);
-    addComponent(m_ConstellationArt = new ConstellationArtComponent(this, m_Cultures.get()), 100);
+    addComponent(m_DeepSky, 5);
+    addComponent(m_ConstellationArt, 100);
 
     // Hips
     addComponent(m_HiPS = new HIPSComponent(this));
 
-    addComponent(m_ArtificialHorizon = new ArtificialHorizonComponent(this), 110);
+    addComponent(m_ArtificialHorizon, 110);
 
-    m_internetResolvedCat = "_Internet_Resolved";
-    m_manualAdditionsCat  = "_Manual_Additions";
-    addComponent(m_internetResolvedComponent = new SyncedCatalogComponent(this, m_internetResolvedCat, true, 0), 6);
-    addComponent(m_manualAdditionsComponent = new SyncedCatalogComponent(this, m_manualAdditionsCat, true, 0), 6);
+    addComponent(m_internetResolvedComponent, 6);
+    addComponent(m_manualAdditionsComponent, 6);
+    // The custom catalogs are loaded once the sky map is shown, see addDeferredTasks()
     m_CustomCatalogs.reset(new SkyComposite(this));
-    QStringList allcatalogs = Options::showCatalogNames();
-    for (int i = 0; i < allcatalogs.size(); ++i)
-    {
-        if (allcatalogs.at(i) == m_internetResolvedCat ||
-                allcatalogs.at(i) == m_manualAdditionsCat) // This is a special catalog
-            continue;
-        m_CustomCatalogs->addComponent(new CatalogComponent(this, allcatalogs.at(i), false, i),
-                                       6); // FIXME: Should this be 6 or 5? See SkyMapComposite::reloadDeepSky()
-    }
 
-    addComponent(m_SolarSystem = new SolarSystemComposite(this), 2);
+    addComponent(m_SolarSystem, 2);
 
-    addComponent(m_Flags = new FlagComponent(this), 4);
+    addComponent(m_Flags, 4);
 
     addComponent(m_ObservingList =
                      new TargetListComponent(this, nullptr, QPen(), &Options::obsListSymbol, &Options::obsListText),
@@ -179,7 +268,123 @@ SkyMapComposite::SkyMapComposite(SkyComposite *parent) : SkyComposite(parent), m
     addComponent(m_Satellites = new SatellitesComponent(this), 7);
     addComponent(m_Supernovae = new SupernovaeComponent(this), 7);
 #endif
-    connect(this, SIGNAL(progressText(QString)), KStarsData::Instance(), SIGNAL(progressText(QString)));
+}
+
+QStringList SkyMapComposite::addDeferredTasks(StartupLoader *loader)
+{
+    QStringList tasks;
+
+    // The files are parsed in the background, and the objects added to the lists drawn on the main thread
+    std::shared_ptr<QList<KSAsteroid *>> asteroids(new QList<KSAsteroid *>(), [](QList<KSAsteroid *> *list)
+    {
+        qDeleteAll(*list);
+        delete list;
+    });
+
+    tasks << "Asteroid file";
+    loader->addTask(tasks.last(), StartupLoader::AnyThread, QStringList(), QStringList(), [this, asteroids]()
+    {
+        *asteroids = m_SolarSystem->asteroidsComponent()->readData();
+        return true;
+    });
+
+    tasks << "Asteroids";
+    loader->addTask(tasks.last(), StartupLoader::MainThread, QStringList() << "Asteroid file", QStringList(),
+                    [this, asteroids]()
+    {
+        m_SolarSystem->asteroidsComponent()->addData(*asteroids);
+        asteroids->clear();
+        return true;
+    });
+
+    std::shared_ptr<QList<KSComet *>> comets(new QList<KSComet *>(), [](QList<KSComet *> *list)
+    {
+        qDeleteAll(*list);
+        delete list;
+    });
+
+    tasks << "Comet file";
+    loader->addTask(tasks.last(), StartupLoader::AnyThread, QStringList(), QStringList(), [this, comets]()
+    {
+        *comets = m_SolarSystem->cometsComponent()->readData();
+        return true;
+    });
+
+    tasks << "Comets";
+    loader->addTask(tasks.last(), StartupLoader::MainThread, QStringList() << "Comet file", QStringList(),
+                    [this, comets]()
+    {
+        m_SolarSystem->cometsComponent()->addData(*comets);
+        comets->clear();
+        return true;
+    });
+
+    std::shared_ptr<QList<SatelliteGroup *>> groups(new QList<SatelliteGroup *>(), [](QList<SatelliteGroup *> *list)
+    {
+        qDeleteAll(*list);
+        delete list;
+    });
+
+    tasks << "Satellite TLEs";
+    loader->addTask(tasks.last(), StartupLoader::AnyThread, QStringList(), QStringList(), [groups]()
+    {
+        *groups = SatellitesComponent::readGroups();
+        return true;
+    });
+
+    tasks << "Satellites";
+    loader->addTask(tasks.last(), StartupLoader::MainThread, QStringList() << "Satellite TLEs", QStringList(),
+                    [this, groups]()
+    {
+        m_Satellites->setGroups(*groups);
+        groups->clear();
+        return true;
+    });
+
+#ifndef KSTARS_LITE
+    // The catalogs are read through a database connection of the pool thread, and added with their
+    // names on the main thread
+    std::shared_ptr<QList<CatalogComponent *>> catalogs(new QList<CatalogComponent *>(),
+            [](QList<CatalogComponent *> *list)
+    {
+        qDeleteAll(*list);
+        delete list;
+    });
+
+    QStringList const allcatalogs = Options::showCatalogNames();
+
+    tasks << "Custom catalog objects";
+    loader->addTask(tasks.last(), StartupLoader::AnyThread, QStringList(), QStringList(),
+                    [this, catalogs, allcatalogs]()
+    {
+        for (int i = 0; i < allcatalogs.size(); ++i)
+        {
+            if (allcatalogs.at(i) == m_internetResolvedCat ||
+                    allcatalogs.at(i) == m_manualAdditionsCat) // This is a special catalog
+                continue;
+            CatalogComponent *catalog = new CatalogComponent(this, allcatalogs.at(i), false, i, false);
+            catalog->readData();
+            catalogs->append(catalog);
+        }
+        return true;
+    });
+
+    tasks << "Custom catalogs";
+    loader->addTask(tasks.last(), StartupLoader::MainThread, QStringList() << "Custom catalog objects", QStringList(),
+                    [this, catalogs]()
+    {
+        for (auto catalog : *catalogs)
+        {
+            catalog->addNames();
+            m_CustomCatalogs->addComponent(catalog,
+                                           6); // FIXME: Should this be 6 or 5? See SkyMapComposite::reloadDeepSky()
+        }
+        catalogs->clear();
+        return true;
+    });
+#endif
+
+    return tasks;
 }
 
 void SkyMapComposite::update(KSNumbers *num)
@@ -252,6 +457,9 @@ void SkyMapComposite::draw(SkyPainter *skyp)
     SkyMap *map      = SkyMap::Instance();
     KStarsData *data = KStarsData::Instance();
 
+    FrameProfiler::Timer total;
+    FrameProfiler::Timer timer;
+
     // We delay one draw cycle before re-indexing
     // we MUST ensure CLines do not get re-indexed while we use DRAW_BUF
     // so we do it here.
@@ -311,46 +519,61 @@ void SkyMapComposite::draw(SkyPainter *skyp)
             }
     }
 
+    timer.lap("draw/Setup");
+
     m_MilkyWay->draw(skyp);
+    timer.lap("draw/MilkyWay");
 
     // Draw HIPS after milky way but before everything else
     m_HiPS->draw(skyp);
+    timer.lap("draw/HiPS");
 
     m_EquatorialCoordinateGrid->draw(skyp);
     m_HorizontalCoordinateGrid->draw(skyp);
     m_LocalMeridianComponent->draw(skyp);
+    timer.lap("draw/CoordinateGrids");
 
     //Draw constellation boundary lines only if we draw western constellations
     if (m_Cultures->current() == "Western")
     {
         m_CBoundLines->draw(skyp);
+        timer.lap("draw/ConstellationBoundaries");
         m_ConstellationArt->draw(skyp);
     }
     else if (m_Cultures->current() == "Inuit")
     {
         m_ConstellationArt->draw(skyp);
     }
+    timer.lap("draw/ConstellationArt");
 
     m_CLines->draw(skyp);
+    timer.lap("draw/ConstellationLines");
 
     m_Equator->draw(skyp);
 
     m_Ecliptic->draw(skyp);
+    timer.lap("draw/EquatorEcliptic");
 
     m_DeepSky->draw(skyp);
+    timer.lap("draw/DeepSky");
 
     m_CustomCatalogs->draw(skyp);
     m_internetResolvedComponent->draw(skyp);
     m_manualAdditionsComponent->draw(skyp);
+    timer.lap("draw/Catalogs");
 
     m_Stars->draw(skyp);
+    timer.lap("draw/Stars");
 
     m_SolarSystem->drawTrails(skyp);
     m_SolarSystem->draw(skyp);
+    timer.lap("draw/SolarSystem");
 
     m_Satellites->draw(skyp);
+    timer.lap("draw/Satellites");
 
     m_Supernovae->draw(skyp);
+    timer.lap("draw/Supernovae");
 
     map->drawObjectLabels(labelObjects());
 
@@ -358,19 +581,25 @@ void SkyMapComposite::draw(SkyPainter *skyp)
     m_CNames->draw(skyp);
     m_Stars->drawLabels();
     m_DeepSky->drawLabels();
+    timer.lap("draw/Labels");
 
     m_ObservingList->pen = QPen(QColor(data->colorScheme()->colorNamed("ObsListColor")), 1.);
     m_ObservingList->list2 = KStarsData::Instance()->observingList()->sessionList();
     m_ObservingList->draw(skyp);
+    timer.lap("draw/ObservingList");
 
     m_Flags->draw(skyp);
+    timer.lap("draw/Flags");
 
     m_StarHopRouteList->pen = QPen(QColor(data->colorScheme()->colorNamed("StarHopRouteColor")), 1.);
     m_StarHopRouteList->draw(skyp);
+    timer.lap("draw/StarHopRoute");
 
     m_ArtificialHorizon->draw(skyp);
 
     m_Horizon->draw(skyp);
+    timer.lap("draw/Horizon");
+    total.lap("draw/Total");
 
     m_skyMesh->inDraw(false);
 
@@ -580,6 +809,11 @@ QList<SkyObject *> SkyMapComposite::findObjectsInArea(const SkyPoint &p1, const
         m_Stars->objectsInArea(list, region);
     if (m_DeepSky->selected())
         m_DeepSky->objectsInArea(list, region);
+    for (SkyComponent *catalog : m_CustomCatalogs->components())
+    {
+        if (catalog->selected())
+            catalog->objectsInArea(list, region);
+    }
     return list;
 }
 
@@ -54,6 +54,7 @@ class SkyMap;
 class SkyObject;
 class SolarSystemComposite;
 class StarComponent;
+class StartupLoader;
 class SupernovaeComponent;
 class SyncedCatalogComponent;
 class TargetListComponent;
@@ -83,6 +84,14 @@ class SkyMapComposite : public QObject, public SkyComposite
 
     virtual ~SkyMapComposite() override = default;
 
+    /**
+     * @short Add the loading of the objects which are not drawn at startup to a loader.
+     *
+     * Asteroids, comets, satellites and custom catalogs are loaded once the sky map is shown.
+     * @return the names of the added tasks
+     */
+    QStringList addDeferredTasks(StartupLoader *loader);
+
     void update(KSNumbers *num = nullptr) override;
 
     /**
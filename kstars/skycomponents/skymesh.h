@@ -18,6 +18,7 @@
 #pragma once
 
 #include "ksnumbers.h"
+#include "skycap.h"
 #include "typedef.h"
 #include "htmesh/HTMesh.h"
 
@@ -125,6 +126,12 @@ class SkyMesh : public HTMesh
          */
     void aperture(SkyPoint *center, double radius, MeshBufNum_t bufNum = DRAW_BUF);
 
+    /** @return the circle in J2000 coordinates last given to aperture() or
+         * index(center, radius) for the buffer.  Lists of objects bounded by a
+         * SkyCap can be tested against it before looking at their trixels.
+         */
+    const SkyCap &apertureCap(MeshBufNum_t bufNum = DRAW_BUF) const { return m_apertureCaps[bufNum]; }
+
     /** @short returns the index of the trixel containing p.
          */
     Trixel index(const SkyPoint *p);
@@ -300,6 +307,7 @@ class SkyMesh : public HTMesh
 
     IndexHash indexHash;
     KSNumbers m_KSNumbers;
+    SkyCap m_apertureCaps[NUM_MESH_BUF];
 
     bool m_inDraw { false };
     static int defaultLevel;
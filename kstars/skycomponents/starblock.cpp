@@ -20,9 +20,18 @@
 #include "starblock.h"
 #include "skyobjects/starobject.h"
 #include "starcomponent.h"
+#include "deepstarcomponent.h"
 #include "skyobjects/stardata.h"
 #include "skyobjects/deepstardata.h"
 
+#ifndef KSTARS_LITE
+#include "kstarsdata.h"
+#include "Options.h"
+#include "skyobjects/skypointbatch.h"
+
+#include <cstring>
+#endif
+
 #ifdef KSTARS_LITE
 #include "skymaplite.h"
 #include "kstarslite/skyitems/skynodes/pointsourcenode.h"
@@ -41,18 +50,32 @@ StarNode::~StarNode()
 }
 #endif
 
+#ifdef KSTARS_LITE
 StarBlock::StarBlock(int nstars)
     : faintMag(-5), brightMag(35), parent(nullptr), prev(nullptr), next(nullptr), drawID(0), nStars(0),
-#ifdef KSTARS_LITE
       stars(nstars, StarNode())
+{
+}
 #else
-      stars(nstars, StarObject())
-#endif
+StarBlock::StarBlock(int nstars)
+    : faintMag(-5), brightMag(35), parent(nullptr), prev(nullptr), next(nullptr), drawID(0), nStars(0),
+      m_Capacity(nstars), m_RA0(nstars), m_Dec0(nstars), m_PMRA(nstars), m_PMDec(nstars), m_Mag(nstars),
+      m_SpType(nstars), m_RA(nstars), m_Dec(nstars), m_Alt(nstars), m_Az(nstars)
 {
 }
+#endif
 
 void StarBlock::reset()
 {
+#ifndef KSTARS_LITE
+    if (parent && parent->component())
+    {
+        quint64 trixel = quint64(parent->getTrixel()) << 32;
+        for (auto it = m_Materialized.constBegin(); it != m_Materialized.constEnd(); ++it)
+            parent->component()->releaseMaterializedStar(trixel | (firstIndex + it.key()));
+    }
+#endif
+
     if (parent)
         parent->releaseBlock(this);
 
@@ -60,6 +83,18 @@ void StarBlock::reset()
     faintMag  = -5.0;
     brightMag = 35.0;
     nStars    = 0;
+
+#ifndef KSTARS_LITE
+    // The StarObjects belong to the DeepStarComponent, which was told about them above
+    m_Materialized.clear();
+    firstIndex        = 0;
+    m_RecordSize      = 0;
+    m_UpdateID        = 0;
+    m_UpdateNumID     = 0;
+    m_LastPrecessJD   = 0;
+    m_HorizontalCount = 0;
+    m_PrecessedCount  = 0;
+#endif
 }
 
 #ifdef KSTARS_LITE
@@ -93,31 +128,231 @@ StarNode *StarBlock::addStar(const DeepStarData &data)
     return &node;
 }
 #else
-StarObject *StarBlock::addStar(const StarData &data)
+int StarBlock::addStar(const StarData &data)
 {
-    if (isFull())
-        return nullptr;
-    StarObject &star = stars[nStars++];
+    // NOTE: Scaling must match StarObject::init(const StarData *)
+    return appendStar(data.RA / 1000000.0, data.Dec / 100000.0, data.dRA / 10.0, data.dDec / 10.0, data.mag / 100.0,
+                      data.spec_type[0], &data, sizeof(StarData));
+}
 
-    star.init(&data);
-    if (star.mag() > faintMag)
-        faintMag = star.mag();
-    if (star.mag() < brightMag)
-        brightMag = star.mag();
-    return &star;
+int StarBlock::addStar(const DeepStarData &data)
+{
+    // NOTE: Scaling and spectral type guess must match StarObject::init(const DeepStarData *)
+    float mag;
+    if (data.V == 30000 && data.B != 30000)
+        mag = (data.B - 1600) / 1000.0;
+    else
+        mag = data.V / 1000.0;
+
+    char spType = 'B';
+    if (data.B == 30000 || data.V == 30000)
+    {
+        spType = '?';
+    }
+    else
+    {
+        double BV_Index = (data.B - data.V) / 1000.0;
+        (BV_Index > 0.0) && (spType = 'A');
+        (BV_Index > 0.325) && (spType = 'F');
+        (BV_Index > 0.575) && (spType = 'G');
+        (BV_Index > 0.975) && (spType = 'K');
+        (BV_Index > 1.6) && (spType = 'M');
+    }
+
+    return appendStar(data.RA / 1000000.0, data.Dec / 100000.0, data.dRA / 100.0, data.dDec / 100.0, mag, spType,
+                      &data, sizeof(DeepStarData));
 }
 
-StarObject *StarBlock::addStar(const DeepStarData &data)
+int StarBlock::appendStar(double ra0, double dec0, double pmRA, double pmDec, float mag, char spType,
+                          const void *record, int recordSize)
 {
     if (isFull())
+        return -1;
+
+    // The block may have held records of the other catalog type before it was recycled
+    if (m_RecordSize != recordSize)
+    {
+        if (nStars != 0)
+        {
+            qWarning() << "Cannot mix star record sizes" << m_RecordSize << "and" << recordSize << "in one StarBlock";
+            return -1;
+        }
+        m_RecordSize = recordSize;
+        m_Records.resize(m_Capacity * recordSize);
+    }
+
+    int i = nStars++;
+
+    // ra0 is in hours
+    m_RA0[i]    = ra0 * 15.0;
+    m_Dec0[i]   = dec0;
+    m_PMRA[i]   = pmRA;
+    m_PMDec[i]  = pmDec;
+    m_Mag[i]    = mag;
+    m_SpType[i] = spType;
+    m_RA[i]     = m_RA0[i];
+    m_Dec[i]    = dec0;
+    m_Alt[i]    = 0;
+    m_Az[i]     = 0;
+    memcpy(m_Records.data() + i * recordSize, record, recordSize);
+
+    if (mag > faintMag)
+        faintMag = mag;
+    if (mag < brightMag)
+        brightMag = mag;
+    return i;
+}
+
+StarObject *StarBlock::star(int i)
+{
+    if (i < 0 || i >= nStars)
         return nullptr;
-    StarObject &star = stars[nStars++];
 
-    star.init(&data);
-    if (star.mag() > faintMag)
-        faintMag = star.mag();
-    if (star.mag() < brightMag)
-        brightMag = star.mag();
-    return &star;
+    StarObject *star = m_Materialized.value(i, nullptr);
+    if (!star)
+    {
+        DeepStarComponent *component = parent ? parent->component() : nullptr;
+        if (!component)
+        {
+            qWarning() << "Cannot materialize a star of a StarBlock that is not in a StarBlockList";
+            return nullptr;
+        }
+
+        // The star may have been materialized before this block was recycled and reloaded
+        quint64 id = (quint64(parent->getTrixel()) << 32) | (firstIndex + i);
+        star       = component->materializedStar(id);
+        if (!star)
+        {
+            star = new StarObject();
+            if (m_RecordSize == sizeof(StarData))
+            {
+                StarData data;
+                memcpy(&data, m_Records.constData() + i * m_RecordSize, sizeof(StarData));
+                star->init(&data);
+            }
+            else
+            {
+                DeepStarData data;
+                memcpy(&data, m_Records.constData() + i * m_RecordSize, sizeof(DeepStarData));
+                star->init(&data);
+            }
+            component->addMaterializedStar(id, star);
+        }
+        m_Materialized.insert(i, star);
+    }
+
+    syncStar(i, star);
+    return star;
+}
+
+void StarBlock::syncStar(int i, StarObject *star) const
+{
+    star->setRA(m_RA[i] / 15.0);
+    star->setDec(m_Dec[i]);
+    star->setAlt(m_Alt[i]);
+    star->setAz(m_Az[i]);
+}
+
+void StarBlock::position(int i, SkyPoint *p) const
+{
+    p->setRA(m_RA[i] / 15.0);
+    p->setDec(m_Dec[i]);
+    p->setAlt(m_Alt[i]);
+    p->setAz(m_Az[i]);
+}
+
+int StarBlock::starCountToMag(float maglim) const
+{
+    // Stars are sorted by magnitude
+    int count = 0;
+    while (count < nStars && m_Mag[count] <= maglim)
+        ++count;
+    return count;
+}
+
+void StarBlock::JITupdate(float maglim)
+{
+    static KStarsData *data = KStarsData::Instance();
+
+    // Stars are sorted by magnitude. Like the per-star loop this replaces, the first star fainter
+    // than maglim is still updated.
+    int limit = 0;
+    while (limit < nStars && m_Mag[limit] <= maglim)
+        ++limit;
+    if (limit < nStars)
+        ++limit;
+
+    if (m_UpdateNumID != data->updateNumID())
+    {
+        // NOTE: Same short-circuiting as in StarObject::JITupdate() and SkyPoint::updateCoords()
+        if (Options::alwaysRecomputeCoordinates() || Options::useRelativistic() ||
+            std::abs(m_LastPrecessJD - data->updateNum()->getJD()) >= 0.00069444)
+        {
+            m_PrecessedCount = 0;
+            m_LastPrecessJD  = data->updateNum()->getJD();
+        }
+        m_UpdateNumID = data->updateNumID();
+    }
+
+    if (m_UpdateID != data->updateID())
+    {
+        m_HorizontalCount = 0;
+        m_UpdateID        = data->updateID();
+    }
+
+    if (m_PrecessedCount >= limit && m_HorizontalCount >= limit)
+        return;
+
+    const KSNumbers *num = data->updateNum();
+
+    if (m_PrecessedCount < limit)
+    {
+        int first = m_PrecessedCount, count = limit - m_PrecessedCount;
+
+        // Proper motion first, into the arrays of current coordinates, which are then precessed in place
+        for (int i = first; i < limit; ++i)
+        {
+            double sinDec0, cosDec0;
+            dms(m_Dec0[i]).SinCos(sinDec0, cosDec0);
+            StarObject::getIndexCoords(num, m_RA0[i], m_Dec0[i], sinDec0, cosDec0, m_PMRA[i], m_PMDec[i], &m_RA[i],
+                                       &m_Dec[i]);
+        }
+
+        if (Options::useRelativistic())
+        {
+            // Light bending depends on each star's distance to the Sun, so take the slow path
+            SkyPoint p;
+            for (int i = first; i < limit; ++i)
+            {
+                p.setRA0(m_RA[i] / 15.0);
+                p.setDec0(m_Dec[i]);
+                p.updateCoordsNow(num);
+                m_RA[i]  = p.ra().Degrees();
+                m_Dec[i] = p.dec().Degrees();
+            }
+        }
+        else
+        {
+            SkyPointBatch::updateCoords(num, count, m_RA.constData() + first, m_Dec.constData() + first,
+                                        m_RA.data() + first, m_Dec.data() + first);
+        }
+    }
+    // Freshly precessed stars need their horizontal coordinates recomputed as well
+    m_HorizontalCount = qMin(m_HorizontalCount, m_PrecessedCount);
+    m_PrecessedCount  = qMax(m_PrecessedCount, limit);
+
+    if (m_HorizontalCount < limit)
+    {
+        int first = m_HorizontalCount;
+        SkyPointBatch::equatorialToHorizontal(data->lst(), data->geo()->lat(), limit - first, m_RA.constData() + first,
+                                              m_Dec.constData() + first, m_Alt.data() + first, m_Az.data() + first);
+    }
+    m_HorizontalCount = qMax(m_HorizontalCount, limit);
+
+    for (auto it = m_Materialized.constBegin(); it != m_Materialized.constEnd(); ++it)
+    {
+        if (it.key() < limit)
+            syncStar(it.key(), it.value());
+    }
 }
 #endif
@@ -20,9 +20,12 @@
 #include "typedef.h"
 #include "starblocklist.h"
 
+#include <QByteArray>
+#include <QHash>
 #include <QVector>
 
 class StarObject;
+class SkyPoint;
 class StarBlockList;
 class PointSourceNode;
 struct StarData;
@@ -46,6 +49,13 @@ struct StarNode
  *
  * Holds a block of stars and various peripheral variables to mark its place in data structures
  *
+ * In the desktop build, the stars are not held as StarObject instances. Instead, the block is a
+ * structure of arrays: the catalog values needed for drawing (J2000 position, proper motion,
+ * magnitude, spectral class) and the current RA/Dec/Alt/Az live in parallel arrays, together with
+ * a copy of the raw catalog record. A real StarObject is only materialized by star() when somebody
+ * needs one, eg. when the star is clicked or labelled. This keeps each star well below a hundred
+ * bytes, so many more blocks fit in the StarBlockFactory's LRU cache.
+ *
  * @author  Akarsh Simha
  * @version 1.0
  */
@@ -56,8 +66,6 @@ class StarBlock
 // StarBlockEntry is the data type held by the StarBlock's QVector
 #ifdef KSTARS_LITE
     typedef StarNode StarBlockEntry;
-#else
-    typedef StarObject StarBlockEntry;
 #endif
 
     /**
@@ -69,6 +77,7 @@ class StarBlock
      */
     explicit StarBlock(int nstars = 100);
 
+#ifdef KSTARS_LITE
     ~StarBlock() = default;
 
     /**
@@ -83,6 +92,18 @@ class StarBlock
      */
     StarBlockEntry *addStar(const StarData &data);
     StarBlockEntry *addStar(const DeepStarData &data);
+#else
+    ~StarBlock() = default;
+
+    /**
+     * @short Initialize another star with data.
+     *
+     * @param  data    data to initialize star with.
+     * @return index of the star in this block, -1 if block is full.
+     */
+    int addStar(const StarData &data);
+    int addStar(const DeepStarData &data);
+#endif
 
     /**
      * @short Returns true if the StarBlock is full
@@ -100,8 +121,13 @@ class StarBlock
      *
      * @return The number of stars that this StarBlock can hold
      */
+#ifdef KSTARS_LITE
     inline int size() const { return stars.size(); }
+#else
+    inline int size() const { return m_Capacity; }
+#endif
 
+#ifdef KSTARS_LITE
     /**
      * @short  Return the i-th star in this StarBlock
      *
@@ -117,6 +143,75 @@ class StarBlock
      */
 
     inline QVector<StarBlockEntry> &contents() { return stars; }
+#else
+    /**
+     * @short  Return the i-th star in this StarBlock as a real StarObject
+     *
+     * The StarObject is created on the first call and owned by the DeepStarComponent of the block,
+     * keyed by the position of the star in its trixel. When the block is recycled by the
+     * StarBlockFactory, the StarObject is deleted unless the sky map or a name label still points to it
+     * (see DeepStarComponent::releaseMaterializedStar()). While the star is in this block, its
+     * coordinates are kept in sync with the block on every JITupdate().
+     *
+     * @param  i Index of the star
+     * @return A pointer to the i-th star, nullptr if i is out of range
+     */
+    StarObject *star(int i);
+
+    /** @return magnitude of the i-th star */
+    inline float mag(int i) const { return m_Mag[i]; }
+
+    /** @return first character of the spectral type of the i-th star */
+    inline char spchar(int i) const { return m_SpType[i]; }
+
+    /** @return current (precessed, nutated, aberrated) right ascension of the i-th star, in degrees */
+    inline double ra(int i) const { return m_RA[i]; }
+
+    /** @return current declination of the i-th star, in degrees */
+    inline double dec(int i) const { return m_Dec[i]; }
+
+    /** @return altitude of the i-th star as of the last JITupdate(), in degrees */
+    inline double alt(int i) const { return m_Alt[i]; }
+
+    /** @return azimuth of the i-th star as of the last JITupdate(), in degrees */
+    inline double az(int i) const { return m_Az[i]; }
+
+    /**
+     * @name Raw arrays
+     * Contiguous per-star arrays, indexed like the accessors above, for batch consumers like
+     * SkyPainter::drawPointSources()
+     */
+    ///@{
+    inline const float *magData() const { return m_Mag.constData(); }
+    inline const char *spTypeData() const { return m_SpType.constData(); }
+    inline const double *raData() const { return m_RA.constData(); }
+    inline const double *decData() const { return m_Dec.constData(); }
+    inline const double *altData() const { return m_Alt.constData(); }
+    inline const double *azData() const { return m_Az.constData(); }
+    ///@}
+
+    /** @return the number of leading stars of this block that are not fainter than maglim */
+    int starCountToMag(float maglim) const;
+
+    /**
+     * @short Fill a SkyPoint with the current coordinates of the i-th star
+     *
+     * Useful to hand a star to code that expects a SkyPoint (eg. SkyPainter::drawPointSource())
+     * without materializing a StarObject.
+     */
+    void position(int i, SkyPoint *p) const;
+
+    /**
+     * @short Bring the current coordinates of the stars up to date
+     *
+     * The equivalent of StarObject::JITupdate() for the whole block. Stars are stored in order of
+     * increasing magnitude, so updating stops at the first star fainter than maglim; stars already
+     * updated for the current updateID are not touched again.
+     *
+     * @param maglim Faintest magnitude that needs to be up to date
+     */
+    void JITupdate(float maglim);
+#endif
 
     // These methods are there because we might want to make faintMag and brightMag private at some point
     /**
@@ -149,6 +244,10 @@ class StarBlock
     std::shared_ptr<StarBlock> prev;
     std::shared_ptr<StarBlock> next;
     quint32 drawID { 0 };
+#ifndef KSTARS_LITE
+    /** Index of the first star of this block among all stars of its trixel, set by the StarBlockList */
+    quint32 firstIndex { 0 };
+#endif
 
   private:
     // Disallow copying and assignment. Just in case.
@@ -157,6 +256,43 @@ class StarBlock
 
     /** Number of initialized stars in StarBlock. */
     int nStars { 0 };
+#ifdef KSTARS_LITE
     /** Array of stars. */
     QVector<StarBlockEntry> stars;
+#else
+    /** Common part of both addStar() overloads */
+    int appendStar(double ra0, double dec0, double pmRA, double pmDec, float mag, char spType, const void *record,
+                   int recordSize);
+
+    /** Bring the i-th StarObject, if materialized, in sync with the arrays */
+    void syncStar(int i, StarObject *star) const;
+
+    /** Number of stars this block can hold */
+    int m_Capacity { 0 };
+    /** Size of the raw records, either sizeof(StarData) or sizeof(DeepStarData). Zero if the block is empty */
+    int m_RecordSize { 0 };
+
+    /** J2000 right ascension and declination, in degrees */
+    QVector<double> m_RA0, m_Dec0;
+    /** Proper motion, in milliarcsec/year */
+    QVector<float> m_PMRA, m_PMDec;
+    QVector<float> m_Mag;
+    QVector<char> m_SpType;
+    /** Current right ascension, declination, altitude and azimuth, in degrees */
+    QVector<double> m_RA, m_Dec, m_Alt, m_Az;
+    /** Copy of the raw catalog records, used to materialize StarObjects */
+    QByteArray m_Records;
+
+    /** Stars that have been materialized with star(), owned by the DeepStarComponent */
+    QHash<int, StarObject *> m_Materialized;
+
+    /** updateID / updateNumID of KStarsData the arrays were last updated for */
+    quint64 m_UpdateID { 0 };
+    quint64 m_UpdateNumID { 0 };
+    /** JD the precessed coordinates were last computed for */
+    long double m_LastPrecessJD { 0 };
+    /** Number of stars (from the bright end) whose horizontal / precessed coordinates are current */
+    int m_HorizontalCount { 0 };
+    int m_PrecessedCount { 0 };
+#endif
 };
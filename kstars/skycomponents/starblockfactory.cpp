@@ -23,7 +23,12 @@
 #include <kstars_debug.h>
 
 // TODO: Implement a better way of deciding this
+#ifdef KSTARS_LITE
 #define DEFAULT_NCACHE 12
+#else
+// Compact StarBlocks are several times smaller than blocks of StarObjects, so we can afford to keep more around
+#define DEFAULT_NCACHE 64
+#endif
 
 StarBlockFactory *StarBlockFactory::pInstance = nullptr;
 
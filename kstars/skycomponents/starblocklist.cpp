@@ -74,14 +74,12 @@ bool StarBlockList::fillToMag(float maglim)
 {
     // TODO: Remove staticity of BinFileHelper
     BinFileHelper *dSReader;
-    StarBlockFactory *SBFactory;
     StarData stardata;
     DeepStarData deepstardata;
     FILE *dataFile;
 
     dSReader  = parent->getStarReader();
     dataFile  = dSReader->getFileHandle();
-    SBFactory = StarBlockFactory::Instance();
 
     if (staticStars)
         return false;
@@ -95,6 +93,9 @@ bool StarBlockList::fillToMag(float maglim)
         return false;
     }
 
+    if (dSReader->isMapped())
+        return fillToMagMapped(maglim);
+
     Trixel trixelId =
         trixel; //( ( trixel < 256 ) ? ( trixel + 256 ) : ( trixel - 256 ) ); // Trixel ID on datafile is assigned differently
 
@@ -115,25 +116,9 @@ bool StarBlockList::fillToMag(float maglim)
     {
         int ret = 0;
 
-        if (nBlocks == 0 || blocks[nBlocks - 1]->isFull())
-        {
-            std::shared_ptr<StarBlock> newBlock = SBFactory->getBlock();
+        if (!appendBlockIfFull())
+            return false;
 
-            if (!newBlock.get())
-            {
-                qWarning() << "ERROR: Could not get a new block from StarBlockFactory::getBlock() in trixel " << trixel
-                           << ", while trying to create block #" << nBlocks + 1;
-                return false;
-            }
-            blocks.append(newBlock);
-            blocks[nBlocks]->parent = this;
-            if (nBlocks == 0)
-                SBFactory->markFirst(blocks[0]);
-            else if (!SBFactory->markNext(blocks[nBlocks - 1], blocks[nBlocks]))
-                qWarning() << "ERROR: markNext() failed on block #" << nBlocks + 1 << "in trixel" << trixel;
-
-            ++nBlocks;
-        }
         // TODO: Make this more general
         if (dSReader->guessRecordSize() == 32)
         {
@@ -165,6 +150,86 @@ bool StarBlockList::fillToMag(float maglim)
     return ((maglim < faintMag) ? true : false);
 }
 
+bool StarBlockList::appendBlockIfFull()
+{
+    StarBlockFactory *SBFactory = StarBlockFactory::Instance();
+
+    if (nBlocks != 0 && !blocks[nBlocks - 1]->isFull())
+        return true;
+
+    std::shared_ptr<StarBlock> newBlock = SBFactory->getBlock();
+
+    if (!newBlock.get())
+    {
+        qWarning() << "ERROR: Could not get a new block from StarBlockFactory::getBlock() in trixel " << trixel
+                   << ", while trying to create block #" << nBlocks + 1;
+        return false;
+    }
+    blocks.append(newBlock);
+    blocks[nBlocks]->parent = this;
+#ifndef KSTARS_LITE
+    blocks[nBlocks]->firstIndex = nStars;
+#endif
+    if (nBlocks == 0)
+        SBFactory->markFirst(blocks[0]);
+    else if (!SBFactory->markNext(blocks[nBlocks - 1], blocks[nBlocks]))
+        qWarning() << "ERROR: markNext() failed on block #" << nBlocks + 1 << "in trixel" << trixel;
+
+    ++nBlocks;
+    return true;
+}
+
+bool StarBlockList::fillToMagMapped(float maglim)
+{
+    BinFileHelper *dSReader = parent->getStarReader();
+    bool byteSwap           = dSReader->getByteSwap();
+
+    if (readOffset <= 0)
+        readOffset = dSReader->getOffset(trixel);
+
+    // Records already loaded are skipped, so the span starts at the first star we still need
+    if (dSReader->guessRecordSize() == 32)
+    {
+        BinRecordSpan<StarData> span = dSReader->records<StarData>(trixel, nStars);
+        StarData stardata;
+
+        for (quint32 i = 0; i < span.size() && maglim >= faintMag; ++i)
+        {
+            if (!appendBlockIfFull())
+                return false;
+
+            span.at(i, &stardata);
+            if (byteSwap)
+                DeepStarComponent::byteSwap(&stardata);
+            blocks[nBlocks - 1]->addStar(stardata);
+            readOffset += sizeof(StarData);
+            faintMag = blocks[nBlocks - 1]->getFaintMag();
+            nStars++;
+        }
+    }
+    else
+    {
+        BinRecordSpan<DeepStarData> span = dSReader->records<DeepStarData>(trixel, nStars);
+        DeepStarData deepstardata;
+
+        for (quint32 i = 0; i < span.size() && maglim >= faintMag; ++i)
+        {
+            if (!appendBlockIfFull())
+                return false;
+
+            span.at(i, &deepstardata);
+            if (byteSwap)
+                DeepStarComponent::byteSwap(&deepstardata);
+            blocks[nBlocks - 1]->addStar(deepstardata);
+            readOffset += sizeof(DeepStarData);
+            faintMag = blocks[nBlocks - 1]->getFaintMag();
+            nStars++;
+        }
+    }
+
+    return ((maglim < faintMag) ? true : false);
+}
+
 void StarBlockList::setStaticBlock(std::shared_ptr<StarBlock> &block)
 {
     if (!block)
@@ -103,7 +103,21 @@ class StarBlockList
      */
     inline Trixel getTrixel() const { return trixel; }
 
+    /** @return the DeepStarComponent this list belongs to */
+    inline DeepStarComponent *component() const { return parent; }
+
   private:
+    /**
+     * @short Backend of fillToMag() reading from the memory-mapped catalog instead of the FILE handle
+     */
+    bool fillToMagMapped(float maglim);
+
+    /**
+     * @short Appends a fresh block from the StarBlockFactory if the last block is full (or there is none)
+     * @return false if no block could be obtained
+     */
+    bool appendBlockIfFull();
+
     Trixel trixel;
     unsigned long nStars { 0 };
     long readOffset { 0 };
@@ -111,6 +111,7 @@ DeepSkyObject *SyncedCatalogComponent::addObject(CatalogEntryData &catalogEntry)
         objectLists()[newObj->type()].append(QPair<QString, const SkyObject *>(newObj->name(), newObj));
     }
     m_ObjectList.append(newObj);
+    indexObject(newObj);
     qDebug() << "Added new SkyObject " << newObj->name() << " to synced catalog " << m_catName << " which now contains "
              << m_ObjectList.count() << " objects.";
     return newObj;
@@ -154,6 +155,7 @@ bool SyncedCatalogComponent::removeObject(SkyObject &object)
         qWarning() << "Can't find SkyObject " << name << " in the synced catalog " << m_catName;
         return false;
     }
+    unindexObject(&object);
     m_ObjectList.removeAll(&object);
     qDebug() << "Remove SkyObject " << name << " from synced catalog " << m_catName;
     // Remove the catalog entry
@@ -572,6 +572,9 @@ class SkyMap : public QGraphicsView
         /** Emitted when a sky object is removed from the database */
         void removeSkyObject(SkyObject *object);
 
+        /** Emitted when the sky has been drawn, not when a cached sky image is shown again */
+        void frameDrawn();
+
     protected:
         bool event(QEvent *event) override;
 
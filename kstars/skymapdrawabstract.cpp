@@ -27,6 +27,7 @@
 #include "skymap.h"
 #include "Options.h"
 #include "fov.h"
+#include "frameprofiler.h"
 #include "kstars.h"
 #include "kstarsdata.h"
 #include "ksnumbers.h"
@@ -102,6 +103,53 @@ void SkyMapDrawAbstract::drawOverlays(QPainter &p, bool drawFov)
         m_SkyMap->updateAngleRuler();
         drawAngleRuler(p);
     }
+
+    drawFrameProfile(p);
+}
+
+void SkyMapDrawAbstract::drawFrameProfile(QPainter &p)
+{
+    if (!FrameProfiler::isEnabled())
+        return;
+
+    QStringList lines = FrameProfiler::Instance()->summary();
+    if (lines.isEmpty())
+        return;
+    lines.prepend(i18n("Frame profile (mean / 95% / max)"));
+
+    p.save();
+
+    QFont font("Monospace");
+    font.setStyleHint(QFont::TypeWriter);
+    font.setPointSize(8);
+    p.setFont(font);
+
+    QFontMetrics fm(font);
+    int width = 0;
+    for (const QString &line : lines)
+#if QT_VERSION >= QT_VERSION_CHECK(5, 11, 0)
+        width = qMax(width, fm.horizontalAdvance(line));
+#else
+        width = qMax(width, fm.width(line));
+#endif
+
+    // Same look as the info boxes
+    ColorScheme *cs = m_KStarsData->colorScheme();
+    QColor colBG    = cs->colorNamed("BoxBGColor");
+    colBG.setAlpha(127);
+
+    QRect box(10, 10, width + 10, fm.lineSpacing() * lines.size() + 10);
+    p.fillRect(box, colBG);
+
+    p.setPen(cs->colorNamed("BoxTextColor"));
+    int y = box.top() + 5 + fm.ascent();
+    for (const QString &line : lines)
+    {
+        p.drawText(box.left() + 5, y, line);
+        y += fm.lineSpacing();
+    }
+
+    p.restore();
 }
 
 void SkyMapDrawAbstract::drawAngleRuler(QPainter &p)
@@ -91,6 +91,13 @@ class SkyMapDrawAbstract
         	*/
     void drawAngleRuler(QPainter &psky);
 
+    /**
+    	*@short Draw the draw / update timing statistics collected by FrameProfiler, when
+    	*Options::frameProfiling() is enabled.
+    	*@param psky reference to the QPainter on which to draw (this should be the Sky pixmap).
+    	*/
+    void drawFrameProfile(QPainter &psky);
+
     /** @short Draw the current Sky map to a pixmap which is to be printed or exported to a file.
         	*
         	*@param pd pointer to the QPaintDevice on which to draw.
@@ -73,4 +73,6 @@ void SkyMapGLDraw::paintEvent(QPaintEvent *event)
     p.end();
 
     setDrawLock(false);
+
+    emit m_SkyMap->frameDrawn();
 }
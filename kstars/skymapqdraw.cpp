@@ -20,6 +20,7 @@
 #include "skymap.h"
 #include "projections/projector.h"
 #include "printing/legend.h"
+#include "auxiliary/frameprofiler.h"
 #include "kstars_debug.h"
 
 SkyMapQDraw::SkyMapQDraw(SkyMap *sm) : QWidget(sm), SkyMapDrawAbstract(sm)
@@ -65,6 +66,8 @@ void SkyMapQDraw::paintEvent(QPaintEvent *event)
         return; // exit because the pixmap is repainted and that's all what we want
     }
 
+    FrameProfiler::Timer timer;
+
     // FIXME: used to notify infobox about possible change of object coordinates
     // Not elegant at all. Should find better option
     m_SkyMap->showFocusCoords();
@@ -99,9 +102,13 @@ void SkyMapQDraw::paintEvent(QPaintEvent *event)
         m_SkyMap->m_legend.paintLegend(m_SkyPixmap);
     }
 
+    timer.lap("frame/Paint");
+
     m_SkyMap->computeSkymap = false; // use forceUpdate() to compute new skymap else old pixmap will be shown
 
     setDrawLock(false);
+
+    emit m_SkyMap->frameDrawn();
 }
 
 void SkyMapQDraw::resizeEvent(QResizeEvent *e)
@@ -47,7 +47,8 @@ int letterDesigToN(QString s)
     return n;
 }
 
-QMap<QChar, qint64> cometType;
+// Constant, as comets may be created on several threads
+const QMap<QChar, qint64> cometType { { 'P', 0 }, { 'C', 1 }, { 'X', 2 }, { 'D', 3 }, { 'A', 4 } };
 }
 
 KSComet::KSComet(const QString &_s, const QString &imfile, double _q, double _e, dms _i, dms _w,
@@ -110,16 +111,7 @@ KSComet::KSComet(const QString &_s, const QString &imfile, double _q, double _e,
     QRegExp rePro("^([PCXDA])/.*\\((\\d{4}) ([A-Z])(\\d+)(-([A-Z]+))?\\)");
     if (rePro.indexIn(_s) != -1)
     {
-        // Fill comet type
-        if (cometType.empty())
-        {
-            cometType.insert('P', 0);
-            cometType.insert('C', 1);
-            cometType.insert('X', 2);
-            cometType.insert('D', 3);
-            cometType.insert('A', 4);
-        }
-        qint64 type       = cometType[rePro.cap(1).at(0)]; // Type of comet
+        qint64 type       = cometType.value(rePro.cap(1).at(0)); // Type of comet
         qint64 year       = rePro.cap(2).toInt();       // Year of discovery
         qint64 halfMonth  = letterToNum(rePro.cap(3).at(0));
         qint64 nHalfMonth = rePro.cap(4).toInt();
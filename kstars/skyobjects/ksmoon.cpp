@@ -295,8 +295,13 @@ void KSMoon::findPhase(const KSSun *Sun)
 
 QString KSMoon::phaseName() const
 {
-    double f = illum();
-    double p = abs(dms(Phase).reduce().Degrees());
+    return phaseName(Phase);
+}
+
+QString KSMoon::phaseName(double phase)
+{
+    double f = 0.5 * (1.0 - cos(phase * dms::PI / 180.0));
+    double p = abs(dms(phase).reduce().Degrees());
 
     //First, handle the major phases
     if (f > 0.99)
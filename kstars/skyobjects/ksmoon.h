@@ -62,6 +62,9 @@ class KSMoon : public KSPlanetBase
     /** @return a short string describing the moon's phase */
     QString phaseName() const;
 
+    /** @return a short string describing the moon's phase for a phase angle in degrees, see phase() */
+    static QString phaseName(double phase);
+
     /** reimplemented from KSPlanetBase */
     bool loadData() override;
 
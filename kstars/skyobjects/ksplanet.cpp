@@ -18,110 +18,17 @@
 #include "ksplanet.h"
 
 #include "ksnumbers.h"
-#include "ksutils.h"
-#include "ksfilereader.h"
 
 #include <cmath>
 #include <typeinfo>
+#include <vector>
 
 #include "kstars_debug.h"
 
-KSPlanet::OrbitDataManager KSPlanet::odm;
-
-KSPlanet::OrbitDataManager::OrbitDataManager()
-{
-    //EMPTY
-}
-
-bool KSPlanet::OrbitDataManager::readOrbitData(const QString &fname, QVector<OrbitData> *vector)
-{
-    QFile f;
-
-    if (KSUtils::openDataFile(f, fname))
-    {
-        KSFileReader fileReader(f); // close file is included
-        QStringList fields;
-        while (fileReader.hasMoreLines())
-        {
-            fields = fileReader.readLine().split(' ', QString::SkipEmptyParts);
-
-            if (fields.size() == 3)
-            {
-                double A = fields[0].toDouble();
-                double B = fields[1].toDouble();
-                double C = fields[2].toDouble();
-                vector->append(OrbitData(A, B, C));
-            }
-        }
-    }
-    else
-    {
-        return false;
-    }
-    return true;
-}
-
-bool KSPlanet::OrbitDataManager::loadData(KSPlanet::OrbitDataColl &odc, const QString &n)
-{
-    QString fname, snum;
-    QFile f;
-    int nCount = 0;
-    QString nl = n.toLower();
-
-    if (hash.contains(nl))
-    {
-        odc = hash[nl];
-        return true; //orbit data already loaded
-    }
-
-    //Create a new OrbitDataColl
-    OrbitDataColl ret;
-
-    //Ecliptic Longitude
-    for (int i = 0; i < 6; ++i)
-    {
-        snum.setNum(i);
-        fname = nl + ".L" + snum + ".vsop";
-        if (readOrbitData(fname, &ret.Lon[i]))
-            nCount++;
-    }
-
-    if (nCount == 0)
-        return false;
-
-    //Ecliptic Latitude
-    for (int i = 0; i < 6; ++i)
-    {
-        snum.setNum(i);
-        fname = nl + ".B" + snum + ".vsop";
-        if (readOrbitData(fname, &ret.Lat[i]))
-            nCount++;
-    }
-
-    if (nCount == 0)
-        return false;
-
-    //Heliocentric Distance
-    for (int i = 0; i < 6; ++i)
-    {
-        snum.setNum(i);
-        fname = nl + ".R" + snum + ".vsop";
-        if (readOrbitData(fname, &ret.Dst[i]))
-            nCount++;
-    }
-
-    if (nCount == 0)
-        return false;
-
-    hash[nl] = ret;
-    odc      = hash[nl];
-
-    return true;
-}
-
 KSPlanet::KSPlanet(const QString &s, const QString &imfile, const QColor &c, double pSize)
     : KSPlanetBase(s, imfile, c, pSize)
 {
+    m_VSOP87 = VSOP87::get(untranslatedName());
 }
 
 KSPlanet::KSPlanet(int n) : KSPlanetBase()
@@ -153,6 +60,8 @@ KSPlanet::KSPlanet(int n) : KSPlanetBase()
             qDebug() << "Error: Illegal identifier in KSPlanet constructor: " << n;
             break;
     }
+
+    m_VSOP87 = VSOP87::get(untranslatedName());
 }
 
 KSPlanet *KSPlanet::clone() const
@@ -190,26 +99,20 @@ QString KSPlanet::untranslatedName() const
         return name();
 }
 
-//we don't need the reference to the ODC, so just give it a junk variable
 bool KSPlanet::loadData()
 {
-    OrbitDataColl odc;
-    return odm.loadData(odc, untranslatedName());
+    return m_VSOP87 != nullptr;
 }
 
-void KSPlanet::calcEcliptic(double Tau, EclipticPosition &epret) const
+void KSPlanet::setTolerance(double tolerance)
 {
-    double sum[6];
-    OrbitDataColl odc;
-    double Tpow[6];
-
-    Tpow[0] = 1.0;
-    for (int i = 1; i < 6; ++i)
-    {
-        Tpow[i] = Tpow[i - 1] * Tau;
-    }
+    if (m_VSOP87)
+        m_VSOP87 = VSOP87::get(m_VSOP87->planet(), tolerance);
+}
 
-    if (!odm.loadData(odc, untranslatedName()))
+void KSPlanet::calcEcliptic(double Tau, EclipticPosition &epret) const
+{
+    if (!m_VSOP87)
     {
         epret.longitude = dms(0.0);
         epret.latitude  = dms(0.0);
@@ -218,56 +121,34 @@ void KSPlanet::calcEcliptic(double Tau, EclipticPosition &epret) const
         return;
     }
 
-    //Ecliptic Longitude
-    for (int i = 0; i < 6; ++i)
-    {
-        sum[i] = 0.0;
-        for (int j = 0; j < odc.Lon[i].size(); ++j)
-        {
-            sum[i] += odc.Lon[i][j].A * cos(odc.Lon[i][j].B + odc.Lon[i][j].C * Tau);
-            /*
-            qDebug() << "sum[" << i <<"] =" << sum[i] <<
-                " A = " << odc.Lon[i][j].A << " B = " << odc.Lon[i][j].B <<
-                " C = " << odc.Lon[i][j].C;
-                */
-        }
-        sum[i] *= Tpow[i];
-        //qDebug() << name() << " : sum[" << i << "] = " << sum[i];
-    }
+    VSOP87::Position const position = m_VSOP87->evaluate(Tau);
 
-    epret.longitude.setRadians(sum[0] + sum[1] + sum[2] + sum[3] + sum[4] + sum[5]);
+    epret.longitude.setRadians(position.longitude);
     epret.longitude.setD(epret.longitude.reduce().Degrees());
+    epret.latitude.setRadians(position.latitude);
+    epret.radius = position.radius;
+}
 
-    //Compute Ecliptic Latitude
-    for (uint i = 0; i < 6; ++i)
+void KSPlanet::calcEcliptic(double jm, double step, int count, EclipticPosition *ret) const
+{
+    if (!m_VSOP87)
     {
-        sum[i] = 0.0;
-        for (int j = 0; j < odc.Lat[i].size(); ++j)
-        {
-            sum[i] += odc.Lat[i][j].A * cos(odc.Lat[i][j].B + odc.Lat[i][j].C * Tau);
-        }
-        sum[i] *= Tpow[i];
+        for (int i = 0; i < count; ++i)
+            ret[i] = EclipticPosition(dms(0.0), dms(0.0), 0.0);
+        qCWarning(KSTARS) << "Could not get data for name:" << name() << "(" << untranslatedName() << ")";
+        return;
     }
 
-    epret.latitude.setRadians(sum[0] + sum[1] + sum[2] + sum[3] + sum[4] + sum[5]);
+    std::vector<VSOP87::Position> positions(count);
+    m_VSOP87->evaluate(jm, step, count, positions.data());
 
-    //Compute Heliocentric Distance
-    for (uint i = 0; i < 6; ++i)
+    for (int i = 0; i < count; ++i)
     {
-        sum[i] = 0.0;
-        for (int j = 0; j < odc.Dst[i].size(); ++j)
-        {
-            sum[i] += odc.Dst[i][j].A * cos(odc.Dst[i][j].B + odc.Dst[i][j].C * Tau);
-        }
-        sum[i] *= Tpow[i];
+        ret[i].longitude.setRadians(positions[i].longitude);
+        ret[i].longitude.setD(ret[i].longitude.reduce().Degrees());
+        ret[i].latitude.setRadians(positions[i].latitude);
+        ret[i].radius = positions[i].radius;
     }
-
-    epret.radius = sum[0] + sum[1] + sum[2] + sum[3] + sum[4] + sum[5];
-
-    /*
-    qDebug() << name() << " pre: Lat = " << epret.latitude.toDMSString() << " Long = " <<
-        epret.longitude.toDMSString() << " Dist = " << epret.radius;
-    */
 }
 
 bool KSPlanet::findGeocentricPosition(const KSNumbers *num, const KSPlanetBase *Earth)
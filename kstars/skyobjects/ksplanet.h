@@ -18,10 +18,11 @@
 #pragma once
 
 #include "ksplanetbase.h"
+#include "vsop87.h"
 
-#include <QHash>
 #include <QString>
-#include <QVector>
+
+#include <memory>
 
 class KSNumbers;
 
@@ -72,9 +73,16 @@ class KSPlanet : public KSPlanetBase
      */
     QString untranslatedName() const;
 
-    /** @short Preload the data used by findPosition. */
+    /** @short Check that the planet has the series used by findPosition. */
     bool loadData() override;
 
+    /**
+     * Truncate the series of the planet to their terms whose amplitude is at least tolerance,
+     * in radians or AU, which makes the positions faster to compute and less accurate.
+     * @param tolerance 0 for the complete series, the default.
+     */
+    void setTolerance(double tolerance);
+
     /**
      * Calculate the ecliptic longitude and latitude of the planet for
      * the given date (expressed in Julian Millenia since J2000).  A reference
@@ -84,6 +92,16 @@ class KSPlanet : public KSPlanetBase
      */
     virtual void calcEcliptic(double jm, EclipticPosition &ret) const;
 
+    /**
+     * Calculate the heliocentric ecliptic coordinates at evenly spaced dates, which is
+     * much faster than calling calcEcliptic() for each of them.
+     * @param jm first date, in Julian Millenia
+     * @param step time between the dates, in Julian Millenia
+     * @param count number of dates
+     * @param ret filled with the count ecliptic coordinates
+     */
+    void calcEcliptic(double jm, double step, int count, EclipticPosition *ret) const;
+
   protected:
     /**
      * Calculate the geocentric RA, Dec coordinates of the Planet.
@@ -94,93 +112,11 @@ class KSPlanet : public KSPlanetBase
      */
     bool findGeocentricPosition(const KSNumbers *num, const KSPlanetBase *Earth = nullptr) override;
 
-    /**
-     * @class OrbitData
-     * This class contains doubles A,B,C which represent a single term in a planet's
-     * positional expansion sums (each sum-term is A*COS(B+C*T)).
-     *
-     * @author Mark Hollomon
-     * @version 1.0
-     */
-    class OrbitData
-    {
-      public:
-        /** Default constructor */
-        OrbitData() : A(0.), B(0.), C(0.) {}
-        /**
-         * Constructor
-         * @param a the A value
-         * @param b the B value
-         * @param c the C value
-         */
-        OrbitData(double a, double b, double c) : A(a), B(b), C(c) {}
-
-        double A, B, C;
-    };
-
-    typedef QVector<OrbitData> OBArray[6];
-
-    /**
-     * OrbitDataColl contains three groups of six QVectors.  Each QVector is a
-     * list of OrbitData objects, representing a single sum used in computing
-     * the planet's position.  A set of six of these vectors comprises the large
-     * "meta-sum" which yields the planet's Longitude, Latitude, or Distance value.
-     *
-     * @author Mark Hollomon
-     * @version 1.0
-     */
-    class OrbitDataColl
-    {
-      public:
-        /** Constructor */
-        OrbitDataColl() = default;
-
-        OBArray Lon;
-        OBArray Lat;
-        OBArray Dst;
-    };
-
-    /**
-     * OrbitDataManager places the OrbitDataColl objects for all planets in a QDict
-     * indexed by the planets' names. It also loads the positional data of each planet from disk.
-     *
-     * @author Mark Hollomon
-     * @version 1.0
-     */
-    class OrbitDataManager
-    {
-      public:
-        /** Constructor */
-        OrbitDataManager();
-
-        /**
-         * Load orbital data for a planet from disk.
-       	 * The data is stored on disk in a series of files named
-         * "name.[LBR][0...5].vsop", where "L"=Longitude data, "B"=Latitude data,
-         * and R=Radius data.
-         * @param n the name of the planet whose data is to be loaded from disk.
-         * @param odc reference to the OrbitDataColl containing the planet's orbital data.
-         * @return true if data successfully loaded
-         */
-        bool loadData(OrbitDataColl &odc, const QString &n);
-
-      private:
-        /**
-         * Read a single orbital data file from disk into an OrbitData vector.
-         * The data files are named "name.[LBR][0...5].vsop", where
-         * "L"=Longitude data, "B"=Latitude data, and R=Radius data.
-         * @param fname the filename to be read.
-         * @param vector pointer to the OrbitData vector to be filled with these data.
-         */
-        bool readOrbitData(const QString &fname, QVector<KSPlanet::OrbitData> *vector);
-
-        QHash<QString, OrbitDataColl> hash;
-    };
-
   private:
     void findMagnitude(const KSNumbers *) override;
 
   protected:
     bool data_loaded { false };
-    static OrbitDataManager odm;
+    /// Series of the planet, nullptr if it has none
+    std::shared_ptr<const VSOP87> m_VSOP87;
 };
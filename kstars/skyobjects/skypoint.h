@@ -358,6 +358,26 @@ class SkyPoint
      */
     void aberrate(const KSNumbers *num);
 
+    /**
+     * @short Offsets in RA and Dec due to annual aberration (Meeus, Astronomical Algorithms, eq. 23.3)
+     *
+     * Used by aberrate() and by SkyPointBatch, so that single objects and batches of stars get the
+     * same correction. The factors that only depend on time are passed in precomputed.
+     *
+     * @param a K * (e * cos(P) - cos(L)), with K the constant of aberration in degrees, e the
+     * eccentricity of the Earth's orbit, P the longitude of its perihelion and L the true longitude
+     * of the Sun
+     * @param b K * (e * sin(P) - sin(L))
+     * @param dRA set to the offset in right ascension, in degrees
+     * @param dDec set to the offset in declination, in degrees
+     */
+    static inline void aberrationOffsets(double a, double b, double sinOb, double cosOb, double sinRA, double cosRA,
+                                         double sinDec, double cosDec, double &dRA, double &dDec)
+    {
+        dRA  = (a * cosRA * cosOb + b * sinRA) / cosDec;
+        dDec = a * (sinOb * cosDec - cosOb * sinRA * sinDec) + b * cosRA * sinDec;
+    }
+
     /**
      * General case of precession. It precess from an original epoch to a
      * final epoch. In this case RA0, and Dec0 from SkyPoint object represent
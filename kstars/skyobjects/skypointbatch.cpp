@@ -0,0 +1,170 @@
+/***************************************************************************
+                   skypointbatch.cpp  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sat 17 Oct 2026
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "skypointbatch.h"
+
+#include "ksnumbers.h"
+#include "auxiliary/dms.h"
+#include "skypoint.h"
+
+#include <QtGlobal>
+
+#include <cmath>
+
+namespace
+{
+/** Rotation of the coordinate frame about the x axis by angle (radians) */
+Eigen::Matrix3d rotationX(double angle)
+{
+    double s = sin(angle), c = cos(angle);
+    Eigen::Matrix3d r;
+    r << 1, 0, 0, 0, c, s, 0, -s, c;
+    return r;
+}
+
+/** Rotation of the coordinate frame about the z axis by angle (radians) */
+Eigen::Matrix3d rotationZ(double angle)
+{
+    double s = sin(angle), c = cos(angle);
+    Eigen::Matrix3d r;
+    r << c, s, 0, -s, c, 0, 0, 0, 1;
+    return r;
+}
+
+/** Fill the columns of v with the unit vectors of the given (RA, Dec) pairs */
+void toUnitVectors(int n, const double *ra, const double *dec, Eigen::Matrix3Xd &v)
+{
+    for (int i = 0; i < n; ++i)
+    {
+        double sinRA, cosRA, sinDec, cosDec;
+        dms(ra[i]).SinCos(sinRA, cosRA);
+        dms(dec[i]).SinCos(sinDec, cosDec);
+        v(0, i) = cosRA * cosDec;
+        v(1, i) = sinRA * cosDec;
+        v(2, i) = sinDec;
+    }
+}
+}
+
+Eigen::Matrix3d SkyPointBatch::precessionNutationMatrix(const KSNumbers *num)
+{
+    // Nutation as a rotation: from mean equator of date to the ecliptic, by dEcLong along the
+    // ecliptic, and back to the true equator of date.
+    double eps  = num->obliquity()->radians();
+    double deps = num->dObliq() * dms::DegToRad;
+    double dpsi = num->dEcLong() * dms::DegToRad;
+
+    Eigen::Matrix3d nutation = rotationX(-(eps + deps)) * rotationZ(-dpsi) * rotationX(eps);
+
+    // See SkyPoint::precess() for the (confusing) naming of the precession matrices
+    return nutation * num->p2();
+}
+
+Eigen::Matrix3d SkyPointBatch::horizontalMatrix(const dms *LST, const dms *lat)
+{
+    double sinLST, cosLST, sinLat, cosLat;
+    LST->SinCos(sinLST, cosLST);
+    lat->SinCos(sinLat, cosLat);
+
+    // With the hour angle H = LST - RA, cos(Dec) cos(H) = cos(LST) x + sin(LST) y and
+    // cos(Dec) sin(H) = sin(LST) x - cos(LST) y. Azimuth is measured from North through East.
+    Eigen::Matrix3d h;
+    h << -sinLat * cosLST, -sinLat * sinLST, cosLat,
+          -sinLST,          cosLST,          0,
+          cosLat * cosLST,  cosLat * sinLST, sinLat;
+    return h;
+}
+
+void SkyPointBatch::precessNutate(const KSNumbers *num, int n, const double *ra0, const double *dec0, double *ra,
+                                  double *dec)
+{
+    transform(num, false, n, ra0, dec0, ra, dec);
+}
+
+void SkyPointBatch::updateCoords(const KSNumbers *num, int n, const double *ra0, const double *dec0, double *ra,
+                                 double *dec)
+{
+    transform(num, true, n, ra0, dec0, ra, dec);
+}
+
+void SkyPointBatch::transform(const KSNumbers *num, bool aberrate, int n, const double *ra0, const double *dec0,
+                              double *ra, double *dec)
+{
+    if (n <= 0)
+        return;
+
+    Eigen::Matrix3Xd v(3, n);
+    toUnitVectors(n, ra0, dec0, v);
+
+    v = precessionNutationMatrix(num) * v;
+
+    if (!aberrate)
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            double r = atan2(v(1, i), v(0, i)) / dms::DegToRad;
+            ra[i]    = (r < 0) ? r + 360.0 : r;
+            dec[i]   = asin(qBound(-1.0, v(2, i), 1.0)) / dms::DegToRad;
+        }
+        return;
+    }
+
+    // Annual aberration, with the same formula as SkyPoint::aberrate() so that stars updated in
+    // batches and one by one agree
+    double sinOb, cosOb, sinL, cosL, sinP, cosP;
+    num->obliquity()->SinCos(sinOb, cosOb);
+    num->sunTrueLongitude().SinCos(sinL, cosL);
+    num->earthPerihelionLongitude().SinCos(sinP, cosP);
+
+    double K = num->constAberr().Degrees();
+    double e = num->earthEccentricity();
+    double a = K * (e * cosP - cosL), b = K * (e * sinP - sinL);
+
+    for (int i = 0; i < n; ++i)
+    {
+        // The rotations keep v normalized
+        double sinDec = qBound(-1.0, v(2, i), 1.0);
+        double cosDec = sqrt(v(0, i) * v(0, i) + v(1, i) * v(1, i));
+        double r      = atan2(v(1, i), v(0, i));
+        double sinRA = sin(r), cosRA = cos(r);
+
+        double dRA, dDec;
+        SkyPoint::aberrationOffsets(a, b, sinOb, cosOb, sinRA, cosRA, sinDec, cosDec, dRA, dDec);
+
+        r      = r / dms::DegToRad + dRA;
+        ra[i]  = r - 360.0 * floor(r / 360.0);
+        dec[i] = asin(sinDec) / dms::DegToRad + dDec;
+    }
+}
+
+void SkyPointBatch::equatorialToHorizontal(const dms *LST, const dms *lat, int n, const double *ra,
+                                           const double *dec, double *alt, double *az)
+{
+    if (n <= 0)
+        return;
+
+    Eigen::Matrix3Xd v(3, n);
+    toUnitVectors(n, ra, dec, v);
+
+    // Rows are now North, East and zenith components
+    v = horizontalMatrix(LST, lat) * v;
+
+    for (int i = 0; i < n; ++i)
+    {
+        double a = atan2(v(1, i), v(0, i)) / dms::DegToRad;
+        az[i]    = (a < 0) ? a + 360.0 : a;
+        alt[i]   = asin(qBound(-1.0, v(2, i), 1.0)) / dms::DegToRad;
+    }
+}
@@ -0,0 +1,96 @@
+/***************************************************************************
+                    skypointbatch.h  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sat 17 Oct 2026
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include <Eigen/Core>
+
+class dms;
+class KSNumbers;
+
+/**
+ * @class SkyPointBatch
+ *
+ * Coordinate updates for many points at once, for callers that keep their coordinates in plain
+ * arrays (see StarBlock) rather than in SkyPoint instances.
+ *
+ * Instead of precessing, nutating and aberrating each point separately with its own spherical
+ * trigonometry like SkyPoint::updateCoords() does, the points are turned into unit vectors and
+ * rotated in chunks by a single precession-nutation matrix that is computed once per KSNumbers.
+ * Annual aberration is then applied with SkyPoint::aberrationOffsets(), and the equatorial to horizontal conversion
+ * is done in the same way with one rotation matrix per LST / latitude. The per-chunk products
+ * are Eigen matrix expressions and the remaining loops run over contiguous arrays, so both are
+ * vectorized by the compiler.
+ *
+ * All angles in the array interfaces are in degrees.
+ *
+ * @note Nutation is applied as an exact rotation, so near the celestial poles the results differ
+ * very slightly from the approximate method used by SkyPoint::nutate(). Aberration is computed
+ * exactly like SkyPoint::aberrate().
+ *
+ * @short Batch coordinate conversions on arrays of points
+ */
+class SkyPointBatch
+{
+  public:
+    /**
+     * @return the rotation matrix taking J2000.0 unit vectors to true equator and equinox of date
+     * (precession followed by nutation) for the epoch of num
+     */
+    static Eigen::Matrix3d precessionNutationMatrix(const KSNumbers *num);
+
+    /**
+     * @return the rotation matrix taking equatorial unit vectors of date to horizontal ones, with
+     * the rows pointing North, East and to the zenith
+     */
+    static Eigen::Matrix3d horizontalMatrix(const dms *LST, const dms *lat);
+
+    /**
+     * @short Apply precession and nutation to n points
+     * @param num numbers for the target epoch
+     * @param n number of points
+     * @param ra0 J2000.0 right ascensions
+     * @param dec0 J2000.0 declinations
+     * @param ra output right ascensions of date (may alias ra0)
+     * @param dec output declinations of date (may alias dec0)
+     */
+    static void precessNutate(const KSNumbers *num, int n, const double *ra0, const double *dec0, double *ra,
+                              double *dec);
+
+    /**
+     * @short Apply precession, nutation and aberration to n points, the batch equivalent of
+     * SkyPoint::updateCoords()
+     * @note Parameters as in precessNutate(). Light bending by the Sun is not handled, callers
+     * have to fall back to SkyPoint::updateCoords() when Options::useRelativistic() is set.
+     */
+    static void updateCoords(const KSNumbers *num, int n, const double *ra0, const double *dec0, double *ra,
+                             double *dec);
+
+    /**
+     * @short Batch equivalent of SkyPoint::EquatorialToHorizontal()
+     * @param LST local sidereal time
+     * @param lat geographic latitude
+     * @param n number of points
+     * @param ra, dec equatorial coordinates of date
+     * @param alt, az output horizontal coordinates, azimuth in [0, 360)
+     */
+    static void equatorialToHorizontal(const dms *LST, const dms *lat, int n, const double *ra, const double *dec,
+                                       double *alt, double *az);
+
+  private:
+    /** Worker for precessNutate() and updateCoords() */
+    static void transform(const KSNumbers *num, bool aberrate, int n, const double *ra0, const double *dec0,
+                          double *ra, double *dec);
+};
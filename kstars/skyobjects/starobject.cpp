@@ -371,8 +371,12 @@ bool StarObject::getIndexCoords(const KSNumbers *num, CachingDms &ra, CachingDms
 
 bool StarObject::getIndexCoords(const KSNumbers *num, double *ra, double *dec)
 {
-    static double pmms;
+    return getIndexCoords(num, ra0().Degrees(), dec0().Degrees(), dec0().sin(), dec0().cos(), pmRA(), pmDec(), ra, dec);
+}
 
+bool StarObject::getIndexCoords(const KSNumbers *num, double ra0, double dec0, double sinDec0, double cosDec0,
+                                double pmRA, double pmDec, double *ra, double *dec)
+{
     // =================== NOTE: CODE DUPLICATION ====================
     // If you modify this, please also modify the other getIndexCoords
     // ===============================================================
@@ -403,19 +407,20 @@ bool StarObject::getIndexCoords(const KSNumbers *num, double *ra, double *dec)
     // atan2( pmRA(), pmDec() ) to an angular distance given by the Magnitude of
     // PM times the number of Julian millenia since J2000.0
 
-    pmms = pmMagnitudeSquared();
+    double metric_weighted_pmRA = cosDec0 * pmRA;
+    double pmms                 = metric_weighted_pmRA * metric_weighted_pmRA + pmDec * pmDec;
 
     if (std::isnan(pmms) || pmms * num->julianMillenia() * num->julianMillenia() < 1.)
     {
         // Ignore corrections
-        *ra  = ra0().Degrees();
-        *dec = dec0().Degrees();
+        *ra  = ra0;
+        *dec = dec0;
         return false;
     }
 
-    double pm = pmMagnitude() * num->julianMillenia(); // Proper Motion in arcseconds
+    double pm = sqrt(pmms) * num->julianMillenia(); // Proper Motion in arcseconds
 
-    double dir0 = ((pm > 0) ? atan2(pmRA(), pmDec()) : atan2(-pmRA(), -pmDec())); // Bearing, in radian
+    double dir0 = ((pm > 0) ? atan2(pmRA, pmDec) : atan2(-pmRA, -pmDec)); // Bearing, in radian
 
     (pm < 0) && (pm = -pm);
 
@@ -433,12 +438,12 @@ bool StarObject::getIndexCoords(const KSNumbers *num, double *ra, double *dec)
     // CPU cycle) recomputation!
     dms lat1, dtheta;
     double sinDst = sin(dst), cosDst = cos(dst);
-    double sinLat1 = dec0().sin() * cosDst + dec0().cos() * sinDst * cos(dir0);
+    double sinLat1 = sinDec0 * cosDst + cosDec0 * sinDst * cos(dir0);
     lat1.setRadians(asin(sinLat1));
-    dtheta.setRadians(atan2(sin(dir0) * sinDst * dec0().cos(), cosDst - dec0().sin() * sinLat1));
+    dtheta.setRadians(atan2(sin(dir0) * sinDst * cosDec0, cosDst - sinDec0 * sinLat1));
 
     // Using dms instead, to ensure that the numbers are in the right range.
-    dms finalRA(ra0().Degrees() + dtheta.Degrees());
+    dms finalRA(ra0 + dtheta.Degrees());
 
     *ra  = finalRA.Degrees();
     *dec = lat1.Degrees();
@@ -193,6 +193,23 @@ class StarObject : public SkyObject
     bool getIndexCoords(const KSNumbers *num, CachingDms &ra, CachingDms &dec);
     bool getIndexCoords(const KSNumbers *num, double *ra, double *dec);
 
+    /**
+     * @short Proper motion correction for a star that is not held in a StarObject
+     *
+     * Same computation as the member getIndexCoords(), but working on plain values so that
+     * compact star stores (see StarBlock) can use it without creating StarObject instances.
+     *
+     * @param ra0 J2000 right ascension in degrees
+     * @param dec0 J2000 declination in degrees
+     * @param sinDec0 sine of dec0
+     * @param cosDec0 cosine of dec0
+     * @param pmRA proper motion in RA, in milliarcsec/year
+     * @param pmDec proper motion in Dec, in milliarcsec/year
+     * @return true if we changed the coordinates, false otherwise
+     */
+    static bool getIndexCoords(const KSNumbers *num, double ra0, double dec0, double sinDec0, double cosDec0,
+                               double pmRA, double pmDec, double *ra, double *dec);
+
     /** @short added for JIT updates from both StarComponent and ConstellationLines */
     void JITupdate();
 
@@ -0,0 +1,212 @@
+/***************************************************************************
+                          vsop87.cpp  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sat 17 Oct 2026
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "vsop87.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Generated at build time from data/vsop87
+#include "vsop87tables.h"
+}
+
+constexpr int VSOP87::Coordinates;
+constexpr int VSOP87::Powers;
+constexpr int VSOP87::Reseed;
+constexpr int VSOP87::Lanes;
+
+std::shared_ptr<const VSOP87> VSOP87::get(const QString &planet, double tolerance)
+{
+    static std::mutex mutex;
+    static std::map<std::pair<QString, double>, std::shared_ptr<const VSOP87>> series;
+
+    QString const name = planet.toLower();
+    const Tables *tables = std::find_if(std::begin(vsop87Tables), std::end(vsop87Tables), [&name](const Tables &t)
+    {
+        return name == QLatin1String(t.planet);
+    });
+    if (tables == std::end(vsop87Tables))
+        return nullptr;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::shared_ptr<const VSOP87> &instance = series[std::make_pair(name, tolerance)];
+    if (!instance)
+        instance = std::make_shared<const VSOP87>(*tables, tolerance);
+
+    return instance;
+}
+
+VSOP87::VSOP87(const Tables &tables, double tolerance) : m_Tables(tables), m_Tolerance(tolerance)
+{
+    // The terms are mostly by decreasing amplitude, all those above the tolerance are kept
+    for (int c = 0; c < Coordinates; c++)
+    {
+        for (int p = 0; p < Powers; p++)
+        {
+            const Series &series = m_Tables.series[c][p];
+
+            int size = series.size;
+            while (size > 0 && std::fabs(series.terms[size - 1].A) < tolerance)
+                size--;
+
+            m_Size[c][p] = size;
+            m_MaxSize    = std::max(m_MaxSize, size);
+        }
+    }
+}
+
+int VSOP87::terms() const
+{
+    int terms = 0;
+    for (int c = 0; c < Coordinates; c++)
+    {
+        for (int p = 0; p < Powers; p++)
+            terms += m_Size[c][p];
+    }
+    return terms;
+}
+
+VSOP87::Position VSOP87::evaluate(double tau) const
+{
+    double values[Coordinates];
+
+    for (int c = 0; c < Coordinates; c++)
+    {
+        // Horner scheme on the powers of time
+        double value = 0;
+        for (int p = Powers - 1; p >= 0; p--)
+        {
+            const Term *terms = m_Tables.series[c][p].terms;
+            int const size    = m_Size[c][p];
+
+            double sum = 0;
+            for (int j = 0; j < size; j++)
+                sum += terms[j].A * std::cos(terms[j].B + terms[j].C * tau);
+
+            value = value * tau + sum;
+        }
+        values[c] = value;
+    }
+
+    Position position;
+    position.longitude = values[Longitude];
+    position.latitude  = values[Latitude];
+    position.radius    = values[Radius];
+    return position;
+}
+
+void VSOP87::evaluate(double tau, double step, int count, Position *positions) const
+{
+    if (count <= 0)
+        return;
+
+    static double Position::*const members[Coordinates] = { &Position::longitude, &Position::latitude,
+                                                            &Position::radius };
+
+    std::vector<double> values(count), sums(count);
+    std::vector<double> scratch(5 * static_cast<size_t>(m_MaxSize));
+
+    for (int c = 0; c < Coordinates; c++)
+    {
+        std::fill(values.begin(), values.end(), 0.0);
+
+        // Horner scheme on the powers of time
+        for (int p = Powers - 1; p >= 0; p--)
+        {
+            sumSeries(m_Tables.series[c][p].terms, m_Size[c][p], tau, step, count, scratch.data(), sums.data());
+
+            for (int k = 0; k < count; k++)
+                values[k] = values[k] * (tau + k * step) + sums[k];
+        }
+
+        for (int k = 0; k < count; k++)
+            positions[k].*members[c] = values[k];
+    }
+}
+
+void VSOP87::sumSeries(const Term *terms, int size, double tau, double step, int count, double *scratch,
+                       double *sums) const
+{
+    if (size == 0)
+    {
+        std::fill(sums, sums + count, 0.0);
+        return;
+    }
+
+    // Amplitudes, cosines and sines of the phases, and of their advance per step, as arrays
+    double *a  = scratch;
+    double *c  = a + size;
+    double *s  = c + size;
+    double *dc = s + size;
+    double *ds = dc + size;
+
+    for (int j = 0; j < size; j++)
+    {
+        a[j]  = terms[j].A;
+        dc[j] = std::cos(terms[j].C * step);
+        ds[j] = std::sin(terms[j].C * step);
+    }
+
+    for (int first = 0; first < count; first += Reseed)
+    {
+        // The rotated phases drift, so they are computed again for each block
+        double const t = tau + first * step;
+        for (int j = 0; j < size; j++)
+        {
+            double const phase = terms[j].B + terms[j].C * t;
+            c[j] = std::cos(phase);
+            s[j] = std::sin(phase);
+        }
+
+        int const last = std::min(first + Reseed, count);
+        for (int k = first; k < last; k++)
+        {
+            double lanes[Lanes] = {};
+
+            int j = 0;
+            for (; j + Lanes <= size; j += Lanes)
+            {
+                for (int l = 0; l < Lanes; l++)
+                {
+                    double const cj = c[j + l], sj = s[j + l];
+                    lanes[l] += a[j + l] * cj;
+                    c[j + l] = cj * dc[j + l] - sj * ds[j + l];
+                    s[j + l] = sj * dc[j + l] + cj * ds[j + l];
+                }
+            }
+
+            double sum = 0;
+            for (; j < size; j++)
+            {
+                double const cj = c[j], sj = s[j];
+                sum += a[j] * cj;
+                c[j] = cj * dc[j] - sj * ds[j];
+                s[j] = sj * dc[j] + cj * ds[j];
+            }
+
+            for (int l = 0; l < Lanes; l++)
+                sum += lanes[l];
+            sums[k] = sum;
+        }
+    }
+}
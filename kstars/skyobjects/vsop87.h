@@ -0,0 +1,130 @@
+/***************************************************************************
+                          vsop87.h  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sat 17 Oct 2026
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QString>
+
+#include <memory>
+
+/**
+ * @class VSOP87
+ *
+ * Evaluates the VSOP87 series of a planet's heliocentric ecliptic longitude, latitude and
+ * distance, see README.planetmath. Each coordinate is a polynomial of degree 5 in time whose
+ * coefficients are sums of terms A * cos(B + C * T).
+ *
+ * The terms are compiled into constant tables at build time from the files of data/vsop87, see
+ * vsop87tables.cmake. The series may be truncated to the terms whose amplitude A is at least a
+ * tolerance, in radians or AU, which trades accuracy for speed.
+ *
+ * Evenly spaced times are evaluated by a single call, which only computes the cosines of the
+ * terms at the first time of each block of Reseed times, and rotates the term phases by their
+ * advance per step for the others.
+ *
+ * @short Precompiled VSOP87 series of a planet
+ */
+class VSOP87
+{
+  public:
+    /** A term A * cos(B + C * T) of a series */
+    struct Term
+    {
+        double A, B, C;
+    };
+
+    struct Series
+    {
+        const Term *terms;
+        int size;
+    };
+
+    enum Coordinate
+    {
+        Longitude,
+        Latitude,
+        Radius
+    };
+
+    static constexpr int Coordinates = 3;
+    static constexpr int Powers      = 6;
+
+    /** All the series of a planet, the coefficients of the powers of time of each coordinate */
+    struct Tables
+    {
+        const char *planet;
+        Series series[Coordinates][Powers];
+    };
+
+    /** Heliocentric ecliptic position, in radians and AU. The longitude is not reduced. */
+    struct Position
+    {
+        double longitude;
+        double latitude;
+        double radius;
+    };
+
+    /**
+     * @brief get Series of a planet, shared by all users of the same planet and tolerance
+     * @param planet untranslated name of the planet, e.g. "Earth"
+     * @param tolerance smallest amplitude of the terms kept, 0 for the complete series
+     * @return the series, nullptr if the planet has none
+     */
+    static std::shared_ptr<const VSOP87> get(const QString &planet, double tolerance = 0);
+
+    VSOP87(const Tables &tables, double tolerance);
+
+    /** @return the lower case untranslated name of the planet */
+    QString planet() const
+    {
+        return QLatin1String(m_Tables.planet);
+    }
+
+    double tolerance() const
+    {
+        return m_Tolerance;
+    }
+
+    /** @return the number of terms evaluated for each time */
+    int terms() const;
+
+    /** @return the position at tau Julian millenia since J2000 */
+    Position evaluate(double tau) const;
+
+    /**
+     * @brief evaluate Positions at evenly spaced times
+     * @param tau first time, in Julian millenia since J2000
+     * @param step time between positions, in Julian millenia
+     * @param count number of positions
+     * @param positions filled with the count positions
+     */
+    void evaluate(double tau, double step, int count, Position *positions) const;
+
+  private:
+    /** Times evaluated from the phases rotated by their advance per step, before they are computed again */
+    static constexpr int Reseed = 64;
+    /** Independent partial sums of the terms, so that their loop is vectorized */
+    static constexpr int Lanes = 4;
+
+    /** Sums of a series at evenly spaced times, using scratch of 5 * m_MaxSize doubles */
+    void sumSeries(const Term *terms, int size, double tau, double step, int count, double *scratch,
+                   double *sums) const;
+
+    const Tables &m_Tables;
+    double m_Tolerance;
+    /// Number of terms kept in each series
+    int m_Size[Coordinates][Powers];
+    int m_MaxSize { 0 };
+};
@@ -0,0 +1,54 @@
+# Compiles the VSOP87 series of the files in data/vsop87 into the tables of vsop87.cpp.
+#
+# cmake -DVSOP87_DIR=<data/vsop87> -DOUTPUT=<vsop87tables.h> -P vsop87tables.cmake
+#
+# Each file <planet>.<L|B|R><power>.vsop holds the terms "A B C" of one series, one per line.
+# The terms keep the order of the files, missing files are empty series.
+
+SET(planets mercury venus earth mars jupiter saturn uranus neptune)
+SET(coordinates L B R)
+
+SET(terms_content "")
+SET(tables_content "")
+
+FOREACH(planet ${planets})
+    SET(planet_table "    { \"${planet}\", {\n")
+
+    FOREACH(coordinate ${coordinates})
+        SET(series_list "")
+
+        FOREACH(power 0 1 2 3 4 5)
+            SET(series_file "${VSOP87_DIR}/${planet}.${coordinate}${power}.vsop")
+            SET(series_name "${planet}_${coordinate}${power}")
+
+            IF (EXISTS "${series_file}")
+                FILE(READ "${series_file}" terms)
+                # The last line may not end with a newline
+                STRING(REGEX REPLACE "[ \t]*([^ \t\r\n]+)[ \t]+([^ \t\r\n]+)[ \t]+([^ \t\r\n]+)[ \t\r]*\n"
+                       "    { \\1, \\2, \\3 },\n" terms "${terms}\n")
+                STRING(REGEX REPLACE "\n[ \t\r\n]*$" "\n" terms "${terms}")
+
+                SET(terms_content "${terms_content}constexpr VSOP87::Term ${series_name}[] = {\n${terms}};\n\n")
+                LIST(APPEND series_list "{ ${series_name}, sizeof(${series_name}) / sizeof(VSOP87::Term) }")
+            ELSE ()
+                LIST(APPEND series_list "{ nullptr, 0 }")
+            ENDIF ()
+        ENDFOREACH()
+
+        STRING(REPLACE ";" ",\n          " series_list "${series_list}")
+        SET(planet_table "${planet_table}        { ${series_list} },\n")
+    ENDFOREACH()
+
+    SET(tables_content "${tables_content}${planet_table}    } },\n")
+ENDFOREACH()
+
+SET(content "// Generated by vsop87tables.cmake from the files of data/vsop87, do not edit\n\n")
+SET(content "${content}${terms_content}constexpr VSOP87::Tables vsop87Tables[] = {\n${tables_content}};\n")
+
+# Unchanged tables are not written, which would rebuild vsop87.cpp
+IF (EXISTS "${OUTPUT}")
+    FILE(READ "${OUTPUT}" old_content)
+ENDIF ()
+IF (NOT old_content STREQUAL content)
+    FILE(WRITE "${OUTPUT}" "${content}")
+ENDIF ()
@@ -31,6 +31,7 @@
 #include "skyobjects/ksplanetbase.h"
 #include "skyobjects/trailobject.h"
 #include "skyobjects/constellationsart.h"
+#include "skyobjects/skypoint.h"
 
 SkyPainter::SkyPainter()
 {
@@ -61,3 +62,21 @@ float SkyPainter::starWidth(float mag) const
 
     return size;
 }
+
+int SkyPainter::drawPointSources(int n, const double *ra, const double *dec, const double *alt, const double *az,
+                                 const float *mag, const char *sp)
+{
+    SkyPoint p;
+    int count = 0;
+
+    for (int i = 0; i < n; ++i)
+    {
+        p.setRA(ra[i] / 15.0);
+        p.setDec(dec[i]);
+        p.setAlt(alt[i]);
+        p.setAz(az[i]);
+        if (drawPointSource(&p, mag[i], sp[i]))
+            ++count;
+    }
+    return count;
+}
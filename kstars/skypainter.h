@@ -128,6 +128,22 @@ class SkyPainter
      */
     virtual bool drawPointSource(SkyPoint *loc, float mag, char sp = 'A') = 0;
 
+    /**
+     * @short Draw n point sources whose coordinates are stored in plain arrays.
+     *
+     * The default implementation calls drawPointSource() for each source. Painters that can
+     * project many points at once (see Projector::toScreenBatch()) should override it.
+     *
+     * @param n number of sources
+     * @param ra, dec current equatorial coordinates of the sources, in degrees
+     * @param alt, az current horizontal coordinates of the sources, in degrees
+     * @param mag magnitudes of the sources
+     * @param sp spectral classes of the sources
+     * @return the number of sources drawn
+     */
+    virtual int drawPointSources(int n, const double *ra, const double *dec, const double *alt, const double *az,
+                                 const float *mag, const char *sp);
+
     /**
      * @short Draw a deep sky object
      * @param obj the object to draw
@@ -22,6 +22,7 @@
 #include <QPointer>
 
 #include "kstarsdata.h"
+#include "ksutils.h"
 #include "Options.h"
 #include "skymap.h"
 #include "projections/projector.h"
@@ -578,6 +579,29 @@ bool SkyQPainter::drawPointSource(SkyPoint *loc, float mag, char sp)
     }
 }
 
+int SkyQPainter::drawPointSources(int n, const double *ra, const double *dec, const double *alt, const double *az,
+                                  const float *mag, const char *sp)
+{
+    if (n <= 0)
+        return 0;
+
+    m_batchPoints.resize(n);
+    m_batchVisible.resize(n);
+
+    if (m_proj->toScreenBatch(n, ra, dec, alt, az, m_batchPoints.data(), m_batchVisible.data()) == 0)
+        return 0;
+
+    int count = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        if (!m_batchVisible[i])
+            continue;
+        drawPointSource(KSUtils::vecToPoint(m_batchPoints[i]), starWidth(mag[i]), sp[i]);
+        ++count;
+    }
+    return count;
+}
+
 void SkyQPainter::drawPointSource(const QPointF &pos, float size, char sp)
 {
     int isize = qMin(static_cast<int>(size), 14);
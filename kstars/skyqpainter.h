@@ -21,8 +21,21 @@
 
 #include "skypainter.h"
 
+#if __GNUC__ > 5
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wignored-attributes"
+#endif
+#if __GNUC__ > 6
+#pragma GCC diagnostic ignored "-Wint-in-bool-context"
+#endif
+#include <Eigen/Core>
+#if __GNUC__ > 5
+#pragma GCC diagnostic pop
+#endif
+
 #include <QColor>
 #include <QMap>
+#include <QVector>
 
 class Projector;
 class QWidget;
@@ -87,6 +100,8 @@ class SkyQPainter : public SkyPainter, public QPainter
                          LineListLabel *label = nullptr) override;
     void drawSkyPolygon(LineList *list, bool forceClip = true) override;
     bool drawPointSource(SkyPoint *loc, float mag, char sp = 'A') override;
+    int drawPointSources(int n, const double *ra, const double *dec, const double *alt, const double *az,
+                         const float *mag, const char *sp) override;
     bool drawDeepSkyObject(DeepSkyObject *obj, bool drawImage = false) override;
     bool drawPlanet(KSPlanetBase *planet) override;
     bool drawEarthShadow(KSEarthShadow *shadow) override;
@@ -110,6 +125,9 @@ private:
     bool m_vectorStars { false };
     HIPSRenderer *m_hipsRender { nullptr };
     QSize m_size;
+    // Scratch buffers for drawPointSources()
+    QVector<Eigen::Vector2f> m_batchPoints;
+    QVector<bool> m_batchVisible;
     static int starColorMode;
     static QColor m_starColor;
     static QMap<char, QColor> ColorMap;
@@ -186,7 +186,6 @@ AltVsTime::AltVsTime(QWidget *parent) : QDialog(parent)
 
     computeSunRiseSetTimes();
     setLSTLimits();
-    setDawnDusk();
 
     connect(avtUI->View->yAxis, SIGNAL(rangeChanged(QCPRange)), this, SLOT(onYRangeChanged(QCPRange)));
     connect(avtUI->View->xAxis2, SIGNAL(rangeChanged(QCPRange)), this, SLOT(onXRangeChanged(QCPRange)));
@@ -974,8 +973,6 @@ void AltVsTime::slotUpdateDateLoc()
 
     //First determine time of sunset and sunrise
     computeSunRiseSetTimes();
-    // Determine dawn/dusk time and min/max sun elevation
-    setDawnDusk();
 
     for (int i = 0; i < pList.count(); ++i)
     {
@@ -1361,51 +1358,6 @@ double AltVsTime::getEpoch(const QString &eName)
     return epoch;
 }
 
-void AltVsTime::setDawnDusk()
-{
-    KStarsDateTime today = getDate();
-    KSNumbers num(today.djd());
-    CachingDms LST = geo->GSTtoLST(today.gst());
-
-    KSSun sun;
-    sun.updateCoords(&num, true, geo->lat(), &LST, true);
-
-    /* TODO:
-    double last_h = -12.0;
-    double last_alt = findAltitude( &sun, last_h );
-    double dawn = -13.0;
-    double dusk = -13.0;
-    double max_alt = -100.0;
-    double min_alt = 100.0;
-    for ( double h=-11.95; h<=12.0; h+=0.05 ) {
-        double alt = findAltitude( &sun, h );
-        bool asc = alt - last_alt > 0;
-        if ( alt > max_alt )
-            max_alt = alt;
-        if ( alt < min_alt )
-            min_alt = alt;
-
-        if ( asc && last_alt <= -18.0 && alt >= -18.0 )
-            dawn = h;
-        if ( !asc && last_alt >= -18.0 && alt <= -18.0 )
-            dusk = h;
-
-        last_h   = h;
-        last_alt = alt;
-    }
-
-    if ( dawn < -12.0 || dusk < -12.0 ) {
-        da = -1.0;
-        du = -1.0;
-    } else {
-        da = dawn / 24.0;
-        du = ( dusk + 24.0 ) / 24.0;
-    }
-    avtUI->View->setDawnDuskTimes( da, du );
-    avtUI->View->setMinMaxSunAlt( min_alt, max_alt );
-    */
-}
-
 void AltVsTime::slotPrint()
 {
     QPainter p;            // Our painter object
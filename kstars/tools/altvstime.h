@@ -194,9 +194,6 @@ class AltVsTime : public QDialog
     void slotPrint();
 
   private:
-    /** @short find start of dawn, end of dusk, maximum and minimum elevation of the sun */
-    void setDawnDusk();
-
     AltVsTimeUI *avtUI { nullptr };
 
     GeoLocation *geo { nullptr };
@@ -231,6 +231,10 @@ void ObservingList::showEvent(QShowEvent *)
     {
         m_initialWishlistLoad = true;
 
+        // The wishlist may hold comets, asteroids or custom catalog objects, which are loaded
+        // after startup. Wait for them, otherwise they would be dropped from the saved list.
+        KStarsData::Instance()->loadDeferredData(true);
+
         slotLoadWishList(); //Load the wishlist from disk if present
         m_CurrentObject = nullptr;
         setSaveImagesButton();
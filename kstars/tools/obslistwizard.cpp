@@ -23,6 +23,9 @@
 #include "skycomponents/constellationboundarylines.h"
 #include "skycomponents/skymapcomposite.h"
 #include "skyobjects/deepskyobject.h"
+#include "tools/visibilityengine.h"
+
+#include <QSet>
 
 ObsListWizardUI::ObsListWizardUI(QWidget *p) : QFrame(p)
 {
@@ -491,7 +494,7 @@ void ObsListWizard::applyFilters(bool doBuildList)
                 filterPass = applyRegionFilter(o, doBuildList, !doBuildList);
             //Filter objects visible from geo at Date if region filter passes
             if (olw->SelectByDate->isChecked() && filterPass)
-                applyObservableFilter(o, doBuildList, !doBuildList);
+                queueObservableFilter(o, !doBuildList);
         }
     }
 
@@ -510,7 +513,7 @@ void ObsListWizard::applyFilters(bool doBuildList)
         if (needRegion && filterPass)
             filterPass = applyRegionFilter(data->skyComposite()->findByName(i18n("Sun")), doBuildList);
         if (olw->SelectByDate->isChecked() && filterPass)
-            applyObservableFilter(data->skyComposite()->findByName(i18n("Sun")), doBuildList);
+            queueObservableFilter(data->skyComposite()->findByName(i18n("Sun")));
 
         if (maglimit < data->skyComposite()->findByName(i18n("Moon"))->mag())
         {
@@ -524,7 +527,7 @@ void ObsListWizard::applyFilters(bool doBuildList)
         if (needRegion && filterPass)
             filterPass = applyRegionFilter(data->skyComposite()->findByName(i18n("Moon")), doBuildList);
         if (olw->SelectByDate->isChecked() && filterPass)
-            applyObservableFilter(data->skyComposite()->findByName(i18n("Moon")), doBuildList);
+            queueObservableFilter(data->skyComposite()->findByName(i18n("Moon")));
 
         if (maglimit < data->skyComposite()->findByName(i18n("Mercury"))->mag())
         {
@@ -537,7 +540,7 @@ void ObsListWizard::applyFilters(bool doBuildList)
         if (needRegion && filterPass)
             filterPass = applyRegionFilter(data->skyComposite()->findByName(i18n("Mercury")), doBuildList);
         if (olw->SelectByDate->isChecked() && filterPass)
-            applyObservableFilter(data->skyComposite()->findByName(i18n("Mercury")), doBuildList);
+            queueObservableFilter(data->skyComposite()->findByName(i18n("Mercury")));
 
         if (maglimit < data->skyComposite()->findByName(i18n("Venus"))->mag())
         {
@@ -551,7 +554,7 @@ void ObsListWizard::applyFilters(bool doBuildList)
         if (needRegion && filterPass)
             filterPass = applyRegionFilter(data->skyComposite()->findByName(i18n("Venus")), doBuildList);
         if (olw->SelectByDate->isChecked() && filterPass)
-            applyObservableFilter(data->skyComposite()->findByName(i18n("Venus")), doBuildList);
+            queueObservableFilter(data->skyComposite()->findByName(i18n("Venus")));
 
         if (maglimit < data->skyComposite()->findByName(i18n("Mars"))->mag())
         {
@@ -564,7 +567,7 @@ void ObsListWizard::applyFilters(bool doBuildList)
         if (needRegion && filterPass)
             filterPass = applyRegionFilter(data->skyComposite()->findByName(i18n("Mars")), doBuildList);
         if (olw->SelectByDate->isChecked() && filterPass)
-            applyObservableFilter(data->skyComposite()->findByName(i18n("Mars")), doBuildList);
+            queueObservableFilter(data->skyComposite()->findByName(i18n("Mars")));
 
         if (maglimit < data->skyComposite()->findByName(i18n("Jupiter"))->mag())
         {
@@ -577,7 +580,7 @@ void ObsListWizard::applyFilters(bool doBuildList)
         if (needRegion && filterPass)
             filterPass = applyRegionFilter(data->skyComposite()->findByName(i18n("Jupiter")), doBuildList);
         if (olw->SelectByDate->isChecked() && filterPass)
-            applyObservableFilter(data->skyComposite()->findByName(i18n("Jupiter")), doBuildList);
+            queueObservableFilter(data->skyComposite()->findByName(i18n("Jupiter")));
 
         if (maglimit < data->skyComposite()->findByName(i18n("Saturn"))->mag())
         {
@@ -591,7 +594,7 @@ void ObsListWizard::applyFilters(bool doBuildList)
         if (needRegion && filterPass)
             filterPass = applyRegionFilter(data->skyComposite()->findByName(i18n("Saturn")), doBuildList);
         if (olw->SelectByDate->isChecked() && filterPass)
-            applyObservableFilter(data->skyComposite()->findByName(i18n("Saturn")), doBuildList);
+            queueObservableFilter(data->skyComposite()->findByName(i18n("Saturn")));
 
         if (maglimit < data->skyComposite()->findByName(i18n("Uranus"))->mag())
         {
@@ -605,7 +608,7 @@ void ObsListWizard::applyFilters(bool doBuildList)
         if (needRegion && filterPass)
             filterPass = applyRegionFilter(data->skyComposite()->findByName(i18n("Uranus")), doBuildList);
         if (olw->SelectByDate->isChecked() && filterPass)
-            applyObservableFilter(data->skyComposite()->findByName(i18n("Uranus")), doBuildList);
+            queueObservableFilter(data->skyComposite()->findByName(i18n("Uranus")));
 
         if (maglimit < data->skyComposite()->findByName(i18n("Neptune"))->mag())
         {
@@ -619,7 +622,7 @@ void ObsListWizard::applyFilters(bool doBuildList)
         if (needRegion && filterPass)
             filterPass = applyRegionFilter(data->skyComposite()->findByName(i18n("Neptune")), doBuildList);
         if (olw->SelectByDate->isChecked() && filterPass)
-            applyObservableFilter(data->skyComposite()->findByName(i18n("Neptune")), doBuildList);
+            queueObservableFilter(data->skyComposite()->findByName(i18n("Neptune")));
 
         if (maglimit < data->skyComposite()->findByName(i18n("Pluto"))->mag())
         {
@@ -633,7 +636,7 @@ void ObsListWizard::applyFilters(bool doBuildList)
         if (needRegion && filterPass)
             filterPass = applyRegionFilter(data->skyComposite()->findByName(i18nc("Asteroid name (optional)", "Pluto")), doBuildList);
         if (olw->SelectByDate->isChecked() && filterPass)
-            applyObservableFilter(data->skyComposite()->findByName(i18nc("Asteroid name (optional)", "Pluto")), doBuildList);
+            queueObservableFilter(data->skyComposite()->findByName(i18nc("Asteroid name (optional)", "Pluto")));
     }
 
     //Deep sky objects
@@ -696,7 +699,7 @@ void ObsListWizard::applyFilters(bool doBuildList)
                             if (needRegion)
                                 filterPass = applyRegionFilter(o, doBuildList);
                             if (olw->SelectByDate->isChecked() && filterPass)
-                                applyObservableFilter(o, doBuildList);
+                                queueObservableFilter(o);
                         }
                         else if (!doBuildList)
                             --ObjectCount;
@@ -708,7 +711,7 @@ void ObsListWizard::applyFilters(bool doBuildList)
                             if (needRegion)
                                 filterPass = applyRegionFilter(o, doBuildList);
                             if (olw->SelectByDate->isChecked() && filterPass)
-                                applyObservableFilter(o, doBuildList);
+                                queueObservableFilter(o);
                         }
                         else if (!doBuildList)
                             --ObjectCount;
@@ -719,7 +722,7 @@ void ObsListWizard::applyFilters(bool doBuildList)
                     if (needRegion)
                         filterPass = applyRegionFilter(o, doBuildList);
                     if (olw->SelectByDate->isChecked() && filterPass)
-                        applyObservableFilter(o, doBuildList);
+                        queueObservableFilter(o);
                 }
             }
         }
@@ -739,7 +742,7 @@ void ObsListWizard::applyFilters(bool doBuildList)
                         if (needRegion)
                             filterPass = applyRegionFilter(o, doBuildList);
                         if (olw->SelectByDate->isChecked() && filterPass)
-                            applyObservableFilter(o, doBuildList);
+                            queueObservableFilter(o);
                     }
                     else if (!doBuildList)
                         --ObjectCount;
@@ -751,7 +754,7 @@ void ObsListWizard::applyFilters(bool doBuildList)
                         if (needRegion)
                             filterPass = applyRegionFilter(o, doBuildList);
                         if (olw->SelectByDate->isChecked() && filterPass)
-                            applyObservableFilter(o, doBuildList);
+                            queueObservableFilter(o);
                     }
                     else if (!doBuildList)
                         --ObjectCount;
@@ -762,7 +765,7 @@ void ObsListWizard::applyFilters(bool doBuildList)
                 if (needRegion)
                     filterPass = applyRegionFilter(o, doBuildList);
                 if (olw->SelectByDate->isChecked() && filterPass)
-                    applyObservableFilter(o, doBuildList);
+                    queueObservableFilter(o);
             }
         }
     }
@@ -781,7 +784,7 @@ void ObsListWizard::applyFilters(bool doBuildList)
                         if (needRegion)
                             filterPass = applyRegionFilter(o, doBuildList);
                         if (olw->SelectByDate->isChecked() && filterPass)
-                            applyObservableFilter(o, doBuildList);
+                            queueObservableFilter(o);
                     }
                     else if (!doBuildList)
                         --ObjectCount;
@@ -793,7 +796,7 @@ void ObsListWizard::applyFilters(bool doBuildList)
                         if (needRegion)
                             filterPass = applyRegionFilter(o, doBuildList);
                         if (olw->SelectByDate->isChecked() && filterPass)
-                            applyObservableFilter(o, doBuildList);
+                            queueObservableFilter(o);
                     }
                     else if (!doBuildList)
                         --ObjectCount;
@@ -804,11 +807,14 @@ void ObsListWizard::applyFilters(bool doBuildList)
                 if (needRegion)
                     filterPass = applyRegionFilter(o, doBuildList);
                 if (olw->SelectByDate->isChecked() && filterPass)
-                    applyObservableFilter(o, doBuildList);
+                    queueObservableFilter(o);
             }
         }
     }
 
+    //Filter all the objects visible from geo at Date at once
+    applyObservableFilters(doBuildList);
+
     //Update the object count label
     if (doBuildList)
         ObjectCount = obsList().size();
@@ -904,15 +910,20 @@ bool ObsListWizard::applyRegionFilter(SkyObject *o, bool doBuildList, bool doAdj
     return true;
 }
 
-bool ObsListWizard::applyObservableFilter(SkyObject *o, bool doBuildList, bool doAdjustCount)
+void ObsListWizard::queueObservableFilter(SkyObject *o, bool doAdjustCount)
+{
+    ObservableCandidates.append(o);
+    ObservableAdjustCount.append(doAdjustCount);
+}
+
+void ObsListWizard::applyObservableFilters(bool doBuildList)
 {
-    SkyPoint p = *o;
+    if (ObservableCandidates.isEmpty())
+        return;
 
-    //Check altitude of object every hour from 18:00 to midnight
-    //If it's ever above 15 degrees, flag it as visible
+    //Check altitude of objects every hour from 18:00 to midnight
     KStarsDateTime Evening(olw->Date->date(), QTime(18, 0, 0), Qt::LocalTime);
     KStarsDateTime Midnight(olw->Date->date().addDays(1), QTime(0, 0, 0), Qt::LocalTime);
-    double minAlt = 15, maxAlt = 90;
 
     // Or use user-selected values, if they're valid
     if (olw->timeFrom->time().isValid() && olw->timeTo->time().isValid())
@@ -933,51 +944,47 @@ bool ObsListWizard::applyObservableFilter(SkyObject *o, bool doBuildList, bool d
         }
     }
 
-    minAlt = olw->minAlt->value();
-    maxAlt = olw->maxAlt->value();
-
     // This is the "relaxed" search mode
-    // where if the object obeys the restrictions in 50% of the time of the range
+    // where if the object obeys the restrictions in coverage % of the time of the range
     // then it qualifies as "visible"
-    double totalCount = 0, visibleCount = 0;
-    for (KStarsDateTime t = Evening; t < Midnight; t = t.addSecs(3600.0))
+    VisibilityEngine::Query query;
+    query.geo         = geo;
+    query.start       = geo->LTtoUT(Evening);
+    query.end         = geo->LTtoUT(Midnight);
+    query.step        = 3600;
+    query.minAltitude = olw->minAlt->value();
+    query.maxAltitude = olw->maxAlt->value();
+    query.coverage    = olw->coverage->value() / 100.0;
+
+    QVector<const SkyObject *> objects;
+    objects.reserve(ObservableCandidates.size());
+    for (SkyObject *o : ObservableCandidates)
+        objects.append(o);
+
+    QVector<bool> const visible = VisibilityEngine::evaluate(query, objects);
+
+    QSet<SkyObject *> rejected;
+    for (int i = 0; i < visible.size(); ++i)
     {
-        dms LST = geo->GSTtoLST(t.gst());
-        p.EquatorialToHorizontal(&LST, geo->lat());
-        totalCount++;
-        if (p.alt().Degrees() >= minAlt && p.alt().Degrees() <= maxAlt)
-            visibleCount++;
+        if (visible[i])
+            continue;
+        if (ObservableAdjustCount[i])
+            --ObjectCount;
+        if (doBuildList)
+            rejected.insert(ObservableCandidates[i]);
     }
 
-    // If the object is within the min/max alt at least coverage % of the time range
-    // then consider it visible
-    if (visibleCount / totalCount >= olw->coverage->value() / 100.0)
-        return true;
-
-    if (doAdjustCount)
-        --ObjectCount;
-    if (doBuildList)
-        obsList().takeAt(obsList().indexOf(o));
-
-    return false;
-
-    // This is the strict mode where ANY object that does not meet the min & max
-    // altitude at ANY time would be removed from the list.
-#if 0
-    for (KStarsDateTime t = Evening; t < Midnight; t = t.addSecs(3600.0))
+    if (!rejected.isEmpty())
     {
-        dms LST = geo->GSTtoLST(t.gst());
-        p.EquatorialToHorizontal(&LST, geo->lat());
-        if (p.alt().Degrees() < minAlt || p.alt().Degrees() > maxAlt)
+        for (auto it = obsList().begin(); it != obsList().end();)
         {
-            if (doAdjustCount)
-                --ObjectCount;
-            if (doBuildList)
-                obsList().takeAt(obsList().indexOf(o));
-            return false;
+            if (rejected.contains(*it))
+                it = obsList().erase(it);
+            else
+                ++it;
         }
     }
-    return true;
-#endif
 
+    ObservableCandidates.clear();
+    ObservableAdjustCount.clear();
 }
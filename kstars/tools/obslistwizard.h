@@ -75,7 +75,10 @@ class ObsListWizard : public QDialog
 
     /** @return true if the object passes the filter region constraints, false otherwise.*/
     bool applyRegionFilter(SkyObject *o, bool doBuildList, bool doAdjustCount = true);
-    bool applyObservableFilter(SkyObject *o, bool doBuildList, bool doAdjustCount = true);
+    /** Queue an object which passed the other filters, to be checked by applyObservableFilters() */
+    void queueObservableFilter(SkyObject *o, bool doAdjustCount = true);
+    /** Remove the queued objects which are not observable from geo at the selected date and times */
+    void applyObservableFilters(bool doBuildList);
 
     /**
      * Convenience function for safely getting the selected state of a QListWidget item by name.
@@ -97,6 +100,8 @@ class ObsListWizard : public QDialog
     void setItemSelected(const QString &name, QListWidget *listWidget, bool value, bool *ok = nullptr);
 
     QList<SkyObject *> ObsList;
+    QList<SkyObject *> ObservableCandidates;
+    QList<bool> ObservableAdjustCount;
     ObsListWizardUI *olw { nullptr };
     uint ObjectCount { 0 };
     uint StarCount { 0 };
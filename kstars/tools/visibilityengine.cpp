@@ -0,0 +1,252 @@
+/***************************************************************************
+                 visibilityengine.cpp  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sat 17 Oct 2026
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "visibilityengine.h"
+
+#include "geolocation.h"
+#include "ksnumbers.h"
+#include "skyobjects/skyobject.h"
+#include "skyobjects/skypointbatch.h"
+
+#include <QtConcurrent>
+
+#include <cmath>
+
+constexpr double VisibilityEngine::AtLeastOnce;
+
+struct VisibilityEngine::Job
+{
+    explicit Job(long double jd) : numbers(jd) {}
+
+    Query query;
+    double latitude { 0 };
+
+    /** Local sidereal time of each step, in degrees */
+    QVector<double> lst;
+    /** Fraction of the window elapsed at each step, to interpolate moving objects */
+    QVector<double> elapsed;
+
+    /** Numbers for the middle of the window */
+    KSNumbers numbers;
+
+    /** Catalog coordinates of fixed objects, coordinates at the start of the window of moving ones */
+    QVector<double> ra0, dec0;
+    /** Coordinates at the end of the window of moving objects */
+    QVector<double> ra1, dec1;
+    QVector<bool> moving;
+};
+
+/** Evaluates one batch of a job, the result being the indices of the visible objects */
+class VisibilityEngine::BatchEvaluator
+{
+  public:
+    typedef QVector<int> result_type;
+
+    explicit BatchEvaluator(const QSharedPointer<const Job> &job) : m_Job(job) {}
+
+    QVector<int> operator()(int first) const
+    {
+        const Job &job  = *m_Job;
+        int const count = qMin(BatchSize, job.ra0.size() - first);
+        int const steps = job.lst.size();
+
+        // Apparent coordinates of the fixed objects, the moving ones are overwritten at each step.
+        // Light bending by the Sun is ignored, it does not matter for altitudes.
+        QVector<double> ra(count), dec(count);
+        SkyPointBatch::updateCoords(&job.numbers, count, job.ra0.constData() + first, job.dec0.constData() + first,
+                                    ra.data(), dec.data());
+
+        bool anyMoving = false;
+        for (int i = 0; i < count; ++i)
+            anyMoving |= job.moving[first + i];
+
+        QVector<double> alt(count), az(count);
+        QVector<int> hits(count, 0);
+        dms const lat(job.latitude);
+
+        for (int s = 0; s < steps; ++s)
+        {
+            if (anyMoving)
+            {
+                double const f = job.elapsed[s];
+                for (int i = 0; i < count; ++i)
+                {
+                    int const j = first + i;
+                    if (!job.moving[j])
+                        continue;
+
+                    // Shortest way around in right ascension
+                    double dRA = job.ra1[j] - job.ra0[j];
+                    dRA -= 360.0 * std::round(dRA / 360.0);
+                    ra[i]  = job.ra0[j] + f * dRA;
+                    dec[i] = job.dec0[j] + f * (job.dec1[j] - job.dec0[j]);
+                }
+            }
+
+            dms const LST(job.lst[s]);
+            SkyPointBatch::equatorialToHorizontal(&LST, &lat, count, ra.constData(), dec.constData(), alt.data(),
+                                                  az.data());
+
+            for (int i = 0; i < count; ++i)
+            {
+                if (alt[i] >= job.query.minAltitude && alt[i] <= job.query.maxAltitude)
+                    hits[i]++;
+            }
+        }
+
+        QVector<int> result;
+        if (steps == 0)
+            return result;
+
+        double const required = job.query.coverage * steps;
+        for (int i = 0; i < count; ++i)
+        {
+            if (hits[i] >= required)
+                result.append(first + i);
+        }
+        return result;
+    }
+
+  private:
+    QSharedPointer<const Job> m_Job;
+};
+
+VisibilityEngine::VisibilityEngine(QObject *parent) : QObject(parent)
+{
+    connect(&m_Watcher, &QFutureWatcher<QVector<int>>::resultReadyAt, this, &VisibilityEngine::processResult);
+    connect(&m_Watcher, &QFutureWatcher<QVector<int>>::finished, this, [this]()
+    {
+        if (m_Job.isNull())
+            return;
+        m_Job.clear();
+        m_Objects.clear();
+        emit finished();
+    });
+}
+
+VisibilityEngine::~VisibilityEngine()
+{
+    cancel();
+}
+
+void VisibilityEngine::start(const Query &query, const QVector<const SkyObject *> &objects)
+{
+    cancel();
+
+    m_Objects = objects;
+    m_Job     = prepare(query, objects);
+    m_Watcher.setFuture(QtConcurrent::mapped(batches(*m_Job), BatchEvaluator(m_Job)));
+}
+
+void VisibilityEngine::cancel()
+{
+    if (m_Job.isNull())
+        return;
+
+    m_Watcher.cancel();
+    m_Watcher.waitForFinished();
+
+    // Drop the pending notifications of the cancelled evaluation
+    m_Job.clear();
+    m_Objects.clear();
+    m_Watcher.setFuture(QFuture<QVector<int>>());
+}
+
+bool VisibilityEngine::isRunning() const
+{
+    return !m_Job.isNull();
+}
+
+QVector<bool> VisibilityEngine::evaluate(const Query &query, const QVector<const SkyObject *> &objects)
+{
+    QSharedPointer<const Job> job = prepare(query, objects);
+
+    QVector<bool> result(objects.size(), false);
+    for (const QVector<int> &visible : QtConcurrent::blockingMapped(batches(*job), BatchEvaluator(job)))
+    {
+        for (int i : visible)
+            result[i] = true;
+    }
+    return result;
+}
+
+void VisibilityEngine::processResult(int index)
+{
+    if (m_Job.isNull())
+        return;
+
+    QVector<const SkyObject *> visible;
+    for (int i : m_Watcher.resultAt(index))
+        visible.append(m_Objects[i]);
+
+    if (!visible.isEmpty())
+        emit objectsVisible(visible);
+}
+
+QSharedPointer<const VisibilityEngine::Job> VisibilityEngine::prepare(const Query &query,
+        const QVector<const SkyObject *> &objects)
+{
+    Q_ASSERT(query.geo);
+
+    double const window = query.start.secsTo(query.end);
+    QSharedPointer<Job> job(new Job(query.start.djd() + window / 2 / 86400.0));
+    job->query    = query;
+    job->latitude = query.geo->lat()->Degrees();
+
+    for (KStarsDateTime t = query.start; t < query.end; t = t.addSecs(qMax(1, query.step)))
+    {
+        job->lst.append(query.geo->GSTtoLST(t.gst()).Degrees());
+        job->elapsed.append(window > 0 ? query.start.secsTo(t) / window : 0);
+    }
+
+    int const n = objects.size();
+    job->ra0.resize(n);
+    job->dec0.resize(n);
+    job->ra1.resize(n);
+    job->dec1.resize(n);
+    job->moving.fill(false, n);
+
+    for (int i = 0; i < n; ++i)
+    {
+        const SkyObject *o = objects[i];
+
+        if (o->isSolarSystem())
+        {
+            SkyPoint const p0 = o->recomputeCoords(query.start, query.geo);
+            SkyPoint const p1 = o->recomputeCoords(query.end, query.geo);
+
+            job->ra0[i]    = p0.ra().Degrees();
+            job->dec0[i]   = p0.dec().Degrees();
+            job->ra1[i]    = p1.ra().Degrees();
+            job->dec1[i]   = p1.dec().Degrees();
+            job->moving[i] = true;
+        }
+        else
+        {
+            job->ra0[i]  = o->ra0().Degrees();
+            job->dec0[i] = o->dec0().Degrees();
+        }
+    }
+
+    return job;
+}
+
+QVector<int> VisibilityEngine::batches(const Job &job)
+{
+    QVector<int> result;
+    for (int first = 0; first < job.ra0.size(); first += BatchSize)
+        result.append(first);
+    return result;
+}
@@ -0,0 +1,114 @@
+/***************************************************************************
+                  visibilityengine.h  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sat 17 Oct 2026
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include "kstarsdatetime.h"
+
+#include <QFutureWatcher>
+#include <QObject>
+#include <QSharedPointer>
+#include <QVector>
+
+class GeoLocation;
+class SkyObject;
+
+/**
+ * @class VisibilityEngine
+ * @short Finds which objects of a list are within an altitude range during a time window
+ *
+ * What's Up Tonight and the Observing List Wizard used to recompute the coordinates of each object
+ * at each hour of the night on the GUI thread. Here the work is shared instead:
+ *
+ * @li the local sidereal time of each step of the window is computed once,
+ * @li the apparent coordinates of fixed objects are computed once for the middle of the window, in
+ * batches with SkyPointBatch; over one night they move by much less than the altitude tolerance,
+ * @li solar system objects are recomputed at both ends of the window, on the calling thread since
+ * that uses the shared Earth, and interpolated linearly in between,
+ * @li the objects are then split in batches whose altitudes are evaluated with SkyPointBatch on
+ * the global thread pool.
+ *
+ * start() returns immediately, and the visible objects are streamed back through objectsVisible()
+ * on the thread of the engine as batches complete. evaluate() is the blocking equivalent.
+ */
+class VisibilityEngine : public QObject
+{
+    Q_OBJECT
+
+  public:
+    /** Coverage meaning that the object only needs to be in range at one step */
+    static constexpr double AtLeastOnce = 1e-9;
+
+    /** The time window and the altitude criteria */
+    struct Query
+    {
+        const GeoLocation *geo { nullptr };
+        /** First step of the window, UT */
+        KStarsDateTime start;
+        /** End of the window, UT, excluded */
+        KStarsDateTime end;
+        /** Interval between steps, in seconds */
+        int step { 3600 };
+        double minAltitude { 0 };
+        double maxAltitude { 90 };
+        /** Fraction of the steps during which the altitude must be in range, see AtLeastOnce */
+        double coverage { AtLeastOnce };
+    };
+
+    explicit VisibilityEngine(QObject *parent = nullptr);
+    ~VisibilityEngine() override;
+
+    /**
+     * @short Start evaluating objects in the background, cancelling any running evaluation
+     * @note The objects must stay alive until finished() is emitted or cancel() returns.
+     */
+    void start(const Query &query, const QVector<const SkyObject *> &objects);
+
+    /** Stop the running evaluation, no more signals are emitted for it */
+    void cancel();
+
+    /** @return true while an evaluation is running */
+    bool isRunning() const;
+
+    /** @return for each object, whether it satisfies the query; evaluated in parallel, but blocking */
+    static QVector<bool> evaluate(const Query &query, const QVector<const SkyObject *> &objects);
+
+  signals:
+    /** Some of the objects passed to start() satisfy the query */
+    void objectsVisible(const QVector<const SkyObject *> &objects);
+
+    /** All objects passed to start() have been evaluated */
+    void finished();
+
+  private slots:
+    void processResult(int index);
+
+  private:
+    struct Job;
+    class BatchEvaluator;
+
+    /** Objects evaluated by each worker */
+    static const int BatchSize = 2048;
+
+    /** Set up a job on the calling thread, see the class description */
+    static QSharedPointer<const Job> prepare(const Query &query, const QVector<const SkyObject *> &objects);
+
+    /** @return the first indices of the batches of a job */
+    static QVector<int> batches(const Job &job);
+
+    QSharedPointer<const Job> m_Job;
+    QVector<const SkyObject *> m_Objects;
+    QFutureWatcher<QVector<int>> m_Watcher;
+};
@@ -17,6 +17,7 @@
 
 #include "wutdialog.h"
 
+#include "ephemeriscache.h"
 #include "kstars.h"
 #include "skymap.h"
 #include "dialogs/detaildialog.h"
@@ -81,6 +82,10 @@ WUTDialog::WUTDialog(QWidget *parent, bool _session, GeoLocation *_geo, KStarsDa
     WUT->MagnitudeEdit->setSingleStep(0.100);
     initCategories();
 
+    m_Engine = new VisibilityEngine(this);
+    connect(m_Engine, &VisibilityEngine::objectsVisible, this, &WUTDialog::slotObjectsVisible);
+    connect(m_Engine, &VisibilityEngine::finished, this, &WUTDialog::slotVisibilityFinished);
+
     makeConnections();
 
     QTimer::singleShot(0, this, SLOT(init()));
@@ -116,7 +121,14 @@ void WUTDialog::init()
     float Dur;
     int hDur, mDur;
     KStarsData *data = KStarsData::Instance();
+
     // reset all lists
+    if (m_Engine->isRunning())
+    {
+        m_Engine->cancel();
+        m_PendingCategories.clear();
+        setCursor(QCursor(Qt::ArrowCursor));
+    }
     foreach (const QString &c, m_Categories)
     {
         if (m_VisibleList.contains(c))
@@ -136,15 +148,13 @@ void WUTDialog::init()
     sunSetToday     = oSun->riseSetTime(EveningUT, geo, false);
     sunRiseToday    = oSun->riseSetTime(EveningUT, geo, true);
 
-    //check to see if Sun is circumpolar
-    KSNumbers *num    = new KSNumbers(UT0.djd());
-    KSNumbers *oldNum = new KSNumbers(data->ut().djd());
-    CachingDms LST    = geo->GSTtoLST(T0.gst());
+    //check to see if Sun is circumpolar, from the shared ephemeris so that the Sun on the sky map is left alone
+    EphemerisCache *ephemeris          = EphemerisCache::Instance();
+    EphemerisCache::Sample const night = ephemeris->at(geo, UT0.djd());
 
-    oSun->updateCoords(num, true, geo->lat(), &LST, true);
-    if (oSun->checkCircumpolar(geo->lat()))
+    if (SkyPoint(dms(night.sunRA), dms(night.sunDec)).checkCircumpolar(geo->lat()))
     {
-        if (oSun->alt().Degrees() > 0.0)
+        if (ephemeris->sunAltitude(geo, UT0.djd()) > 0.0)
         {
             sRise     = i18n("circumpolar");
             sSet      = i18n("circumpolar");
@@ -198,10 +208,9 @@ void WUTDialog::init()
     moonSet       = oMoon->riseSetTime(UT0, geo, false);
 
     //check to see if Moon is circumpolar
-    oMoon->updateCoords(num, true, geo->lat(), &LST, true);
-    if (oMoon->checkCircumpolar(geo->lat()))
+    if (SkyPoint(dms(night.moonRA), dms(night.moonDec)).checkCircumpolar(geo->lat()))
     {
-        if (oMoon->alt().Degrees() > 0.0)
+        if (ephemeris->moonAltitude(geo, UT0.djd()) > 0.0)
         {
             sRise = i18n("circumpolar");
             sSet  = i18n("circumpolar");
@@ -231,19 +240,11 @@ void WUTDialog::init()
     else
         WUT->MoonSetLabel->setText(
             i18n("Moon sets at: %1 on %2", sSet, QLocale().toString(Tomorrow.date(), QLocale::LongFormat)));
-    oMoon->findPhase(nullptr);
-    WUT->MoonIllumLabel->setText(oMoon->phaseName() + QString(" (%1%)").arg(int(100.0 * oMoon->illum())));
-
-    //Restore Sun's and Moon's coordinates, and recompute Moon's original Phase
-    oMoon->updateCoords(oldNum, true, geo->lat(), data->lst(), true);
-    oSun->updateCoords(oldNum, true, geo->lat(), data->lst(), true);
-    oMoon->findPhase(nullptr);
+    WUT->MoonIllumLabel->setText(KSMoon::phaseName(night.moonPhase) +
+                                 QString(" (%1%)").arg(int(100.0 * night.moonIllum())));
 
     if (WUT->CategoryListWidget->currentItem())
         slotLoadList(WUT->CategoryListWidget->currentItem()->text());
-
-    delete num;
-    delete oldNum;
 }
 
 QSet<const SkyObject *> &WUTDialog::visibleObjects(const QString &category)
@@ -263,108 +264,139 @@ void WUTDialog::slotLoadList(const QString &c)
         return;
 
     WUT->ObjectListWidget->clear();
-    setCursor(QCursor(Qt::WaitCursor));
 
-    if (!isCategoryInitialized(c))
+    if (isCategoryInitialized(c))
     {
-        if (c == m_Categories[0]) //Planets
-        {
-            foreach (const QString &name, data->skyComposite()->objectNames(SkyObject::PLANET))
-            {
-                SkyObject *o = data->skyComposite()->findByName(name);
+        //The category has been initialized, we can populate the list widget
+        foreach (const SkyObject *o, visibleObjects(c))
+            //WUT->ObjectListWidget->addItem(o->name());
+            WUT->ObjectListWidget->addItem(o->longname());
 
-                if (checkVisibility(o) && o->mag() <= m_Mag)
-                    visibleObjects(c).insert(o);
-            }
+        highlightFirstObject();
+        return;
+    }
 
-            m_CategoryInitialized[c] = true;
-        }
+    // The category is already being evaluated, its objects show up as they are found
+    if (m_PendingCategories.contains(c))
+    {
+        foreach (const SkyObject *o, visibleObjects(c))
+            WUT->ObjectListWidget->addItem(o->longname());
+        return;
+    }
 
-        else if (c == m_Categories[1]) //Stars
-        {
+    // Only one evaluation at a time, forget the partial results of the previous one
+    if (m_Engine->isRunning())
+    {
+        m_Engine->cancel();
+        foreach (const QString &pending, m_PendingCategories)
+            visibleObjects(pending).clear();
+        m_PendingCategories.clear();
+        setCursor(QCursor(Qt::ArrowCursor));
+    }
 
-            QVector<QPair<QString, const SkyObject *>> starObjects;
-            starObjects.append(data->skyComposite()->objectLists(SkyObject::STAR));
-            starObjects.append(data->skyComposite()->objectLists(SkyObject::CATALOG_STAR));
+    // Collect the candidates, the cheap filters come first
+    QVector<const SkyObject *> candidates;
 
-            for (const auto &object : starObjects)
-            {
-                const SkyObject *o =  object.second;
+    if (c == m_Categories[0]) //Planets
+    {
+        foreach (const QString &name, data->skyComposite()->objectNames(SkyObject::PLANET))
+        {
+            SkyObject *o = data->skyComposite()->findByName(name);
 
-                if (checkVisibility(o) && o->mag() <= m_Mag)
-                {
-                    visibleObjects(c).insert(o);
-                }
-            }
-            m_CategoryInitialized[c] = true;
+            if (o->mag() <= m_Mag)
+                candidates.append(o);
         }
 
-        else if (c == m_Categories[5]) //Constellations
-        {
-            foreach (SkyObject *o, data->skyComposite()->constellationNames())
-                if (checkVisibility(o))
-                    visibleObjects(c).insert(o);
+        m_PendingCategories << c;
+    }
 
-            m_CategoryInitialized[c] = true;
-        }
+    else if (c == m_Categories[1]) //Stars
+    {
+        QVector<QPair<QString, const SkyObject *>> starObjects;
+        starObjects.append(data->skyComposite()->objectLists(SkyObject::STAR));
+        starObjects.append(data->skyComposite()->objectLists(SkyObject::CATALOG_STAR));
 
-        else if (c == m_Categories[6]) //Asteroids
+        for (const auto &object : starObjects)
         {
-            foreach (SkyObject *o, data->skyComposite()->asteroids())
-                if (checkVisibility(o) && o->name() != i18nc("Asteroid name (optional)", "Pluto") && o->mag() <= m_Mag)
-                    visibleObjects(c).insert(o);
+            const SkyObject *o = object.second;
 
-            m_CategoryInitialized[c] = true;
+            if (o->mag() <= m_Mag)
+                candidates.append(o);
         }
 
-        else if (c == m_Categories[7]) //Comets
-        {
-            foreach (SkyObject *o, data->skyComposite()->comets())
-                if (checkVisibility(o) && o->mag() <= m_Mag)
-                    visibleObjects(c).insert(o);
+        m_PendingCategories << c;
+    }
 
-            m_CategoryInitialized[c] = true;
-        }
+    else if (c == m_Categories[5]) //Constellations
+    {
+        foreach (SkyObject *o, data->skyComposite()->constellationNames())
+            candidates.append(o);
 
-        else //all deep-sky objects, need to split clusters, nebulae and galaxies
-        {
-            foreach (DeepSkyObject *dso, data->skyComposite()->deepSkyObjects())
-            {
-                SkyObject *o = (SkyObject *)dso;
-                if (checkVisibility(o) && o->mag() <= m_Mag)
-                {
-                    switch (o->type())
-                    {
-                        case SkyObject::OPEN_CLUSTER: //fall through
-                        case SkyObject::GLOBULAR_CLUSTER:
-                            visibleObjects(m_Categories[4]).insert(o); //star clusters
-                            break;
-                        case SkyObject::GASEOUS_NEBULA:   //fall through
-                        case SkyObject::PLANETARY_NEBULA: //fall through
-                        case SkyObject::SUPERNOVA_REMNANT:
-                            visibleObjects(m_Categories[2]).insert(o); //nebulae
-                            break;
-                        case SkyObject::GALAXY:
-                            visibleObjects(m_Categories[3]).insert(o); //galaxies
-                            break;
-                    }
-                }
-            }
+        m_PendingCategories << c;
+    }
+
+    else if (c == m_Categories[6]) //Asteroids
+    {
+        foreach (SkyObject *o, data->skyComposite()->asteroids())
+            if (o->name() != i18nc("Asteroid name (optional)", "Pluto") && o->mag() <= m_Mag)
+                candidates.append(o);
 
-            m_CategoryInitialized[m_Categories[2]] = true;
-            m_CategoryInitialized[m_Categories[3]] = true;
-            m_CategoryInitialized[m_Categories[4]] = true;
+        m_PendingCategories << c;
+    }
+
+    else if (c == m_Categories[7]) //Comets
+    {
+        foreach (SkyObject *o, data->skyComposite()->comets())
+            if (o->mag() <= m_Mag)
+                candidates.append(o);
+
+        m_PendingCategories << c;
+    }
+
+    else //all deep-sky objects, need to split clusters, nebulae and galaxies
+    {
+        foreach (DeepSkyObject *dso, data->skyComposite()->deepSkyObjects())
+        {
+            SkyObject *o = (SkyObject *)dso;
+            if (o->mag() <= m_Mag && !deepSkyCategory(o).isEmpty())
+                candidates.append(o);
         }
+
+        m_PendingCategories << m_Categories[2] << m_Categories[3] << m_Categories[4];
     }
 
-    //Now the category has been initialized, we can populate the list widget
-    foreach (const SkyObject *o, visibleObjects(c))
-        //WUT->ObjectListWidget->addItem(o->name());
-        WUT->ObjectListWidget->addItem(o->longname());
+    setCursor(QCursor(Qt::WaitCursor));
+    m_Engine->start(visibilityQuery(), candidates);
+}
+
+void WUTDialog::slotObjectsVisible(const QVector<const SkyObject *> &objects)
+{
+    QListWidgetItem *current = WUT->CategoryListWidget->currentItem();
+    QString const shown      = current ? current->text() : QString();
+
+    for (const SkyObject *o : objects)
+    {
+        QString const c = m_PendingCategories.size() == 1 ? m_PendingCategories.first() : deepSkyCategory(o);
+
+        visibleObjects(c).insert(o);
+        if (c == shown)
+            WUT->ObjectListWidget->addItem(o->longname());
+    }
+}
+
+void WUTDialog::slotVisibilityFinished()
+{
+    foreach (const QString &c, m_PendingCategories)
+        m_CategoryInitialized[c] = true;
+    m_PendingCategories.clear();
 
     setCursor(QCursor(Qt::ArrowCursor));
 
-    // highlight first item
+    highlightFirstObject();
+}
+
+void WUTDialog::highlightFirstObject()
+{
     if (WUT->ObjectListWidget->count())
     {
         WUT->ObjectListWidget->setCurrentRow(0);
@@ -372,15 +404,25 @@ void WUTDialog::slotLoadList(const QString &c)
     }
 }
 
-bool WUTDialog::checkVisibility(const SkyObject *o)
+QString WUTDialog::deepSkyCategory(const SkyObject *o) const
 {
-    bool visible(false);
-    double minAlt = 6.0; //An object is considered 'visible' if it is above horizon during civil twilight.
-
-    // reject objects that never rise
-    if (o->checkCircumpolar(geo->lat()) == true && o->alt().Degrees() <= 0)
-        return false;
+    switch (o->type())
+    {
+        case SkyObject::OPEN_CLUSTER: //fall through
+        case SkyObject::GLOBULAR_CLUSTER:
+            return m_Categories[4]; //star clusters
+        case SkyObject::GASEOUS_NEBULA:   //fall through
+        case SkyObject::PLANETARY_NEBULA: //fall through
+        case SkyObject::SUPERNOVA_REMNANT:
+            return m_Categories[2]; //nebulae
+        case SkyObject::GALAXY:
+            return m_Categories[3]; //galaxies
+    }
+    return QString();
+}
 
+VisibilityEngine::Query WUTDialog::visibilityQuery() const
+{
     //Initial values for T1, T2 assume all night option of EveningMorningBox
     KStarsDateTime T1 = Evening;
     T1.setTime(sunSetToday);
@@ -397,24 +439,20 @@ bool WUTDialog::checkVisibility(const SkyObject *o)
         T1 = T0; //midnight
     }
 
-    for (KStarsDateTime test = T1; test < T2; test = test.addSecs(3600))
-    {
-        //Need LST of the test time, expressed as a dms object.
-        KStarsDateTime ut = geo->LTtoUT(test);
-        dms LST           = geo->GSTtoLST(ut.gst());
-        SkyPoint sp       = o->recomputeCoords(ut, geo);
-
-        //check altitude of object at this time.
-        sp.EquatorialToHorizontal(&LST, geo->lat());
-
-        if (sp.alt().Degrees() > minAlt)
-        {
-            visible = true;
-            break;
-        }
-    }
+    //An object is considered 'visible' if it is above horizon during civil twilight, checked every hour
+    VisibilityEngine::Query query;
+    query.geo         = geo;
+    query.start       = geo->LTtoUT(T1);
+    query.end         = geo->LTtoUT(T2);
+    query.step        = 3600;
+    query.minAltitude = 6.0;
+    query.coverage    = VisibilityEngine::AtLeastOnce;
+    return query;
+}
 
-    return visible;
+bool WUTDialog::checkVisibility(const SkyObject *o)
+{
+    return VisibilityEngine::evaluate(visibilityQuery(), { o }).first();
 }
 
 void WUTDialog::slotDisplayObject(const QString &name)
@@ -20,6 +20,7 @@
 #include "kstarsdata.h"
 #include "kstarsdatetime.h"
 #include "ui_wutdialog.h"
+#include "tools/visibilityengine.h"
 
 #include <QFrame>
 #include <QDialog>
@@ -58,6 +59,7 @@ class WUTDialog : public QDialog
      * @short Check visibility of object
      * @p o the object to check
      * @return true if visible
+     * @note Lists of objects are evaluated in the background by slotLoadList() instead
      */
     bool checkVisibility(const SkyObject *o);
 
@@ -75,6 +77,12 @@ class WUTDialog : public QDialog
      */
     void slotLoadList(const QString &category);
 
+    /** Add objects found visible by the background evaluation to their category */
+    void slotObjectsVisible(const QVector<const SkyObject *> &objects);
+
+    /** Mark the categories of the background evaluation as initialized */
+    void slotVisibilityFinished();
+
     /** Display the rise/transit/set times for selected object */
     void slotDisplayObject(const QString &name);
 
@@ -119,6 +127,12 @@ class WUTDialog : public QDialog
     void makeConnections();
     /** @short Initialize category list, used in constructor */
     void initCategories();
+    /** @short Select the first object of the list widget */
+    void highlightFirstObject();
+    /** @return the category of a deep-sky object, empty if it doesn't belong to any */
+    QString deepSkyCategory(const SkyObject *o) const;
+    /** @return the part of the night and altitude that make an object visible */
+    VisibilityEngine::Query visibilityQuery() const;
 
     WUTDialogUI *WUT { nullptr };
     bool session { false };
@@ -131,4 +145,7 @@ class WUTDialog : public QDialog
     QStringList m_Categories;
     QHash<QString, QSet<const SkyObject *>> m_VisibleList;
     QHash<QString, bool> m_CategoryInitialized;
+    VisibilityEngine *m_Engine { nullptr };
+    /** Categories being filled by m_Engine */
+    QStringList m_PendingCategories;
 };
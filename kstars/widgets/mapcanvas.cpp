@@ -23,6 +23,7 @@
 #include <QMouseEvent>
 #include <QPaintEvent>
 #include <QStandardPaths>
+#include "citydb.h"
 #include "kspaths.h"
 
 #include "dialogs/locationdialog.h"
@@ -80,10 +81,10 @@ void MapCanvas::paintEvent(QPaintEvent *)
 
     //Draw cities
     QPoint o;
-    foreach (GeoLocation *g, KStarsData::Instance()->getGeoList())
+    foreach (const QPointF &city, KStarsData::Instance()->citydb()->coordinates())
     {
-        o.setX(int(g->lng()->Degrees() + origin.x()));
-        o.setY(height() - int(g->lat()->Degrees() + origin.y()));
+        o.setX(int(city.x() + origin.x()));
+        o.setY(height() - int(city.y() + origin.y()));
 
         if (o.x() >= 0 && o.x() <= width() && o.y() >= 0 && o.y() <= height())
         {